@@ -0,0 +1,251 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#pragma once
+
+class CLIParser
+{
+public:
+
+    CLIParser() = delete;
+
+    //! Direction of the samples driven through the enabler
+    enum class Direction
+    {
+        //! From DDS publishers to the user's app (data callback)
+        IN,
+        //! From the user's app (publish) to DDS subscribers
+        OUT,
+        //! Both of the above
+        BOTH
+    };
+
+    //! Transport used by the enabler and the in-process DDS entities
+    enum class Transport
+    {
+        //! Shared memory
+        SHM,
+        //! UDP over the loopback interface
+        UDP
+    };
+
+    struct bench_config
+    {
+        uint32_t topics = 1;
+        uint32_t payload_size = 256;
+        uint32_t rate = 100;
+        uint32_t duration = 10;
+        uint32_t discovery_timeout = 10;
+        uint32_t domain = 42;
+        Direction direction = Direction::BOTH;
+        Transport transport = Transport::SHM;
+        std::string output_path = "";
+    };
+
+    /**
+     * @brief Print usage help message and exit with the given return code
+     *
+     * @param return_code return code to exit with
+     *
+     * @warning This method finishes the execution of the program with the input return code
+     */
+    static void print_help(
+            uint8_t return_code)
+    {
+        std::cout << "Usage: ddsenabler_bench [options]"                                                << std::endl;
+        std::cout << ""                                                                                 << std::endl;
+        std::cout << "--topics <num>                        Number of topics in each direction"         << std::endl;
+        std::cout << "                                      (Default: 1)"                               << std::endl;
+        std::cout << "--payload-size <num>                  Bytes of payload of each sample (min. 8)"   << std::endl;
+        std::cout << "                                      (Default: 256)"                             << std::endl;
+        std::cout << "--rate <num>                          Samples per second and topic, 0 to publish" << std::endl;
+        std::cout << "                                      as fast as possible"                        << std::endl;
+        std::cout << "                                      (Default: 100)"                             << std::endl;
+        std::cout << "--duration <num>                      Time (seconds) publishing samples"          << std::endl;
+        std::cout << "                                      (Default: 10)"                              << std::endl;
+        std::cout << "--direction <in|out|both>             Samples from DDS to the app (in), from the" << std::endl;
+        std::cout << "                                      app to DDS (out) or both"                   << std::endl;
+        std::cout << "                                      (Default: both)"                            << std::endl;
+        std::cout << "--transport <shm|udp>                 Shared memory or UDP loopback transport"    << std::endl;
+        std::cout << "                                      (Default: shm)"                             << std::endl;
+        std::cout << "--domain <num>                        DDS domain of the benchmark"                << std::endl;
+        std::cout << "                                      (Default: 42)"                              << std::endl;
+        std::cout << "--discovery-timeout <num>             Time (seconds) to wait for the topics to"   << std::endl;
+        std::cout << "                                      be discovered and matched"                  << std::endl;
+        std::cout << "                                      (Default: 10)"                              << std::endl;
+        std::cout << "--output <str>                        Path of a JSON file to write results to"    << std::endl;
+        std::cout << "                                      (Default: '')"                              << std::endl;
+        std::exit(return_code);
+    }
+
+    /**
+     * @brief Parse the command line options and return the bench_config object
+     *
+     * @param argc number of arguments
+     * @param argv array of arguments
+     * @return bench_config object with the parsed options
+     *
+     * @warning This method finishes the execution of the program if the input arguments are invalid
+     */
+    static bench_config parse_cli_options(
+            int argc,
+            char* argv[])
+    {
+        bench_config config;
+
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string arg = argv[i];
+
+            if (arg == "-h" || arg == "--help")
+            {
+                print_help(EXIT_SUCCESS);
+            }
+            else if (arg == "--topics")
+            {
+                config.topics = parse_number_(argc, argv, i);
+            }
+            else if (arg == "--payload-size")
+            {
+                config.payload_size = parse_number_(argc, argv, i);
+            }
+            else if (arg == "--rate")
+            {
+                config.rate = parse_number_(argc, argv, i);
+            }
+            else if (arg == "--duration")
+            {
+                config.duration = parse_number_(argc, argv, i);
+            }
+            else if (arg == "--discovery-timeout")
+            {
+                config.discovery_timeout = parse_number_(argc, argv, i);
+            }
+            else if (arg == "--domain")
+            {
+                config.domain = parse_number_(argc, argv, i);
+            }
+            else if (arg == "--direction")
+            {
+                const std::string value = parse_string_(argc, argv, i);
+                if (value == "in")
+                {
+                    config.direction = Direction::IN;
+                }
+                else if (value == "out")
+                {
+                    config.direction = Direction::OUT;
+                }
+                else if (value == "both")
+                {
+                    config.direction = Direction::BOTH;
+                }
+                else
+                {
+                    std::cerr << "Invalid --direction argument " << value << std::endl;
+                    print_help(EXIT_FAILURE);
+                }
+            }
+            else if (arg == "--transport")
+            {
+                const std::string value = parse_string_(argc, argv, i);
+                if (value == "shm")
+                {
+                    config.transport = Transport::SHM;
+                }
+                else if (value == "udp")
+                {
+                    config.transport = Transport::UDP;
+                }
+                else
+                {
+                    std::cerr << "Invalid --transport argument " << value << std::endl;
+                    print_help(EXIT_FAILURE);
+                }
+            }
+            else if (arg == "--output")
+            {
+                config.output_path = parse_string_(argc, argv, i);
+            }
+            else
+            {
+                std::cerr << "Unknown argument: " << arg << std::endl;
+                print_help(EXIT_FAILURE);
+            }
+        }
+
+        if (config.topics == 0 || config.duration == 0)
+        {
+            std::cerr << "--topics and --duration must be greater than 0" << std::endl;
+            print_help(EXIT_FAILURE);
+        }
+        if (config.payload_size < sizeof(int64_t))
+        {
+            std::cerr << "--payload-size must be at least " << sizeof(int64_t) <<
+                " bytes to carry the send timestamp" << std::endl;
+            print_help(EXIT_FAILURE);
+        }
+
+        return config;
+    }
+
+protected:
+
+    //! Get the value of the option at \c i , advancing \c i
+    static std::string parse_string_(
+            int argc,
+            char* argv[],
+            int& i)
+    {
+        const std::string arg = argv[i];
+        if (++i >= argc)
+        {
+            std::cerr << "Failed to parse " << arg << " argument" << std::endl;
+            print_help(EXIT_FAILURE);
+        }
+        return argv[i];
+    }
+
+    //! Get the numeric value of the option at \c i , advancing \c i
+    static uint32_t parse_number_(
+            int argc,
+            char* argv[],
+            int& i)
+    {
+        const std::string arg = argv[i];
+        const std::string value = parse_string_(argc, argv, i);
+        try
+        {
+            const unsigned long number = std::stoul(value);
+            if (number > UINT32_MAX)
+            {
+                throw std::out_of_range("value out of range");
+            }
+            return static_cast<uint32_t>(number);
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "Invalid " << arg << " argument " << value << ": " << std::string(e.what()) << std::endl;
+            print_help(EXIT_FAILURE);
+        }
+        return 0;
+    }
+
+};
@@ -0,0 +1,842 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file DdsEnablerBench.cpp
+ *
+ * End-to-end throughput and latency benchmark of the enabler: samples are driven from in-process Fast DDS publishers
+ * to the user's app (data callback), and from the user's app (publish) to in-process Fast DDS subscribers.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include <fastdds/dds/domain/DomainParticipant.hpp>
+#include <fastdds/dds/domain/DomainParticipantFactory.hpp>
+#include <fastdds/dds/log/Log.hpp>
+#include <fastdds/dds/publisher/DataWriter.hpp>
+#include <fastdds/dds/publisher/Publisher.hpp>
+#include <fastdds/dds/subscriber/DataReader.hpp>
+#include <fastdds/dds/subscriber/DataReaderListener.hpp>
+#include <fastdds/dds/subscriber/SampleInfo.hpp>
+#include <fastdds/dds/subscriber/Subscriber.hpp>
+#include <fastdds/dds/topic/Topic.hpp>
+#include <fastdds/dds/topic/TypeSupport.hpp>
+#include <fastdds/LibrarySettings.hpp>
+#include <fastdds/rtps/attributes/BuiltinTransports.hpp>
+#include <fastdds/rtps/transport/UDPv4TransportDescriptor.hpp>
+
+#include "ddsenabler/dds_enabler_runner.hpp"
+#include "ddsenabler/DDSEnabler.hpp"
+
+#include "types/sequencesPubSubTypes.hpp"
+
+#include "CLIParser.hpp"
+
+using namespace eprosima;
+using namespace eprosima::fastdds::dds;
+using namespace eprosima::ddsenabler;
+
+namespace {
+
+//! Prefix of the topics published by the in-process DDS writers and notified to the app
+const std::string IN_TOPIC_PREFIX = "ddsenabler_bench/in/";
+
+//! Prefix of the topics published by the app and received by the in-process DDS readers
+const std::string OUT_TOPIC_PREFIX = "ddsenabler_bench/out/";
+
+//! History depth of the in-process DDS entities
+constexpr const int32_t HISTORY_DEPTH = 100;
+
+//! Maximum time to wait for the samples in flight when publication stops
+constexpr const std::chrono::seconds DRAIN_TIMEOUT {2};
+
+//! Period between checks while waiting for discovery or in-flight samples
+constexpr const std::chrono::milliseconds POLL_PERIOD {100};
+
+int64_t now_ns()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * Counters and latencies of one direction, updated from the publishing thread and the reception callbacks.
+ */
+struct DirectionStats
+{
+    std::atomic<uint64_t> sent {0};
+    std::atomic<uint64_t> received {0};
+
+    std::mutex mtx;
+    std::vector<uint64_t> latencies_ns;
+
+    void record(
+            int64_t send_time_ns)
+    {
+        const int64_t latency = now_ns() - send_time_ns;
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            latencies_ns.push_back(static_cast<uint64_t>(std::max<int64_t>(latency, 0)));
+        }
+        received.fetch_add(1, std::memory_order_relaxed);
+    }
+
+};
+
+/**
+ * Summary of the samples driven in one direction.
+ */
+struct DirectionResults
+{
+    uint64_t sent {0};
+    uint64_t received {0};
+    uint64_t dropped {0};
+    double throughput {0};
+    double throughput_mbps {0};
+    double mean_us {0};
+    double p50_us {0};
+    double p99_us {0};
+    double p999_us {0};
+    double max_us {0};
+};
+
+//! Nearest-rank percentile of sorted latencies, in microseconds
+double percentile_us(
+        const std::vector<uint64_t>& sorted_latencies_ns,
+        double percentile)
+{
+    if (sorted_latencies_ns.empty())
+    {
+        return 0;
+    }
+    const std::size_t rank = static_cast<std::size_t>(std::ceil(percentile / 100.0 * sorted_latencies_ns.size()));
+    return sorted_latencies_ns[std::min(std::max<std::size_t>(rank, 1), sorted_latencies_ns.size()) - 1] / 1000.0;
+}
+
+DirectionResults summarize(
+        DirectionStats& stats,
+        double seconds,
+        uint32_t payload_size)
+{
+    DirectionResults results;
+    results.sent = stats.sent.load();
+    results.received = stats.received.load();
+    results.dropped = results.sent > results.received ? results.sent - results.received : 0;
+    results.throughput = results.received / seconds;
+    results.throughput_mbps = results.throughput * payload_size / (1024.0 * 1024.0);
+
+    std::lock_guard<std::mutex> lock(stats.mtx);
+    std::vector<uint64_t>& latencies = stats.latencies_ns;
+    if (!latencies.empty())
+    {
+        std::sort(latencies.begin(), latencies.end());
+        long double total = 0;
+        for (const auto latency : latencies)
+        {
+            total += latency;
+        }
+        results.mean_us = static_cast<double>(total / latencies.size() / 1000.0);
+        results.p50_us = percentile_us(latencies, 50);
+        results.p99_us = percentile_us(latencies, 99);
+        results.p999_us = percentile_us(latencies, 99.9);
+        results.max_us = latencies.back() / 1000.0;
+    }
+    return results;
+}
+
+nlohmann::json to_json(
+        const DirectionResults& results)
+{
+    nlohmann::json json;
+    json["sent"] = results.sent;
+    json["received"] = results.received;
+    json["dropped"] = results.dropped;
+    json["throughput"] = results.throughput;
+    json["throughput_mbps"] = results.throughput_mbps;
+    json["latency_us"] = {
+        {"mean", results.mean_us},
+        {"p50", results.p50_us},
+        {"p99", results.p99_us},
+        {"p999", results.p999_us},
+        {"max", results.max_us}
+    };
+    return json;
+}
+
+void print_results(
+        const std::string& direction,
+        const DirectionResults& results)
+{
+    std::cout << std::left << std::setw(5) << direction << std::right << std::fixed << std::setprecision(1)
+              << std::setw(12) << results.sent
+              << std::setw(12) << results.received
+              << std::setw(10) << results.dropped
+              << std::setw(14) << results.throughput
+              << std::setw(10) << std::setprecision(2) << results.throughput_mbps << std::setprecision(1)
+              << std::setw(11) << results.p50_us
+              << std::setw(11) << results.p99_us
+              << std::setw(11) << results.p999_us
+              << std::setw(11) << results.max_us << std::endl;
+}
+
+/**
+ * In-process DDS entities of a topic, along the lines of the \c KnownType of the enabler tests.
+ */
+struct BenchTopic
+{
+    std::string name;
+    Topic* topic = nullptr;
+    DataWriter* writer = nullptr;
+    DataReader* reader = nullptr;
+};
+
+/**
+ * Listener of the in-process DDS readers, recording the latency of the samples published by the app.
+ *
+ * The send time travels in the first bytes of the payload, as the app publishes JSON with no source timestamp.
+ */
+class OutReaderListener : public DataReaderListener
+{
+public:
+
+    OutReaderListener(
+            DirectionStats& stats,
+            const std::atomic<int64_t>& start_ns)
+        : stats_(stats)
+        , start_ns_(start_ns)
+    {
+    }
+
+    void on_data_available(
+            DataReader* reader) override
+    {
+        SequenceOctet sample;
+        SampleInfo info;
+        while (RETCODE_OK == reader->take_next_sample(&sample, &info))
+        {
+            const std::vector<uint8_t>& payload = sample.var_sequence_octet();
+            if (!info.valid_data || payload.size() < sizeof(int64_t))
+            {
+                continue;
+            }
+
+            uint64_t send_time = 0;
+            for (std::size_t i = 0; i < sizeof(int64_t); ++i)
+            {
+                send_time |= static_cast<uint64_t>(payload[i]) << (8 * i);
+            }
+
+            // Skip the samples published to match the topics
+            if (static_cast<int64_t>(send_time) >= start_ns_.load(std::memory_order_relaxed))
+            {
+                stats_.record(static_cast<int64_t>(send_time));
+            }
+        }
+    }
+
+protected:
+
+    DirectionStats& stats_;
+
+    const std::atomic<int64_t>& start_ns_;
+};
+
+/**
+ * Benchmark run: the enabler, the in-process DDS entities and the publishing threads.
+ */
+class Bench
+{
+public:
+
+    Bench(
+            const CLIParser::bench_config& config)
+        : config_(config)
+        , out_listener_(out_stats_, start_ns_)
+    {
+    }
+
+    ~Bench()
+    {
+        enabler_.reset();
+        instance_ = nullptr;
+        if (participant_ != nullptr)
+        {
+            participant_->delete_contained_entities();
+            DomainParticipantFactory::get_instance()->delete_participant(participant_);
+        }
+    }
+
+    //! Create the enabler and the DDS entities, and wait until every topic is discovered and matched
+    bool init();
+
+    //! Drive the samples for the configured duration and print the results
+    bool run();
+
+    // Enabler callbacks
+    static void log_callback(
+            const char* file_name,
+            int line_no,
+            const char* func_name,
+            int category,
+            const char* msg);
+
+    static void type_notification_callback(
+            const char*,
+            const char*,
+            const unsigned char*,
+            uint32_t,
+            const char*)
+    {
+    }
+
+    static void topic_notification_callback(
+            const char* topic_name,
+            const participants::TopicInfo& topic_info);
+
+    static void data_notification_callback(
+            const char* topic_name,
+            const char* json,
+            int64_t publish_time);
+
+    static bool type_query_callback(
+            const char*,
+            std::unique_ptr<const unsigned char[]>&,
+            uint32_t&)
+    {
+        return false;
+    }
+
+    static bool topic_query_callback(
+            const char*,
+            participants::TopicInfo&)
+    {
+        return false;
+    }
+
+protected:
+
+    bool drives_in_() const
+    {
+        return config_.direction != CLIParser::Direction::OUT;
+    }
+
+    bool drives_out_() const
+    {
+        return config_.direction != CLIParser::Direction::IN;
+    }
+
+    bool create_enabler_();
+
+    bool create_entities_();
+
+    //! Wait until \c predicate holds or the discovery timeout expires
+    template <typename Predicate>
+    bool wait_for_(
+            Predicate predicate,
+            std::chrono::steady_clock::time_point deadline);
+
+    //! JSON sample published by the app, carrying \c send_time in its first bytes
+    std::string out_json_(
+            int64_t send_time) const;
+
+    //! Publish one sample per topic every period until \c stop_
+    void publish_in_routine_();
+    void publish_out_routine_();
+
+    const CLIParser::bench_config config_;
+
+    std::shared_ptr<DDSEnabler> enabler_;
+
+    DomainParticipant* participant_ = nullptr;
+    TypeSupport type_ {new SequenceOctetPubSubType()};
+    std::vector<BenchTopic> in_topics_;
+    std::vector<BenchTopic> out_topics_;
+
+    DirectionStats in_stats_;
+    DirectionStats out_stats_;
+    OutReaderListener out_listener_;
+
+    //! Start of the measurement (samples sent before are not accounted)
+    std::atomic<int64_t> start_ns_ {INT64_MAX};
+
+    std::atomic<bool> stop_ {false};
+
+    //! Topics notified by the enabler
+    std::mutex discovery_mtx_;
+    std::set<std::string> discovered_topics_;
+
+    //! Payload of the out samples after the send time, as JSON array elements
+    std::string out_json_tail_;
+
+    static Bench* instance_;
+};
+
+Bench* Bench::instance_ = nullptr;
+
+void Bench::log_callback(
+        const char* file_name,
+        int line_no,
+        const char* func_name,
+        int category,
+        const char* msg)
+{
+    if (category == utils::Log::Kind::Error)
+    {
+        std::cerr << "[ERROR] " << file_name << ":" << line_no << " (" << func_name << "): " << msg << std::endl;
+    }
+}
+
+void Bench::topic_notification_callback(
+        const char* topic_name,
+        const participants::TopicInfo&)
+{
+    if (instance_)
+    {
+        std::lock_guard<std::mutex> lock(instance_->discovery_mtx_);
+        instance_->discovered_topics_.insert(topic_name);
+    }
+}
+
+void Bench::data_notification_callback(
+        const char* topic_name,
+        const char*,
+        int64_t publish_time)
+{
+    if (instance_ && std::strncmp(topic_name, IN_TOPIC_PREFIX.c_str(), IN_TOPIC_PREFIX.size()) == 0 &&
+            publish_time >= instance_->start_ns_.load(std::memory_order_relaxed))
+    {
+        instance_->in_stats_.record(publish_time);
+    }
+}
+
+bool Bench::init()
+{
+    instance_ = this;
+
+    // Force samples through the configured transport, even if every entity lives in this process
+    fastdds::LibrarySettings library_settings;
+    library_settings.intraprocess_delivery = fastdds::INTRAPROCESS_OFF;
+    DomainParticipantFactory::get_instance()->set_library_settings(library_settings);
+
+    if (!create_enabler_() || !create_entities_())
+    {
+        return false;
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(config_.discovery_timeout);
+
+    // Wait until the enabler knows every topic (and thus its type) and the in writers match the enabler
+    const bool discovered = wait_for_([this]()
+                    {
+                        std::lock_guard<std::mutex> lock(discovery_mtx_);
+                        for (const auto& topics : {&in_topics_, &out_topics_})
+                        {
+                            for (const auto& topic : *topics)
+                            {
+                                if (discovered_topics_.count(topic.name) == 0)
+                                {
+                                    return false;
+                                }
+                            }
+                        }
+                        for (const auto& topic : in_topics_)
+                        {
+                            PublicationMatchedStatus status;
+                            topic.writer->get_publication_matched_status(status);
+                            if (status.current_count == 0)
+                            {
+                                return false;
+                            }
+                        }
+                        return true;
+                    }, deadline);
+
+    // Publish from the app until the enabler writers match the out readers (start_ns_ is not set, so not accounted)
+    const bool matched = discovered && wait_for_([this]()
+                    {
+                        bool all_matched = true;
+                        for (const auto& topic : out_topics_)
+                        {
+                            SubscriptionMatchedStatus status;
+                            topic.reader->get_subscription_matched_status(status);
+                            if (status.current_count == 0)
+                            {
+                                enabler_->publish(topic.name, out_json_(0));
+                                all_matched = false;
+                            }
+                        }
+                        return all_matched;
+                    }, deadline);
+
+    if (!matched)
+    {
+        std::cerr << "Topics not discovered and matched within " << config_.discovery_timeout << " seconds" <<
+            std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool Bench::create_enabler_()
+{
+    std::stringstream yml_str;
+    yml_str << "dds:\n"
+            << "  domain: " << config_.domain << "\n"
+            << "  allowlist:\n"
+            << "    - name: \"ddsenabler_bench/*\"\n";
+    if (config_.transport == CLIParser::Transport::SHM)
+    {
+        yml_str << "  transport: shm\n";
+    }
+    else
+    {
+        yml_str << "  transport: udp\n"
+                << "  whitelist-interfaces: [\"127.0.0.1\"]\n";
+    }
+    yml_str << "specs:\n"
+            << "  logging:\n"
+            << "    stdout: false\n";
+
+    yaml::EnablerConfiguration configuration(YAML::Load(yml_str.str()));
+
+    CallbackSet callbacks{
+        log_callback,
+        {
+            type_notification_callback,
+            topic_notification_callback,
+            data_notification_callback,
+            type_query_callback,
+            topic_query_callback
+        }
+    };
+
+    if (!create_dds_enabler(configuration, callbacks, enabler_))
+    {
+        std::cerr << "Failed to create DDSEnabler instance." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool Bench::create_entities_()
+{
+    DomainParticipantQos participant_qos = PARTICIPANT_QOS_DEFAULT;
+    participant_qos.name("ddsenabler_bench");
+    if (config_.transport == CLIParser::Transport::SHM)
+    {
+        participant_qos.setup_transports(fastdds::rtps::BuiltinTransports::SHM);
+    }
+    else
+    {
+        auto udp_transport = std::make_shared<fastdds::rtps::UDPv4TransportDescriptor>();
+        udp_transport->interfaceWhiteList.push_back("127.0.0.1");
+        participant_qos.transport().use_builtin_transports = false;
+        participant_qos.transport().user_transports.push_back(udp_transport);
+    }
+
+    participant_ = DomainParticipantFactory::get_instance()->create_participant(config_.domain, participant_qos);
+    if (participant_ == nullptr)
+    {
+        std::cerr << "Failed to create the DDS participant" << std::endl;
+        return false;
+    }
+
+    if (RETCODE_OK != type_.register_type(participant_))
+    {
+        std::cerr << "Failed to register type: " << type_.get_type_name() << std::endl;
+        return false;
+    }
+
+    Publisher* publisher = participant_->create_publisher(PUBLISHER_QOS_DEFAULT);
+    Subscriber* subscriber = participant_->create_subscriber(SUBSCRIBER_QOS_DEFAULT);
+    if (publisher == nullptr || subscriber == nullptr)
+    {
+        std::cerr << "Failed to create the DDS publisher and subscriber" << std::endl;
+        return false;
+    }
+
+    DataWriterQos writer_qos = DATAWRITER_QOS_DEFAULT;
+    writer_qos.reliability().kind = RELIABLE_RELIABILITY_QOS;
+    writer_qos.history().kind = KEEP_LAST_HISTORY_QOS;
+    writer_qos.history().depth = HISTORY_DEPTH;
+
+    DataReaderQos reader_qos = DATAREADER_QOS_DEFAULT;
+    reader_qos.reliability().kind = RELIABLE_RELIABILITY_QOS;
+    reader_qos.history().kind = KEEP_LAST_HISTORY_QOS;
+    reader_qos.history().depth = HISTORY_DEPTH;
+
+    for (uint32_t i = 0; i < config_.topics; ++i)
+    {
+        if (drives_in_())
+        {
+            BenchTopic topic;
+            topic.name = IN_TOPIC_PREFIX + std::to_string(i);
+            topic.topic = participant_->create_topic(topic.name, type_.get_type_name(), TOPIC_QOS_DEFAULT);
+            if (topic.topic != nullptr)
+            {
+                topic.writer = publisher->create_datawriter(topic.topic, writer_qos);
+            }
+            if (topic.writer == nullptr)
+            {
+                std::cerr << "Failed to create the DDS writer of topic " << topic.name << std::endl;
+                return false;
+            }
+            in_topics_.push_back(topic);
+        }
+        if (drives_out_())
+        {
+            BenchTopic topic;
+            topic.name = OUT_TOPIC_PREFIX + std::to_string(i);
+            topic.topic = participant_->create_topic(topic.name, type_.get_type_name(), TOPIC_QOS_DEFAULT);
+            if (topic.topic != nullptr)
+            {
+                topic.reader = subscriber->create_datareader(topic.topic, reader_qos, &out_listener_);
+            }
+            if (topic.reader == nullptr)
+            {
+                std::cerr << "Failed to create the DDS reader of topic " << topic.name << std::endl;
+                return false;
+            }
+            out_topics_.push_back(topic);
+        }
+    }
+
+    std::stringstream tail;
+    for (uint32_t i = sizeof(int64_t); i < config_.payload_size; ++i)
+    {
+        tail << ", 0";
+    }
+    out_json_tail_ = tail.str();
+
+    return true;
+}
+
+template <typename Predicate>
+bool Bench::wait_for_(
+        Predicate predicate,
+        std::chrono::steady_clock::time_point deadline)
+{
+    while (!predicate())
+    {
+        if (std::chrono::steady_clock::now() >= deadline)
+        {
+            return false;
+        }
+        std::this_thread::sleep_for(POLL_PERIOD);
+    }
+    return true;
+}
+
+std::string Bench::out_json_(
+        int64_t send_time) const
+{
+    std::string json = "{\"var_sequence_octet\": [";
+    for (std::size_t i = 0; i < sizeof(int64_t); ++i)
+    {
+        if (i > 0)
+        {
+            json += ", ";
+        }
+        json += std::to_string((static_cast<uint64_t>(send_time) >> (8 * i)) & 0xff);
+    }
+    json += out_json_tail_;
+    json += "]}";
+    return json;
+}
+
+void Bench::publish_in_routine_()
+{
+    SequenceOctet sample;
+    sample.var_sequence_octet().resize(config_.payload_size, 0);
+
+    const auto period = config_.rate > 0 ?
+            std::chrono::nanoseconds(1000000000 / config_.rate) : std::chrono::nanoseconds(0);
+    auto next = std::chrono::steady_clock::now();
+    while (!stop_.load(std::memory_order_relaxed))
+    {
+        for (auto& topic : in_topics_)
+        {
+            // Latency is taken from the source timestamp of the sample, set by the writer
+            in_stats_.sent.fetch_add(1, std::memory_order_relaxed);
+            topic.writer->write(&sample);
+        }
+        if (period.count() > 0)
+        {
+            next += period;
+            std::this_thread::sleep_until(next);
+        }
+    }
+}
+
+void Bench::publish_out_routine_()
+{
+    const auto period = config_.rate > 0 ?
+            std::chrono::nanoseconds(1000000000 / config_.rate) : std::chrono::nanoseconds(0);
+    auto next = std::chrono::steady_clock::now();
+    while (!stop_.load(std::memory_order_relaxed))
+    {
+        for (auto& topic : out_topics_)
+        {
+            out_stats_.sent.fetch_add(1, std::memory_order_relaxed);
+            enabler_->publish(topic.name, out_json_(now_ns()));
+        }
+        if (period.count() > 0)
+        {
+            next += period;
+            std::this_thread::sleep_until(next);
+        }
+    }
+}
+
+bool Bench::run()
+{
+    const std::clock_t cpu_start = std::clock();
+    const auto start = std::chrono::steady_clock::now();
+    start_ns_.store(now_ns());
+
+    std::thread in_thread;
+    std::thread out_thread;
+    if (drives_in_())
+    {
+        in_thread = std::thread(&Bench::publish_in_routine_, this);
+    }
+    if (drives_out_())
+    {
+        out_thread = std::thread(&Bench::publish_out_routine_, this);
+    }
+
+    std::this_thread::sleep_for(std::chrono::seconds(config_.duration));
+    stop_.store(true);
+    if (in_thread.joinable())
+    {
+        in_thread.join();
+    }
+    if (out_thread.joinable())
+    {
+        out_thread.join();
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // Give the samples in flight a chance to arrive
+    wait_for_([this]()
+            {
+                return in_stats_.received.load() >= in_stats_.sent.load() &&
+                out_stats_.received.load() >= out_stats_.sent.load();
+            }, std::chrono::steady_clock::now() + DRAIN_TIMEOUT);
+
+    const double cpu_seconds = static_cast<double>(std::clock() - cpu_start) / CLOCKS_PER_SEC;
+
+    const DirectionResults in_results = summarize(in_stats_, seconds, config_.payload_size);
+    const DirectionResults out_results = summarize(out_stats_, seconds, config_.payload_size);
+    const uint64_t received = in_results.received + out_results.received;
+    const double cpu_per_sample_us = received > 0 ? cpu_seconds * 1e6 / received : 0;
+
+    // Samples lost inside the enabler (e.g. failed conversions or full queues)
+    uint64_t enabler_dropped = 0;
+    for (const auto& entity : enabler_->get_metrics().entities)
+    {
+        enabler_dropped += entity.dropped;
+    }
+
+    std::cout << std::endl << "Topics: " << config_.topics << ", payload: " << config_.payload_size <<
+        " bytes, rate: " << (config_.rate > 0 ? std::to_string(config_.rate) : "max") << " samples/s per topic, " <<
+        "transport: " << (config_.transport == CLIParser::Transport::SHM ? "shm" : "udp") << std::endl << std::endl;
+    std::cout << "dir         sent    received   dropped     samples/s      MB/s   p50 [us]   p99 [us]  p999 [us]" <<
+        "   max [us]" << std::endl;
+    if (drives_in_())
+    {
+        print_results("in", in_results);
+    }
+    if (drives_out_())
+    {
+        print_results("out", out_results);
+    }
+    std::cout << std::endl << "CPU per sample: " << std::setprecision(2) << cpu_per_sample_us << " us (" <<
+        cpu_seconds << " s of process CPU time)" << std::endl;
+    std::cout << "Samples dropped by the enabler: " << enabler_dropped << std::endl;
+
+    if (!config_.output_path.empty())
+    {
+        nlohmann::json json;
+        json["config"] = {
+            {"topics", config_.topics},
+            {"payload_size", config_.payload_size},
+            {"rate", config_.rate},
+            {"duration", config_.duration},
+            {"transport", config_.transport == CLIParser::Transport::SHM ? "shm" : "udp"}
+        };
+        if (drives_in_())
+        {
+            json["in"] = to_json(in_results);
+        }
+        if (drives_out_())
+        {
+            json["out"] = to_json(out_results);
+        }
+        json["cpu_seconds"] = cpu_seconds;
+        json["cpu_per_sample_us"] = cpu_per_sample_us;
+        json["enabler_dropped"] = enabler_dropped;
+
+        std::ofstream file(config_.output_path);
+        if (!file)
+        {
+            std::cerr << "Failed to open output file: " << config_.output_path << std::endl;
+            return false;
+        }
+        file << json.dump(4) << std::endl;
+    }
+    return true;
+}
+
+} // namespace
+
+int main(
+        int argc,
+        char** argv)
+{
+    Log::SetVerbosity(Log::Kind::Error);
+
+    const CLIParser::bench_config config = CLIParser::parse_cli_options(argc, argv);
+
+    int ret_code = EXIT_FAILURE;
+    {
+        Bench bench(config);
+        if (bench.init() && bench.run())
+        {
+            ret_code = EXIT_SUCCESS;
+        }
+    }
+
+    Log::Flush();
+    return ret_code;
+}
@@ -0,0 +1,601 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file DdsEnablerBenchmarks.cpp
+ *
+ * Micro-benchmarks of the conversion and RPC hot paths of the enabler.
+ */
+
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <fastdds/dds/domain/DomainParticipantFactory.hpp>
+#include <fastdds/dds/log/Log.hpp>
+#include <fastdds/dds/topic/TopicDataType.hpp>
+#include <fastdds/dds/xtypes/dynamic_types/DynamicDataFactory.hpp>
+#include <fastdds/dds/xtypes/dynamic_types/DynamicTypeBuilder.hpp>
+#include <fastdds/dds/xtypes/dynamic_types/DynamicTypeBuilderFactory.hpp>
+#include <fastdds/dds/xtypes/dynamic_types/MemberDescriptor.hpp>
+#include <fastdds/dds/xtypes/dynamic_types/TypeDescriptor.hpp>
+#include <fastdds/dds/xtypes/utils.hpp>
+
+#include <ddspipe_core/efficiency/payload/FastPayloadPool.hpp>
+
+#include <ddsenabler_participants/Handler.hpp>
+#include <ddsenabler_participants/HandlerConfiguration.hpp>
+#include <ddsenabler_participants/Message.hpp>
+#include <ddsenabler_participants/Serialization.hpp>
+#include <ddsenabler_participants/Writer.hpp>
+#include <ddsenabler_participants/rpc/RpcStructs.hpp>
+#include <ddsenabler_participants/rpc/RpcUtils.hpp>
+
+#include "DdsEnablerTypedTestTypeHeaders.hpp"
+
+using namespace eprosima;
+using namespace eprosima::fastdds::dds;
+using namespace eprosima::ddsenabler;
+
+namespace {
+
+class BenchmarkWriter : public participants::Writer
+{
+public:
+
+    // Expose protected methods
+    using Writer::prepare_json_data_;
+};
+
+/**
+ * Type of the dds-types-test suite, along with the CDR and JSON encodings of a default sample.
+ */
+struct BenchmarkType
+{
+    bool valid {false};
+    xtypes::TypeIdentifier type_identifier;
+    DynamicType::_ref_type dynamic_type;
+    ddspipe::core::types::DdsTopic topic;
+    std::vector<uint8_t> cdr;
+    std::string json;
+};
+
+BenchmarkType make_benchmark_type(
+        std::shared_ptr<TopicDataType> type_support)
+{
+    BenchmarkType type;
+
+    type_support->register_type_object_representation();
+    auto type_id_pair = type_support->type_identifiers();
+    type.type_identifier =
+            (xtypes::EK_COMPLETE == type_id_pair.type_identifier1()._d()) ?
+            type_id_pair.type_identifier1() : type_id_pair.type_identifier2();
+
+    xtypes::TypeObject type_object;
+    if (RETCODE_OK != DomainParticipantFactory::get_instance()->type_object_registry().get_type_object(
+                type.type_identifier, type_object))
+    {
+        return type;
+    }
+    type.dynamic_type = DynamicTypeBuilderFactory::get_instance()->create_type_w_type_object(type_object)->build();
+
+    type.topic.m_topic_name = std::string("benchmark_") + type_support->get_name();
+    type.topic.type_name = type_support->get_name();
+    type.topic.type_identifiers = type_id_pair;
+
+    // CDR encoding of a default sample
+    void* data = type_support->create_data();
+    fastdds::rtps::SerializedPayload_t payload(
+        type_support->calculate_serialized_size(data, DataRepresentationId::XCDR2_DATA_REPRESENTATION));
+    const bool serialized = type_support->serialize(data, payload, DataRepresentationId::XCDR2_DATA_REPRESENTATION);
+    type_support->delete_data(data);
+    if (!serialized)
+    {
+        return type;
+    }
+    type.cdr.assign(payload.data, payload.data + payload.length);
+
+    // JSON encoding of the same sample, as received from the user's app
+    std::stringstream json;
+    if (RETCODE_OK != json_serialize(DynamicDataFactory::get_instance()->create_data(type.dynamic_type),
+            DynamicDataJsonFormat::EPROSIMA, json))
+    {
+        return type;
+    }
+    type.json = json.str();
+
+    type.valid = true;
+    return type;
+}
+
+//! Get the benchmarked type of a dds-types-test PubSubType, built on first use
+template <typename PubSubType>
+const BenchmarkType& benchmark_type()
+{
+    static const BenchmarkType type = make_benchmark_type(std::make_shared<PubSubType>());
+    return type;
+}
+
+////////////////////
+// JSON CONVERSION
+
+template <typename PubSubType>
+void BM_prepare_json_data(
+        benchmark::State& state)
+{
+    const BenchmarkType& type = benchmark_type<PubSubType>();
+    if (!type.valid)
+    {
+        state.SkipWithError("Failed to build the benchmarked type.");
+        return;
+    }
+
+    auto payload_pool = std::make_shared<ddspipe::core::FastPayloadPool>();
+    participants::Message msg;
+    msg.topic = type.topic;
+    msg.payload_owner = payload_pool.get();
+    payload_pool->get_payload(static_cast<uint32_t>(type.cdr.size()), msg.payload);
+    std::memcpy(msg.payload.data, type.cdr.data(), type.cdr.size());
+    msg.payload.length = static_cast<uint32_t>(type.cdr.size());
+
+    BenchmarkWriter writer;
+    for (auto _ : state)
+    {
+        nlohmann::json json_output;
+        if (!writer.prepare_json_data_(msg, type.dynamic_type, json_output))
+        {
+            state.SkipWithError("Failed to convert the sample into JSON.");
+            return;
+        }
+        benchmark::DoNotOptimize(json_output);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * type.cdr.size()));
+}
+
+template <typename PubSubType>
+void BM_get_serialized_data(
+        benchmark::State& state)
+{
+    const BenchmarkType& type = benchmark_type<PubSubType>();
+    if (!type.valid)
+    {
+        state.SkipWithError("Failed to build the benchmarked type.");
+        return;
+    }
+
+    auto payload_pool = std::make_shared<ddspipe::core::FastPayloadPool>();
+    participants::Handler handler(participants::HandlerConfiguration(), payload_pool);
+    handler.add_schema(type.dynamic_type, type.type_identifier);
+
+    for (auto _ : state)
+    {
+        ddspipe::core::types::Payload payload;
+        if (!handler.get_serialized_data(type.topic.type_name, type.json, payload))
+        {
+            state.SkipWithError("Failed to serialize the JSON sample.");
+            return;
+        }
+        benchmark::DoNotOptimize(payload.data);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * type.json.size()));
+}
+
+// Types of dds-types-test covering every kind of member and extensibility
+#define DDSENABLER_BENCHMARK_TYPE(Type) \
+    BENCHMARK_TEMPLATE(BM_prepare_json_data, Type ## PubSubType)->Name("prepare_json_data/" #Type); \
+    BENCHMARK_TEMPLATE(BM_get_serialized_data, Type ## PubSubType)->Name("get_serialized_data/" #Type)
+
+DDSENABLER_BENCHMARK_TYPE(LongStruct);
+DDSENABLER_BENCHMARK_TYPE(StringStruct);
+DDSENABLER_BENCHMARK_TYPE(EnumStructure);
+DDSENABLER_BENCHMARK_TYPE(ArrayLong);
+DDSENABLER_BENCHMARK_TYPE(ArrayMultiDimensionDouble);
+DDSENABLER_BENCHMARK_TYPE(BoundedBigArrays);
+DDSENABLER_BENCHMARK_TYPE(SequenceLong);
+DDSENABLER_BENCHMARK_TYPE(SequenceStructure);
+DDSENABLER_BENCHMARK_TYPE(MapStringLong);
+DDSENABLER_BENCHMARK_TYPE(UnionLong);
+DDSENABLER_BENCHMARK_TYPE(StructStructure);
+DDSENABLER_BENCHMARK_TYPE(Structures);
+DDSENABLER_BENCHMARK_TYPE(InnerStructureHelperChildChild);
+DDSENABLER_BENCHMARK_TYPE(AppendableLongStruct);
+DDSENABLER_BENCHMARK_TYPE(FinalLongStruct);
+DDSENABLER_BENCHMARK_TYPE(MutableLongStruct);
+DDSENABLER_BENCHMARK_TYPE(KeyedLongStruct);
+
+#undef DDSENABLER_BENCHMARK_TYPE
+
+////////////////////
+// TYPE AND QOS SERIALIZATION
+
+void BM_serialize_dynamic_type(
+        benchmark::State& state)
+{
+    const BenchmarkType& type = benchmark_type<StructuresPubSubType>();
+    if (!type.valid)
+    {
+        state.SkipWithError("Failed to build the benchmarked type.");
+        return;
+    }
+
+    for (auto _ : state)
+    {
+        participants::DynamicTypesCollection dynamic_types;
+        if (!participants::serialization::serialize_dynamic_type(type.topic.type_name, type.type_identifier,
+                dynamic_types))
+        {
+            state.SkipWithError("Failed to serialize the type.");
+            return;
+        }
+        benchmark::DoNotOptimize(dynamic_types);
+    }
+}
+BENCHMARK(BM_serialize_dynamic_type)->Name("serialize_dynamic_type/Structures");
+
+void BM_serialize_dynamic_type_cached(
+        benchmark::State& state)
+{
+    const BenchmarkType& type = benchmark_type<StructuresPubSubType>();
+    if (!type.valid)
+    {
+        state.SkipWithError("Failed to build the benchmarked type.");
+        return;
+    }
+
+    participants::serialization::DynamicTypesCache cache;
+    for (auto _ : state)
+    {
+        participants::DynamicTypesCollection dynamic_types;
+        if (!participants::serialization::serialize_dynamic_type(type.topic.type_name, type.type_identifier,
+                dynamic_types, cache, false))
+        {
+            state.SkipWithError("Failed to serialize the type.");
+            return;
+        }
+        benchmark::DoNotOptimize(dynamic_types);
+    }
+}
+BENCHMARK(BM_serialize_dynamic_type_cached)->Name("serialize_dynamic_type_cached/Structures");
+
+ddspipe::core::types::TopicQoS benchmark_qos()
+{
+    ddspipe::core::types::TopicQoS qos{};
+    qos.reliability_qos = ddspipe::core::types::ReliabilityKind::RELIABLE;
+    qos.durability_qos = ddspipe::core::types::DurabilityKind::TRANSIENT_LOCAL;
+    qos.keyed = true;
+    return qos;
+}
+
+void BM_serialize_qos(
+        benchmark::State& state)
+{
+    const auto qos = benchmark_qos();
+    const bool compact = state.range(0) != 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(participants::serialization::serialize_qos(qos, compact));
+    }
+}
+BENCHMARK(BM_serialize_qos)->ArgName("compact")->Arg(0)->Arg(1);
+
+void BM_deserialize_qos(
+        benchmark::State& state)
+{
+    const std::string qos_str = participants::serialization::serialize_qos(benchmark_qos(), state.range(0) != 0);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(participants::serialization::deserialize_qos(qos_str));
+    }
+}
+BENCHMARK(BM_deserialize_qos)->ArgName("compact")->Arg(0)->Arg(1);
+
+void BM_deserialize_qos_yaml_parsing(
+        benchmark::State& state)
+{
+    // Flow style YAML does not match any precomputed encoding, so it is always parsed
+    const std::string qos_str = "{reliability: true, durability: true, ownership: false, keyed: true}";
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(participants::serialization::deserialize_qos(qos_str));
+    }
+}
+BENCHMARK(BM_deserialize_qos_yaml_parsing);
+
+////////////////////
+// TYPE PRELOADING
+
+//! Number of type collections preloaded
+constexpr std::size_t PRELOAD_N_TYPES = 200;
+
+//! Directory with the preloaded type collections
+std::filesystem::path preload_types_path()
+{
+    return std::filesystem::temp_directory_path() / "ddsenabler_benchmarks_preload_types";
+}
+
+/**
+ * Write the collections of \c PRELOAD_N_TYPES types sharing a dependency, as notified to the user's app.
+ *
+ * @return \c true if every collection was written, \c false otherwise.
+ */
+bool write_preload_types()
+{
+    const std::filesystem::path directory = preload_types_path();
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+
+    auto factory = DynamicTypeBuilderFactory::get_instance();
+    auto& registry = DomainParticipantFactory::get_instance()->type_object_registry();
+
+    TypeDescriptor::_ref_type base_descriptor {traits<TypeDescriptor>::make_shared()};
+    base_descriptor->kind(TK_STRUCTURE);
+    base_descriptor->name("PreloadTypesBase");
+    DynamicTypeBuilder::_ref_type base_builder {factory->create_type(base_descriptor)};
+    MemberDescriptor::_ref_type base_member {traits<MemberDescriptor>::make_shared()};
+    base_member->name("stamp");
+    base_member->type(factory->get_primitive_type(TK_INT64));
+    if (RETCODE_OK != base_builder->add_member(base_member))
+    {
+        return false;
+    }
+    DynamicType::_ref_type base_type = base_builder->build();
+
+    for (std::size_t i = 0; i < PRELOAD_N_TYPES; ++i)
+    {
+        const std::string type_name = "PreloadTypes_" + std::to_string(i);
+
+        TypeDescriptor::_ref_type descriptor {traits<TypeDescriptor>::make_shared()};
+        descriptor->kind(TK_STRUCTURE);
+        descriptor->name(type_name);
+        DynamicTypeBuilder::_ref_type builder {factory->create_type(descriptor)};
+        MemberDescriptor::_ref_type member {traits<MemberDescriptor>::make_shared()};
+        member->name("base");
+        member->type(base_type);
+        if (RETCODE_OK != builder->add_member(member))
+        {
+            return false;
+        }
+        member = traits<MemberDescriptor>::make_shared();
+        member->name("value");
+        member->type(factory->get_primitive_type(TK_INT32));
+        if (RETCODE_OK != builder->add_member(member))
+        {
+            return false;
+        }
+
+        xtypes::TypeIdentifierPair type_ids;
+        if (RETCODE_OK != registry.register_typeobject_w_dynamic_type(builder->build(), type_ids))
+        {
+            return false;
+        }
+        const xtypes::TypeIdentifier& type_id =
+                (xtypes::EK_COMPLETE == type_ids.type_identifier1()._d()) ?
+                type_ids.type_identifier1() : type_ids.type_identifier2();
+
+        participants::DynamicTypesCollection dynamic_types;
+        if (!participants::serialization::serialize_dynamic_type(type_name, type_id, dynamic_types))
+        {
+            return false;
+        }
+        auto payload = participants::serialization::serialize_dynamic_types(dynamic_types);
+        if (nullptr == payload)
+        {
+            return false;
+        }
+
+        std::ofstream file(directory / (type_name + ".bin"), std::ios::binary);
+        if (!file.write(reinterpret_cast<const char*>(payload->data), payload->length))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void BM_preload_types(
+        benchmark::State& state)
+{
+    static const bool written = write_preload_types();
+    if (!written)
+    {
+        state.SkipWithError("Failed to write the type collections.");
+        return;
+    }
+
+    auto payload_pool = std::make_shared<ddspipe::core::FastPayloadPool>();
+    const unsigned int n_threads = static_cast<unsigned int>(state.range(0));
+    for (auto _ : state)
+    {
+        // Preloaded types are kept by the handler, so each iteration preloads them into a new one
+        state.PauseTiming();
+        auto handler = std::make_unique<participants::Handler>(participants::HandlerConfiguration(), payload_pool);
+        state.ResumeTiming();
+
+        if (handler->preload_types(preload_types_path().string(), n_threads) != PRELOAD_N_TYPES)
+        {
+            state.SkipWithError("Failed to preload the type collections.");
+            return;
+        }
+
+        state.PauseTiming();
+        handler.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * PRELOAD_N_TYPES));
+}
+// Sequentially and with as many threads as the hardware supports
+BENCHMARK(BM_preload_types)->ArgName("threads")->Arg(1)->Arg(0)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+////////////////////
+// RPC
+
+void BM_rpc_info(
+        benchmark::State& state,
+        const std::string& topic_name)
+{
+    for (auto _ : state)
+    {
+        participants::RpcInfo rpc_info(topic_name);
+        benchmark::DoNotOptimize(rpc_info);
+    }
+}
+BENCHMARK_CAPTURE(BM_rpc_info, topic, std::string("rt/chatter"));
+BENCHMARK_CAPTURE(BM_rpc_info, service_request, std::string("rq/add_two_intsRequest"));
+BENCHMARK_CAPTURE(BM_rpc_info, action_goal_request, std::string("rq/fibonacci/_action/send_goalRequest"));
+BENCHMARK_CAPTURE(BM_rpc_info, action_feedback, std::string("rt/fibonacci/_action/feedback"));
+BENCHMARK_CAPTURE(BM_rpc_info, dds_service_reply, std::string("add_two_ints_Reply"));
+
+// Payload of the goals, feedbacks and results
+constexpr const char* RPC_JSON = "{\"order\": 10, \"sequence\": [0, 1, 1, 2, 3, 5, 8, 13, 21, 34]}";
+
+void BM_create_goal_request_msg(
+        benchmark::State& state)
+{
+    const std::string goal_json = RPC_JSON;
+    participants::UUID goal_id = participants::RpcUtils::generate_UUID();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(participants::RpcUtils::create_goal_request_msg(goal_json, goal_id));
+    }
+}
+BENCHMARK(BM_create_goal_request_msg);
+
+void BM_create_goal_reply_msg(
+        benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(participants::RpcUtils::create_goal_reply_msg(true));
+    }
+}
+BENCHMARK(BM_create_goal_reply_msg);
+
+void BM_create_cancel_request_msg(
+        benchmark::State& state)
+{
+    const participants::UUID goal_id = participants::RpcUtils::generate_UUID();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(participants::RpcUtils::create_cancel_request_msg(goal_id, 0));
+    }
+}
+BENCHMARK(BM_create_cancel_request_msg);
+
+void BM_create_cancel_reply_msg(
+        benchmark::State& state)
+{
+    std::vector<std::pair<participants::UUID, std::chrono::system_clock::time_point>> cancelling_goals;
+    for (int64_t i = 0; i < state.range(0); ++i)
+    {
+        cancelling_goals.emplace_back(participants::RpcUtils::generate_UUID(), std::chrono::system_clock::now());
+    }
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(participants::RpcUtils::create_cancel_reply_msg(cancelling_goals,
+                participants::CancelCode::NONE));
+    }
+}
+BENCHMARK(BM_create_cancel_reply_msg)->ArgName("goals")->Arg(1)->Arg(16);
+
+void BM_create_result_request_msg(
+        benchmark::State& state)
+{
+    const participants::UUID goal_id = participants::RpcUtils::generate_UUID();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(participants::RpcUtils::create_result_request_msg(goal_id));
+    }
+}
+BENCHMARK(BM_create_result_request_msg);
+
+void BM_create_result_reply_msg(
+        benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(participants::RpcUtils::create_result_reply_msg(participants::StatusCode::SUCCEEDED,
+                RPC_JSON));
+    }
+}
+BENCHMARK(BM_create_result_reply_msg);
+
+void BM_create_feedback_msg(
+        benchmark::State& state)
+{
+    const participants::UUID goal_id = participants::RpcUtils::generate_UUID();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(participants::RpcUtils::create_feedback_msg(RPC_JSON, goal_id));
+    }
+}
+BENCHMARK(BM_create_feedback_msg);
+
+void BM_create_status_msg(
+        benchmark::State& state)
+{
+    const participants::UUID goal_id = participants::RpcUtils::generate_UUID();
+    const auto accepted_stamp = std::chrono::system_clock::now();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(participants::RpcUtils::create_status_msg(goal_id,
+                participants::StatusCode::EXECUTING, accepted_stamp));
+    }
+}
+BENCHMARK(BM_create_status_msg);
+
+} // namespace
+
+int main(
+        int argc,
+        char** argv)
+{
+    Log::SetVerbosity(Log::Kind::Error);
+
+    // Results are written in JSON too, unless an output file is given explicitly
+    std::vector<char*> args(argv, argv + argc);
+    bool has_output = false;
+    for (int i = 1; i < argc; ++i)
+    {
+        has_output |= std::string(argv[i]).rfind("--benchmark_out=", 0) == 0;
+    }
+    std::string default_out = "--benchmark_out=ddsenabler_benchmarks.json";
+    std::string default_out_format = "--benchmark_out_format=json";
+    if (!has_output)
+    {
+        args.push_back(&default_out[0]);
+        args.push_back(&default_out_format[0]);
+    }
+    int args_count = static_cast<int>(args.size());
+
+    benchmark::Initialize(&args_count, args.data());
+    if (benchmark::ReportUnrecognizedArguments(args_count, args.data()))
+    {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    std::filesystem::remove_all(preload_types_path());
+
+    Log::Flush();
+    return 0;
+}
@@ -97,6 +97,14 @@ struct CallbackSet
     ServiceCallbacks service;
     //! Action related callbacks
     ActionCallbacks action;
+
+    // NOTE: optional callbacks are kept last so existing aggregate initializations remain valid
+
+    //! Callback for batched notification of discovered entities (only used if a discovery batch window is configured)
+    participants::DiscoveryBatchNotification discovery_batch_notification{nullptr};
+
+    //! Callback for notifying the callbacks exceeding their time budget (only used if a callback budget is configured)
+    participants::SlowCallbackNotification slow_callback_notification{nullptr};
 };
 
 } /* namespace ddsenabler */
@@ -18,11 +18,18 @@
 
 #pragma once
 
+#include <functional>
+#include <map>
 #include <memory>
+#include <set>
+#include <string>
+#include <vector>
 
 #include <fastdds/dds/domain/DomainParticipantFactory.hpp>
+#include <fastdds/dds/topic/TopicDataType.hpp>
 
 #include <cpp_utils/event/FileWatcherHandler.hpp>
+#include <cpp_utils/event/PeriodicEventHandler.hpp>
 #include <cpp_utils/ReturnCode.hpp>
 #include <cpp_utils/thread_pool/pool/SlotThreadPool.hpp>
 
@@ -36,8 +43,13 @@
 #include <ddsenabler_participants/Callbacks.hpp>
 #include <ddsenabler_participants/Handler.hpp>
 #include <ddsenabler_participants/HandlerConfiguration.hpp>
+#include <ddsenabler_participants/LockMetrics.hpp>
 #include <ddsenabler_participants/DdsParticipant.hpp>
 #include <ddsenabler_participants/EnablerParticipant.hpp>
+#include <ddsenabler_participants/MeteredPayloadPool.hpp>
+#include <ddsenabler_participants/MetricsExporter.hpp>
+#include <ddsenabler_participants/MetricsRegistry.hpp>
+#include <ddsenabler_participants/ThreadPlacement.hpp>
 #include <ddsenabler_participants/rpc/RpcTypes.hpp>
 
 #include <ddsenabler_yaml/EnablerConfiguration.hpp>
@@ -68,6 +80,14 @@ public:
             const yaml::EnablerConfiguration& configuration,
             const CallbackSet& callbacks);
 
+    /**
+     * DDSEnabler destructor.
+     *
+     * Writes a last discovery snapshot if configured.
+     */
+    DDSENABLER_DllAPI
+    ~DDSEnabler();
+
     /**
      * Associate the file watcher to the configuration file and establish the callback to reload the configuration.
      *
@@ -105,6 +125,232 @@ public:
             const std::string& topic_name,
             const std::string& json);
 
+    /**
+     * Publish CDR serialized data to the specified topic, avoiding the JSON conversion of \c publish.
+     *
+     * The encapsulation header is validated against the type registered for the topic. If the data is not encoded
+     * with \c representation, it is re-encoded before being published.
+     *
+     * @param topic_name: The name of the topic to publish to.
+     * @param cdr: The serialized data, including the encapsulation header.
+     * @param size: The size of the serialized data in bytes.
+     * @param representation: The data representation to publish with (XCDR1 by default, as \c publish does).
+     *
+     * @return \c true if the data was published successfully, \c false otherwise.
+     */
+    DDSENABLER_DllAPI
+    bool publish_cdr(
+            const std::string& topic_name,
+            const uint8_t* cdr,
+            const uint32_t size,
+            fastdds::dds::DataRepresentationId_t representation =
+            fastdds::dds::DataRepresentationId::XCDR_DATA_REPRESENTATION);
+
+    /**
+     * Loan a payload to be filled in place with CDR serialized data and published with \c publish_loaned.
+     *
+     * The payload is taken from the enabler payload pool, so publishing it does not require any extra copy.
+     * Its \c length is set to \c size, and may be reduced before publishing if fewer bytes are written.
+     *
+     * @param topic_name: The name of the topic the payload will be published to.
+     * @param size: The number of bytes to reserve, including the encapsulation header.
+     * @param loan: The loaned payload.
+     *
+     * @return \c true if the payload was loaned successfully, \c false otherwise.
+     */
+    DDSENABLER_DllAPI
+    bool loan_payload(
+            const std::string& topic_name,
+            const uint32_t size,
+            ddspipe::core::types::Payload& loan);
+
+    /**
+     * Publish a payload previously loaned with \c loan_payload to the specified topic.
+     *
+     * On success the loan is consumed and must not be accessed anymore.
+     *
+     * @param topic_name: The name of the topic to publish to.
+     * @param loan: The loaned payload holding the CDR serialized sample.
+     *
+     * @return \c true if the payload was published successfully, \c false otherwise.
+     */
+    DDSENABLER_DllAPI
+    bool publish_loaned(
+            const std::string& topic_name,
+            ddspipe::core::types::Payload& loan);
+
+    /*****************************************/
+    /*              TYPED API                */
+    /*****************************************/
+
+    /**
+     * Publish a sample of a compiled type (e.g. generated with Fast DDS-Gen) to the specified topic.
+     *
+     * The sample is serialized by its type support straight into a loaned payload, skipping both the JSON and the
+     * DynamicData conversions. If the topic is unknown it is created with the compiled type and default QoS.
+     *
+     * @tparam PubSubType: The type support of the sample type (\c PubSubType::type being the sample type).
+     * @param topic_name: The name of the topic to publish to.
+     * @param sample: The sample to publish.
+     *
+     * @return \c true if the sample was published successfully, \c false otherwise.
+     */
+    template<typename PubSubType>
+    bool publish(
+            const std::string& topic_name,
+            const typename PubSubType::type& sample);
+
+    /**
+     * Subscribe to a topic with a compiled type (e.g. generated with Fast DDS-Gen).
+     *
+     * Samples received in the topic are deserialized by the type support and delivered to \c callback instead of
+     * the JSON data notification callback. Topic discovery and allowlist filtering are not affected.
+     *
+     * @tparam PubSubType: The type support of the sample type (\c PubSubType::type being the sample type).
+     * @param topic_name: The name of the topic to subscribe to.
+     * @param callback: The callback receiving each sample and its publication time (ns).
+     *
+     * @return \c true if the subscription was created successfully, \c false otherwise.
+     */
+    template<typename PubSubType>
+    bool subscribe(
+            const std::string& topic_name,
+            std::function<void(const typename PubSubType::type&, int64_t)> callback);
+
+    /**
+     * Remove the typed subscription of a topic, restoring its JSON data notifications.
+     *
+     * @param topic_name: The name of the topic to unsubscribe from.
+     *
+     * @return \c true if the subscription was removed, \c false if it did not exist.
+     */
+    DDSENABLER_DllAPI
+    bool unsubscribe(
+            const std::string& topic_name);
+
+    /*****************************************/
+    /*                TYPES                  */
+    /*****************************************/
+
+    /**
+     * Preload the type collections stored in a directory, one \c .bin file per type containing the serialized
+     * collection provided by the type notification callback. Decoding is parallelized across cores.
+     *
+     * @param directory: The directory containing the type collections.
+     *
+     * @return The number of types preloaded.
+     */
+    DDSENABLER_DllAPI
+    std::size_t preload_types(
+            const std::string& directory);
+
+    /**
+     * Load a type bundle generated by \c ddsenabler_type_bundler, so schema lookups for the bundled types (and their
+     * IDL and placeholder) are served from cache.
+     *
+     * @param path: The path of the type bundle.
+     *
+     * @return The number of types loaded.
+     */
+    DDSENABLER_DllAPI
+    std::size_t load_type_bundle(
+            const std::string& path);
+
+    /**
+     * Get the occupancy of the schema cache: known and materialized types, types pinned by live topics, estimated
+     * memory usage and number of evictions.
+     *
+     * @return The schema cache statistics.
+     */
+    DDSENABLER_DllAPI
+    participants::SchemaCacheStats get_schema_cache_stats();
+
+    /**
+     * Get the state of the configured priority classes: queued, delivered and dropped samples, and delivery latency.
+     *
+     * @return The priority classes statistics, from highest to lowest priority (empty if none is configured).
+     */
+    DDSENABLER_DllAPI
+    std::vector<participants::PriorityClassStats> get_priority_class_stats() const;
+
+    /**
+     * Get the metrics of every topic, service and action: samples received, converted, delivered, filtered, dropped
+     * and published, bytes in and out, conversion and callback times, and end-to-end latency (from the source
+     * timestamp of the samples to the delivery of their notifications), along with the state of the priority
+     * classes, the pending notifications and the payload pool.
+     *
+     * @return A snapshot of the metrics, sorted by entity kind and name.
+     */
+    DDSENABLER_DllAPI
+    participants::MetricsReport get_metrics() const;
+
+    /**
+     * Write a snapshot of the discovery state: known topics, services and actions announced by the enabler, and the
+     * known types (stored in a type bundle next to the snapshot, with suffix \c DISCOVERY_SNAPSHOT_TYPES_SUFFIX).
+     *
+     * @param path: The path of the snapshot file.
+     *
+     * @return \c true if the snapshot was written, \c false otherwise.
+     */
+    DDSENABLER_DllAPI
+    bool save_discovery_snapshot(
+            const std::string& path);
+
+    /**
+     * Restore a discovery snapshot written by \c save_discovery_snapshot: load its types, create the writers of its
+     * topics and announce its services and actions, without querying the user's app.
+     *
+     * Restored entities are then reconciled with live discovery as usual: entities discovered again are notified,
+     * and restored services and actions are adopted by the first explicit announcement.
+     *
+     * @param path: The path of the snapshot file.
+     *
+     * @return \c true if every entity in the snapshot was restored, \c false otherwise.
+     */
+    DDSENABLER_DllAPI
+    bool restore_discovery_snapshot(
+            const std::string& path);
+
+    /**
+     * Get the IDL representation of a type. Generated on first request and cached afterwards.
+     *
+     * @param type_name: The name of the type.
+     * @param idl: The IDL representation of the type.
+     *
+     * @return \c true if the IDL was retrieved, \c false otherwise.
+     */
+    DDSENABLER_DllAPI
+    bool get_type_idl(
+            const std::string& type_name,
+            std::string& idl);
+
+    /**
+     * Get the serialized collection of a type and its dependencies, in the format expected by the type query
+     * callback. Generated on first request and cached afterwards.
+     *
+     * @param type_name: The name of the type.
+     * @param collection: The serialized type collection.
+     *
+     * @return \c true if the collection was retrieved, \c false otherwise.
+     */
+    DDSENABLER_DllAPI
+    bool get_type_collection(
+            const std::string& type_name,
+            std::vector<unsigned char>& collection);
+
+    /**
+     * Get the JSON data placeholder of a type. Generated on first request and cached afterwards.
+     *
+     * @param type_name: The name of the type.
+     * @param placeholder: The JSON data placeholder of the type.
+     *
+     * @return \c true if the placeholder was retrieved, \c false otherwise.
+     */
+    DDSENABLER_DllAPI
+    bool get_type_placeholder(
+            const std::string& type_name,
+            std::string& placeholder);
+
     /*****************************************/
     /*               SERVICE                 */
     /*****************************************/
@@ -422,6 +668,52 @@ protected:
             const std::string& reply_json,
             const uint64_t request_id);
 
+    /**
+     * Register the type object of a compiled type and declare the topic with it (only the first time).
+     *
+     * @param topic_name: The name of the topic to declare.
+     * @param type_support: The type support of the compiled type.
+     *
+     * @return \c true if the topic is ready to publish in, \c false otherwise.
+     */
+    DDSENABLER_DllAPI
+    bool declare_typed_topic_(
+            const std::string& topic_name,
+            fastdds::dds::TopicDataType& type_support);
+
+    /**
+     * Register the type object of a compiled type and add a typed subscription to the topic.
+     *
+     * @param topic_name: The name of the topic to subscribe to.
+     * @param type_support: The type support of the compiled type.
+     * @param callback: The type-erased callback deserializing and delivering the samples.
+     *
+     * @return \c true if the subscription was created successfully, \c false otherwise.
+     */
+    DDSENABLER_DllAPI
+    bool subscribe_typed_(
+            const std::string& topic_name,
+            fastdds::dds::TopicDataType& type_support,
+            participants::TypedDataCallback callback);
+
+    /**
+     * Create the topics and announce the services and actions listed in the warm-up configuration.
+     *
+     * Entities are created in parallel, with at most \c warm_up_max_concurrency of them at once.
+     * Failures are logged and do not prevent the enabler from starting.
+     */
+    void warm_up_();
+
+    /**
+     * Create the topics and announce the services and actions recorded in a discovery snapshot.
+     *
+     * @param path: The path of the snapshot file.
+     *
+     * @return \c true if every entity in the snapshot was restored, \c false otherwise.
+     */
+    bool restore_discovery_entities_(
+            const std::string& path);
+
     /**
      * Load the Enabler's internal topics into a configuration object.
      *
@@ -445,8 +737,11 @@ protected:
     //! Configuration of the DDS Enabler
     yaml::EnablerConfiguration configuration_;
 
+    //! Placement of the enabler threads, resolved against the NUMA topology
+    participants::ThreadPlacementConfiguration thread_placement_;
+
     //! Payload Pool
-    std::shared_ptr<ddspipe::core::PayloadPool> payload_pool_;
+    std::shared_ptr<eprosima::ddsenabler::participants::MeteredPayloadPool> payload_pool_;
 
     //! Discovery Database
     std::shared_ptr<ddspipe::core::DiscoveryDatabase> discovery_database_;
@@ -472,9 +767,26 @@ protected:
     //! Config File watcher handler
     std::unique_ptr<eprosima::utils::event::FileWatcherHandler> file_watcher_handler_;
 
-    //! Mutex to protect class attributes
-    mutable std::mutex mutex_;
+    //! Periodic discovery snapshot writer (if enabled)
+    std::unique_ptr<eprosima::utils::event::PeriodicEventHandler> snapshot_handler_;
+
+    //! Metrics exporter (if enabled)
+    std::unique_ptr<eprosima::ddsenabler::participants::MetricsExporter> metrics_exporter_;
+
+    //! Services announced during warm-up and not yet explicitly announced by the user
+    std::set<std::string> warmed_up_services_;
+
+    //! Actions announced during warm-up and not yet explicitly announced by the user
+    std::set<std::string> warmed_up_actions_;
+
+    //! Type names of the topics declared through the typed API
+    std::map<std::string, std::string> typed_topics_;
+
+    //! Mutex to protect class attributes (metered when built with lock metrics)
+    mutable participants::MeteredMutex<std::mutex> mutex_ {"dds_enabler"};
 };
 
 } /* namespace ddsenabler */
 } /* namespace eprosima */
+
+#include <ddsenabler/impl/DDSEnabler.ipp>
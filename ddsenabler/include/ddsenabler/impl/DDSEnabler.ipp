@@ -0,0 +1,81 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file DDSEnabler.ipp
+ */
+
+#pragma once
+
+#include <fastdds/dds/log/Log.hpp>
+
+namespace eprosima {
+namespace ddsenabler {
+
+template<typename PubSubType>
+bool DDSEnabler::publish(
+        const std::string& topic_name,
+        const typename PubSubType::type& sample)
+{
+    PubSubType type_support;
+    if (!declare_typed_topic_(topic_name, type_support))
+    {
+        return false;
+    }
+
+    // Use XCDR1 as the JSON publication does, for backwards compatibility
+    uint32_t size = type_support.calculate_serialized_size(&sample,
+                    fastdds::dds::DataRepresentationId::XCDR_DATA_REPRESENTATION);
+
+    ddspipe::core::types::Payload loan;
+    if (!loan_payload(topic_name, size, loan))
+    {
+        return false;
+    }
+
+    if (!type_support.serialize(&sample, loan, fastdds::dds::DataRepresentationId::XCDR_DATA_REPRESENTATION))
+    {
+        EPROSIMA_LOG_ERROR(DDSENABLER_EXECUTION,
+                "Failed to publish data in topic " << topic_name << " : sample serialization failed.");
+        return false;
+    }
+
+    return publish_loaned(topic_name, loan);
+}
+
+template<typename PubSubType>
+bool DDSEnabler::subscribe(
+        const std::string& topic_name,
+        std::function<void(const typename PubSubType::type&, int64_t)> callback)
+{
+    auto type_support = std::make_shared<PubSubType>();
+
+    return subscribe_typed_(
+        topic_name,
+        *type_support,
+        [type_support, callback, topic_name](ddspipe::core::types::Payload& payload, int64_t publish_time)
+        {
+            typename PubSubType::type sample;
+            if (!type_support->deserialize(payload, &sample))
+            {
+                EPROSIMA_LOG_ERROR(DDSENABLER_EXECUTION,
+                        "Failed to deliver data in topic " << topic_name << " : sample deserialization failed.");
+                return;
+            }
+            callback(sample, publish_time);
+        });
+}
+
+} /* namespace ddsenabler */
+} /* namespace eprosima */
@@ -12,6 +12,12 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <thread>
+#include <vector>
+
 #include <ddsenabler/DDSEnabler.hpp>
 
 #include <cpp_utils/exception/InitializationException.hpp>
@@ -19,6 +25,8 @@
 
 #include <ddspipe_core/types/dynamic_types/types.hpp>
 
+#include <ddsenabler_participants/DiscoverySnapshot.hpp>
+#include <ddsenabler_participants/ThreadPlacement.hpp>
 #include <ddsenabler_participants/rpc/RpcUtils.hpp>
 
 namespace eprosima {
@@ -31,6 +39,32 @@ using namespace eprosima::ddspipe::participants::rtps;
 using namespace eprosima::ddsenabler::participants;
 using namespace eprosima::utils;
 
+namespace {
+
+ThreadPlacementConfiguration resolve_thread_placement(
+        const ThreadPlacementConfiguration& configuration)
+{
+    ThreadPlacementConfiguration placement = configuration;
+
+    // Workers and dispatchers run on the CPUs of the configured NUMA node, unless given explicitly
+    std::vector<unsigned int> node_cpus;
+    if (placement.numa_node >= 0 && get_numa_node_cpus(placement.numa_node, node_cpus))
+    {
+        if (placement.workers.cpus.empty())
+        {
+            placement.workers.cpus = node_cpus;
+        }
+        if (placement.dispatchers.cpus.empty())
+        {
+            placement.dispatchers.cpus = node_cpus;
+        }
+    }
+
+    return placement;
+}
+
+} // namespace
+
 DDSEnabler::DDSEnabler(
         const yaml::EnablerConfiguration& configuration,
         const CallbackSet& callbacks)
@@ -42,26 +76,58 @@ DDSEnabler::DDSEnabler(
     // Create Discovery Database
     discovery_database_ = std::make_shared<DiscoveryDatabase>();
 
+    // Threads inherit the placement of the thread creating them, so the DDS Pipe workers and the threads of the
+    // participants are placed by creating them under the workers placement.
+    // NOTE: payloads are allocated lazily by the threads receiving the data, so placing the workers on a NUMA node
+    // also makes the first touch of the payload pool memory happen on that node.
+    thread_placement_ = resolve_thread_placement(configuration_.thread_placement);
+
     // Create Payload Pool
-    payload_pool_ = std::make_shared<FastPayloadPool>();
+    payload_pool_ = std::make_shared<MeteredPayloadPool>();
 
     // Create Thread Pool
     thread_pool_ = std::make_shared<SlotThreadPool>(configuration_.n_threads);
 
     // Create Handler configuration
-    participants::HandlerConfiguration handler_config;
+    participants::HandlerConfiguration handler_config = configuration_.handler_configuration;
 
-    // Create DDS Participant
-    dds_participant_ = std::make_shared<DdsParticipant>(
-        configuration_.simple_configuration,
-        payload_pool_,
-        discovery_database_);
-    dds_participant_->init();
+    // Create DDS Participant, whose threads are workers
+    {
+        ScopedThreadPlacement workers_placement(thread_placement_.workers);
+        dds_participant_ = std::make_shared<DdsParticipant>(
+            configuration_.simple_configuration,
+            payload_pool_,
+            discovery_database_);
+        dds_participant_->init();
+    }
+
+    // Create Handler, whose helper threads are dispatchers
+    {
+        ScopedThreadPlacement dispatchers_placement(thread_placement_.dispatchers);
+        handler_ = std::make_shared<participants::Handler>(
+            handler_config,
+            payload_pool_);
+    }
 
-    // Create Handler
-    handler_ = std::make_shared<participants::Handler>(
-        handler_config,
-        payload_pool_);
+    // Preload known types before discovery starts, so their discovery is a cache hit
+    if (!handler_config.preload_types_path.empty())
+    {
+        handler_->preload_types(handler_config.preload_types_path);
+    }
+    if (!handler_config.type_bundle_path.empty())
+    {
+        handler_->load_type_bundle(handler_config.type_bundle_path);
+    }
+
+    // Types of the discovery snapshot are loaded before discovery starts too, its entities once the pipe is enabled
+    const std::string& snapshot_path = configuration_.enabler_configuration->discovery_snapshot_path;
+    std::error_code ec;
+    const bool restore_snapshot = !snapshot_path.empty() && std::filesystem::is_regular_file(snapshot_path, ec);
+    const std::string snapshot_types_path = snapshot_path + DISCOVERY_SNAPSHOT_TYPES_SUFFIX;
+    if (restore_snapshot && std::filesystem::is_regular_file(snapshot_types_path, ec))
+    {
+        handler_->load_type_bundle(snapshot_types_path);
+    }
 
     handler_->set_send_action_get_result_request_callback(
         [this](const std::string& action_name, const UUID& action_id)
@@ -118,12 +184,61 @@ DDSEnabler::DDSEnabler(
     // Set user defined callbacks in all internal entities requiring it
     set_internal_callbacks_(callbacks);
 
-    // Enable DDS Pipe after having set all callbacks
-    if (pipe_->enable() != utils::ReturnCode::RETCODE_OK)
+    // Enable DDS Pipe after having set all callbacks, which starts the thread pool workers
     {
-        throw utils::InitializationException(
-                  utils::Formatter() << "Failed to enable DDS Pipe.");
+        ScopedThreadPlacement workers_placement(thread_placement_.workers);
+        if (pipe_->enable() != utils::ReturnCode::RETCODE_OK)
+        {
+            throw utils::InitializationException(
+                      utils::Formatter() << "Failed to enable DDS Pipe.");
+        }
     }
+
+    // Recreate the entities known before the last restart, to be reconciled with live discovery
+    if (restore_snapshot)
+    {
+        restore_discovery_entities_(snapshot_path);
+    }
+
+    // Create the configured topics, services and actions before any publication takes place
+    warm_up_();
+
+    if (!snapshot_path.empty() && configuration_.enabler_configuration->discovery_snapshot_period > 0)
+    {
+        ScopedThreadPlacement dispatchers_placement(thread_placement_.dispatchers);
+        snapshot_handler_ = std::make_unique<eprosima::utils::event::PeriodicEventHandler>(
+            [this, snapshot_path]()
+            {
+                this->save_discovery_snapshot(snapshot_path);
+            },
+            configuration_.enabler_configuration->discovery_snapshot_period);
+    }
+
+    if (configuration_.metrics_export.enabled())
+    {
+        ScopedThreadPlacement dispatchers_placement(thread_placement_.dispatchers);
+        metrics_exporter_ = std::make_unique<MetricsExporter>(
+            configuration_.metrics_export,
+            [this]()
+            {
+                return this->get_metrics();
+            });
+    }
+}
+
+DDSEnabler::~DDSEnabler()
+{
+    // Stop the periodic snapshots and write the last one first, while every entity (the handler included) is up
+    snapshot_handler_.reset();
+
+    const std::string& snapshot_path = configuration_.enabler_configuration->discovery_snapshot_path;
+    if (!snapshot_path.empty())
+    {
+        save_discovery_snapshot(snapshot_path);
+    }
+
+    // Stop exporting metrics before tearing down the entities they are taken from
+    metrics_exporter_.reset();
 }
 
 bool DDSEnabler::set_file_watcher(
@@ -171,6 +286,7 @@ bool DDSEnabler::set_file_watcher(
             };
 
     // Creating FileWatcher event handler
+    ScopedThreadPlacement file_watcher_placement(thread_placement_.file_watcher);
     file_watcher_handler_ = std::make_unique<eprosima::utils::event::FileWatcherHandler>(file_watcher_callback,
                     file_path);
 
@@ -180,7 +296,7 @@ bool DDSEnabler::set_file_watcher(
 utils::ReturnCode DDSEnabler::reload_configuration(
         yaml::EnablerConfiguration& new_configuration)
 {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::lock_guard<MeteredMutex<std::mutex>> lock(mutex_);
 
     // Load the Enabler's internal topics from a configuration object.
     load_internal_topics_(new_configuration);
@@ -194,6 +310,157 @@ utils::ReturnCode DDSEnabler::reload_configuration(
     return ret;
 }
 
+void DDSEnabler::warm_up_()
+{
+    const auto& config = *configuration_.enabler_configuration;
+
+    std::vector<std::function<void()>> tasks;
+
+    // Topics with a known type are created in a single batch, the rest need to be queried one by one
+    std::vector<std::pair<std::string, TopicInfo>> typed_topics;
+    for (const auto& topic : config.warm_up_topics)
+    {
+        if (!topic.type_name.empty())
+        {
+            typed_topics.emplace_back(topic.name, TopicInfo(topic.type_name, ""));
+            continue;
+        }
+
+        tasks.push_back([this, topic]()
+                {
+                    if (!enabler_participant_->declare_topic(topic.name))
+                    {
+                        EPROSIMA_LOG_WARNING(DDSENABLER_EXECUTION,
+                                "Failed to create topic " << topic.name << " during warm-up.");
+                    }
+                });
+    }
+
+    if (!typed_topics.empty())
+    {
+        tasks.push_back([this, typed_topics]()
+                {
+                    if (!enabler_participant_->declare_topics(typed_topics))
+                    {
+                        EPROSIMA_LOG_WARNING(DDSENABLER_EXECUTION,
+                                "Failed to create some of the typed topics during warm-up.");
+                    }
+                });
+    }
+
+    for (const auto& service : config.warm_up_services)
+    {
+        tasks.push_back([this, service]()
+                {
+                    if (!enabler_participant_->announce_service(service.name, service.protocol))
+                    {
+                        EPROSIMA_LOG_WARNING(DDSENABLER_EXECUTION,
+                                "Failed to announce service " << service.name << " during warm-up.");
+                        return;
+                    }
+                    std::lock_guard<MeteredMutex<std::mutex>> lock(mutex_);
+                    warmed_up_services_.insert(service.name);
+                });
+    }
+
+    for (const auto& action : config.warm_up_actions)
+    {
+        tasks.push_back([this, action]()
+                {
+                    if (!enabler_participant_->announce_action(action.name, action.protocol))
+                    {
+                        EPROSIMA_LOG_WARNING(DDSENABLER_EXECUTION,
+                                "Failed to announce action " << action.name << " during warm-up.");
+                        return;
+                    }
+                    std::lock_guard<MeteredMutex<std::mutex>> lock(mutex_);
+                    warmed_up_actions_.insert(action.name);
+                });
+    }
+
+    if (tasks.empty())
+    {
+        return;
+    }
+
+    EPROSIMA_LOG_INFO(DDSENABLER_EXECUTION,
+            "Warming up " << tasks.size() << " topics, services and actions.");
+
+    // Run the tasks with bounded concurrency: endpoint creation mostly waits for the discovery thread, so
+    // overlapping several creations hides most of that latency
+    std::atomic<std::size_t> next_task{0};
+    auto worker = [&tasks, &next_task]()
+            {
+                for (std::size_t i = next_task++; i < tasks.size(); i = next_task++)
+                {
+                    tasks[i]();
+                }
+            };
+
+    std::size_t n_workers = std::min<std::size_t>(std::max(config.warm_up_max_concurrency, 1u), tasks.size());
+    std::vector<std::thread> workers;
+    for (std::size_t i = 1; i < n_workers; ++i)
+    {
+        workers.emplace_back(worker);
+    }
+    worker();
+
+    for (auto& thread : workers)
+    {
+        thread.join();
+    }
+}
+
+bool DDSEnabler::restore_discovery_entities_(
+        const std::string& path)
+{
+    DiscoverySnapshot snapshot;
+    if (!snapshot.load(path))
+    {
+        return false;
+    }
+
+    bool ret = true;
+    if (!snapshot.topics.empty() && !enabler_participant_->declare_topics(snapshot.topics))
+    {
+        EPROSIMA_LOG_WARNING(DDSENABLER_EXECUTION,
+                "Failed to restore some of the topics of discovery snapshot " << path << ".");
+        ret = false;
+    }
+
+    for (const auto& service : snapshot.services)
+    {
+        if (!enabler_participant_->announce_service(service.name, service.info, service.protocol))
+        {
+            EPROSIMA_LOG_WARNING(DDSENABLER_EXECUTION,
+                    "Failed to restore service " << service.name << " from discovery snapshot " << path << ".");
+            ret = false;
+            continue;
+        }
+        std::lock_guard<MeteredMutex<std::mutex>> lock(mutex_);
+        warmed_up_services_.insert(service.name);
+    }
+
+    for (const auto& action : snapshot.actions)
+    {
+        if (!enabler_participant_->announce_action(action.name, action.info, action.protocol))
+        {
+            EPROSIMA_LOG_WARNING(DDSENABLER_EXECUTION,
+                    "Failed to restore action " << action.name << " from discovery snapshot " << path << ".");
+            ret = false;
+            continue;
+        }
+        std::lock_guard<MeteredMutex<std::mutex>> lock(mutex_);
+        warmed_up_actions_.insert(action.name);
+    }
+
+    EPROSIMA_LOG_INFO(DDSENABLER_EXECUTION,
+            "Restored discovery snapshot " << path << ": " << snapshot.topics.size() << " topics, " <<
+            snapshot.services.size() << " services, " << snapshot.actions.size() << " actions.");
+
+    return ret;
+}
+
 void DDSEnabler::load_internal_topics_(
         yaml::EnablerConfiguration& configuration)
 {
@@ -284,6 +551,14 @@ void DDSEnabler::set_internal_callbacks_(
     {
         enabler_participant_->set_action_query_callback(callbacks.action.action_query);
     }
+    if (callbacks.discovery_batch_notification)
+    {
+        handler_->set_discovery_batch_notification_callback(callbacks.discovery_batch_notification);
+    }
+    if (callbacks.slow_callback_notification)
+    {
+        handler_->set_slow_callback_notification_callback(callbacks.slow_callback_notification);
+    }
 }
 
 bool DDSEnabler::publish(
@@ -293,6 +568,152 @@ bool DDSEnabler::publish(
     return enabler_participant_->publish(topic_name, json);
 }
 
+bool DDSEnabler::publish_cdr(
+        const std::string& topic_name,
+        const uint8_t* cdr,
+        const uint32_t size,
+        fastdds::dds::DataRepresentationId_t representation)
+{
+    return enabler_participant_->publish_cdr(topic_name, cdr, size, representation);
+}
+
+bool DDSEnabler::loan_payload(
+        const std::string& topic_name,
+        const uint32_t size,
+        ddspipe::core::types::Payload& loan)
+{
+    return enabler_participant_->loan_payload(topic_name, size, loan);
+}
+
+bool DDSEnabler::publish_loaned(
+        const std::string& topic_name,
+        ddspipe::core::types::Payload& loan)
+{
+    return enabler_participant_->publish_loaned(topic_name, loan);
+}
+
+bool DDSEnabler::unsubscribe(
+        const std::string& topic_name)
+{
+    return handler_->remove_typed_subscription(topic_name);
+}
+
+std::size_t DDSEnabler::preload_types(
+        const std::string& directory)
+{
+    return handler_->preload_types(directory);
+}
+
+std::size_t DDSEnabler::load_type_bundle(
+        const std::string& path)
+{
+    return handler_->load_type_bundle(path);
+}
+
+participants::SchemaCacheStats DDSEnabler::get_schema_cache_stats()
+{
+    return handler_->get_schema_cache_stats();
+}
+
+std::vector<participants::PriorityClassStats> DDSEnabler::get_priority_class_stats() const
+{
+    return handler_->get_priority_class_stats();
+}
+
+participants::MetricsReport DDSEnabler::get_metrics() const
+{
+    participants::MetricsReport report = handler_->get_metrics();
+    report.payload_pool = payload_pool_->stats();
+    return report;
+}
+
+bool DDSEnabler::save_discovery_snapshot(
+        const std::string& path)
+{
+    DiscoverySnapshot snapshot;
+    enabler_participant_->get_discovery_snapshot(snapshot);
+
+    // Types are stored first, so a snapshot never references types missing from its bundle
+    handler_->save_type_bundle(path + DISCOVERY_SNAPSHOT_TYPES_SUFFIX);
+
+    return snapshot.save(path);
+}
+
+bool DDSEnabler::restore_discovery_snapshot(
+        const std::string& path)
+{
+    const std::string types_path = path + DISCOVERY_SNAPSHOT_TYPES_SUFFIX;
+    std::error_code ec;
+    if (std::filesystem::is_regular_file(types_path, ec))
+    {
+        handler_->load_type_bundle(types_path);
+    }
+
+    return restore_discovery_entities_(path);
+}
+
+bool DDSEnabler::get_type_idl(
+        const std::string& type_name,
+        std::string& idl)
+{
+    return handler_->get_type_idl(type_name, idl);
+}
+
+bool DDSEnabler::get_type_collection(
+        const std::string& type_name,
+        std::vector<unsigned char>& collection)
+{
+    return handler_->get_type_collection(type_name, collection);
+}
+
+bool DDSEnabler::get_type_placeholder(
+        const std::string& type_name,
+        std::string& placeholder)
+{
+    return handler_->get_type_placeholder(type_name, placeholder);
+}
+
+bool DDSEnabler::declare_typed_topic_(
+        const std::string& topic_name,
+        fastdds::dds::TopicDataType& type_support)
+{
+    std::lock_guard<MeteredMutex<std::mutex>> lock(mutex_);
+
+    auto it = typed_topics_.find(topic_name);
+    if (it != typed_topics_.end())
+    {
+        if (it->second != type_support.get_name())
+        {
+            EPROSIMA_LOG_ERROR(DDSENABLER_EXECUTION,
+                    "Failed to publish data in topic " << topic_name << " : topic declared with type " << it->second <<
+                    ".");
+            return false;
+        }
+        return true;
+    }
+
+    // Make the type known to the type object registry, so the handler can resolve it without querying the user
+    type_support.register_type_object_representation();
+
+    if (!enabler_participant_->declare_topic(topic_name, participants::TopicInfo(type_support.get_name(), "")))
+    {
+        return false;
+    }
+
+    typed_topics_.emplace(topic_name, type_support.get_name());
+    return true;
+}
+
+bool DDSEnabler::subscribe_typed_(
+        const std::string& topic_name,
+        fastdds::dds::TopicDataType& type_support,
+        participants::TypedDataCallback callback)
+{
+    type_support.register_type_object_representation();
+
+    return handler_->add_typed_subscription(topic_name, type_support.get_name(), std::move(callback));
+}
+
 bool DDSEnabler::send_service_request(
         const std::string& service_name,
         const std::string& json,
@@ -322,6 +743,16 @@ bool DDSEnabler::announce_service(
         const std::string& service_name,
         participants::Protocol Protocol)
 {
+    {
+        // Services announced at startup are adopted by the first explicit announcement, as long as they are still
+        // announced with the requested protocol (otherwise they are announced again)
+        std::lock_guard<MeteredMutex<std::mutex>> lock(mutex_);
+        if (warmed_up_services_.erase(service_name) > 0 &&
+                enabler_participant_->is_service_announced(service_name, Protocol))
+        {
+            return true;
+        }
+    }
     return enabler_participant_->announce_service(service_name, Protocol);
 }
 
@@ -334,6 +765,10 @@ bool DDSEnabler::announce_service(
 bool DDSEnabler::revoke_service(
         const std::string& service_name)
 {
+    {
+        std::lock_guard<MeteredMutex<std::mutex>> lock(mutex_);
+        warmed_up_services_.erase(service_name);
+    }
     return enabler_participant_->revoke_service(service_name);
 }
 
@@ -403,12 +838,26 @@ bool DDSEnabler::announce_action(
         const std::string& action_name,
         participants::Protocol Protocol)
 {
+    {
+        // Actions announced at startup are adopted by the first explicit announcement, as long as they are still
+        // announced with the requested protocol (otherwise they are announced again)
+        std::lock_guard<MeteredMutex<std::mutex>> lock(mutex_);
+        if (warmed_up_actions_.erase(action_name) > 0 &&
+                enabler_participant_->is_action_announced(action_name, Protocol))
+        {
+            return true;
+        }
+    }
     return enabler_participant_->announce_action(action_name, Protocol);
 }
 
 bool DDSEnabler::revoke_action(
         const std::string& action_name)
 {
+    {
+        std::lock_guard<MeteredMutex<std::mutex>> lock(mutex_);
+        warmed_up_actions_.erase(action_name);
+    }
     return enabler_participant_->revoke_action(action_name);
 }
 
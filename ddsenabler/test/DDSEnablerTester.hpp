@@ -20,6 +20,8 @@
 #include <fastdds/dds/domain/DomainParticipantFactory.hpp>
 #include <fastdds/dds/publisher/DataWriter.hpp>
 #include <fastdds/dds/publisher/Publisher.hpp>
+#include <fastdds/dds/subscriber/DataReader.hpp>
+#include <fastdds/dds/subscriber/Subscriber.hpp>
 #include <fastdds/dds/xtypes/dynamic_types/DynamicData.hpp>
 #include <fastdds/dds/xtypes/dynamic_types/DynamicDataFactory.hpp>
 #include <fastdds/dds/xtypes/dynamic_types/DynamicType.hpp>
@@ -43,6 +45,7 @@ struct KnownType
     DynamicType::_ref_type dyn_type_;
     TypeSupport type_sup_;
     DataWriter* writer_ = nullptr;
+    DataReader* reader_ = nullptr;
 };
 
 const unsigned int DOMAIN_ = 33;
@@ -82,12 +85,14 @@ public:
     }
 
     // Create the DDSEnabler and bind the static callbacks
-    std::shared_ptr<DDSEnabler> create_ddsenabler()
+    std::shared_ptr<DDSEnabler> create_ddsenabler(
+            std::size_t schema_cache_max_types = 0)
     {
         YAML::Node yml;
 
         eprosima::ddsenabler::yaml::EnablerConfiguration configuration(yml);
         configuration.simple_configuration->domain = DOMAIN_;
+        configuration.handler_configuration.schema_cache_max_types = schema_cache_max_types;
 
         CallbackSet callbacks{
             test_log_callback,
@@ -271,6 +276,70 @@ public:
         return true;
     }
 
+    // Create a reliable reader of the topic of the type, and wait for it to match the given number of writers
+    bool create_subscriber(
+            KnownType& a_type,
+            int32_t matched_writers = 1)
+    {
+        DomainParticipant* participant = DomainParticipantFactory::get_instance()
+                        ->create_participant(DOMAIN_, PARTICIPANT_QOS_DEFAULT);
+        if (participant == nullptr)
+        {
+            std::cout << "ERROR DDSEnablerTester: create_participant" << std::endl;
+            return false;
+        }
+
+        if (RETCODE_OK != a_type.type_sup_.register_type(participant))
+        {
+            std::cout << "ERROR DDSEnablerTester: fail to register type: " <<
+                a_type.type_sup_.get_type_name() << std::endl;
+            return false;
+        }
+
+        Subscriber* subscriber = participant->create_subscriber(SUBSCRIBER_QOS_DEFAULT);
+        if (subscriber == nullptr)
+        {
+            std::cout << "ERROR DDSEnablerTester: create_subscriber: " <<
+                a_type.type_sup_.get_type_name() << std::endl;
+            return false;
+        }
+
+        std::ostringstream topic_name;
+        topic_name << a_type.type_sup_.get_type_name() << "TopicName";
+        Topic* topic = participant->create_topic(topic_name.str(), a_type.type_sup_.get_type_name(), TOPIC_QOS_DEFAULT);
+        if (topic == nullptr)
+        {
+            std::cout << "ERROR DDSEnablerTester: create_topic: " <<
+                a_type.type_sup_.get_type_name() << std::endl;
+            return false;
+        }
+
+        DataReaderQos rqos = subscriber->get_default_datareader_qos();
+        rqos.reliability().kind = RELIABLE_RELIABILITY_QOS;
+        a_type.reader_ = subscriber->create_datareader(topic, rqos);
+        if (a_type.reader_ == nullptr)
+        {
+            std::cout << "ERROR DDSEnablerTester: create_datareader: " <<
+                a_type.type_sup_.get_type_name() << std::endl;
+            return false;
+        }
+
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::nanoseconds(wait_for_ack_ns_);
+        SubscriptionMatchedStatus status;
+        while (RETCODE_OK == a_type.reader_->get_subscription_matched_status(status) &&
+                status.current_count < matched_writers)
+        {
+            if (std::chrono::steady_clock::now() > deadline)
+            {
+                std::cout << "ERROR DDSEnablerTester: reader not matched: " <<
+                    a_type.type_sup_.get_type_name() << std::endl;
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(write_delay_ms_));
+        }
+        return true;
+    }
+
     bool send_samples(
             KnownType& a_type)
     {
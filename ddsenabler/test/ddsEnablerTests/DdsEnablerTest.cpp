@@ -12,9 +12,19 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
 #include <cpp_utils/testing/gtest_aux.hpp>
 #include <gtest/gtest.h>
 
+#include <ddsenabler_participants/DiscoverySnapshot.hpp>
+
 #include "types/DDSEnablerTestTypesPubSubTypes.hpp"
 #include "DDSEnablerTester.hpp"
 
@@ -385,6 +395,134 @@ TEST_F(DDSEnablerTest, send_history_multiple_types)
     ASSERT_EQ(get_received_data(), types * history_depth);
 }
 
+TEST_F(DDSEnablerTest, publish_loaned)
+{
+    auto enabler = create_ddsenabler();
+    ASSERT_TRUE(enabler != nullptr);
+
+    KnownType a_type;
+    a_type.type_sup_.reset(new DDSEnablerTestType1PubSubType());
+
+    // Discover the topic from an external writer, as the topic query callback is not able to resolve it
+    ASSERT_TRUE(create_publisher(a_type));
+    ASSERT_EQ(get_received_topics(), 1);
+
+    std::string topic_name = std::string(a_type.type_sup_.get_type_name()) + "TopicName";
+
+    // Subscribe to the topic, matching both the external writer and the one created by the enabler on discovery
+    ASSERT_TRUE(create_subscriber(a_type, 2));
+
+    void* sample = a_type.type_sup_.create_data();
+    static_cast<DDSEnablerTestType1*>(sample)->value(42);
+    uint32_t size = a_type.type_sup_.calculate_serialized_size(sample,
+                    DataRepresentationId_t::XCDR_DATA_REPRESENTATION);
+
+    eprosima::ddspipe::core::types::Payload loan;
+    ASSERT_FALSE(enabler->loan_payload("UnknownTopicName", size, loan));
+    ASSERT_FALSE(enabler->loan_payload(topic_name, 0, loan));
+    ASSERT_TRUE(enabler->loan_payload(topic_name, size, loan));
+    ASSERT_GE(loan.max_size, size);
+
+    // Serialize the sample directly into the loaned buffer
+    ASSERT_TRUE(a_type.type_sup_.serialize(sample, loan, DataRepresentationId_t::XCDR_DATA_REPRESENTATION));
+    a_type.type_sup_.delete_data(sample);
+    const std::vector<uint8_t> published(loan.data, loan.data + loan.length);
+
+    ASSERT_TRUE(enabler->publish_loaned(topic_name, loan));
+    ASSERT_EQ(loan.data, nullptr);
+
+    // The sample reaches DDS with the serialized contents
+    ASSERT_TRUE(a_type.reader_->wait_for_unread_message(Duration_t(wait_for_ack_ns_ / 1000000000, 0)));
+    DDSEnablerTestType1 received;
+    SampleInfo info;
+    ASSERT_EQ(a_type.reader_->take_next_sample(&received, &info), RETCODE_OK);
+    ASSERT_TRUE(info.valid_data);
+    ASSERT_EQ(received.value(), 42);
+
+    eprosima::ddspipe::core::types::Payload received_payload(
+        a_type.type_sup_.calculate_serialized_size(&received, DataRepresentationId_t::XCDR_DATA_REPRESENTATION));
+    ASSERT_TRUE(a_type.type_sup_.serialize(&received, received_payload,
+            DataRepresentationId_t::XCDR_DATA_REPRESENTATION));
+    ASSERT_EQ(std::vector<uint8_t>(received_payload.data, received_payload.data + received_payload.length),
+            published);
+
+    // A consumed loan cannot be published again
+    ASSERT_FALSE(enabler->publish_loaned(topic_name, loan));
+}
+
+TEST_F(DDSEnablerTest, typed_publish_subscribe)
+{
+    ddsenablertester::num_samples_ = 3;
+
+    auto enabler = create_ddsenabler();
+    ASSERT_TRUE(enabler != nullptr);
+
+    KnownType a_type;
+    a_type.type_sup_.reset(new DDSEnablerTestType1PubSubType());
+    std::string topic_name = std::string(a_type.type_sup_.get_type_name()) + "TopicName";
+
+    std::atomic<int> typed_received{0};
+    ASSERT_TRUE(enabler->subscribe<DDSEnablerTestType1PubSubType>(topic_name,
+            [&typed_received](const DDSEnablerTestType1&, int64_t)
+            {
+                typed_received++;
+            }));
+    ASSERT_FALSE(enabler->subscribe<DDSEnablerTestType1PubSubType>(topic_name,
+            [](const DDSEnablerTestType1&, int64_t)
+            {
+            }));
+
+    ASSERT_TRUE(create_publisher(a_type));
+    ASSERT_TRUE(send_samples(a_type));
+
+    // Typed samples are not notified as JSON
+    ASSERT_EQ(typed_received.load(), num_samples_);
+    ASSERT_EQ(get_received_data(), 0);
+
+    ASSERT_TRUE(enabler->unsubscribe(topic_name));
+    ASSERT_FALSE(enabler->unsubscribe(topic_name));
+
+    // Publish in a topic unknown to the topic query callback, declared from the compiled type
+    DDSEnablerTestType1 sample;
+    ASSERT_TRUE(enabler->publish<DDSEnablerTestType1PubSubType>("TypedTopicName", sample));
+    ASSERT_FALSE(enabler->publish<DDSEnablerTestType2PubSubType>("TypedTopicName", DDSEnablerTestType2()));
+}
+
+TEST_F(DDSEnablerTest, schema_cache_release_removed_topics)
+{
+    auto enabler = create_ddsenabler(1);
+    ASSERT_TRUE(enabler != nullptr);
+
+    KnownType type1;
+    type1.type_sup_.reset(new DDSEnablerTestType1PubSubType());
+    ASSERT_TRUE(create_publisher(type1));
+
+    KnownType type2;
+    type2.type_sup_.reset(new DDSEnablerTestType2PubSubType());
+    ASSERT_TRUE(create_publisher(type2));
+
+    ASSERT_EQ(get_received_topics(), 2);
+
+    // Types of live topics are never evicted, even if the bound is exceeded
+    auto stats = enabler->get_schema_cache_stats();
+    const std::size_t pinned_types = stats.pinned_types;
+    const std::size_t evictions = stats.evictions;
+    ASSERT_GE(pinned_types, 2u);
+    ASSERT_GE(stats.cached_types, 2u);
+
+    // Once the last endpoint of a topic is gone, its type is released and evicted
+    ASSERT_EQ(RETCODE_OK, type1.writer_->get_publisher()->delete_datawriter(type1.writer_));
+    type1.writer_ = nullptr;
+    for (int i = 0; i < 50 && enabler->get_schema_cache_stats().pinned_types == pinned_types; i++)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+
+    stats = enabler->get_schema_cache_stats();
+    ASSERT_EQ(stats.pinned_types, pinned_types - 1);
+    ASSERT_EQ(stats.evictions, evictions + 1);
+}
+
 // SERVICES
 
 TEST_F(DDSEnablerTest, service_client)
@@ -451,6 +589,144 @@ TEST_F(DDSEnablerTest, action_server)
     ASSERT_FALSE(enabler->revoke_action(action_name));
 }
 
+// WARM-UP
+
+TEST_F(DDSEnablerTest, warm_up)
+{
+    constexpr uint32_t INITIAL_PUBLISH_WAIT_MS = 1000;
+
+    const char* yml_str =
+            R"(
+            ddsenabler:
+              initial-publish-wait: 1000
+              warm-up:
+                max-concurrency: 1
+                topics:
+                  - name: "rt/rosout"
+                    type: "rcl_interfaces::msg::dds_::Log_"
+                services:
+                  - name: "add_two_ints"
+                actions:
+                  - name: "fibonacci/_action/"
+        )";
+    eprosima::Yaml yml = YAML::Load(yml_str);
+    eprosima::ddsenabler::yaml::EnablerConfiguration configuration(yml);
+    configuration.simple_configuration->domain = DOMAIN_;
+
+    eprosima::utils::Formatter error_msg;
+    ASSERT_TRUE(configuration.is_valid(error_msg));
+
+    // Count the queries to the user's app, forwarding them to the regular test callbacks
+    static std::atomic<int> type_queries{0};
+    static std::atomic<int> topic_queries{0};
+    static std::atomic<int> service_queries{0};
+    static std::atomic<int> action_queries{0};
+
+    CallbackSet callbacks{
+        test_log_callback,
+        {
+            test_type_notification_callback,
+            test_topic_notification_callback,
+            test_data_notification_callback,
+            [](const char* type_name,
+               std::unique_ptr<const unsigned char []>& serialized_type_internal,
+               uint32_t& serialized_type_internal_size)
+            {
+                ++type_queries;
+                return test_type_query_callback(type_name, serialized_type_internal, serialized_type_internal_size);
+            },
+            [](const char* topic_name, TopicInfo& topic_info)
+            {
+                ++topic_queries;
+                return test_topic_query_callback(topic_name, topic_info);
+            }
+        },
+        {
+            test_service_notification_callback,
+            test_service_request_notification_callback,
+            test_service_reply_notification_callback,
+            [](const char* service_name, ServiceInfo& service_info)
+            {
+                ++service_queries;
+                return test_service_query_callback(service_name, service_info);
+            }
+        },
+        {
+            test_action_notification_callback,
+            test_action_goal_request_notification_callback,
+            test_action_feedback_notification_callback,
+            test_action_cancel_request_notification_callback,
+            test_action_result_notification_callback,
+            test_action_status_notification_callback,
+            [](const char* action_name, ActionInfo& action_info)
+            {
+                ++action_queries;
+                return test_action_query_callback(action_name, action_info);
+            }
+        }
+    };
+
+    // Warm-up runs in the constructor. The typed topic waits once for matching, while the service and the action
+    // (whose five endpoints are created in a single batch) do not wait at all
+    const auto start = std::chrono::steady_clock::now();
+    auto enabler = std::make_shared<DDSEnabler>(configuration, callbacks);
+    const auto startup = std::chrono::steady_clock::now() - start;
+    ASSERT_TRUE(enabler != nullptr);
+    ASSERT_LT(startup, std::chrono::milliseconds(2 * INITIAL_PUBLISH_WAIT_MS));
+
+    ASSERT_GE(type_queries.load(), 1);
+    ASSERT_EQ(topic_queries.load(), 0);
+    ASSERT_EQ(service_queries.load(), 1);
+    ASSERT_EQ(action_queries.load(), 1);
+
+    // All warmed up entities exist right after construction
+    const std::string snapshot_path =
+            (std::filesystem::temp_directory_path() / "ddsenabler_warm_up_snapshot.json").string();
+    ASSERT_TRUE(enabler->save_discovery_snapshot(snapshot_path));
+    DiscoverySnapshot snapshot;
+    ASSERT_TRUE(snapshot.load(snapshot_path));
+    std::filesystem::remove(snapshot_path);
+    std::filesystem::remove(snapshot_path + DISCOVERY_SNAPSHOT_TYPES_SUFFIX);
+
+    ASSERT_TRUE(std::any_of(snapshot.topics.begin(), snapshot.topics.end(),
+            [](const std::pair<std::string, TopicInfo>& topic)
+            {
+                return topic.first == "rt/rosout" && topic.second.type_name == "rcl_interfaces::msg::dds_::Log_";
+            }));
+    ASSERT_EQ(snapshot.services.size(), 1u);
+    ASSERT_EQ(snapshot.services[0].name, "add_two_ints");
+    ASSERT_EQ(snapshot.actions.size(), 1u);
+    ASSERT_EQ(snapshot.actions[0].name, "fibonacci/_action/");
+    ASSERT_FALSE(snapshot.actions[0].info.goal.request.type_name.empty());
+    ASSERT_FALSE(snapshot.actions[0].info.result.request.type_name.empty());
+    ASSERT_FALSE(snapshot.actions[0].info.cancel.request.type_name.empty());
+    ASSERT_FALSE(snapshot.actions[0].info.feedback.type_name.empty());
+    ASSERT_FALSE(snapshot.actions[0].info.status.type_name.empty());
+
+    // The first publish finds the writer already created: neither queried nor waiting for matching
+    const int type_queries_at_startup = type_queries.load();
+    const std::string json =
+            "{\"stamp\": {\"sec\": 0, \"nanosec\": 0}, \"level\": 20, \"name\": \"warm_up\", \"msg\": \"hello\", "
+            "\"file\": \"\", \"function\": \"\", \"line\": 0}";
+    const auto publish_start = std::chrono::steady_clock::now();
+    ASSERT_TRUE(enabler->publish("rt/rosout", json));
+    ASSERT_LT(std::chrono::steady_clock::now() - publish_start,
+            std::chrono::milliseconds(INITIAL_PUBLISH_WAIT_MS / 2));
+    ASSERT_EQ(type_queries.load(), type_queries_at_startup);
+    ASSERT_EQ(topic_queries.load(), 0);
+
+    // The user's announcements adopt the warmed up service and action, without querying them again
+    ASSERT_TRUE(enabler->announce_service("add_two_ints"));
+    ASSERT_FALSE(enabler->announce_service("add_two_ints"));
+    ASSERT_TRUE(enabler->announce_action("fibonacci/_action/"));
+    ASSERT_FALSE(enabler->announce_action("fibonacci/_action/"));
+    ASSERT_EQ(service_queries.load(), 1);
+    ASSERT_EQ(action_queries.load(), 1);
+
+    ASSERT_TRUE(enabler->revoke_service("add_two_ints"));
+    ASSERT_TRUE(enabler->revoke_action("fibonacci/_action/"));
+}
+
 int main(
         int argc,
         char** argv)
@@ -0,0 +1,204 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file main.cpp
+ *
+ * Compile the types defined in IDL files into a type bundle, to be loaded by the DDS Enabler at startup.
+ */
+
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <cpp_utils/exception/InitializationException.hpp>
+
+#include <fastdds/dds/domain/DomainParticipantFactory.hpp>
+#include <fastdds/dds/xtypes/dynamic_types/DynamicTypeBuilderFactory.hpp>
+#include <fastdds/dds/xtypes/type_representation/ITypeObjectRegistry.hpp>
+
+#include <ddsenabler_participants/TypeStore.hpp>
+#include <ddsenabler_participants/Writer.hpp>
+
+using namespace eprosima;
+using namespace eprosima::fastdds::dds;
+
+namespace {
+
+struct BundlerConfig
+{
+    std::string output_path = "types.bundle";
+    std::vector<std::string> include_paths;
+    std::vector<std::string> type_names;
+    std::vector<std::string> idl_files;
+};
+
+void print_help(
+        int return_code)
+{
+    std::cout << "Usage: ddsenabler_type_bundler [options] <file.idl>..."                                       <<
+        std::endl;
+    std::cout << ""                                                                                             <<
+        std::endl;
+    std::cout << "--output <str>                        Path of the generated type bundle"                      <<
+        std::endl;
+    std::cout << "                                      (Default: 'types.bundle')"                              <<
+        std::endl;
+    std::cout << "--include <str>                       Directory where included IDL files are looked up"       <<
+        std::endl;
+    std::cout << "                                      (may be repeated)"                                      <<
+        std::endl;
+    std::cout << "--type <str>                          Fully qualified name of a type to bundle"               <<
+        std::endl;
+    std::cout << "                                      (e.g. 'std_msgs::msg::dds_::String_', may be repeated)" <<
+        std::endl;
+    std::cout << "--help                                Print this help message"                                <<
+        std::endl;
+    std::exit(return_code);
+}
+
+BundlerConfig parse_cli_options(
+        int argc,
+        char* argv[])
+{
+    BundlerConfig config;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+
+        if (arg == "-h" || arg == "--help")
+        {
+            print_help(EXIT_SUCCESS);
+        }
+        else if (arg == "-o" || arg == "--output" || arg == "-I" || arg == "--include" || arg == "-t" ||
+                arg == "--type")
+        {
+            if (++i >= argc)
+            {
+                std::cerr << "Missing value for " << arg << " argument." << std::endl;
+                print_help(EXIT_FAILURE);
+            }
+
+            if (arg == "-o" || arg == "--output")
+            {
+                config.output_path = argv[i];
+            }
+            else if (arg == "-I" || arg == "--include")
+            {
+                config.include_paths.push_back(argv[i]);
+            }
+            else
+            {
+                config.type_names.push_back(argv[i]);
+            }
+        }
+        else if (!arg.empty() && arg[0] == '-')
+        {
+            std::cerr << "Unknown argument " << arg << "." << std::endl;
+            print_help(EXIT_FAILURE);
+        }
+        else
+        {
+            config.idl_files.push_back(arg);
+        }
+    }
+
+    if (config.idl_files.empty() || config.type_names.empty())
+    {
+        std::cerr << "At least one IDL file and one type must be provided." << std::endl;
+        print_help(EXIT_FAILURE);
+    }
+
+    return config;
+}
+
+} // namespace
+
+int main(
+        int argc,
+        char* argv[])
+{
+    BundlerConfig config = parse_cli_options(argc, argv);
+
+    // Always generate the bundle from scratch, as the type store is append-only
+    std::error_code ec;
+    std::filesystem::remove(config.output_path, ec);
+
+    std::unique_ptr<ddsenabler::participants::TypeStore> bundle;
+    try
+    {
+        bundle = std::make_unique<ddsenabler::participants::TypeStore>(config.output_path);
+    }
+    catch (const utils::InitializationException& e)
+    {
+        std::cerr << "Failed to create type bundle: " << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    ddsenabler::participants::Writer writer;
+    auto& registry = DomainParticipantFactory::get_instance()->type_object_registry();
+    int ret = EXIT_SUCCESS;
+
+    for (const auto& type_name : config.type_names)
+    {
+        // Look the type up in every IDL file until found
+        DynamicType::_ref_type dyn_type;
+        for (const auto& idl_file : config.idl_files)
+        {
+            auto builder = DynamicTypeBuilderFactory::get_instance()->create_type_w_uri(idl_file, type_name,
+                            config.include_paths);
+            if (builder)
+            {
+                dyn_type = builder->build();
+                break;
+            }
+        }
+
+        xtypes::TypeIdentifierPair type_ids;
+        if (!dyn_type || RETCODE_OK != registry.register_typeobject_w_dynamic_type(dyn_type, type_ids))
+        {
+            std::cerr << "Failed to compile type " << type_name << "." << std::endl;
+            ret = EXIT_FAILURE;
+            continue;
+        }
+        const xtypes::TypeIdentifier& type_id =
+                (xtypes::EK_COMPLETE == type_ids.type_identifier1()._d()) ?
+                type_ids.type_identifier1() : type_ids.type_identifier2();
+
+        // Precompute the descriptions the enabler would otherwise generate at runtime
+        std::string idl;
+        std::string placeholder;
+        if (!writer.generate_type_idl(dyn_type, idl) || !writer.generate_type_placeholder(dyn_type, placeholder))
+        {
+            std::cerr << "Failed to generate the description of type " << type_name << "." << std::endl;
+            ret = EXIT_FAILURE;
+            continue;
+        }
+
+        if (!bundle->store(dyn_type->get_name().to_string(), type_id, idl, placeholder))
+        {
+            std::cerr << "Failed to bundle type " << type_name << "." << std::endl;
+            ret = EXIT_FAILURE;
+            continue;
+        }
+    }
+
+    std::cout << "Bundled " << bundle->size() << " types into " << config.output_path << "." << std::endl;
+
+    return ret;
+}
@@ -0,0 +1,165 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file CallbackWatchdog.hpp
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+#include <ddsenabler_participants/Callbacks.hpp>
+#include <ddsenabler_participants/NotificationQueue.hpp>
+#include <ddsenabler_participants/PriorityDispatcher.hpp>
+#include <ddsenabler_participants/library/library_dll.h>
+
+namespace eprosima {
+namespace ddsenabler {
+namespace participants {
+
+/**
+ * Watchdog timing the callbacks to the user's app against a time budget.
+ *
+ * Callbacks exceeding the budget are reported through the log and the slow callback notification. Entities whose
+ * offloadable callbacks exceed it a number of consecutive times are offloaded: their notifications are delivered from
+ * a dedicated thread, so they do not delay those of the rest. Once their callbacks are within the budget as many
+ * consecutive times, and no notification of theirs is pending in the offloading thread, they are restored.
+ *
+ * The notifications of an entity are always delivered in order and one at a time: those of a newly offloaded entity
+ * are held until the ones it still has in the notification queue have been delivered. The callbacks of offloaded
+ * entities do run concurrently with those of the rest.
+ */
+class CallbackWatchdog
+{
+public:
+
+    /**
+     * @brief Create the watchdog, starting the offloading thread if offloading is enabled (so it is placed as the
+     * thread creating the watchdog).
+     *
+     * @param [in] budget Time budget of a callback.
+     * @param [in] offload_threshold Consecutive budget overruns after which an entity is offloaded (never if 0), and
+     * consecutive callbacks within budget after which it is restored.
+     */
+    DDSENABLER_PARTICIPANTS_DllAPI
+    CallbackWatchdog(
+            std::chrono::nanoseconds budget,
+            uint32_t offload_threshold);
+
+    DDSENABLER_PARTICIPANTS_DllAPI
+    void set_slow_callback_notification_callback(
+            SlowCallbackNotification callback)
+    {
+        slow_callback_notification_callback_ = callback;
+    }
+
+    /**
+     * @brief Invoke a notification, timing it against the budget.
+     *
+     * @param [in] callback_name Name of the callback invoked by the notification.
+     * @param [in] entity_name Name of the topic, service, action or type the notification refers to.
+     * @param [in] notification Notification to invoke.
+     * @param [in] offloadable Whether the entity may be offloaded if its callbacks keep exceeding the budget.
+     */
+    DDSENABLER_PARTICIPANTS_DllAPI
+    void invoke(
+            const char* callback_name,
+            const std::string& entity_name,
+            const NotificationQueue::Notification& notification,
+            bool offloadable);
+
+    //! Whether the notifications of an entity are delivered from the offloading thread
+    DDSENABLER_PARTICIPANTS_DllAPI
+    bool is_offloaded(
+            const std::string& entity_name) const;
+
+    /**
+     * @brief Deliver a notification from the offloading thread if its entity is offloaded.
+     *
+     * Otherwise, the notification is to be delivered from the notification queue, and it is wrapped so the watchdog
+     * knows when it has been delivered.
+     *
+     * @param [in] entity_name Name of the entity the notification refers to.
+     * @param [in,out] notification Notification to deliver, holding a copy of all its arguments. Moved from if the
+     * entity is offloaded, wrapped otherwise.
+     * @param [in] on_drop Function invoked if the notification is dropped because the offloading queue is full.
+     * @return \c true if the notification was offloaded, \c false if it must be delivered from the notification
+     * queue.
+     */
+    DDSENABLER_PARTICIPANTS_DllAPI
+    bool offload(
+            const std::string& entity_name,
+            NotificationQueue::Notification& notification,
+            NotificationQueue::Notification&& on_drop = nullptr);
+
+protected:
+
+    //! Account for a notification delivered from the notification queue, releasing those held if it was the last one
+    void queued_done_(
+            const std::string& entity_name);
+
+    //! Account for an offloaded notification delivered or dropped, restoring its entity if it is fast again
+    void offloaded_done_(
+            const std::string& entity_name);
+
+    //! Queue the held notifications of an entity in the offloading thread (called with \c mtx_ released)
+    void release_held_(
+            const std::string& entity_name);
+
+    const std::chrono::nanoseconds budget_;
+
+    const uint32_t offload_threshold_;
+
+    //! Consecutive budget overruns of the offloadable entities not offloaded yet, indexed by entity name
+    std::unordered_map<std::string, uint32_t> overruns_;
+
+    std::unordered_set<std::string> offloaded_;
+
+    //! Consecutive callbacks within budget of the offloaded entities, indexed by entity name
+    std::unordered_map<std::string, uint32_t> within_budget_;
+
+    //! Notifications of the offloaded entities held or pending in the offloading thread, indexed by entity name
+    std::unordered_map<std::string, std::size_t> offloaded_pending_;
+
+    //! Notifications of the offloadable entities pending in the notification queue, indexed by entity name
+    std::unordered_map<std::string, std::size_t> queued_;
+
+    //! Notifications (and their drop functions) of the offloaded entities held until the notification queue has
+    //! delivered the previous ones, indexed by entity name. Present while releasing them, even if empty.
+    std::unordered_map<std::string,
+            std::deque<std::pair<NotificationQueue::Notification, NotificationQueue::Notification>>> held_;
+
+    SlowCallbackNotification slow_callback_notification_callback_{nullptr};
+
+    //! Mutex guarding the budget counters, the offloaded entities and their pending notifications
+    mutable std::mutex mtx_;
+
+    //! Single-class dispatcher running the offloaded notifications, if offloading is enabled (declared last, so it
+    //! is stopped first)
+    std::unique_ptr<PriorityDispatcher> offload_dispatcher_;
+};
+
+} /* namespace participants */
+} /* namespace ddsenabler */
+} /* namespace eprosima */
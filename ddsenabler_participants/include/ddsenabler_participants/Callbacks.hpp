@@ -21,6 +21,8 @@
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include <ddsenabler_participants/rpc/RpcTypes.hpp>
 
@@ -78,6 +80,9 @@ typedef void (* DdsLogFunc)(
  * @param [in] serialized_type_internal Serialized type in internal format
  * @param [in] serialized_type_internal_size Size of the serialized type in internal format
  * @param [in] data_placeholder JSON data placeholder
+ *
+ * @note With lazy type notification enabled, only \c type_name is provided: \c serialized_type and
+ * \c data_placeholder are empty and \c serialized_type_internal is null. They can be retrieved on demand.
  */
 typedef void (* DdsTypeNotification)(
         const char* type_name,
@@ -367,6 +372,62 @@ typedef bool (* ActionQuery)(
         const char* action_name,
         ActionInfo& action_info);
 
+/**********************/
+/*     DISCOVERY      */
+/**********************/
+
+/**
+ * @brief Struct that contains the entities discovered during a discovery batch window.
+ *
+ * Each entity is given by its name and the same information provided by its individual discovery notification.
+ */
+struct DiscoveryBatch
+{
+    //! Discovered topics
+    std::vector<std::pair<std::string, TopicInfo>> topics;
+
+    //! Discovered services
+    std::vector<std::pair<std::string, ServiceInfo>> services;
+
+    //! Discovered actions
+    std::vector<std::pair<std::string, ActionInfo>> actions;
+
+    //! Whether the batch contains no entities
+    bool empty() const
+    {
+        return topics.empty() && services.empty() && actions.empty();
+    }
+};
+
+/**
+ * @brief Callback for batched notification of discovered topics, services and actions.
+ *
+ * When a discovery batch window is configured, this callback is used instead of the individual topic, service and
+ * action notification callbacks, delivering all entities discovered during the window in a single call.
+ *
+ * @param [in] batch Entities discovered during the window, in order of discovery.
+ *
+ * @note This callback is invoked from a dedicated thread, without holding any internal lock.
+ */
+typedef void (* DiscoveryBatchNotification)(
+        const DiscoveryBatch& batch);
+
+/**
+ * @brief Callback for notification of a callback exceeding its time budget.
+ *
+ * @param [in] callback_name Name of the slow callback (e.g. "data_notification").
+ * @param [in] entity_name Name of the topic, service, action or type the slow callback was invoked for.
+ * @param [in] duration Time spent in the slow callback, in nanoseconds.
+ * @param [in] offloaded Whether the notifications of the entity are delivered from a dedicated thread.
+ *
+ * @note This callback is invoked right after the slow one, from the same thread.
+ */
+typedef void (* SlowCallbackNotification)(
+        const char* callback_name,
+        const char* entity_name,
+        int64_t duration,
+        bool offloaded);
+
 } /* namespace participants */
 } /* namespace ddsenabler */
 } /* namespace eprosima */
@@ -27,6 +27,7 @@ constexpr const char* QOS_SERIALIZATION_RELIABILITY("reliability");
 constexpr const char* QOS_SERIALIZATION_DURABILITY("durability");
 constexpr const char* QOS_SERIALIZATION_OWNERSHIP("ownership");
 constexpr const char* QOS_SERIALIZATION_KEYED("keyed");
+constexpr const char* QOS_SERIALIZATION_COMPACT_PREFIX("qos1:");
 
 // Topic mangling
 constexpr const char* ROS_TOPIC_PREFIX("rt/");
@@ -0,0 +1,100 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file DiscoverySnapshot.hpp
+ */
+
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <ddsenabler_participants/Callbacks.hpp>
+#include <ddsenabler_participants/library/library_dll.h>
+#include <ddsenabler_participants/rpc/RpcTypes.hpp>
+
+namespace eprosima {
+namespace ddsenabler {
+namespace participants {
+
+//! Version of the discovery snapshot format
+constexpr const unsigned int DISCOVERY_SNAPSHOT_VERSION = 1u;
+
+//! Suffix appended to the path of a discovery snapshot to get the path of the type bundle holding its types
+constexpr const char* DISCOVERY_SNAPSHOT_TYPES_SUFFIX = ".types";
+
+/**
+ * Service announced by the enabler, as recorded in a discovery snapshot.
+ */
+struct SnapshotService
+{
+    std::string name;
+    Protocol protocol {Protocol::ROS2};
+    ServiceInfo info;
+};
+
+/**
+ * Action announced by the enabler, as recorded in a discovery snapshot.
+ */
+struct SnapshotAction
+{
+    std::string name;
+    Protocol protocol {Protocol::ROS2};
+    ActionInfo info;
+};
+
+/**
+ * Discovery state of the enabler, persisted to restore it right away after a restart.
+ *
+ * The snapshot holds the known (non RPC) topics with their type and QoS, and the services and actions announced by
+ * the enabler. It is stored as a JSON file, with QoS in their compact encoding. The types themselves are stored
+ * separately, in a type bundle.
+ */
+struct DiscoverySnapshot
+{
+    //! Known topics, with their type name and serialized QoS
+    std::vector<std::pair<std::string, TopicInfo>> topics;
+
+    //! Services announced by the enabler
+    std::vector<SnapshotService> services;
+
+    //! Actions announced by the enabler
+    std::vector<SnapshotAction> actions;
+
+    /**
+     * @brief Write the snapshot to a file, replacing it atomically.
+     *
+     * @param [in] path Path of the snapshot file.
+     * @return \c true if the snapshot was written, \c false otherwise.
+     */
+    DDSENABLER_PARTICIPANTS_DllAPI
+    bool save(
+            const std::string& path) const;
+
+    /**
+     * @brief Read the snapshot from a file, replacing the current contents.
+     *
+     * @param [in] path Path of the snapshot file.
+     * @return \c true if the snapshot was read, \c false otherwise.
+     */
+    DDSENABLER_PARTICIPANTS_DllAPI
+    bool load(
+            const std::string& path);
+};
+
+} /* namespace participants */
+} /* namespace ddsenabler */
+} /* namespace eprosima */
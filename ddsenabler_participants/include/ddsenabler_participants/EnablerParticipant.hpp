@@ -21,14 +21,23 @@
 #include <condition_variable>
 #include <map>
 #include <mutex>
-
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <ddspipe_core/types/dds/Endpoint.hpp>
+#include <ddspipe_core/types/dds/Guid.hpp>
+#include <ddspipe_core/types/dds/Payload.hpp>
 #include <ddspipe_participants/participant/dynamic_types/SchemaParticipant.hpp>
 #include <ddspipe_participants/reader/auxiliar/InternalReader.hpp>
 
 #include <ddsenabler_participants/Callbacks.hpp>
+#include <ddsenabler_participants/DiscoverySnapshot.hpp>
 #include <ddsenabler_participants/EnablerParticipantConfiguration.hpp>
 #include <ddsenabler_participants/library/library_dll.h>
 #include <ddsenabler_participants/InternalRpcReader.hpp>
+#include <ddsenabler_participants/LockMetrics.hpp>
 #include <ddsenabler_participants/rpc/RpcUtils.hpp>
 #include <ddsenabler_participants/rpc/RpcStructs.hpp>
 
@@ -63,6 +72,92 @@ public:
             const std::string& topic_name,
             const std::string& json);
 
+    /**
+     * @brief Create the writer of a topic with the given type and QoS, without querying the user.
+     *
+     * Succeeds without doing anything if the topic already exists with the same type.
+     *
+     * @param [in] topic_name Name of the topic to declare.
+     * @param [in] topic_info Type name and (optional) serialized QoS of the topic.
+     * @return \c true if the topic is ready to publish in, \c false otherwise.
+     */
+    DDSENABLER_PARTICIPANTS_DllAPI
+    bool declare_topic(
+            const std::string& topic_name,
+            const TopicInfo& topic_info);
+
+    /**
+     * @brief Create the writer of a topic, requesting its type and QoS through the topic query callback.
+     *
+     * Succeeds without doing anything if the topic already exists.
+     *
+     * @param [in] topic_name Name of the topic to declare.
+     * @return \c true if the topic is ready to publish in, \c false otherwise.
+     */
+    DDSENABLER_PARTICIPANTS_DllAPI
+    bool declare_topic(
+            const std::string& topic_name);
+
+    /**
+     * @brief Create the writers of several topics with the given types and QoS in a single batch.
+     *
+     * Topics already existing with the same type are skipped.
+     *
+     * @param [in] topics_info Topic names with their type name and (optional) serialized QoS.
+     * @return \c true if all topics are ready to publish in, \c false otherwise.
+     */
+    DDSENABLER_PARTICIPANTS_DllAPI
+    bool declare_topics(
+            const std::vector<std::pair<std::string, TopicInfo>>& topics_info);
+
+    /**
+     * @brief Loan a payload from the payload pool to be filled in place and published with \c publish_loaned.
+     *
+     * The topic is resolved (and its writer created if needed) before loaning, as done in \c publish.
+     * The returned payload has \c length set to \c size, which may be reduced by the user before publishing.
+     *
+     * @param [in] topic_name Name of the topic the payload will be published in.
+     * @param [in] size Number of bytes to reserve, including the encapsulation header.
+     * @param [out] loan Payload loaned from the payload pool.
+     * @return \c true if the payload was loaned, \c false otherwise.
+     */
+    DDSENABLER_PARTICIPANTS_DllAPI
+    bool loan_payload(
+            const std::string& topic_name,
+            const uint32_t size,
+            ddspipe::core::types::Payload& loan);
+
+    /**
+     * @brief Publish a payload previously obtained with \c loan_payload without copying it.
+     *
+     * The payload must contain CDR serialized data (encapsulation included) of the topic type.
+     * Ownership of the loan is transferred to the pipe, leaving \c loan empty on success.
+     *
+     * @param [in] topic_name Name of the topic to publish in.
+     * @param [in,out] loan Payload to publish.
+     * @return \c true if the payload was published, \c false otherwise.
+     */
+    DDSENABLER_PARTICIPANTS_DllAPI
+    bool publish_loaned(
+            const std::string& topic_name,
+            ddspipe::core::types::Payload& loan);
+
+    /**
+     * @brief Publish CDR serialized data (encapsulation header included) without going through JSON.
+     *
+     * @param [in] topic_name Name of the topic to publish in.
+     * @param [in] cdr Serialized data.
+     * @param [in] size Size of the serialized data in bytes.
+     * @param [in] representation Data representation required by the topic, data is re-encoded if it differs.
+     * @return \c true if the data was published, \c false otherwise.
+     */
+    DDSENABLER_PARTICIPANTS_DllAPI
+    bool publish_cdr(
+            const std::string& topic_name,
+            const uint8_t* cdr,
+            const uint32_t size,
+            fastdds::dds::DataRepresentationId_t representation);
+
     DDSENABLER_PARTICIPANTS_DllAPI
     bool publish_rpc(
             const std::string& topic_name,
@@ -95,6 +190,20 @@ public:
             const std::string& service_name,
             Protocol Protocol);
 
+    /**
+     * @brief Announce a service with the given request and reply types and QoS, without querying the user.
+     *
+     * @param [in] service_name Name of the service to announce.
+     * @param [in] service_info Type names and serialized QoS of the request and reply topics.
+     * @param [in] Protocol RPC protocol of the service.
+     * @return \c true if the service was announced, \c false otherwise.
+     */
+    DDSENABLER_PARTICIPANTS_DllAPI
+    bool announce_service(
+            const std::string& service_name,
+            const ServiceInfo& service_info,
+            Protocol Protocol);
+
     DDSENABLER_PARTICIPANTS_DllAPI
     bool revoke_service(
             const std::string& service_name);
@@ -116,15 +225,53 @@ public:
     Protocol get_service_protocol(
             const std::string& service_name);
 
+    /**
+     * @brief Check whether a service is currently announced by the enabler as server.
+     *
+     * @param [in] service_name Name of the service.
+     * @param [in] Protocol RPC protocol the service is expected to be announced with.
+     * @return \c true if the service is announced with the given protocol and its request endpoint still exists.
+     */
+    DDSENABLER_PARTICIPANTS_DllAPI
+    bool is_service_announced(
+            const std::string& service_name,
+            Protocol Protocol);
+
     DDSENABLER_PARTICIPANTS_DllAPI
     bool announce_action(
             const std::string& action_name,
             Protocol Protocol);
 
+    /**
+     * @brief Announce an action with the given types and QoS, without querying the user.
+     *
+     * @param [in] action_name Name of the action to announce.
+     * @param [in] action_info Type names and serialized QoS of the action services and topics.
+     * @param [in] Protocol RPC protocol of the action.
+     * @return \c true if the action was announced, \c false otherwise.
+     */
+    DDSENABLER_PARTICIPANTS_DllAPI
+    bool announce_action(
+            const std::string& action_name,
+            const ActionInfo& action_info,
+            Protocol Protocol);
+
     DDSENABLER_PARTICIPANTS_DllAPI
     bool revoke_action(
             const std::string& action_name);
 
+    /**
+     * @brief Check whether an action is currently announced by the enabler as server.
+     *
+     * @param [in] action_name Name of the action.
+     * @param [in] Protocol RPC protocol the action is expected to be announced with.
+     * @return \c true if the action and its three services are announced with the given protocol.
+     */
+    DDSENABLER_PARTICIPANTS_DllAPI
+    bool is_action_announced(
+            const std::string& action_name,
+            Protocol Protocol);
+
     DDSENABLER_PARTICIPANTS_DllAPI
     bool send_action_goal(
             const std::string& action_name,
@@ -182,12 +329,59 @@ public:
             const UUID& goal_id,
             const StatusCode& status_code);
 
+    /**
+     * @brief Get the current discovery state: known (non RPC) topics, and services and actions announced by the
+     * enabler, along with their types and QoS.
+     *
+     * @param [out] snapshot Discovery state.
+     */
+    DDSENABLER_PARTICIPANTS_DllAPI
+    void get_discovery_snapshot(
+            DiscoverySnapshot& snapshot);
+
 protected:
 
+    std::shared_ptr<ddspipe::participants::InternalReader> get_topic_reader_nts_(
+            const std::string& topic_name,
+            std::string& type_name,
+            std::unique_lock<MeteredMutex<std::mutex>>& lck);
+
+    bool declare_topic_nts_(
+            const ddspipe::core::types::DdsTopic& topic,
+            std::unique_lock<MeteredMutex<std::mutex>>& lck);
+
     bool query_topic_nts_(
             const std::string& topic_name,
             ddspipe::core::types::DdsTopic& topic);
 
+    /**
+     * @brief Announce a service, with the given types or requesting them through the service query callback.
+     *
+     * @param [in] service_name Name of the service to announce.
+     * @param [in] service_info Types and QoS of the service (queried if \c nullptr).
+     * @param [in] Protocol RPC protocol of the service.
+     * @param [in] lck Lock on \c mtx_, released while waiting.
+     */
+    bool announce_service_nts_(
+            const std::string& service_name,
+            const ServiceInfo* service_info,
+            Protocol Protocol,
+            std::unique_lock<MeteredMutex<std::mutex>>& lck);
+
+    /**
+     * @brief Announce an action, with the given types or requesting them through the action query callback.
+     *
+     * @param [in] action_name Name of the action to announce.
+     * @param [in] action_info Types and QoS of the action (queried if \c nullptr).
+     * @param [in] Protocol RPC protocol of the action.
+     * @param [in] lck Lock on \c mtx_, released while waiting.
+     */
+    bool announce_action_nts_(
+            const std::string& action_name,
+            const ActionInfo* action_info,
+            Protocol Protocol,
+            std::unique_lock<MeteredMutex<std::mutex>>& lck);
+
     bool query_service_nts_(
             std::shared_ptr<ServiceDiscovered> service,
             Protocol Protocol);
@@ -195,23 +389,45 @@ protected:
     bool query_action_nts_(
             ActionDiscovered& action,
             Protocol Protocol,
-            std::unique_lock<std::mutex>& lck);
+            std::unique_lock<MeteredMutex<std::mutex>>& lck);
+
+    //! Create the services and topics of an action with the given types, announcing it as server
+    bool create_action_nts_(
+            ActionDiscovered& action,
+            const ActionInfo& action_info,
+            Protocol Protocol,
+            std::unique_lock<MeteredMutex<std::mutex>>& lck);
 
     bool create_topic_writer_nts_(
             const ddspipe::core::types::DdsTopic& topic,
             std::shared_ptr<eprosima::ddspipe::core::IReader>& reader,
-            std::unique_lock<std::mutex>& lck);
+            std::unique_lock<MeteredMutex<std::mutex>>& lck);
 
     bool create_topic_writer_nts_(
             const ddspipe::core::types::DdsTopic& topic,
             std::shared_ptr<eprosima::ddspipe::core::IReader>& reader,
             ddspipe::core::types::Endpoint& request_edp,
-            std::unique_lock<std::mutex>& lck);
-
+            std::unique_lock<MeteredMutex<std::mutex>>& lck);
+
+    /**
+     * @brief Create the writers of several topics in a single batch.
+     *
+     * All simulated endpoints are added to the discovery database before waiting, and then their internal readers
+     * are awaited together.
+     *
+     * @param [in] topics Topics to create writers for.
+     * @param [out] request_edps Simulated endpoints, in the same order as \c topics.
+     * @param [in] lck Lock on \c mtx_, released while waiting.
+     * @return \c true if all readers were created, \c false otherwise.
+     */
+    bool create_topic_writers_nts_(
+            const std::vector<ddspipe::core::types::DdsTopic>& topics,
+            std::vector<ddspipe::core::types::Endpoint>& request_edps,
+            std::unique_lock<MeteredMutex<std::mutex>>& lck);
 
     bool create_service_request_writer_nts_(
             std::shared_ptr<ServiceDiscovered> service,
-            std::unique_lock<std::mutex>& lck);
+            std::unique_lock<MeteredMutex<std::mutex>>& lck);
 
     bool fill_topic_struct_nts_(
             const std::string& topic_name,
@@ -241,15 +457,47 @@ protected:
     bool revoke_service_nts_(
             const std::string& service_name);
 
+    bool is_service_announced_nts_(
+            const std::string& service_name,
+            Protocol Protocol) const;
+
+    /**
+     * @brief Keep track of the live endpoints of each topic, as reported by the discovery database.
+     *
+     * @param [in] endpoint Endpoint discovered, updated or erased.
+     * @param [in] erased Whether the endpoint has been erased from the discovery database.
+     */
+    void on_endpoint_changed_(
+            const ddspipe::core::types::Endpoint& endpoint,
+            bool erased);
+
+    /**
+     * @brief Reference the type of a topic in the handler while the topic has a reader and live endpoints, and
+     * release it once its last endpoint is gone, so it can be evicted from the schema cache.
+     *
+     * @param [in] topic_name Name of the topic.
+     * @param [in] type_name Name of the topic type.
+     */
+    void update_type_reference_nts_(
+            const std::string& topic_name,
+            const std::string& type_name);
+
     std::map<ddspipe::core::types::DdsTopic, std::shared_ptr<ddspipe::participants::InternalReader>> readers_;
 
+    //! Live endpoints of each topic, identified by its name and type name
+    std::map<std::pair<std::string, std::string>, std::set<ddspipe::core::types::Guid>> topic_endpoints_;
+
+    //! Topics (name and type name) whose type is referenced in the handler
+    std::set<std::pair<std::string, std::string>> referenced_topics_;
+
     std::map<std::string, std::shared_ptr<ServiceDiscovered>> services_;
 
     std::map<std::string, std::shared_ptr<ActionDiscovered>> actions_;
 
-    std::mutex mtx_;
+    //! Metered when built with lock metrics (hence a condition variable usable with any lock)
+    MeteredMutex<std::mutex> mtx_ {"enabler_participant"};
 
-    std::condition_variable cv_;
+    std::condition_variable_any cv_;
 
     DdsTopicQuery topic_query_callback_;
 
@@ -14,14 +14,40 @@
 
 #pragma once
 
+#include <string>
+#include <vector>
+
 #include <ddspipe_participants/configuration/ParticipantConfiguration.hpp>
 
 #include <ddsenabler_participants/library/library_dll.h>
+#include <ddsenabler_participants/rpc/RpcTypes.hpp>
 
 namespace eprosima {
 namespace ddsenabler {
 namespace participants {
 
+//! Default maximum number of entities created concurrently during the startup warm-up
+constexpr const unsigned int DEFAULT_WARM_UP_MAX_CONCURRENCY = 4u;
+
+/**
+ * Topic to be created during the DDS Enabler startup.
+ * If no type name is given, type and QoS are requested through the topic query callback.
+ */
+struct WarmUpTopic
+{
+    std::string name;
+    std::string type_name;
+};
+
+/**
+ * Service or action to be announced during the DDS Enabler startup.
+ */
+struct WarmUpRpc
+{
+    std::string name;
+    Protocol protocol {Protocol::ROS2};
+};
+
 /**
  * This data struct represents a configuration for a EnablerParticipant
  */
@@ -41,6 +67,24 @@ public:
     /////////////////////////
 
     unsigned int initial_publish_wait {0u};
+
+    //! Topics created eagerly at startup
+    std::vector<WarmUpTopic> warm_up_topics;
+
+    //! Services announced eagerly at startup
+    std::vector<WarmUpRpc> warm_up_services;
+
+    //! Actions announced eagerly at startup
+    std::vector<WarmUpRpc> warm_up_actions;
+
+    //! Maximum number of topics, services and actions created concurrently at startup
+    unsigned int warm_up_max_concurrency {DEFAULT_WARM_UP_MAX_CONCURRENCY};
+
+    //! Path of the discovery snapshot restored at startup and written periodically (disabled if empty)
+    std::string discovery_snapshot_path;
+
+    //! Period (in milliseconds) at which the discovery snapshot is written (only on destruction if 0)
+    unsigned int discovery_snapshot_period {0u};
 };
 
 } /* namespace participants */
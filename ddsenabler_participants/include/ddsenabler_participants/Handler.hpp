@@ -18,12 +18,23 @@
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstdint>
+#include <functional>
+#include <list>
 #include <memory>
 #include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
+#include <vector>
+
+#include <fastdds/dds/core/policy/QosPolicies.hpp>
 
 #include <ddspipe_core/efficiency/payload/PayloadPool.hpp>
 #include <ddspipe_core/types/data/RtpsPayloadData.hpp>
@@ -33,29 +44,23 @@
 
 #include <ddspipe_participants/participant/dynamic_types/ISchemaHandler.hpp>
 
+#include <ddsenabler_participants/CallbackWatchdog.hpp>
 #include <ddsenabler_participants/Callbacks.hpp>
 #include <ddsenabler_participants/HandlerConfiguration.hpp>
+#include <ddsenabler_participants/LockMetrics.hpp>
 #include <ddsenabler_participants/Message.hpp>
+#include <ddsenabler_participants/MetricsRegistry.hpp>
+#include <ddsenabler_participants/NotificationQueue.hpp>
+#include <ddsenabler_participants/PriorityDispatcher.hpp>
+#include <ddsenabler_participants/Tracer.hpp>
+#include <ddsenabler_participants/TypeInterner.hpp>
+#include <ddsenabler_participants/TypeStore.hpp>
 #include <ddsenabler_participants/Writer.hpp>
 #include <ddsenabler_participants/rpc/RpcUtils.hpp>
 #include <ddsenabler_participants/rpc/RpcStructs.hpp>
 #include <ddsenabler_participants/library/library_dll.h>
 
 namespace std {
-template<>
-struct hash<eprosima::fastdds::dds::xtypes::TypeIdentifier>
-{
-    std::size_t operator ()(
-            const eprosima::fastdds::dds::xtypes::TypeIdentifier& k) const
-    {
-        // The collection only has direct hash TypeIdentifiers so the EquivalenceHash can be used.
-        return (static_cast<size_t>(k.equivalence_hash()[0]) << 16) |
-               (static_cast<size_t>(k.equivalence_hash()[1]) << 8) |
-               (static_cast<size_t>(k.equivalence_hash()[2]));
-    }
-
-};
-
 template<>
 struct hash<eprosima::ddsenabler::participants::UUID>
 {
@@ -80,6 +85,41 @@ namespace participants {
 
 class Writer;
 
+/**
+ * Occupancy of the schema cache.
+ */
+struct SchemaCacheStats
+{
+    //! Number of known types, whether their DynamicType is materialized or not
+    std::size_t known_types {0};
+
+    //! Number of types whose DynamicType is materialized
+    std::size_t cached_types {0};
+
+    //! Number of types referenced by live topics, never evicted
+    std::size_t pinned_types {0};
+
+    //! Number of pubsub types kept to deserialize received samples
+    std::size_t pubsub_types {0};
+
+    //! Estimated memory used by the materialized types and their cached descriptions
+    std::size_t estimated_bytes {0};
+
+    //! Number of evictions since startup
+    std::size_t evictions {0};
+};
+
+/**
+ * TypedDataCallback - type-erased callback used by typed subscriptions, which deserializes the payload of a received
+ * sample into its compiled type and forwards it to the user.
+ *
+ * @param [in] payload Serialized payload of the received sample
+ * @param [in] publish_time Time (ns) when the sample was published
+ */
+using TypedDataCallback = std::function<void (
+                    ddspipe::core::types::Payload& payload,
+                    int64_t publish_time)>;
+
 /**
  * Class that manages the interaction between \c EnablerParticipant and the user's app.
  * Payloads are efficiently passed from DDS Pipe to the user's app without copying data (only references).
@@ -171,6 +211,169 @@ public:
             const std::string& type_name,
             fastdds::dds::xtypes::TypeIdentifier& type_identifier);
 
+    /**
+     * @brief Preload the type collections stored in a directory, one \c .bin file per type containing the
+     * serialized collection provided by the type notification callback.
+     *
+     * Collections are decoded and their DynamicTypes built in parallel. Preloaded types are not notified.
+     *
+     * @param [in] directory Directory containing the type collections.
+     * @param [in] n_threads Number of threads to use (hardware concurrency if 0).
+     * @return Number of types preloaded.
+     */
+    DDSENABLER_PARTICIPANTS_DllAPI
+    std::size_t preload_types(
+            const std::string& directory,
+            unsigned int n_threads = 0);
+
+    /**
+     * @brief Load a type bundle generated by \c ddsenabler_type_bundler.
+     *
+     * Every bundled type is registered and added to the known schemas along with its precomputed IDL and data
+     * placeholder, so later schema lookups are served from cache. Bundled types are not notified.
+     *
+     * @param [in] path Path of the type bundle.
+     * @param [in] n_threads Number of threads to use when building the DynamicTypes (hardware concurrency if 0).
+     * @return Number of types loaded.
+     */
+    DDSENABLER_PARTICIPANTS_DllAPI
+    std::size_t load_type_bundle(
+            const std::string& path,
+            unsigned int n_threads = 0);
+
+    /**
+     * @brief Store every known type in a type bundle, along with its IDL and data placeholder if already generated.
+     *
+     * Types already present in the bundle are kept, so the bundle can be refreshed incrementally. The bundle remains
+     * open until a bundle with another path is saved, so periodic saves do not index the file every time.
+     *
+     * @param [in] path Path of the type bundle, created if it does not exist.
+     * @return Number of known types present in the bundle.
+     */
+    DDSENABLER_PARTICIPANTS_DllAPI
+    std::size_t save_type_bundle(
+            const std::string& path);
+
+    /**
+     * @brief Get the IDL representation of a known type, generating and caching it on first request.
+     *
+     * @param [in] type_name Name of the type.
+     * @param [out] idl IDL representation of the type.
+     * @return \c true if the IDL was retrieved, \c false otherwise.
+     */
+    DDSENABLER_PARTICIPANTS_DllAPI
+    bool get_type_idl(
+            const std::string& type_name,
+            std::string& idl);
+
+    /**
+     * @brief Get the serialized collection (type and dependencies) of a known type, generating and caching it on
+     * first request.
+     *
+     * @param [in] type_name Name of the type.
+     * @param [out] collection Serialized type collection, as provided to the type notification callback.
+     * @return \c true if the collection was retrieved, \c false otherwise.
+     */
+    DDSENABLER_PARTICIPANTS_DllAPI
+    bool get_type_collection(
+            const std::string& type_name,
+            std::vector<unsigned char>& collection);
+
+    /**
+     * @brief Get the JSON data placeholder of a known type, generating and caching it on first request.
+     *
+     * @param [in] type_name Name of the type.
+     * @param [out] placeholder JSON data placeholder of the type.
+     * @return \c true if the placeholder was retrieved, \c false otherwise.
+     */
+    DDSENABLER_PARTICIPANTS_DllAPI
+    bool get_type_placeholder(
+            const std::string& type_name,
+            std::string& placeholder);
+
+    /**
+     * @brief Mark a type as referenced by a live topic, so it is never evicted from the schema cache.
+     *
+     * @param [in] type_name Name of the type.
+     */
+    DDSENABLER_PARTICIPANTS_DllAPI
+    void reference_type(
+            const std::string& type_name);
+
+    /**
+     * @brief Release a reference previously taken with \c reference_type, making the type evictable once it is no
+     * longer referenced by any live topic.
+     *
+     * @param [in] type_name Name of the type.
+     */
+    DDSENABLER_PARTICIPANTS_DllAPI
+    void release_type(
+            const std::string& type_name);
+
+    //! Get the occupancy of the schema cache
+    DDSENABLER_PARTICIPANTS_DllAPI
+    SchemaCacheStats get_schema_cache_stats();
+
+    /**
+     * @brief Notify right away the entities discovered in the current discovery batch window, if any.
+     *
+     * @note Only relevant when a discovery batch window is configured. Callbacks are invoked from the calling thread,
+     * unless another one is delivering notifications at the time.
+     */
+    DDSENABLER_PARTICIPANTS_DllAPI
+    void flush_discovery_batch();
+
+    /**
+     * @brief Get the state of the priority classes: queued, delivered and dropped samples, and delivery latency.
+     *
+     * @return The state of every priority class, empty if none is configured.
+     */
+    DDSENABLER_PARTICIPANTS_DllAPI
+    std::vector<PriorityClassStats> get_priority_class_stats() const;
+
+    /**
+     * @brief Get the metrics of the topic, service or action a DDS topic belongs to.
+     *
+     * @param [in] topic_name Name of the DDS topic.
+     * @return Metrics of the entity, valid for the lifetime of the handler.
+     */
+    DDSENABLER_PARTICIPANTS_DllAPI
+    EntityMetrics& entity_metrics(
+            const std::string& topic_name);
+
+    /**
+     * @brief Get the metrics of every topic, service and action: samples received, converted, delivered, filtered,
+     * dropped and published, bytes in and out, conversion and callback times, and end-to-end latency. The state of
+     * the priority classes and the number of pending notifications are included too.
+     *
+     * @return Metrics of every entity with any activity.
+     * @note The internal locks are not taken.
+     */
+    DDSENABLER_PARTICIPANTS_DllAPI
+    MetricsReport get_metrics() const;
+
+    /**
+     * @brief Get the tracer of the samples.
+     *
+     * @return Tracer, or \c nullptr if tracing is disabled.
+     */
+    Tracer* tracer() const noexcept
+    {
+        return tracer_.get();
+    }
+
+    /**
+     * @brief Get the queue where notifications to the user's app are deferred to.
+     *
+     * @note Callers holding their own locks while calling the handler should open a \c NotificationScope on it before
+     * taking them, so callbacks are not invoked until those are released too.
+     */
+    DDSENABLER_PARTICIPANTS_DllAPI
+    NotificationQueue& notification_queue()
+    {
+        return notifications_;
+    }
+
     /**
      * @brief Get the serialized data (payload) associated to the given type name from a JSON string.
      *
@@ -185,6 +388,55 @@ public:
             const std::string& json,
             ddspipe::core::types::Payload& payload);
 
+    /**
+     * @brief Get the serialized data (payload) associated to the given type name from CDR serialized data.
+     *
+     * The encapsulation header of \c cdr is validated against the extensibility of the registered type.
+     * The data is copied as is into the payload when already encoded with \c representation, and re-encoded
+     * otherwise (e.g. XCDR2 data published in a topic requiring XCDR1).
+     *
+     * @param [in] type_name Name of the type of the serialized data.
+     * @param [in] cdr Serialized data, including the encapsulation header.
+     * @param [in] size Size of the serialized data in bytes.
+     * @param [in] representation Data representation the payload must be encoded with.
+     * @param [out] payload Payload reference where the serialized data will be stored.
+     * @return \c true if the data was successfully stored, \c false otherwise.
+     */
+    DDSENABLER_PARTICIPANTS_DllAPI
+    bool get_serialized_data(
+            const std::string& type_name,
+            const uint8_t* cdr,
+            const uint32_t size,
+            fastdds::dds::DataRepresentationId_t representation,
+            ddspipe::core::types::Payload& payload);
+
+    /**
+     * @brief Subscribe to a topic with a compiled type, bypassing the JSON conversion for its samples.
+     *
+     * Samples received in \c topic_name are no longer notified through the data notification callback, but
+     * handed to \c callback still serialized.
+     *
+     * @param [in] topic_name Name of the topic to subscribe to.
+     * @param [in] type_name Name of the compiled type, which must match the topic type.
+     * @param [in] callback Callback deserializing and delivering the samples.
+     * @return \c true if the subscription was added, \c false if the topic already had a typed subscription.
+     */
+    DDSENABLER_PARTICIPANTS_DllAPI
+    bool add_typed_subscription(
+            const std::string& topic_name,
+            const std::string& type_name,
+            TypedDataCallback callback);
+
+    /**
+     * @brief Remove the typed subscription of a topic, restoring the JSON data notifications.
+     *
+     * @param [in] topic_name Name of the topic to unsubscribe from.
+     * @return \c true if the subscription was removed, \c false if it did not exist.
+     */
+    DDSENABLER_PARTICIPANTS_DllAPI
+    bool remove_typed_subscription(
+            const std::string& topic_name);
+
     /**
      * @brief Store an action request (goal, cancel or result) with its associated UUID and request ID.
      * This info will later be used to associate the reply id with the UUID of the action.
@@ -390,6 +642,25 @@ public:
     void set_action_cancel_request_notification_callback(
             participants::ActionCancelRequestNotification callback);
 
+    /**
+     * @brief Set the discovery batch notification callback.
+     *
+     * @param [in] callback Callback to be set.
+     */
+    DDSENABLER_PARTICIPANTS_DllAPI
+    void set_discovery_batch_notification_callback(
+            participants::DiscoveryBatchNotification callback);
+
+    /**
+     * @brief Set the callback to notify the callbacks exceeding their time budget.
+     *
+     * @param [in] callback Callback to notify slow callbacks.
+     * @note Only used when a callback budget is configured.
+     */
+    DDSENABLER_PARTICIPANTS_DllAPI
+    void set_slow_callback_notification_callback(
+            participants::SlowCallbackNotification callback);
+
     /**
      * @brief Set the action send goal reply callback.
      *
@@ -467,6 +738,116 @@ protected:
             const fastdds::dds::xtypes::TypeObject& type_obj,
             bool write_schema = true);
 
+    /**
+     * @brief Get the DynamicType and TypeIdentifier of a known type.
+     *
+     * @param [in] type_name Name of the type.
+     * @param [out] dyn_type DynamicType of the type.
+     * @param [out] type_id TypeIdentifier of the type.
+     * @return \c true if the type is known, \c false otherwise.
+     */
+    bool get_schema_(
+            const std::string& type_name,
+            fastdds::dds::DynamicType::_ref_type& dyn_type,
+            fastdds::dds::xtypes::TypeIdentifier& type_id);
+
+    /**
+     * @brief Get the DynamicType of a known type, rebuilding it from the type object registry if it was evicted,
+     * and mark it as the most recently used.
+     *
+     * @param [in] type_name Name of the type.
+     * @return DynamicType of the type, \c nullptr if unknown or it could not be rebuilt.
+     */
+    fastdds::dds::DynamicType::_ref_type get_dynamic_type_nts_(
+            const std::string& type_name);
+
+    /**
+     * @brief Get the DynamicType of a known type from its dense identifier.
+     *
+     * @param [in] id Dense identifier of the type.
+     * @return DynamicType of the type, \c nullptr if it could not be rebuilt.
+     */
+    fastdds::dds::DynamicType::_ref_type get_dynamic_type_nts_(
+            TypeInterner::TypeId id);
+
+    /**
+     * @brief Mark a materialized type as the most recently used, evicting the least recently used ones if the
+     * cache bounds are exceeded.
+     *
+     * @param [in] id Dense identifier of the type.
+     */
+    void touch_schema_nts_(
+            TypeInterner::TypeId id);
+
+    //! Evict least recently used types not referenced by live topics until the cache bounds are met
+    void evict_schemas_nts_();
+
+    //! Wake up every time an entity is discovered, notifying the discovery batch once its window is over
+    void discovery_batch_routine_();
+
+    //! Start the discovery batch window if no entity is pending (or extend it), waking up the batching thread
+    void schedule_discovery_batch_nts_();
+
+    /**
+     * @brief Whether the discovery of the entity a sample belongs to is still waiting in the discovery batch.
+     *
+     * @param [in] topic Topic the sample was received in.
+     * @param [in] rpc_info RPC information of the topic.
+     * @return \c true if the batch has to be flushed before notifying the sample, \c false otherwise.
+     */
+    bool is_discovery_pending_(
+            const DdsTopic& topic,
+            const RpcInfo& rpc_info);
+
+    /**
+     * @brief Get the priority class of the samples of a topic.
+     *
+     * @param [in] topic_name Name of the topic.
+     * @param [out] priority_class Index of the priority class.
+     * @return \c false if the samples of the topic are not queued (RPC topics), \c true otherwise.
+     */
+    bool get_priority_class_(
+            const std::string& topic_name,
+            std::size_t& priority_class);
+
+    /**
+     * @brief Fill a message with a received sample, referencing its payload.
+     *
+     * @param [in] topic DDS topic associated to the sample.
+     * @param [in] data Received sample.
+     * @param [out] msg Message to fill.
+     */
+    void fill_message_(
+            const ddspipe::core::types::DdsTopic& topic,
+            const ddspipe::core::types::RtpsPayloadData& data,
+            Message& msg);
+
+    /**
+     * @brief Get the metrics of the topic, service or action a DDS topic belongs to.
+     *
+     * @param [in] rpc_info RPC information of the DDS topic.
+     */
+    EntityMetrics& entity_metrics_(
+            const RpcInfo& rpc_info);
+
+    /**
+     * @brief Deliver a sample of a (non RPC) topic queued by priority class.
+     *
+     * @param [in] msg Message holding the sample.
+     */
+    void deliver_queued_sample_(
+            Message& msg);
+
+    /**
+     * @brief Queue the notification of a sample of a topic with a typed subscription.
+     *
+     * @param [in] msg Message holding the sample, with its metrics set.
+     * @param [in] callback Typed callback of the subscription.
+     */
+    void push_typed_notification_nts_(
+            const Message& msg,
+            const TypedDataCallback& callback);
+
     /**
      * @brief Write the schema to user's app.
      *
@@ -634,22 +1015,143 @@ protected:
     //! Payload pool
     std::shared_ptr<ddspipe::core::PayloadPool> payload_pool_;
 
+    //! Metrics of every topic, service and action (declared before the notifications and queues referencing them)
+    MetricsRegistry metrics_;
+
+    //! Tracer of a sampling of the samples (only created when tracing is enabled; declared before the notifications
+    //! recording spans in it)
+    std::unique_ptr<Tracer> tracer_;
+
+    //! Watchdog timing the callbacks to the user's app (only created when a callback budget is configured)
+    std::unique_ptr<CallbackWatchdog> callback_watchdog_;
+
+    //! Notifications to the user's app, delivered once \c mtx_ is released
+    NotificationQueue notifications_;
+
     //! writer
     std::unique_ptr<Writer> writer_;
 
-    //! Schemas map
-    std::map<std::string,
-            std::pair<fastdds::dds::xtypes::TypeIdentifier, fastdds::dds::DynamicType::_ref_type>> schemas_;
+    //! Persistent type store (if enabled)
+    std::unique_ptr<TypeStore> type_store_;
+
+    //! Type bundle of the last \c save_type_bundle call, kept open so later saves only append new types
+    std::unique_ptr<TypeStore> bundle_store_;
+
+    //! Path of \c bundle_store_
+    std::string bundle_store_path_;
+
+    //! Mutex serializing the saves of type bundles
+    std::mutex bundle_store_mtx_;
+
+    //! Dense identifiers of the known types
+    TypeInterner type_interner_;
+
+    //! Schema information generated on demand
+    struct SchemaDescription
+    {
+        std::optional<std::string> idl;
+        std::optional<std::vector<unsigned char>> collection;
+        std::optional<std::string> placeholder;
+    };
+
+    //! Known type
+    struct Schema
+    {
+        //! TypeIdentifier of the type
+        fastdds::dds::xtypes::TypeIdentifier type_id;
+
+        //! DynamicType of the type (\c nullptr if evicted from the schema cache)
+        fastdds::dds::DynamicType::_ref_type dyn_type;
+
+        //! Cached schema information
+        SchemaDescription description;
+
+        //! Whether the type is in \c schemas_lru_
+        bool cached {false};
+
+        //! Position in \c schemas_lru_ (only valid if \c cached)
+        std::list<TypeInterner::TypeId>::iterator lru_it;
+
+        //! Estimated memory used by \c dyn_type (only valid if \c cached)
+        std::size_t estimated_bytes {0};
+    };
+
+    //! Known schemas, indexed by dense type identifier
+    std::vector<Schema> schemas_;
+
+    //! Dense identifiers of the types whose DynamicType is materialized, most recently used first
+    std::list<TypeInterner::TypeId> schemas_lru_;
+
+    //! Estimated memory used by the materialized types
+    std::size_t schemas_bytes_{0};
+
+    //! Number of schema evictions
+    std::size_t schema_evictions_{0};
+
+    //! Number of live topics referencing each type
+    std::unordered_map<std::string, std::size_t> live_types_;
+
+    //! Entities discovered and not yet notified
+    struct PendingDiscovery
+    {
+        std::vector<ddspipe::core::types::DdsTopic> topics;
+        std::vector<ddspipe::core::types::RpcTopic> services;
+        std::vector<RpcAction> actions;
+
+        bool empty() const
+        {
+            return topics.empty() && services.empty() && actions.empty();
+        }
+    };
+
+    //! Entities discovered in the current discovery batch window
+    PendingDiscovery pending_discovery_;
+
+    //! Time at which the first entity of the current discovery batch window was discovered
+    std::chrono::steady_clock::time_point discovery_batch_start_;
+
+    //! Time at which the last entity of the current discovery batch window was discovered
+    std::chrono::steady_clock::time_point discovery_batch_last_;
+
+    //! Whether the discovery batch has entities, checked without locking on every received sample
+    std::atomic<bool> discovery_pending_{false};
+
+    //! Whether the discovery batching thread must stop
+    bool stop_discovery_batching_{false};
+
+    //! Mutex guarding the pending discovery batch, never held while invoking callbacks
+    std::mutex discovery_mtx_;
+
+    //! Mutex serializing batch deliveries so batches are notified in order
+    std::mutex discovery_delivery_mtx_;
+
+    //! Condition variable to wake up the discovery batching thread
+    std::condition_variable discovery_cv_;
+
+    //! Thread notifying discovery batches (only running when a discovery batch window is configured)
+    std::thread discovery_thread_;
+
+    //! Dispatcher of the samples queued by priority class (only created when priority classes are configured)
+    std::unique_ptr<PriorityDispatcher> priority_dispatcher_;
+
+    //! Priority class of the topics whose samples have been received, indexed by topic name
+    std::unordered_map<std::string, std::size_t> priority_classes_;
+
+    //! Mutex guarding \c priority_classes_
+    std::mutex priority_mtx_;
 
     //! Unique sequence number assigned to received messages. It is incremented with every sample added
     unsigned int unique_sequence_number_{0};
 
-    //! Mutex synchronizing access to object's data structures
-    std::recursive_mutex mtx_;
+    //! Mutex synchronizing access to object's data structures (metered when built with lock metrics)
+    MeteredMutex<std::recursive_mutex> mtx_ {"handler"};
 
     //! Callback to request types from the user
     DdsTypeQuery type_query_callback_;
 
+    //! Typed subscriptions (type name and callback) indexed by topic name
+    std::unordered_map<std::string, std::pair<std::string, TypedDataCallback>> typed_subscriptions_;
+
     //! Identifier for the received and sent requests
     uint64_t requests_id_{0};
 
@@ -18,14 +18,52 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
 #include <vector>
 
+#include <ddsenabler_participants/Tracer.hpp>
+
 namespace eprosima {
 namespace ddsenabler {
 namespace participants {
 
+//! Default maximum number of samples waiting in the queue of a priority class
+constexpr const std::size_t DEFAULT_PRIORITY_QUEUE_SIZE = 1000;
+
+//! Name of the priority class of the topics not assigned to any configured class
+constexpr const char* DEFAULT_PRIORITY_CLASS_NAME = "default";
+
+/**
+ * Policy used to choose the priority class whose next sample is delivered.
+ */
+enum class PriorityScheduling
+{
+    //! Always deliver from the highest priority class with pending samples
+    STRICT,
+
+    //! Deliver from every class with pending samples, up to its weight in samples per round
+    WEIGHTED
+};
+
+/**
+ * Priority class of the samples of a set of topics.
+ */
+struct PriorityClass
+{
+    std::string name;
+
+    //! Topic name patterns (wildcards allowed) of the topics in the class
+    std::vector<std::string> topics;
+
+    //! Samples delivered per round with weighted scheduling
+    unsigned int weight {1};
+
+    //! Maximum number of samples waiting to be delivered, the oldest being dropped when exceeded
+    std::size_t queue_size {DEFAULT_PRIORITY_QUEUE_SIZE};
+};
+
 /**
  * Structure encapsulating all of \c Handler configuration options.
  */
@@ -35,6 +73,50 @@ struct HandlerConfiguration
     {
     }
 
+    //! Notify only the name of discovered types, generating their IDL, collection and placeholder on demand
+    bool lazy_type_notification {false};
+
+    //! Reference (by hash) the dependencies delivered in previous type collections instead of including them again
+    bool incremental_type_collections {false};
+
+    //! Notify QoS with the compact encoding instead of YAML
+    bool compact_qos {false};
+
+    //! Path of the persistent type store (disabled if empty)
+    std::string type_store_path;
+
+    //! Directory with the type collections (one .bin file per type) to preload at startup (disabled if empty)
+    std::string preload_types_path;
+
+    //! Path of the type bundle, generated by ddsenabler_type_bundler, to load at startup (disabled if empty)
+    std::string type_bundle_path;
+
+    //! Maximum number of types whose DynamicType is kept in memory (unbounded if 0)
+    std::size_t schema_cache_max_types {0};
+
+    //! Maximum estimated memory used by the types kept in memory (unbounded if 0)
+    std::size_t schema_cache_max_bytes {0};
+
+    //! Time window (in milliseconds) during which discovered entities are accumulated and notified in a single batch
+    //! (disabled if 0)
+    uint32_t discovery_batch_window_ms {0};
+
+    //! Priority classes of the topic samples, from highest to lowest priority (delivered in reception order if empty)
+    std::vector<PriorityClass> priority_classes;
+
+    //! Scheduling policy among priority classes
+    PriorityScheduling priority_scheduling {PriorityScheduling::STRICT};
+
+    //! Time budget (in milliseconds) of the callbacks to the user's app, those exceeding it being reported
+    //! (disabled if 0)
+    uint32_t callback_budget_ms {0};
+
+    //! Consecutive budget overruns of the data callbacks of a topic after which its samples are delivered from a
+    //! dedicated thread (never offloaded if 0), and consecutive callbacks within budget after which it is restored
+    uint32_t callback_offload_threshold {0};
+
+    //! Per-sample tracing of the pipeline (disabled if no file path is set)
+    TracingConfiguration tracing;
 };
 
 } /* namespace participants */
@@ -18,8 +18,9 @@
 
 #pragma once
 
-#include <queue>
 #include <memory>
+#include <mutex>
+#include <queue>
 
 #include <cpp_utils/types/Atomicable.hpp>
 
@@ -29,6 +30,8 @@
 #include <ddspipe_participants/reader/auxiliar/InternalReader.hpp>
 #include <ddspipe_participants/reader/rpc/SimpleReader.hpp>
 
+#include <ddsenabler_participants/LockMetrics.hpp>
+
 namespace eprosima {
 namespace ddsenabler {
 namespace participants {
@@ -80,7 +83,11 @@ public:
     void simulate_data_reception(
             std::unique_ptr<ddspipe::core::IRoutingData>&& data) noexcept
     {
+#if defined(DDSENABLER_LOCK_METRICS)
+        MeteredLockGuard<fastdds::RecursiveTimedMutex> lock(rtps_mutex_, rtps_mutex_stats_);
+#else
         std::lock_guard<fastdds::RecursiveTimedMutex> lock(rtps_mutex_);
+#endif // if defined(DDSENABLER_LOCK_METRICS)
         unread_count_++;
         ddspipe::participants::InternalReader::simulate_data_reception(std::move(data));
     }
@@ -95,6 +102,10 @@ private:
 
     ddspipe::core::types::Guid guid_;
     mutable fastdds::RecursiveTimedMutex rtps_mutex_;
+#if defined(DDSENABLER_LOCK_METRICS)
+    //! Contention of the acquisitions of the RTPS mutex by the enabler (those by the DDS Pipe are not metered)
+    LockStats& rtps_mutex_stats_ {lock_stats("rpc_reader")};
+#endif // if defined(DDSENABLER_LOCK_METRICS)
     mutable uint64_t unread_count_ = 0;
     ddspipe::core::types::DdsTopic topic_;
 };
@@ -0,0 +1,99 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file LatencyHistogram.hpp
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include <ddsenabler_participants/library/library_dll.h>
+
+namespace eprosima {
+namespace ddsenabler {
+namespace participants {
+
+//! Number of buckets of a latency histogram: below 1 us, then one per power of two microseconds
+constexpr const std::size_t LATENCY_HISTOGRAM_BUCKETS = 32;
+
+/**
+ * Latencies recorded in a \c LatencyHistogram.
+ */
+struct LatencyStats
+{
+    //! Number of recorded latencies
+    uint64_t count {0};
+
+    //! Sum of the recorded latencies, in nanoseconds
+    uint64_t total_ns {0};
+
+    //! Maximum recorded latency, in nanoseconds
+    uint64_t max_ns {0};
+
+    //! Number of latencies per bucket: bucket 0 below 1 us, bucket i in [2^(i-1), 2^i) us
+    std::array<uint64_t, LATENCY_HISTOGRAM_BUCKETS> buckets {};
+
+    //! Mean latency, in nanoseconds
+    DDSENABLER_PARTICIPANTS_DllAPI
+    uint64_t mean_ns() const noexcept;
+
+    /**
+     * @brief Get an upper bound of a latency percentile, with the resolution of the histogram buckets.
+     *
+     * @param [in] percentile Percentile, in (0, 100].
+     * @return Upper bound of the bucket holding the percentile (bounded by the maximum latency), in nanoseconds.
+     */
+    DDSENABLER_PARTICIPANTS_DllAPI
+    uint64_t percentile_ns(
+            double percentile) const noexcept;
+};
+
+/**
+ * Lock-free histogram of latencies, with logarithmic buckets.
+ *
+ * Latencies may be recorded concurrently from any thread. Statistics are read without stopping the writers, so they
+ * may miss the latencies being recorded at that moment.
+ */
+class LatencyHistogram
+{
+public:
+
+    //! Record a latency, in nanoseconds
+    DDSENABLER_PARTICIPANTS_DllAPI
+    void record(
+            uint64_t latency_ns) noexcept;
+
+    //! Get the recorded latencies
+    DDSENABLER_PARTICIPANTS_DllAPI
+    LatencyStats stats() const noexcept;
+
+protected:
+
+    std::atomic<uint64_t> count_ {0};
+
+    std::atomic<uint64_t> total_ns_ {0};
+
+    std::atomic<uint64_t> max_ns_ {0};
+
+    std::array<std::atomic<uint64_t>, LATENCY_HISTOGRAM_BUCKETS> buckets_ {};
+};
+
+} /* namespace participants */
+} /* namespace ddsenabler */
+} /* namespace eprosima */
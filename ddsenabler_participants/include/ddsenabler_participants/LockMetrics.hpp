@@ -0,0 +1,262 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file LockMetrics.hpp
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <ddsenabler_participants/LatencyHistogram.hpp>
+#include <ddsenabler_participants/library/library_dll.h>
+
+namespace eprosima {
+namespace ddsenabler {
+namespace participants {
+
+/**
+ * Contention of a named lock, updated by every thread acquiring it without further locks.
+ *
+ * Only the outermost acquisition of a recursive lock is recorded, so its hold time covers the whole critical section.
+ */
+struct LockStats
+{
+    DDSENABLER_PARTICIPANTS_DllAPI
+    LockStats(
+            const std::string& name);
+
+    const std::string name;
+
+    //! Number of acquisitions that had to wait for another thread to release the lock
+    std::atomic<uint64_t> contended {0};
+
+    //! Time waited to acquire the lock (0 if it was free), one record per acquisition
+    LatencyHistogram wait_time;
+
+    //! Time the lock was held, one record per release
+    LatencyHistogram hold_time;
+};
+
+/**
+ * Copy of the contention of a named lock.
+ */
+struct LockMetricsSnapshot
+{
+    std::string name;
+
+    uint64_t acquisitions {0};
+
+    uint64_t contended {0};
+
+    LatencyStats wait_time;
+
+    LatencyStats hold_time;
+};
+
+/**
+ * @brief Get the contention of a named lock, adding it if not present.
+ *
+ * Locks are registered per process and never removed, so locks with the same name (e.g. of several enablers) share
+ * their statistics.
+ *
+ * @param [in] name Name of the lock.
+ * @return Contention of the lock, valid for the lifetime of the process.
+ */
+DDSENABLER_PARTICIPANTS_DllAPI
+LockStats& lock_stats(
+        const std::string& name);
+
+/**
+ * @brief Get a copy of the contention of every lock acquired at least once, sorted by name.
+ *
+ * @return Contention of the locks, always empty unless built with lock metrics (\c LOCK_METRICS CMake option).
+ */
+DDSENABLER_PARTICIPANTS_DllAPI
+std::vector<LockMetricsSnapshot> lock_metrics();
+
+#if defined(DDSENABLER_LOCK_METRICS)
+
+/**
+ * Mutex recording its acquisitions, wait and hold times in the contention of a named lock.
+ *
+ * Satisfies the Lockable requirements, so it is used with \c std::lock_guard , \c std::unique_lock and
+ * \c std::condition_variable_any .
+ */
+template<typename Mutex>
+class MeteredMutex
+{
+public:
+
+    /**
+     * @brief Create a mutex metered under the given name.
+     *
+     * @param [in] name Name of the lock in the metrics.
+     */
+    explicit MeteredMutex(
+            const char* name)
+        : stats_(lock_stats(name))
+    {
+    }
+
+    MeteredMutex(
+            const MeteredMutex&) = delete;
+
+    MeteredMutex& operator =(
+            const MeteredMutex&) = delete;
+
+    void lock()
+    {
+        // Free locks are taken without reading the clock twice
+        if (mutex_.try_lock())
+        {
+            acquired_(0);
+            return;
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        mutex_.lock();
+        stats_.contended.fetch_add(1, std::memory_order_relaxed);
+        acquired_(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - start).count());
+    }
+
+    bool try_lock()
+    {
+        if (!mutex_.try_lock())
+        {
+            return false;
+        }
+        acquired_(0);
+        return true;
+    }
+
+    void unlock()
+    {
+        if (--depth_ == 0)
+        {
+            stats_.hold_time.record(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now() - acquired_at_).count());
+        }
+        mutex_.unlock();
+    }
+
+protected:
+
+    //! Record an acquisition, only once per outermost acquisition of recursive mutexes
+    void acquired_(
+            uint64_t wait_ns) noexcept
+    {
+        if (depth_++ == 0)
+        {
+            stats_.wait_time.record(wait_ns);
+            acquired_at_ = std::chrono::steady_clock::now();
+        }
+    }
+
+    Mutex mutex_;
+
+    LockStats& stats_;
+
+    //! Nested acquisitions by the owner thread (only modified while holding the lock)
+    std::size_t depth_ {0};
+
+    //! Time of the outermost acquisition (only modified while holding the lock)
+    std::chrono::steady_clock::time_point acquired_at_;
+};
+
+/**
+ * Guard of a mutex that cannot be wrapped (e.g. one handed out to the DDS Pipe), recording the acquisition made by
+ * the guard in the contention of a named lock.
+ *
+ * Only available with lock metrics, so no lock is registered otherwise: users guard the mutex with a plain
+ * \c std::lock_guard without them.
+ */
+template<typename Mutex>
+class MeteredLockGuard
+{
+public:
+
+    MeteredLockGuard(
+            Mutex& mutex,
+            LockStats& stats)
+        : mutex_(mutex)
+        , stats_(stats)
+    {
+        if (!mutex_.try_lock())
+        {
+            const auto start = std::chrono::steady_clock::now();
+            mutex_.lock();
+            stats_.contended.fetch_add(1, std::memory_order_relaxed);
+            stats_.wait_time.record(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now() - start).count());
+        }
+        else
+        {
+            stats_.wait_time.record(0);
+        }
+        acquired_at_ = std::chrono::steady_clock::now();
+    }
+
+    ~MeteredLockGuard()
+    {
+        stats_.hold_time.record(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - acquired_at_).count());
+        mutex_.unlock();
+    }
+
+    MeteredLockGuard(
+            const MeteredLockGuard&) = delete;
+
+    MeteredLockGuard& operator =(
+            const MeteredLockGuard&) = delete;
+
+protected:
+
+    Mutex& mutex_;
+
+    LockStats& stats_;
+
+    std::chrono::steady_clock::time_point acquired_at_;
+};
+
+#else
+
+/**
+ * Without lock metrics the mutex is the wrapped one, and its name is dropped.
+ */
+template<typename Mutex>
+class MeteredMutex : public Mutex
+{
+public:
+
+    explicit MeteredMutex(
+            const char*) noexcept
+    {
+    }
+
+};
+
+#endif // if defined(DDSENABLER_LOCK_METRICS)
+
+} /* namespace participants */
+} /* namespace ddsenabler */
+} /* namespace eprosima */
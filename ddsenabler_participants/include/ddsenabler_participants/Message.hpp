@@ -23,6 +23,7 @@
 #include <ddspipe_core/efficiency/payload/PayloadPool.hpp>
 #include <ddspipe_core/types/topic/dds/DdsTopic.hpp>
 
+#include <ddsenabler_participants/MetricsRegistry.hpp>
 #include <ddsenabler_participants/library/library_dll.h>
 
 namespace eprosima {
@@ -82,6 +83,12 @@ struct Message
 
     //! Unique sequence number assigned to received messages.
     unsigned int sequence_number;
+
+    //! Metrics of the topic, service or action the message belongs to (if collected).
+    EntityMetrics* metrics{nullptr};
+
+    //! Identifier of the trace of the message (0 if not traced).
+    uint64_t trace_id{0};
 };
 
 } /* namespace participants */
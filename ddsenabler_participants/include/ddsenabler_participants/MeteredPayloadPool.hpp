@@ -0,0 +1,75 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file MeteredPayloadPool.hpp
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include <ddspipe_core/efficiency/payload/FastPayloadPool.hpp>
+#include <ddspipe_core/types/dds/Payload.hpp>
+
+#include <ddsenabler_participants/MetricsRegistry.hpp>
+#include <ddsenabler_participants/library/library_dll.h>
+
+namespace eprosima {
+namespace ddsenabler {
+namespace participants {
+
+/**
+ * \c FastPayloadPool keeping track of its usage, readable at any time without locks.
+ */
+class MeteredPayloadPool : public ddspipe::core::FastPayloadPool
+{
+public:
+
+    //! Reserve a new payload
+    DDSENABLER_PARTICIPANTS_DllAPI
+    bool get_payload(
+            uint32_t size,
+            ddspipe::core::types::Payload& payload) override;
+
+    //! Reference (or copy, if owned by another pool) an existing payload
+    DDSENABLER_PARTICIPANTS_DllAPI
+    bool get_payload(
+            const ddspipe::core::types::Payload& src_payload,
+            ddspipe::core::types::Payload& target_payload) override;
+
+    //! Release a payload reference
+    DDSENABLER_PARTICIPANTS_DllAPI
+    bool release_payload(
+            ddspipe::core::types::Payload& payload) override;
+
+    //! Get the usage of the pool
+    DDSENABLER_PARTICIPANTS_DllAPI
+    PayloadPoolStats stats() const noexcept;
+
+protected:
+
+    std::atomic<uint64_t> in_use_ {0};
+
+    //! Payloads reserved since startup (never decreased, as released payloads are counted by \c in_use_ )
+    std::atomic<uint64_t> reserved_total_ {0};
+
+    //! Bytes reserved since startup (never decreased)
+    std::atomic<uint64_t> reserved_bytes_total_ {0};
+};
+
+} /* namespace participants */
+} /* namespace ddsenabler */
+} /* namespace eprosima */
@@ -0,0 +1,236 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file MetricsExporter.hpp
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <ddsenabler_participants/MetricsRegistry.hpp>
+#include <ddsenabler_participants/library/library_dll.h>
+
+namespace eprosima {
+namespace ddsenabler {
+namespace participants {
+
+//! Default period of the metrics file dumps, in milliseconds
+constexpr const uint32_t DEFAULT_METRICS_FILE_PERIOD_MS = 10000;
+
+//! Default size of the metrics file after which it is rotated, in bytes
+constexpr const std::size_t DEFAULT_METRICS_FILE_MAX_SIZE = 10 * 1024 * 1024;
+
+//! Default number of rotated metrics files kept besides the current one
+constexpr const unsigned int DEFAULT_METRICS_FILE_MAX_FILES = 5;
+
+/**
+ * Format of the metrics file dumps.
+ */
+enum class MetricsFileFormat
+{
+    //! One JSON object per line and snapshot
+    JSON,
+
+    //! One row per entity and snapshot
+    CSV
+};
+
+/**
+ * Structure encapsulating all of \c MetricsExporter configuration options.
+ */
+struct MetricsExportConfiguration
+{
+    //! Port of localhost serving the metrics in Prometheus text format (disabled if 0)
+    uint16_t prometheus_port {0};
+
+    //! Path of the Unix socket serving the metrics in Prometheus text format (disabled if empty)
+    std::string prometheus_unix_socket;
+
+    //! Path of the file the metrics are periodically dumped to (disabled if empty)
+    std::string file_path;
+
+    //! Format of the file dumps
+    MetricsFileFormat file_format {MetricsFileFormat::JSON};
+
+    //! Period of the file dumps, in milliseconds
+    uint32_t file_period_ms {DEFAULT_METRICS_FILE_PERIOD_MS};
+
+    //! Size after which the file is rotated, in bytes (never rotated if 0)
+    std::size_t file_max_size {DEFAULT_METRICS_FILE_MAX_SIZE};
+
+    //! Number of rotated files kept besides the current one
+    unsigned int file_max_files {DEFAULT_METRICS_FILE_MAX_FILES};
+
+    //! Whether any exporter is configured
+    bool enabled() const noexcept
+    {
+        return prometheus_port != 0 || !prometheus_unix_socket.empty() || !file_path.empty();
+    }
+
+};
+
+/**
+ * @brief Format a metrics report in Prometheus text exposition format.
+ *
+ * Latencies are exported as histograms in seconds, with the buckets of \c LatencyHistogram .
+ *
+ * @param [in] report Metrics to format.
+ * @return Metrics in Prometheus text format.
+ */
+DDSENABLER_PARTICIPANTS_DllAPI
+std::string metrics_to_prometheus(
+        const MetricsReport& report);
+
+/**
+ * @brief Format a metrics report as a single-line JSON object.
+ *
+ * @param [in] report Metrics to format.
+ * @param [in] previous Previous report, used to compute the rates per second (no rates if null).
+ * @return Metrics in JSON format, without a trailing new line.
+ */
+DDSENABLER_PARTICIPANTS_DllAPI
+std::string metrics_to_json(
+        const MetricsReport& report,
+        const MetricsReport* previous = nullptr);
+
+//! Get the header row of \c metrics_to_csv , without a trailing new line
+DDSENABLER_PARTICIPANTS_DllAPI
+std::string metrics_csv_header();
+
+/**
+ * @brief Format the entities of a metrics report as CSV rows.
+ *
+ * @note The state of the queues and the payload pool is not included, as it does not belong to any entity.
+ *
+ * @param [in] report Metrics to format.
+ * @param [in] previous Previous report, used to compute the rates per second (no rates if null).
+ * @return One row per entity, each ending with a new line.
+ */
+DDSENABLER_PARTICIPANTS_DllAPI
+std::string metrics_to_csv(
+        const MetricsReport& report,
+        const MetricsReport* previous = nullptr);
+
+/**
+ * Exporter of the enabler metrics, serving them in Prometheus text format over a localhost port and/or a Unix socket,
+ * and dumping them periodically to a rotating file.
+ *
+ * Everything runs in a thread of its own, which only reads the metrics through the given source, so exporting never
+ * blocks the data path.
+ *
+ * @note Prometheus endpoints are not supported on Windows, file dumps are.
+ */
+class MetricsExporter
+{
+public:
+
+    //! Function taking a snapshot of the metrics
+    using MetricsSource = std::function<MetricsReport()>;
+
+    /**
+     * @brief Open the configured endpoints and start the exporter thread.
+     *
+     * Endpoints failing to open are reported and disabled, without preventing the rest from working.
+     *
+     * @param [in] configuration Exporters to run.
+     * @param [in] source Function taking a snapshot of the metrics, called from the exporter thread.
+     */
+    DDSENABLER_PARTICIPANTS_DllAPI
+    MetricsExporter(
+            const MetricsExportConfiguration& configuration,
+            MetricsSource&& source);
+
+    //! Stop the exporter thread and close the endpoints
+    DDSENABLER_PARTICIPANTS_DllAPI
+    ~MetricsExporter();
+
+    MetricsExporter(
+            const MetricsExporter&) = delete;
+
+    MetricsExporter& operator =(
+            const MetricsExporter&) = delete;
+
+    /**
+     * @brief Dump a snapshot of the metrics to the file, rotating it if needed.
+     *
+     * @return \c true if the snapshot was written, \c false otherwise.
+     */
+    DDSENABLER_PARTICIPANTS_DllAPI
+    bool dump();
+
+protected:
+
+    //! Exporter thread routine
+    void run_();
+
+    //! Wait for requests to the endpoints, or until stopped, up to \c timeout
+    void wait_(
+            std::chrono::milliseconds timeout);
+
+    //! Open a listening socket on localhost
+    int open_tcp_listener_(
+            uint16_t port);
+
+    //! Open a listening Unix socket
+    int open_unix_listener_(
+            const std::string& path);
+
+    //! Answer a request to an endpoint, then close the connection
+    void serve_(
+            int listener);
+
+    //! Rotate the file if writing \c size more bytes would exceed its maximum size
+    void rotate_nts_(
+            std::size_t size);
+
+    const MetricsExportConfiguration configuration_;
+
+    const MetricsSource source_;
+
+    //! Listening sockets (-1 if disabled)
+    int tcp_listener_ {-1};
+    int unix_listener_ {-1};
+
+    //! Pipe waking up the exporter thread to stop (-1 if not open)
+    int wake_pipe_[2] {-1, -1};
+
+    //! Previous snapshot dumped, to compute rates
+    std::unique_ptr<MetricsReport> previous_;
+
+    //! Protects file dumps
+    std::mutex dump_mtx_;
+
+    //! Used to stop the exporter thread when it does not wait on sockets
+    std::mutex mtx_;
+    std::condition_variable cv_;
+    std::atomic<bool> stop_ {false};
+
+    std::thread thread_;
+};
+
+} /* namespace participants */
+} /* namespace ddsenabler */
+} /* namespace eprosima */
@@ -0,0 +1,245 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file MetricsRegistry.hpp
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <ddsenabler_participants/LatencyHistogram.hpp>
+#include <ddsenabler_participants/LockMetrics.hpp>
+#include <ddsenabler_participants/PriorityDispatcher.hpp>
+#include <ddsenabler_participants/library/library_dll.h>
+
+namespace eprosima {
+namespace ddsenabler {
+namespace participants {
+
+/**
+ * Kind of entity metrics are collected for.
+ */
+enum class MetricsEntityKind
+{
+    TOPIC,
+    SERVICE,
+    ACTION
+};
+
+/**
+ * Metrics of a topic, service or action, updated concurrently from any thread without locks.
+ */
+struct EntityMetrics
+{
+    DDSENABLER_PARTICIPANTS_DllAPI
+    EntityMetrics(
+            const std::string& name,
+            MetricsEntityKind kind);
+
+    /**
+     * @brief Record the conversion of a sample between CDR and JSON.
+     *
+     * @param [in] start Time the conversion started.
+     */
+    DDSENABLER_PARTICIPANTS_DllAPI
+    void record_conversion(
+            std::chrono::steady_clock::time_point start) noexcept;
+
+    const std::string name;
+
+    const MetricsEntityKind kind;
+
+    //! Number of samples received from DDS
+    std::atomic<uint64_t> received {0};
+
+    //! Number of conversions between CDR and JSON, in either direction
+    std::atomic<uint64_t> converted {0};
+
+    //! Number of notifications delivered to the user's app
+    std::atomic<uint64_t> delivered {0};
+
+    //! Number of samples discarded on purpose (e.g. no callback to deliver them to)
+    std::atomic<uint64_t> filtered {0};
+
+    //! Number of samples lost (e.g. unknown type, failed conversion or full queue)
+    std::atomic<uint64_t> dropped {0};
+
+    //! Number of samples published from the user's app
+    std::atomic<uint64_t> published {0};
+
+    //! Serialized bytes received from DDS
+    std::atomic<uint64_t> bytes_in {0};
+
+    //! Serialized bytes published from the user's app
+    std::atomic<uint64_t> bytes_out {0};
+
+    //! Time taken by the conversions between CDR and JSON
+    LatencyHistogram conversion_time;
+
+    //! Time taken by the user callbacks
+    LatencyHistogram callback_time;
+
+    //! Time from the sample source timestamp until its notification is delivered
+    LatencyHistogram latency;
+
+    //! Next entity of the same registry bucket
+    EntityMetrics* next {nullptr};
+};
+
+/**
+ * Copy of the metrics of a topic, service or action.
+ */
+struct EntityMetricsSnapshot
+{
+    std::string name;
+
+    MetricsEntityKind kind {MetricsEntityKind::TOPIC};
+
+    uint64_t received {0};
+
+    uint64_t converted {0};
+
+    uint64_t delivered {0};
+
+    uint64_t filtered {0};
+
+    uint64_t dropped {0};
+
+    uint64_t published {0};
+
+    uint64_t bytes_in {0};
+
+    uint64_t bytes_out {0};
+
+    LatencyStats conversion_time;
+
+    LatencyStats callback_time;
+
+    LatencyStats latency;
+};
+
+/**
+ * Usage of the payload pool shared by the DDS Pipe and the enabler.
+ */
+struct PayloadPoolStats
+{
+    //! Payload references currently held
+    uint64_t in_use {0};
+
+    //! Number of payloads reserved since startup (a counter, never decreased on release)
+    uint64_t reserved_total {0};
+
+    //! Bytes reserved since startup (a counter, never decreased on release)
+    uint64_t reserved_bytes_total {0};
+};
+
+/**
+ * Metrics of every entity, as taken by \c MetricsRegistry::snapshot , along with the state of the enabler queues and
+ * payload pool.
+ */
+struct MetricsReport
+{
+    //! Time the snapshot was taken
+    std::chrono::system_clock::time_point timestamp;
+
+    //! Metrics of every entity, sorted by kind and name
+    std::vector<EntityMetricsSnapshot> entities;
+
+    //! State of the priority classes (empty if none is configured)
+    std::vector<PriorityClassStats> priority_classes;
+
+    //! Notifications waiting to be delivered to the user's app
+    std::size_t pending_notifications {0};
+
+    //! Usage of the payload pool (only filled by \c DDSEnabler )
+    PayloadPoolStats payload_pool;
+
+    //! Contention of the enabler locks (empty unless built with lock metrics)
+    std::vector<LockMetricsSnapshot> locks;
+};
+
+/**
+ * Registry of the metrics of every topic, service and action.
+ *
+ * Entities are looked up and added without locks, and are never removed, so references to their metrics remain valid
+ * for the lifetime of the registry. Snapshots are taken without stopping the writers, so they may miss the updates
+ * being made at that moment.
+ */
+class MetricsRegistry
+{
+public:
+
+    DDSENABLER_PARTICIPANTS_DllAPI
+    MetricsRegistry() = default;
+
+    DDSENABLER_PARTICIPANTS_DllAPI
+    ~MetricsRegistry();
+
+    MetricsRegistry(
+            const MetricsRegistry&) = delete;
+
+    MetricsRegistry& operator =(
+            const MetricsRegistry&) = delete;
+
+    /**
+     * @brief Get the metrics of an entity, adding it if not present.
+     *
+     * @param [in] name Name of the entity.
+     * @param [in] kind Kind of the entity.
+     * @return Metrics of the entity.
+     */
+    DDSENABLER_PARTICIPANTS_DllAPI
+    EntityMetrics& entity(
+            const std::string& name,
+            MetricsEntityKind kind);
+
+    //! Get a copy of the metrics of every entity
+    DDSENABLER_PARTICIPANTS_DllAPI
+    MetricsReport snapshot() const;
+
+protected:
+
+    //! Number of buckets of the entities hash table
+    static constexpr std::size_t BUCKETS = 256;
+
+    //! Each bucket holds a list of entities, where new ones are prepended
+    std::array<std::atomic<EntityMetrics*>, BUCKETS> buckets_ {};
+};
+
+/**
+ * @brief Wrap a notification so its delivery is recorded in the metrics of an entity.
+ *
+ * @param [in] metrics Metrics of the entity.
+ * @param [in] source_timestamp Source timestamp of the notified sample, in nanoseconds since epoch.
+ * @param [in] notification Notification to wrap.
+ * @return Notification counting its delivery, the time taken by the callback and the end-to-end latency.
+ */
+DDSENABLER_PARTICIPANTS_DllAPI
+std::function<void()> measure_delivery(
+        EntityMetrics& metrics,
+        int64_t source_timestamp,
+        std::function<void()>&& notification);
+
+} /* namespace participants */
+} /* namespace ddsenabler */
+} /* namespace eprosima */
@@ -0,0 +1,117 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file NotificationQueue.hpp
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+
+#include <ddsenabler_participants/library/library_dll.h>
+
+namespace eprosima {
+namespace ddsenabler {
+namespace participants {
+
+/**
+ * Queue of notifications to the user's app, delivered once the internal locks have been released.
+ *
+ * Notifications are delivered one at a time and in the order they were queued, whatever the thread queuing them.
+ * They are delivered by the thread that finds the queue idle, and a thread queuing notifications while another one
+ * is delivering them returns right away, so a slow callback only delays the notifications queued after it.
+ *
+ * The delivering thread keeps going until the queue is empty, including the notifications queued by other threads
+ * meanwhile. Under sustained load, a thread receiving data (e.g. a DDS Pipe worker) may then be kept running the
+ * callbacks of unrelated topics. The topics with slow callbacks are moved to a dedicated thread with the callback
+ * budget and its offloading threshold.
+ */
+class NotificationQueue
+{
+public:
+
+    using Notification = std::function<void()>;
+
+    /**
+     * @brief Queue a notification.
+     *
+     * The notification is delivered when the outermost \c NotificationScope of the calling thread on this queue is
+     * destroyed, or right away if there is none.
+     *
+     * @param [in] notification Notification to deliver, holding a copy of all its arguments.
+     */
+    DDSENABLER_PARTICIPANTS_DllAPI
+    void push(
+            Notification&& notification);
+
+    //! Deliver the queued notifications, unless another thread is delivering them already
+    DDSENABLER_PARTICIPANTS_DllAPI
+    void deliver();
+
+    //! Number of notifications waiting to be delivered, read without locking the queue
+    DDSENABLER_PARTICIPANTS_DllAPI
+    std::size_t size() const noexcept
+    {
+        return size_.load(std::memory_order_relaxed);
+    }
+
+protected:
+
+    std::deque<Notification> notifications_;
+
+    //! Size of \c notifications_ (updated with \c mtx_ taken)
+    std::atomic<std::size_t> size_ {0};
+
+    //! Whether some thread is delivering notifications
+    bool delivering_ {false};
+
+    std::mutex mtx_;
+};
+
+/**
+ * Defers the delivery of the notifications queued by the current thread until the scope is left.
+ *
+ * Scopes must be created before taking the locks the notifications are queued under, so those are released by the
+ * time the scope is destroyed. Scopes may be nested (e.g. in reentrant calls), only the outermost one on each queue
+ * delivers, and scopes on other queues do not defer the notifications of this one.
+ */
+class NotificationScope
+{
+public:
+
+    DDSENABLER_PARTICIPANTS_DllAPI
+    explicit NotificationScope(
+            NotificationQueue& queue);
+
+    DDSENABLER_PARTICIPANTS_DllAPI
+    ~NotificationScope();
+
+    NotificationScope(
+            const NotificationScope&) = delete;
+    NotificationScope& operator =(
+            const NotificationScope&) = delete;
+
+protected:
+
+    NotificationQueue& queue_;
+};
+
+} /* namespace participants */
+} /* namespace ddsenabler */
+} /* namespace eprosima */
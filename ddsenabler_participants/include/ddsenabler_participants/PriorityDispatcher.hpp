@@ -0,0 +1,154 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file PriorityDispatcher.hpp
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <ddsenabler_participants/HandlerConfiguration.hpp>
+#include <ddsenabler_participants/LatencyHistogram.hpp>
+#include <ddsenabler_participants/library/library_dll.h>
+
+namespace eprosima {
+namespace ddsenabler {
+namespace participants {
+
+/**
+ * State of a priority class.
+ */
+struct PriorityClassStats
+{
+    std::string name;
+
+    //! Number of samples waiting to be delivered
+    std::size_t queued {0};
+
+    //! Number of samples delivered since startup
+    uint64_t delivered {0};
+
+    //! Number of samples dropped since startup because the queue was full
+    uint64_t dropped {0};
+
+    //! Time from the sample being queued until its delivery completes
+    LatencyStats latency;
+};
+
+/**
+ * Dispatcher delivering tasks from one queue per priority class, choosing the next one according to the scheduling
+ * policy. Tasks are run by a single thread, so those of the same class run in order.
+ */
+class PriorityDispatcher
+{
+public:
+
+    using Task = std::function<void()>;
+
+    /**
+     * @brief Create the dispatcher and start its thread.
+     *
+     * @param [in] classes Priority classes, from highest to lowest priority.
+     * @param [in] scheduling Scheduling policy among classes.
+     */
+    DDSENABLER_PARTICIPANTS_DllAPI
+    PriorityDispatcher(
+            const std::vector<PriorityClass>& classes,
+            PriorityScheduling scheduling);
+
+    //! Stop the thread, discarding the pending tasks
+    DDSENABLER_PARTICIPANTS_DllAPI
+    ~PriorityDispatcher();
+
+    /**
+     * @brief Queue a task in a priority class, dropping its oldest task if the queue is full.
+     *
+     * @param [in] priority_class Index of the priority class.
+     * @param [in] task Task to run.
+     * @param [in] on_drop Function invoked if the task is dropped, with the dispatcher locked (so it must not use it).
+     * @return \c false if a task was dropped, \c true otherwise.
+     */
+    DDSENABLER_PARTICIPANTS_DllAPI
+    bool push(
+            std::size_t priority_class,
+            Task&& task,
+            Task&& on_drop = nullptr);
+
+    //! Get the state of every priority class, without blocking the dispatcher
+    DDSENABLER_PARTICIPANTS_DllAPI
+    std::vector<PriorityClassStats> stats() const;
+
+protected:
+
+    struct Entry
+    {
+        Task task;
+        Task on_drop;
+        std::chrono::steady_clock::time_point queued_time;
+    };
+
+    struct Queue
+    {
+        std::string name;
+        unsigned int weight {1};
+        std::size_t max_size {0};
+        std::deque<Entry> entries;
+        //! Counters readable without locking (updated with \c mtx_ taken)
+        std::atomic<std::size_t> queued {0};
+        std::atomic<uint64_t> delivered {0};
+        std::atomic<uint64_t> dropped {0};
+        LatencyHistogram latency;
+    };
+
+    //! Choose the class of the next task to run (some task must be pending)
+    std::size_t next_class_nts_();
+
+    //! Thread routine
+    void run_();
+
+    std::vector<Queue> queues_;
+
+    PriorityScheduling scheduling_;
+
+    //! Class being served, and tasks it may still run in the current round (weighted scheduling)
+    std::size_t current_class_ {0};
+    unsigned int credits_ {0};
+
+    //! Number of pending tasks among all classes
+    std::size_t pending_ {0};
+
+    bool stop_ {false};
+
+    mutable std::mutex mtx_;
+
+    std::condition_variable cv_;
+
+    std::thread thread_;
+};
+
+} /* namespace participants */
+} /* namespace ddsenabler */
+} /* namespace eprosima */
@@ -19,7 +19,11 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include <fastdds/dds/xtypes/type_representation/detail/dds_xtypes_typeobject.hpp>
 #include <fastdds/rtps/common/SerializedPayload.hpp>
@@ -36,15 +40,24 @@ namespace serialization {
 /**
  * @brief Serialize a \c TopicQoS struct into a string.
  *
+ * Serialized strings are precomputed for every combination of the serialized policies, so no YAML is emitted at
+ * runtime. The compact encoding is the \c QOS_SERIALIZATION_COMPACT_PREFIX followed by one '0'/'1' character per
+ * policy (reliability, durability, ownership and keyed).
+ *
  * @param [in] qos TopicQoS to be serialized
+ * @param [in] compact Whether to use the compact encoding instead of YAML
  * @return Serialized TopicQoS string
  */
-std::string serialize_qos(
-        const ddspipe::core::types::TopicQoS& qos);
+const std::string& serialize_qos(
+        const ddspipe::core::types::TopicQoS& qos,
+        bool compact = false);
 
 /**
  * @brief Deserialize a serialized \c TopicQoS string.
  *
+ * Both the compact and the YAML encodings are accepted. Strings matching a precomputed encoding are resolved
+ * without parsing.
+ *
  * @param [in] qos_str Serialized \c TopicQoS string
  * @return Deserialized TopicQoS
  */
@@ -64,6 +77,93 @@ bool serialize_dynamic_type(
         const fastdds::dds::xtypes::TypeIdentifier& type_identifier,
         DynamicTypesCollection& dynamic_types);
 
+/**
+ * @brief Serialize a \c TypeIdentifier into a (binary) string.
+ *
+ * @param [in] type_identifier TypeIdentifier to be serialized
+ * @return Serialized TypeIdentifier string
+ * @throw \c InconsistencyException if serialization fails
+ */
+std::string serialize_type_identifier(
+        const fastdds::dds::xtypes::TypeIdentifier& type_identifier);
+
+/**
+ * @brief Deserialize a serialized \c TypeIdentifier string.
+ *
+ * @param [in] typeid_str Serialized TypeIdentifier string
+ * @return Deserialized TypeIdentifier
+ * @throw \c InconsistencyException if deserialization fails
+ */
+fastdds::dds::xtypes::TypeIdentifier deserialize_type_identifier(
+        const std::string& typeid_str);
+
+/**
+ * @brief Serialize a \c TypeObject into a (binary) string.
+ *
+ * @param [in] type_object TypeObject to be serialized
+ * @return Serialized TypeObject string
+ * @throw \c InconsistencyException if serialization fails
+ */
+std::string serialize_type_object(
+        const fastdds::dds::xtypes::TypeObject& type_object);
+
+/**
+ * @brief Deserialize a serialized \c TypeObject string.
+ *
+ * @param [in] typeobj_str Serialized TypeObject string
+ * @return Deserialized TypeObject
+ * @throw \c InconsistencyException if deserialization fails
+ */
+fastdds::dds::xtypes::TypeObject deserialize_type_object(
+        const std::string& typeobj_str);
+
+/**
+ * @brief Cache of serialized types shared between the collections generated for different types.
+ *
+ * Dependencies common to several types (e.g. headers or timestamps) are only serialized once. When generating
+ * incremental collections, dependencies already delivered in a previous collection are only referenced: their entry
+ * contains the type identifier (a hash for complete types) but an empty type object. Types are only considered
+ * delivered once recorded with \c mark_types_delivered.
+ */
+struct DynamicTypesCache
+{
+    //! Serialized type objects indexed by serialized type identifier
+    std::unordered_map<std::string, std::string> type_objects;
+
+    //! Serialized type identifiers already delivered in a collection
+    std::unordered_set<std::string> delivered;
+
+    //! Mutex guarding the cache
+    std::mutex mtx;
+};
+
+/**
+ * @brief Serialize a dynamic type into a \c DynamicTypesCollection, reusing previously serialized dependencies.
+ *
+ * @param [in] type_name Name of the dynamic type
+ * @param [in] type_identifier Type identifier of the dynamic type
+ * @param [in,out] dynamic_types Collection to store the serialized dynamic type
+ * @param [in,out] cache Cache of serialized types
+ * @param [in] incremental Whether to reference (instead of include) dependencies delivered in previous collections
+ * @return True if serialization was successful, false otherwise
+ */
+bool serialize_dynamic_type(
+        const std::string& type_name,
+        const fastdds::dds::xtypes::TypeIdentifier& type_identifier,
+        DynamicTypesCollection& dynamic_types,
+        DynamicTypesCache& cache,
+        bool incremental);
+
+/**
+ * @brief Record the types of a collection as delivered, so following incremental collections only reference them.
+ *
+ * @param [in] type_identifiers Serialized identifiers of the delivered types
+ * @param [in,out] cache Cache of serialized types
+ */
+void mark_types_delivered(
+        const std::vector<std::string>& type_identifiers,
+        DynamicTypesCache& cache);
+
 /**
  * @brief Serialize a dynamic type into a \c DynamicTypesCollection.
  *
@@ -94,6 +194,17 @@ bool deserialize_dynamic_type(
         fastdds::dds::xtypes::TypeIdentifier& type_identifier,
         fastdds::dds::xtypes::TypeObject& type_object);
 
+/**
+ * @brief Deserialize only the type identifier of a dynamic type from a \c DynamicTypesCollection.
+ *
+ * @param [in] dynamic_type DynamicType whose type identifier is deserialized
+ * @param [out] type_identifier Type identifier of the dynamic type
+ * @return True if deserialization was successful, false otherwise
+ */
+bool deserialize_dynamic_type_identifier(
+        const DynamicType& dynamic_type,
+        fastdds::dds::xtypes::TypeIdentifier& type_identifier);
+
 /**
  * @brief Serialize a collection of dynamic types into a serialized payload.
  *
@@ -0,0 +1,148 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file ThreadPlacement.hpp
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <ddsenabler_participants/library/library_dll.h>
+
+namespace eprosima {
+namespace ddsenabler {
+namespace participants {
+
+//! Name of the DDS Pipe workers and the threads of the enabler participants
+constexpr const char* WORKER_THREAD_NAME = "ddsenabler.wrk";
+
+//! Name of the enabler helper threads (discovery batching, periodic snapshots)
+constexpr const char* DISPATCHER_THREAD_NAME = "ddsenabler.dsp";
+
+//! Name of the configuration file watcher thread
+constexpr const char* FILE_WATCHER_THREAD_NAME = "ddsenabler.fw";
+
+/**
+ * Placement of a group of threads: the CPUs they may run on and the name they are given (both left as they are if
+ * empty).
+ */
+struct ThreadPlacement
+{
+    std::vector<unsigned int> cpus;
+    std::string name;
+};
+
+/**
+ * Placement of every group of threads created by the DDS Enabler.
+ *
+ * Threads are neither placed nor named by default, only once a placement is configured.
+ */
+struct ThreadPlacementConfiguration
+{
+    //! DDS Pipe workers and threads of the enabler participants
+    ThreadPlacement workers;
+
+    //! Enabler helper threads
+    ThreadPlacement dispatchers;
+
+    //! Configuration file watcher
+    ThreadPlacement file_watcher;
+
+    //! NUMA node the enabler runs on (none if negative), default CPU set of the workers and dispatchers
+    int numa_node {-1};
+};
+
+/**
+ * @brief Parse a CPU list in the kernel cpulist format (e.g. "0-3,8,10-11").
+ *
+ * @param [in] cpu_list CPU list to parse.
+ * @param [out] cpus Sorted CPUs in the list, without repetitions.
+ * @return \c true if the list is well formed, \c false otherwise.
+ */
+DDSENABLER_PARTICIPANTS_DllAPI
+bool parse_cpu_list(
+        const std::string& cpu_list,
+        std::vector<unsigned int>& cpus);
+
+/**
+ * @brief Get the CPUs of a NUMA node.
+ *
+ * @param [in] numa_node NUMA node to query.
+ * @param [out] cpus CPUs of the node.
+ * @return \c true if the node exists, \c false otherwise.
+ */
+DDSENABLER_PARTICIPANTS_DllAPI
+bool get_numa_node_cpus(
+        int numa_node,
+        std::vector<unsigned int>& cpus);
+
+/**
+ * @brief Restrict the calling thread to a set of CPUs.
+ *
+ * @param [in] cpus CPUs the thread may run on.
+ * @return \c true if the affinity was set, \c false otherwise.
+ */
+DDSENABLER_PARTICIPANTS_DllAPI
+bool set_current_thread_affinity(
+        const std::vector<unsigned int>& cpus);
+
+/**
+ * @brief Name the calling thread, as shown by profilers and \c top (truncated to 15 characters).
+ *
+ * @param [in] name Name of the thread.
+ * @return \c true if the name was set, \c false otherwise.
+ */
+DDSENABLER_PARTICIPANTS_DllAPI
+bool set_current_thread_name(
+        const std::string& name);
+
+/**
+ * Apply a placement to the calling thread for the lifetime of the object, restoring the previous one afterwards.
+ *
+ * Threads inherit the affinity and name of the thread creating them, so this places the threads spawned internally
+ * by libraries not exposing them (e.g. thread pools and Fast DDS participants) when created within its scope.
+ *
+ * @note Affinity and names are only supported on Linux, placements are ignored elsewhere.
+ */
+class ScopedThreadPlacement
+{
+public:
+
+    DDSENABLER_PARTICIPANTS_DllAPI
+    ScopedThreadPlacement(
+            const ThreadPlacement& placement);
+
+    DDSENABLER_PARTICIPANTS_DllAPI
+    ~ScopedThreadPlacement();
+
+    ScopedThreadPlacement(
+            const ScopedThreadPlacement&) = delete;
+    ScopedThreadPlacement& operator =(
+            const ScopedThreadPlacement&) = delete;
+
+protected:
+
+    //! CPUs the thread could run on before applying the placement (not restored if empty)
+    std::vector<unsigned int> previous_cpus_;
+
+    //! Name of the thread before applying the placement (not restored if empty)
+    std::string previous_name_;
+};
+
+} /* namespace participants */
+} /* namespace ddsenabler */
+} /* namespace eprosima */
@@ -0,0 +1,353 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file Tracer.hpp
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <ddsenabler_participants/library/library_dll.h>
+
+namespace eprosima {
+namespace ddsenabler {
+namespace participants {
+
+//! Default number of samples out of which one is traced
+constexpr const uint32_t DEFAULT_TRACING_SAMPLING_PERIOD = 100;
+
+//! Default number of spans buffered per thread until written to the trace file
+constexpr const std::size_t DEFAULT_TRACING_BUFFER_SIZE = 8192;
+
+//! Default period of the writes to the trace file, in milliseconds
+constexpr const uint32_t DEFAULT_TRACING_FLUSH_PERIOD_MS = 1000;
+
+/**
+ * Structure encapsulating all of \c Tracer configuration options.
+ */
+struct TracingConfiguration
+{
+    //! Path of the trace file, in Chrome trace (JSON) format (tracing disabled if empty)
+    std::string file_path;
+
+    //! One of every this number of samples is traced
+    uint32_t sampling_period {DEFAULT_TRACING_SAMPLING_PERIOD};
+
+    //! Spans buffered per thread, those recorded while the buffer is full being lost
+    std::size_t buffer_size {DEFAULT_TRACING_BUFFER_SIZE};
+
+    //! Period of the writes to the trace file, in milliseconds
+    uint32_t flush_period_ms {DEFAULT_TRACING_FLUSH_PERIOD_MS};
+
+    //! Whether tracing is enabled
+    bool enabled() const noexcept
+    {
+        return !file_path.empty();
+    }
+
+};
+
+/**
+ * Stage of the enabler pipeline covered by a span.
+ */
+enum class SpanKind : uint8_t
+{
+    //! From the source timestamp of a sample until it reaches the handler
+    RECEIVE,
+
+    //! Processing of a received sample in \c Handler::add_data , on the reception thread
+    ADD_DATA,
+
+    //! Deserialization of a CDR sample into DynamicData
+    DECODE,
+
+    //! Serialization of DynamicData into JSON
+    ENCODE,
+
+    //! Wait of a notification until it is delivered to the user's app
+    QUEUE,
+
+    //! User callback
+    CALLBACK,
+
+    //! Publication of a sample from the user's app, from the call until it is handed to the DDS Pipe
+    PUBLISH,
+
+    //! Conversion of a published sample into the CDR representation of its topic
+    SERIALIZE,
+
+    //! Hand over of a published sample to the DDS Pipe
+    WRITE
+};
+
+//! Get the name of a span kind, as shown in the trace
+DDSENABLER_PARTICIPANTS_DllAPI
+const char* span_name(
+        SpanKind kind) noexcept;
+
+/**
+ * Time span of a stage of the pipeline for a traced sample.
+ */
+struct Span
+{
+    //! Identifier of the traced sample, shared by all its spans
+    uint64_t trace_id {0};
+
+    //! Name of the topic, service or action (must outlive the tracer, may be null)
+    const char* entity {nullptr};
+
+    //! Start and end times, in nanoseconds since epoch
+    int64_t start_ns {0};
+    int64_t end_ns {0};
+
+    SpanKind kind {SpanKind::ADD_DATA};
+};
+
+/**
+ * Tracer of a sampling of the samples going through the enabler, writing their spans to a file in Chrome trace format
+ * (readable by Perfetto and chrome://tracing).
+ *
+ * Spans are recorded without locks into a ring buffer per thread, which a thread of the tracer periodically drains
+ * into the file. Spans recorded while the buffer of their thread is full are lost and counted.
+ *
+ * The file is a JSON array of trace events, closed when the tracer is destroyed. Unclosed arrays (e.g. after a crash)
+ * are accepted by the trace viewers too.
+ */
+class Tracer
+{
+public:
+
+    /**
+     * @brief Open the trace file and start the thread writing to it.
+     *
+     * @param [in] configuration Tracing options.
+     *
+     * @throw \c InitializationException if the trace file cannot be opened.
+     */
+    DDSENABLER_PARTICIPANTS_DllAPI
+    Tracer(
+            const TracingConfiguration& configuration);
+
+    //! Write the remaining spans and close the trace file
+    DDSENABLER_PARTICIPANTS_DllAPI
+    ~Tracer();
+
+    Tracer(
+            const Tracer&) = delete;
+
+    Tracer& operator =(
+            const Tracer&) = delete;
+
+    /**
+     * @brief Decide whether a new sample is traced.
+     *
+     * @return Identifier of the trace of the sample, or 0 if it is not traced.
+     */
+    DDSENABLER_PARTICIPANTS_DllAPI
+    uint64_t start_trace() noexcept;
+
+    /**
+     * @brief Record a span in the buffer of the calling thread.
+     *
+     * @param [in] span Span to record, whose entity name must outlive the tracer.
+     */
+    DDSENABLER_PARTICIPANTS_DllAPI
+    void record(
+            const Span& span) noexcept;
+
+    //! Write the buffered spans to the trace file
+    DDSENABLER_PARTICIPANTS_DllAPI
+    void flush();
+
+    //! Number of spans lost because the buffer of their thread was full
+    DDSENABLER_PARTICIPANTS_DllAPI
+    uint64_t lost_spans() const noexcept;
+
+    //! Current time, in nanoseconds since epoch (as span times)
+    DDSENABLER_PARTICIPANTS_DllAPI
+    static int64_t now_ns() noexcept;
+
+protected:
+
+    /**
+     * Single producer, single consumer ring buffer of the spans of a thread.
+     */
+    struct ThreadBuffer
+    {
+        ThreadBuffer(
+                std::size_t capacity,
+                uint32_t thread_id);
+
+        std::vector<Span> spans;
+
+        //! Spans written by the owner thread, and read by the tracer thread
+        std::atomic<uint64_t> head {0};
+        std::atomic<uint64_t> tail {0};
+
+        std::atomic<uint64_t> lost {0};
+
+        //! Identifier of the thread in the trace
+        const uint32_t thread_id;
+    };
+
+    //! Get the buffer of the calling thread, creating it on first use (null if it could not be created)
+    ThreadBuffer* thread_buffer_() noexcept;
+
+    //! Tracer thread routine
+    void run_();
+
+    const TracingConfiguration configuration_;
+
+    //! Unique identifier of this tracer, to tell apart the buffers of each tracer in a thread
+    const uint64_t id_;
+
+    //! Samples seen by \c start_trace
+    std::atomic<uint64_t> samples_ {0};
+
+    //! Buffers of every thread that recorded spans
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers_;
+    mutable std::mutex buffers_mtx_;
+
+    //! Protects the trace file
+    std::mutex file_mtx_;
+    std::ofstream file_;
+
+    //! Used to stop the tracer thread
+    std::mutex mtx_;
+    std::condition_variable cv_;
+    bool stop_ {false};
+
+    std::thread thread_;
+};
+
+/**
+ * Span of a traced sample, recorded when the object is destroyed or \c end is called.
+ *
+ * Spans of samples not traced (trace identifier 0 or no tracer) cost a couple of branches.
+ */
+class TraceSpan
+{
+public:
+
+    /**
+     * @brief Start a span.
+     *
+     * @param [in] tracer Tracer to record the span in (nothing is recorded if null).
+     * @param [in] trace_id Identifier of the trace of the sample (nothing is recorded if 0).
+     * @param [in] kind Stage covered by the span.
+     * @param [in] entity Name of the topic, service or action, which must outlive the tracer (may be null).
+     */
+    TraceSpan(
+            Tracer* tracer,
+            uint64_t trace_id,
+            SpanKind kind,
+            const char* entity = nullptr) noexcept
+        : tracer_(trace_id != 0 ? tracer : nullptr)
+    {
+        if (tracer_)
+        {
+            span_.trace_id = trace_id;
+            span_.entity = entity;
+            span_.kind = kind;
+            span_.start_ns = Tracer::now_ns();
+        }
+    }
+
+    ~TraceSpan()
+    {
+        end();
+    }
+
+    TraceSpan(
+            const TraceSpan&) = delete;
+
+    TraceSpan& operator =(
+            const TraceSpan&) = delete;
+
+    //! Start a span of the same sample and entity
+    TraceSpan child(
+            SpanKind kind) const noexcept
+    {
+        return TraceSpan(tracer_, span_.trace_id, kind, span_.entity);
+    }
+
+    //! Set the entity of the span, when not known at its start
+    void entity(
+            const char* entity) noexcept
+    {
+        span_.entity = entity;
+    }
+
+    //! Record the span, if not recorded yet
+    void end() noexcept
+    {
+        if (tracer_)
+        {
+            span_.end_ns = Tracer::now_ns();
+            tracer_->record(span_);
+            tracer_ = nullptr;
+        }
+    }
+
+    //! Identifier of the trace of the sample (0 if not traced)
+    uint64_t trace_id() const noexcept
+    {
+        return tracer_ ? span_.trace_id : 0;
+    }
+
+    //! Start time of the span, in nanoseconds since epoch (0 if not traced)
+    int64_t start_ns() const noexcept
+    {
+        return span_.start_ns;
+    }
+
+protected:
+
+    Tracer* tracer_;
+
+    Span span_;
+};
+
+/**
+ * @brief Wrap a notification of a traced sample, recording its wait in the queue and the user callback.
+ *
+ * @param [in] tracer Tracer to record the spans in.
+ * @param [in] trace_id Identifier of the trace of the sample.
+ * @param [in] entity Name of the topic, service or action, which must outlive the tracer (may be null).
+ * @param [in] notification Notification to deliver.
+ * @return Notification recording the spans when delivered.
+ */
+DDSENABLER_PARTICIPANTS_DllAPI
+std::function<void()> trace_delivery(
+        Tracer& tracer,
+        uint64_t trace_id,
+        const char* entity,
+        std::function<void()>&& notification);
+
+} /* namespace participants */
+} /* namespace ddsenabler */
+} /* namespace eprosima */
@@ -0,0 +1,134 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file TypeInterner.hpp
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <fastdds/dds/xtypes/type_representation/detail/dds_xtypes_typeobject.hpp>
+
+#include <ddsenabler_participants/library/library_dll.h>
+
+namespace std {
+template<>
+struct hash<eprosima::fastdds::dds::xtypes::TypeIdentifier>
+{
+    /**
+     * Hash of a TypeIdentifier, covering the whole equivalence hash of direct hash identifiers and the serialized
+     * identifier otherwise (primitive and fully descriptive types).
+     */
+    DDSENABLER_PARTICIPANTS_DllAPI
+    std::size_t operator ()(
+            const eprosima::fastdds::dds::xtypes::TypeIdentifier& k) const noexcept;
+};
+
+} // std
+
+namespace eprosima {
+namespace ddsenabler {
+namespace participants {
+
+/**
+ * Interning table assigning dense, stable integer identifiers to types, so structures indexed by type can be plain
+ * arrays.
+ *
+ * Types are interned by name. The identifier registered first for a name is the one kept, as is the type interned
+ * first for a TypeIdentifier shared by several names. Interned types are never removed.
+ *
+ * @warning This class is not thread safe.
+ */
+class TypeInterner
+{
+public:
+
+    //! Dense type identifier
+    using TypeId = uint32_t;
+
+    //! Identifier of types not interned
+    static constexpr TypeId INVALID_TYPE_ID = std::numeric_limits<TypeId>::max();
+
+    /**
+     * @brief Intern a type, assigning it the next dense identifier unless already interned.
+     *
+     * @param [in] type_name Name of the type.
+     * @param [in] type_identifier TypeIdentifier of the type.
+     * @return Dense identifier of the type.
+     */
+    DDSENABLER_PARTICIPANTS_DllAPI
+    TypeId intern(
+            const std::string& type_name,
+            const fastdds::dds::xtypes::TypeIdentifier& type_identifier);
+
+    /**
+     * @brief Find the dense identifier of a type by name.
+     *
+     * @param [in] type_name Name of the type.
+     * @return Dense identifier of the type, \c INVALID_TYPE_ID if not interned.
+     */
+    DDSENABLER_PARTICIPANTS_DllAPI
+    TypeId find(
+            const std::string& type_name) const noexcept;
+
+    /**
+     * @brief Find the dense identifier of a type by TypeIdentifier.
+     *
+     * @param [in] type_identifier TypeIdentifier of the type.
+     * @return Dense identifier of the type, \c INVALID_TYPE_ID if not interned.
+     */
+    DDSENABLER_PARTICIPANTS_DllAPI
+    TypeId find(
+            const fastdds::dds::xtypes::TypeIdentifier& type_identifier) const noexcept;
+
+    //! Name of an interned type
+    DDSENABLER_PARTICIPANTS_DllAPI
+    const std::string& type_name(
+            TypeId id) const;
+
+    //! TypeIdentifier of an interned type
+    DDSENABLER_PARTICIPANTS_DllAPI
+    const fastdds::dds::xtypes::TypeIdentifier& type_identifier(
+            TypeId id) const;
+
+    //! Number of interned types
+    DDSENABLER_PARTICIPANTS_DllAPI
+    std::size_t size() const noexcept
+    {
+        return types_.size();
+    }
+
+protected:
+
+    //! Name and TypeIdentifier of the interned types, indexed by dense identifier
+    std::vector<std::pair<std::string, fastdds::dds::xtypes::TypeIdentifier>> types_;
+
+    //! Dense identifiers indexed by type name
+    std::unordered_map<std::string, TypeId> name_index_;
+
+    //! Dense identifiers indexed by TypeIdentifier
+    std::unordered_map<fastdds::dds::xtypes::TypeIdentifier, TypeId> identifier_index_;
+};
+
+} /* namespace participants */
+} /* namespace ddsenabler */
+} /* namespace eprosima */
@@ -0,0 +1,226 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file TypeStore.hpp
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <fastdds/dds/xtypes/type_representation/detail/dds_xtypes_typeobject.hpp>
+
+#include <ddsenabler_participants/library/library_dll.h>
+
+namespace eprosima {
+namespace ddsenabler {
+namespace participants {
+
+/**
+ * Persistent store of types, backed by an append-only binary file which is memory-mapped for lookups.
+ *
+ * Each record holds a type name followed by the serialized \c TypeIdentifier / \c TypeObject pairs of all its
+ * dependencies and, last, of the type itself, plus its (optional) IDL and data placeholder. Records are indexed by
+ * type name and by the hash of the type's \c TypeIdentifier (or by the identifier itself if it has no hash). Values
+ * are stored in host byte order, so a store is not portable across architectures.
+ *
+ * @note This class is thread safe.
+ */
+class TypeStore
+{
+public:
+
+    /**
+     * @brief Open a type store, creating its file if it does not exist (unless opened read-only).
+     *
+     * A truncated record at the end of the file (e.g. interrupted append) is discarded, and malformed records are
+     * skipped. Read-only stores are never modified: both are reported as errors instead.
+     *
+     * @param [in] file_path Path of the type store file.
+     * @param [in] read_only Whether to open an existing store only to load types from it.
+     * @throw \c InitializationException if the file cannot be created, mapped, is not a type store (of this version)
+     * or, if read-only, contains a truncated or malformed record.
+     */
+    DDSENABLER_PARTICIPANTS_DllAPI
+    TypeStore(
+            const std::string& file_path,
+            bool read_only = false);
+
+    DDSENABLER_PARTICIPANTS_DllAPI
+    ~TypeStore();
+
+    /**
+     * @brief Whether a type with the given name is stored.
+     *
+     * @param [in] type_name Name of the type.
+     */
+    DDSENABLER_PARTICIPANTS_DllAPI
+    bool contains(
+            const std::string& type_name) const;
+
+    /**
+     * @brief Whether a type with the given (hashed) identifier is stored.
+     *
+     * @param [in] type_identifier TypeIdentifier of the type.
+     */
+    DDSENABLER_PARTICIPANTS_DllAPI
+    bool contains(
+            const fastdds::dds::xtypes::TypeIdentifier& type_identifier) const;
+
+    /**
+     * @brief Register a stored type and its dependencies in the type object registry.
+     *
+     * @param [in] type_name Name of the type.
+     * @param [out] type_identifier TypeIdentifier of the type.
+     * @param [out] type_object TypeObject of the type.
+     * @return \c true if the type was found and registered, \c false otherwise.
+     */
+    DDSENABLER_PARTICIPANTS_DllAPI
+    bool load(
+            const std::string& type_name,
+            fastdds::dds::xtypes::TypeIdentifier& type_identifier,
+            fastdds::dds::xtypes::TypeObject& type_object);
+
+    /**
+     * @brief Append a type, along with its dependencies, retrieved from the type object registry.
+     *
+     * @param [in] type_name Name of the type.
+     * @param [in] type_identifier TypeIdentifier of the type.
+     * @param [in] idl IDL representation of the type (optional).
+     * @param [in] placeholder JSON data placeholder of the type (optional).
+     * @return \c true if the type was stored (or already present), \c false otherwise (always if read-only).
+     */
+    DDSENABLER_PARTICIPANTS_DllAPI
+    bool store(
+            const std::string& type_name,
+            const fastdds::dds::xtypes::TypeIdentifier& type_identifier,
+            const std::string& idl = "",
+            const std::string& placeholder = "");
+
+    /**
+     * @brief Get the IDL and data placeholder stored with a type (empty if they were not stored).
+     *
+     * @param [in] type_name Name of the type.
+     * @param [out] idl IDL representation of the type.
+     * @param [out] placeholder JSON data placeholder of the type.
+     * @return \c true if the type was found, \c false otherwise.
+     */
+    DDSENABLER_PARTICIPANTS_DllAPI
+    bool get_description(
+            const std::string& type_name,
+            std::string& idl,
+            std::string& placeholder) const;
+
+    //! Names of the stored types
+    DDSENABLER_PARTICIPANTS_DllAPI
+    std::vector<std::string> type_names() const;
+
+    //! Number of stored types
+    DDSENABLER_PARTICIPANTS_DllAPI
+    std::size_t size() const;
+
+protected:
+
+    //! Serialized TypeIdentifier and TypeObject
+    using Entry = std::pair<std::string, std::string>;
+
+    //! Contents of a record
+    struct Record
+    {
+        std::string type_name;
+        std::vector<Entry> entries;
+        std::string idl;
+        std::string placeholder;
+    };
+
+    /**
+     * @brief Map the file in memory, replacing the previous mapping.
+     *
+     * @throw \c InitializationException if the file cannot be mapped.
+     */
+    void map_nts_();
+
+    //! Release the current mapping
+    void unmap_nts_();
+
+    /**
+     * @brief Index the records found after the last indexed one.
+     *
+     * @return \c true if the whole file was indexed, \c false if a truncated record (or, if read-only, a malformed
+     * one) was found.
+     */
+    bool index_nts_();
+
+    /**
+     * @brief Parse the record starting at \c offset.
+     *
+     * @param [in] offset Offset of the record in the file.
+     * @param [out] record Contents of the record.
+     * @param [out] record_size Size of the record in bytes, even if malformed (0 if it exceeds the end of the file).
+     * @return \c true if a complete record was parsed, \c false otherwise.
+     */
+    bool read_record_nts_(
+            std::size_t offset,
+            Record& record,
+            std::size_t& record_size) const;
+
+    /**
+     * @brief Key of the hash index for a TypeIdentifier: its hash, or its serialized form if it has none, prefixed
+     * with the kind of key.
+     *
+     * @throw \c InconsistencyException if the TypeIdentifier cannot be serialized.
+     */
+    static std::string hash_key_(
+            const fastdds::dds::xtypes::TypeIdentifier& type_identifier);
+
+    //! Path of the type store file
+    std::string file_path_;
+
+    //! Whether the store is never modified
+    bool read_only_{false};
+
+    //! Mapped file contents
+    const char* data_{nullptr};
+
+    //! Size of the mapping
+    std::size_t mapped_size_{0};
+
+    //! Size of the indexed (valid) part of the file
+    std::size_t indexed_size_{0};
+
+#ifdef _WIN32
+    //! File contents, read in memory when memory-mapping is not available
+    std::vector<char> buffer_;
+#endif // _WIN32
+
+    //! Record offsets indexed by type name
+    std::unordered_map<std::string, std::size_t> name_index_;
+
+    //! Record offsets indexed by type identifier hash
+    std::unordered_map<std::string, std::size_t> hash_index_;
+
+    //! Mutex synchronizing access to object's data structures
+    mutable std::mutex mtx_;
+};
+
+} /* namespace participants */
+} /* namespace ddsenabler */
+} /* namespace eprosima */
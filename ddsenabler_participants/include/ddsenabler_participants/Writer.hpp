@@ -18,7 +18,9 @@
 
 #pragma once
 
-#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 #include <nlohmann/json.hpp>
 
@@ -29,8 +31,12 @@
 #include <ddspipe_core/types/topic/dds/DdsTopic.hpp>
 #include <ddspipe_core/types/topic/rpc/RpcTopic.hpp>
 
+#include <ddsenabler_participants/CallbackWatchdog.hpp>
 #include <ddsenabler_participants/Callbacks.hpp>
 #include <ddsenabler_participants/Message.hpp>
+#include <ddsenabler_participants/NotificationQueue.hpp>
+#include <ddsenabler_participants/Serialization.hpp>
+#include <ddsenabler_participants/Tracer.hpp>
 #include <ddsenabler_participants/rpc/RpcStructs.hpp>
 #include <ddsenabler_participants/rpc/RpcUtils.hpp>
 
@@ -138,16 +144,66 @@ public:
         action_cancel_request_notification_callback_ = callback;
     }
 
+    DDSENABLER_PARTICIPANTS_DllAPI
+    void set_discovery_batch_notification_callback(
+            DiscoveryBatchNotification callback)
+    {
+        discovery_batch_notification_callback_ = callback;
+    }
+
     /**
      * @brief Writes the schema of a DynamicType to user's app.
      *
      * @param [in] dyn_type DynamicType containing the type information required.
      * @param [in] type_id TypeIdentifier of the DynamicType.
+     * @param [in] lazy Whether to notify only the type name, leaving IDL, serialized collection and data
+     * placeholder empty.
      */
     DDSENABLER_PARTICIPANTS_DllAPI
     void write_schema(
             const fastdds::dds::DynamicType::_ref_type& dyn_type,
-            const fastdds::dds::xtypes::TypeIdentifier& type_id);
+            const fastdds::dds::xtypes::TypeIdentifier& type_id,
+            const bool lazy = false);
+
+    /**
+     * @brief Generates the IDL representation of a DynamicType.
+     *
+     * @param [in] dyn_type DynamicType to be serialized.
+     * @param [out] idl IDL representation of the type.
+     * @return \c true if the IDL was generated, \c false otherwise.
+     */
+    DDSENABLER_PARTICIPANTS_DllAPI
+    bool generate_type_idl(
+            const fastdds::dds::DynamicType::_ref_type& dyn_type,
+            std::string& idl);
+
+    /**
+     * @brief Generates the serialized collection of a DynamicType and all its dependencies.
+     *
+     * @param [in] dyn_type DynamicType to be serialized.
+     * @param [in] type_id TypeIdentifier of the DynamicType.
+     * @param [out] collection Serialized \c DynamicTypesCollection.
+     * @param [out] type_identifiers (Optional) Serialized identifiers of the types included in the collection.
+     * @return \c true if the collection was generated, \c false otherwise.
+     */
+    DDSENABLER_PARTICIPANTS_DllAPI
+    bool generate_type_collection(
+            const fastdds::dds::DynamicType::_ref_type& dyn_type,
+            const fastdds::dds::xtypes::TypeIdentifier& type_id,
+            std::vector<unsigned char>& collection,
+            std::vector<std::string>* type_identifiers = nullptr);
+
+    /**
+     * @brief Generates the JSON data placeholder of a DynamicType.
+     *
+     * @param [in] dyn_type DynamicType whose default data is serialized.
+     * @param [out] placeholder JSON data placeholder, filtered for action types.
+     * @return \c true if the placeholder was generated, \c false otherwise.
+     */
+    DDSENABLER_PARTICIPANTS_DllAPI
+    bool generate_type_placeholder(
+            const fastdds::dds::DynamicType::_ref_type& dyn_type,
+            std::string& placeholder);
 
     /**
      * @brief Writes the topic to user's app.
@@ -169,6 +225,19 @@ public:
             const Message& msg,
             const fastdds::dds::DynamicType::_ref_type& dyn_type);
 
+    /**
+     * @brief Writes data to a callback other than the data notification one (e.g. that of a typed subscription).
+     *
+     * The callback is timed by the watchdog and recorded in the sample metrics as data notifications are.
+     *
+     * @param [in] msg Pointer to the data to be written.
+     * @param [in] notification Notification invoking the callback, holding a copy of all its arguments.
+     */
+    DDSENABLER_PARTICIPANTS_DllAPI
+    void write_typed_data(
+            const Message& msg,
+            NotificationQueue::Notification&& notification);
+
     DDSENABLER_PARTICIPANTS_DllAPI
     void write_service_notification(
             const ddspipe::core::types::RpcTopic& service);
@@ -191,6 +260,22 @@ public:
     void write_action_notification(
             const RpcAction& action);
 
+    /**
+     * @brief Writes a batch of discovered entities to user's app.
+     *
+     * Entities are delivered in a single call to the discovery batch notification callback if set, falling back to
+     * the individual topic, service and action notification callbacks otherwise.
+     *
+     * @param [in] topics Discovered DDS topics.
+     * @param [in] services Discovered services.
+     * @param [in] actions Discovered actions.
+     */
+    DDSENABLER_PARTICIPANTS_DllAPI
+    void write_discovery_batch(
+            const std::vector<ddspipe::core::types::DdsTopic>& topics,
+            const std::vector<ddspipe::core::types::RpcTopic>& services,
+            const std::vector<RpcAction>& actions);
+
     DDSENABLER_PARTICIPANTS_DllAPI
     void write_action_result_notification(
             const Message& msg,
@@ -232,6 +317,49 @@ public:
             const std::string& action_name,
             const ActionType action_type);
 
+    /**
+     * @brief Releases the pubsub type associated to a DynamicType (e.g. evicted from the schema cache).
+     *
+     * @param [in] dyn_type DynamicType whose pubsub type is released.
+     */
+    DDSENABLER_PARTICIPANTS_DllAPI
+    void erase_pubsub_type(
+            const fastdds::dds::DynamicType::_ref_type& dyn_type)
+    {
+        dynamic_pubsub_types_.erase(dyn_type);
+    }
+
+    //! Number of pubsub types currently stored
+    DDSENABLER_PARTICIPANTS_DllAPI
+    std::size_t pubsub_types_size() const
+    {
+        return dynamic_pubsub_types_.size();
+    }
+
+    /**
+     * @brief Sets whether QoS are notified with the compact encoding instead of YAML.
+     *
+     * @param [in] compact Whether to use the compact QoS encoding.
+     */
+    DDSENABLER_PARTICIPANTS_DllAPI
+    void set_compact_qos(
+            bool compact)
+    {
+        compact_qos_ = compact;
+    }
+
+    /**
+     * @brief Sets whether type collections only reference (by hash) the dependencies delivered in previous ones.
+     *
+     * @param [in] incremental Whether to generate incremental type collections.
+     */
+    DDSENABLER_PARTICIPANTS_DllAPI
+    void set_incremental_type_collections(
+            bool incremental)
+    {
+        incremental_type_collections_ = incremental;
+    }
+
     DDSENABLER_PARTICIPANTS_DllAPI
     void set_is_UUID_active_callback(
             std::function<bool(const std::string&, const UUID&)> callback)
@@ -260,6 +388,42 @@ public:
         send_action_send_goal_reply_callback_ = callback;
     }
 
+    /**
+     * @brief Sets the queue where notifications are deferred to, so callbacks run once the caller's locks are released.
+     *
+     * @param [in] queue Notification queue, or \c nullptr to invoke the callbacks right away.
+     */
+    DDSENABLER_PARTICIPANTS_DllAPI
+    void set_notification_queue(
+            NotificationQueue* queue)
+    {
+        notification_queue_ = queue;
+    }
+
+    /**
+     * @brief Sets the watchdog timing the callbacks against their budget.
+     *
+     * @param [in] watchdog Callback watchdog, or \c nullptr to not time the callbacks.
+     */
+    DDSENABLER_PARTICIPANTS_DllAPI
+    void set_callback_watchdog(
+            CallbackWatchdog* watchdog)
+    {
+        callback_watchdog_ = watchdog;
+    }
+
+    /**
+     * @brief Sets the tracer recording the conversion and delivery of the traced samples.
+     *
+     * @param [in] tracer Tracer, or \c nullptr to not trace the samples.
+     */
+    DDSENABLER_PARTICIPANTS_DllAPI
+    void set_tracer(
+            Tracer* tracer)
+    {
+        tracer_ = tracer;
+    }
+
     bool uuid_from_request_json(
             const Message& msg,
             const fastdds::dds::DynamicType::_ref_type& dyn_type,
@@ -267,6 +431,38 @@ public:
 
 protected:
 
+    /**
+     * @brief Delivers a notification to the user's app, through the notification queue if set.
+     *
+     * @param [in] callback_name Name of the callback invoked by the notification, as reported by the watchdog.
+     * @param [in] entity_name Name of the topic, service, action or type the notification refers to.
+     * @param [in] notification Notification invoking a callback, holding a copy of all its arguments.
+     * @param [in] offloadable Whether the notifications of the entity may be offloaded by the watchdog.
+     * @param [in] metrics Metrics of the entity, counting the notification if dropped (if any).
+     */
+    void notify_(
+            const char* callback_name,
+            const std::string& entity_name,
+            NotificationQueue::Notification&& notification,
+            bool offloadable = false,
+            EntityMetrics* metrics = nullptr);
+
+    /**
+     * @brief Delivers a notification of a received sample to the user's app, recording it in the sample metrics.
+     *
+     * @param [in] callback_name Name of the callback invoked by the notification, as reported by the watchdog.
+     * @param [in] entity_name Name of the topic, service or action the notification refers to.
+     * @param [in] msg Sample the notification refers to.
+     * @param [in] notification Notification invoking a callback, holding a copy of all its arguments.
+     * @param [in] offloadable Whether the notifications of the entity may be offloaded by the watchdog.
+     */
+    void notify_(
+            const char* callback_name,
+            const std::string& entity_name,
+            const Message& msg,
+            NotificationQueue::Notification&& notification,
+            bool offloadable = false);
+
     /**
      * @brief Returns the dyn_data of a dyn_type.
      *
@@ -284,14 +480,26 @@ protected:
      * @return The pubsub type associated to the given dyn_type.
      * @note If the pubsub type is not already created, it will be created and stored in the map.
      */
-    fastdds::dds::DynamicPubSubType get_pubsub_type_(
-            const fastdds::dds::DynamicType::_ref_type& dyn_type) noexcept;
+    fastdds::dds::DynamicPubSubType& get_pubsub_type_(
+            const fastdds::dds::DynamicType::_ref_type& dyn_type);
 
     bool prepare_json_data_(
             const Message& msg,
             const fastdds::dds::DynamicType::_ref_type& dyn_type,
             nlohmann::json& json_output);
 
+    //! Notification information of a DDS topic
+    TopicInfo topic_info_(
+            const ddspipe::core::types::DdsTopic& topic) const;
+
+    //! Notification information of a service
+    ServiceInfo service_info_(
+            const ddspipe::core::types::RpcTopic& service) const;
+
+    //! Notification information of an action
+    ActionInfo action_info_(
+            const RpcAction& action) const;
+
     // Callbacks to notify the user's app
     DdsDataNotification data_notification_callback_;
     DdsTypeNotification type_notification_callback_;
@@ -305,17 +513,36 @@ protected:
     ActionStatusNotification action_status_notification_callback_;
     ActionGoalRequestNotification action_goal_request_notification_callback_;
     ActionCancelRequestNotification action_cancel_request_notification_callback_;
+    DiscoveryBatchNotification discovery_batch_notification_callback_;
 
 
 
     // Map to store the pubsub types associated to dynamic types so they can be reused
-    std::map<fastdds::dds::DynamicType::_ref_type, fastdds::dds::DynamicPubSubType> dynamic_pubsub_types_;
+    std::unordered_map<fastdds::dds::DynamicType::_ref_type, fastdds::dds::DynamicPubSubType> dynamic_pubsub_types_;
+
+    // Cache of serialized types, so dependencies shared by several types are only serialized once
+    serialization::DynamicTypesCache types_cache_;
+
+    // Whether type collections reference the dependencies already delivered instead of including them
+    bool incremental_type_collections_ {false};
+
+    // Whether QoS are notified with the compact encoding instead of YAML
+    bool compact_qos_ {false};
 
     std::function<bool(const std::string&, const UUID&)> is_UUID_active_callback_;
     std::function<void(const UUID&, ActionEraseReason)> erase_action_UUID_callback_;
     std::function<bool(const std::string&, const participants::UUID&)> send_action_get_result_request_callback_;
     std::function<void(const std::string&, const uint64_t, bool accepted)> send_action_send_goal_reply_callback_;
 
+    // Queue where notifications are deferred to (not owned)
+    NotificationQueue* notification_queue_ {nullptr};
+
+    // Watchdog timing the callbacks (not owned)
+    CallbackWatchdog* callback_watchdog_ {nullptr};
+
+    // Tracer of the samples (not owned)
+    Tracer* tracer_ {nullptr};
+
 };
 
 } /* namespace participants */
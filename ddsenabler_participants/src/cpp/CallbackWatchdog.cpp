@@ -0,0 +1,288 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file CallbackWatchdog.cpp
+ */
+
+#include <utility>
+
+#include <fastdds/dds/log/Log.hpp>
+
+#include <ddsenabler_participants/CallbackWatchdog.hpp>
+
+namespace eprosima {
+namespace ddsenabler {
+namespace participants {
+
+namespace {
+
+//! Name of the single class of the offloading dispatcher
+constexpr const char* OFFLOADED_CLASS_NAME = "offloaded";
+
+} // namespace
+
+CallbackWatchdog::CallbackWatchdog(
+        std::chrono::nanoseconds budget,
+        uint32_t offload_threshold)
+    : budget_(budget)
+    , offload_threshold_(offload_threshold)
+{
+    if (offload_threshold_ > 0)
+    {
+        PriorityClass offloaded_class;
+        offloaded_class.name = OFFLOADED_CLASS_NAME;
+        offload_dispatcher_ = std::make_unique<PriorityDispatcher>(
+            std::vector<PriorityClass>{offloaded_class}, PriorityScheduling::STRICT);
+    }
+}
+
+void CallbackWatchdog::invoke(
+        const char* callback_name,
+        const std::string& entity_name,
+        const NotificationQueue::Notification& notification,
+        bool offloadable)
+{
+    const auto start = std::chrono::steady_clock::now();
+    notification();
+    const auto duration = std::chrono::steady_clock::now() - start;
+
+    const bool over_budget = duration > budget_;
+
+    bool offloaded = false;
+    bool newly_offloaded = false;
+    if (offloadable && offload_threshold_ > 0)
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+
+        // Only consecutive overruns count towards offloading, and only consecutive callbacks within budget towards
+        // restoring
+        offloaded = offloaded_.count(entity_name) > 0;
+        if (offloaded)
+        {
+            if (over_budget)
+            {
+                within_budget_.erase(entity_name);
+            }
+            else
+            {
+                ++within_budget_[entity_name];
+            }
+        }
+        else
+        {
+            if (!over_budget)
+            {
+                overruns_.erase(entity_name);
+            }
+            else if (++overruns_[entity_name] >= offload_threshold_)
+            {
+                overruns_.erase(entity_name);
+                offloaded_.insert(entity_name);
+                offloaded = true;
+                newly_offloaded = true;
+            }
+        }
+    }
+
+    if (!over_budget)
+    {
+        return;
+    }
+
+    const auto duration_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+    EPROSIMA_LOG_WARNING(DDSENABLER_CALLBACK_WATCHDOG,
+            "Callback " << callback_name << " for " << entity_name << " took " << duration_ns / 1000000 <<
+            " ms, exceeding its budget of " << std::chrono::duration_cast<std::chrono::milliseconds>(budget_).count() <<
+            " ms" <<
+            (newly_offloaded ? ": its notifications are delivered from a dedicated thread from now on." : "."));
+
+    if (slow_callback_notification_callback_)
+    {
+        slow_callback_notification_callback_(callback_name, entity_name.c_str(), duration_ns, offloaded);
+    }
+}
+
+bool CallbackWatchdog::is_offloaded(
+        const std::string& entity_name) const
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+
+    return offloaded_.count(entity_name) > 0;
+}
+
+bool CallbackWatchdog::offload(
+        const std::string& entity_name,
+        NotificationQueue::Notification& notification,
+        NotificationQueue::Notification&& on_drop)
+{
+    if (!offload_dispatcher_)
+    {
+        return false;
+    }
+
+    std::unique_lock<std::mutex> lock(mtx_);
+    if (offloaded_.count(entity_name) == 0)
+    {
+        // Counted until delivered, so the entity is only moved to the offloading thread once none of its
+        // notifications is left in the notification queue
+        ++queued_[entity_name];
+        notification = [this, entity_name, queued = std::move(notification)]()
+                {
+                    try
+                    {
+                        queued();
+                    }
+                    catch (...)
+                    {
+                        queued_done_(entity_name);
+                        throw;
+                    }
+                    queued_done_(entity_name);
+                };
+        return false;
+    }
+
+    // Counted before queuing, so the entity is not restored while any of its notifications is pending and they are
+    // not overtaken by those delivered from the notification queue
+    ++offloaded_pending_[entity_name];
+
+    NotificationQueue::Notification task = [this, entity_name, offloaded = std::move(notification)]()
+            {
+                try
+                {
+                    offloaded();
+                }
+                catch (...)
+                {
+                    offloaded_done_(entity_name);
+                    throw;
+                }
+                offloaded_done_(entity_name);
+            };
+    NotificationQueue::Notification dropped = [this, entity_name, on_drop = std::move(on_drop)]()
+            {
+                if (on_drop)
+                {
+                    on_drop();
+                }
+                offloaded_done_(entity_name);
+            };
+
+    // Held while the notification queue still has previous notifications of the entity, so they are not overtaken
+    // and never run concurrently with these
+    auto queued = queued_.find(entity_name);
+    auto held = held_.find(entity_name);
+    if ((queued != queued_.end() && queued->second > 0) || held != held_.end())
+    {
+        held_[entity_name].emplace_back(std::move(task), std::move(dropped));
+        return true;
+    }
+    lock.unlock();
+
+    // Queued unlocked, as a dropped notification reports back to the watchdog with the dispatcher locked
+    if (!offload_dispatcher_->push(0, std::move(task), std::move(dropped)))
+    {
+        EPROSIMA_LOG_WARNING(DDSENABLER_CALLBACK_WATCHDOG,
+                "Dropped the oldest offloaded notification: the offloading queue is full.");
+    }
+    return true;
+}
+
+void CallbackWatchdog::queued_done_(
+        const std::string& entity_name)
+{
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+
+        auto queued = queued_.find(entity_name);
+        if (queued != queued_.end() && --queued->second > 0)
+        {
+            return;
+        }
+        queued_.erase(entity_name);
+
+        if (held_.count(entity_name) == 0)
+        {
+            return;
+        }
+    }
+
+    release_held_(entity_name);
+}
+
+void CallbackWatchdog::offloaded_done_(
+        const std::string& entity_name)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+
+    auto pending = offloaded_pending_.find(entity_name);
+    if (pending != offloaded_pending_.end() && --pending->second > 0)
+    {
+        return;
+    }
+    offloaded_pending_.erase(entity_name);
+
+    // Not restored while releasing held notifications either, so those queued afterwards follow them
+    auto within_budget = within_budget_.find(entity_name);
+    if (within_budget == within_budget_.end() || within_budget->second < offload_threshold_ ||
+            held_.count(entity_name) > 0)
+    {
+        return;
+    }
+
+    within_budget_.erase(within_budget);
+    offloaded_.erase(entity_name);
+    EPROSIMA_LOG_INFO(DDSENABLER_CALLBACK_WATCHDOG,
+            "Callbacks for " << entity_name << " are within their budget again: its notifications are delivered "
+            "from the notification queue from now on.");
+}
+
+void CallbackWatchdog::release_held_(
+        const std::string& entity_name)
+{
+    // Released in batches, keeping the entity in the held ones meanwhile so new notifications are queued after them
+    while (true)
+    {
+        std::deque<std::pair<NotificationQueue::Notification, NotificationQueue::Notification>> batch;
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+
+            auto held = held_.find(entity_name);
+            if (held == held_.end())
+            {
+                return;
+            }
+            if (held->second.empty())
+            {
+                held_.erase(held);
+                return;
+            }
+            batch.swap(held->second);
+        }
+
+        for (auto& notification : batch)
+        {
+            if (!offload_dispatcher_->push(0, std::move(notification.first), std::move(notification.second)))
+            {
+                EPROSIMA_LOG_WARNING(DDSENABLER_CALLBACK_WATCHDOG,
+                        "Dropped the oldest offloaded notification: the offloading queue is full.");
+            }
+        }
+    }
+}
+
+} /* namespace participants */
+} /* namespace ddsenabler */
+} /* namespace eprosima */
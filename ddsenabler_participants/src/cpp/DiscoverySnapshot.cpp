@@ -0,0 +1,203 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file DiscoverySnapshot.cpp
+ */
+
+#include <filesystem>
+#include <fstream>
+
+#include <nlohmann/json.hpp>
+
+#include <fastdds/dds/log/Log.hpp>
+
+#include <ddsenabler_participants/DiscoverySnapshot.hpp>
+
+namespace eprosima {
+namespace ddsenabler {
+namespace participants {
+
+namespace {
+
+nlohmann::json topic_to_json(
+        const TopicInfo& topic)
+{
+    return {{"type", topic.type_name}, {"qos", topic.serialized_qos}};
+}
+
+TopicInfo topic_from_json(
+        const nlohmann::json& json)
+{
+    return TopicInfo(json.at("type").get<std::string>(), json.at("qos").get<std::string>());
+}
+
+nlohmann::json service_to_json(
+        const ServiceInfo& service)
+{
+    return {{"request", topic_to_json(service.request)}, {"reply", topic_to_json(service.reply)}};
+}
+
+ServiceInfo service_from_json(
+        const nlohmann::json& json)
+{
+    return ServiceInfo(topic_from_json(json.at("request")), topic_from_json(json.at("reply")));
+}
+
+std::string protocol_to_string(
+        Protocol protocol)
+{
+    return (Protocol::DDS == protocol) ? "dds" : "ros2";
+}
+
+Protocol protocol_from_string(
+        const std::string& protocol)
+{
+    return ("dds" == protocol) ? Protocol::DDS : Protocol::ROS2;
+}
+
+} // namespace
+
+bool DiscoverySnapshot::save(
+        const std::string& path) const
+{
+    nlohmann::json json;
+    json["version"] = DISCOVERY_SNAPSHOT_VERSION;
+
+    json["topics"] = nlohmann::json::array();
+    for (const auto& topic : topics)
+    {
+        nlohmann::json topic_json = topic_to_json(topic.second);
+        topic_json["name"] = topic.first;
+        json["topics"].push_back(std::move(topic_json));
+    }
+
+    json["services"] = nlohmann::json::array();
+    for (const auto& service : services)
+    {
+        nlohmann::json service_json = service_to_json(service.info);
+        service_json["name"] = service.name;
+        service_json["protocol"] = protocol_to_string(service.protocol);
+        json["services"].push_back(std::move(service_json));
+    }
+
+    json["actions"] = nlohmann::json::array();
+    for (const auto& action : actions)
+    {
+        json["actions"].push_back({
+                    {"name", action.name},
+                    {"protocol", protocol_to_string(action.protocol)},
+                    {"goal", service_to_json(action.info.goal)},
+                    {"result", service_to_json(action.info.result)},
+                    {"cancel", service_to_json(action.info.cancel)},
+                    {"feedback", topic_to_json(action.info.feedback)},
+                    {"status", topic_to_json(action.info.status)}
+                });
+    }
+
+    // Write to a temporary file first, so a crash while writing never leaves a truncated snapshot behind
+    const std::string tmp_path = path + ".tmp";
+    {
+        std::ofstream file(tmp_path, std::ios::trunc);
+        if (!file)
+        {
+            EPROSIMA_LOG_ERROR(DDSENABLER_DISCOVERY_SNAPSHOT,
+                    "Failed to write discovery snapshot: cannot open " << tmp_path << ".");
+            return false;
+        }
+        file << json.dump();
+        if (!file.flush())
+        {
+            EPROSIMA_LOG_ERROR(DDSENABLER_DISCOVERY_SNAPSHOT,
+                    "Failed to write discovery snapshot to " << tmp_path << ".");
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tmp_path, path, ec);
+    if (ec)
+    {
+        EPROSIMA_LOG_ERROR(DDSENABLER_DISCOVERY_SNAPSHOT,
+                "Failed to write discovery snapshot to " << path << ": " << ec.message());
+        return false;
+    }
+
+    return true;
+}
+
+bool DiscoverySnapshot::load(
+        const std::string& path)
+{
+    std::ifstream file(path);
+    if (!file)
+    {
+        EPROSIMA_LOG_ERROR(DDSENABLER_DISCOVERY_SNAPSHOT,
+                "Failed to read discovery snapshot: cannot open " << path << ".");
+        return false;
+    }
+
+    try
+    {
+        const nlohmann::json json = nlohmann::json::parse(file);
+        if (json.at("version").get<unsigned int>() != DISCOVERY_SNAPSHOT_VERSION)
+        {
+            EPROSIMA_LOG_ERROR(DDSENABLER_DISCOVERY_SNAPSHOT,
+                    "Failed to read discovery snapshot " << path << ": unsupported version " << json.at("version") <<
+                    ".");
+            return false;
+        }
+
+        DiscoverySnapshot snapshot;
+        for (const auto& topic_json : json.at("topics"))
+        {
+            snapshot.topics.emplace_back(topic_json.at("name").get<std::string>(), topic_from_json(topic_json));
+        }
+        for (const auto& service_json : json.at("services"))
+        {
+            SnapshotService service;
+            service.name = service_json.at("name").get<std::string>();
+            service.protocol = protocol_from_string(service_json.at("protocol").get<std::string>());
+            service.info = service_from_json(service_json);
+            snapshot.services.push_back(std::move(service));
+        }
+        for (const auto& action_json : json.at("actions"))
+        {
+            SnapshotAction action;
+            action.name = action_json.at("name").get<std::string>();
+            action.protocol = protocol_from_string(action_json.at("protocol").get<std::string>());
+            action.info = ActionInfo(
+                service_from_json(action_json.at("goal")),
+                service_from_json(action_json.at("result")),
+                service_from_json(action_json.at("cancel")),
+                topic_from_json(action_json.at("feedback")),
+                topic_from_json(action_json.at("status")));
+            snapshot.actions.push_back(std::move(action));
+        }
+
+        *this = std::move(snapshot);
+    }
+    catch (const nlohmann::json::exception& e)
+    {
+        EPROSIMA_LOG_ERROR(DDSENABLER_DISCOVERY_SNAPSHOT,
+                "Failed to read discovery snapshot " << path << ": " << e.what());
+        return false;
+    }
+
+    return true;
+}
+
+} /* namespace participants */
+} /* namespace ddsenabler */
+} /* namespace eprosima */
@@ -16,6 +16,13 @@
  * @file EnablerParticipant.cpp
  */
 
+#include <algorithm>
+#include <chrono>
+#include <optional>
+#include <set>
+#include <vector>
+
+#include <ddspipe_core/dynamic/DiscoveryDatabase.hpp>
 #include <ddspipe_core/types/data/RtpsPayloadData.hpp>
 #include <ddspipe_core/types/data/RpcPayloadData.hpp>
 #include <ddspipe_core/types/dds/Payload.hpp>
@@ -25,6 +32,7 @@
 
 #include <ddsenabler_participants/Handler.hpp>
 #include <ddsenabler_participants/Serialization.hpp>
+#include <ddsenabler_participants/Tracer.hpp>
 
 #include <ddsenabler_participants/EnablerParticipant.hpp>
 
@@ -45,6 +53,19 @@ EnablerParticipant::EnablerParticipant(
             schema_handler)
     , handler_(std::static_pointer_cast<Handler>(schema_handler_))
 {
+    // Registered before the DDS Pipe ones, so endpoints are tracked before their readers are created
+    discovery_database_->add_endpoint_discovered_callback([this](Endpoint endpoint)
+            {
+                on_endpoint_changed_(endpoint, false);
+            });
+    discovery_database_->add_endpoint_updated_callback([this](Endpoint endpoint)
+            {
+                on_endpoint_changed_(endpoint, false);
+            });
+    discovery_database_->add_endpoint_erased_callback([this](Endpoint endpoint)
+            {
+                on_endpoint_changed_(endpoint, true);
+            });
 }
 
 std::shared_ptr<IReader> EnablerParticipant::create_reader(
@@ -56,8 +77,12 @@ std::shared_ptr<IReader> EnablerParticipant::create_reader(
     }
 
     std::shared_ptr<InternalReader> reader;
+    // Discovered entities are notified once the participant lock is released
+    std::optional<DdsTopic> discovered_topic;
+    std::optional<RpcTopic> discovered_service;
+    std::optional<RpcAction> discovered_action;
     {
-        std::lock_guard<std::mutex> lck(mtx_);
+        std::lock_guard<MeteredMutex<std::mutex>> lck(mtx_);
         auto dds_topic = dynamic_cast<const DdsTopic&>(topic);
         std::shared_ptr<RpcInfo> rpc_info = std::make_shared<RpcInfo>(dds_topic.m_topic_name);
 
@@ -81,8 +106,8 @@ std::shared_ptr<IReader> EnablerParticipant::create_reader(
                     {
                         try
                         {
-                            RpcTopic service = services_.find(rpc_info->service_name)->second->get_service();
-                            handler_->add_service(service);
+                            discovered_service.emplace(
+                                services_.find(rpc_info->service_name)->second->get_service());
                         }
                         catch (const std::exception& e)
                         {
@@ -98,8 +123,8 @@ std::shared_ptr<IReader> EnablerParticipant::create_reader(
                     {
                         try
                         {
-                            auto action = actions_.find(rpc_info->action_name)->second->get_action();
-                            handler_->add_action(action);
+                            discovered_action.emplace(
+                                actions_.find(rpc_info->action_name)->second->get_action());
                         }
                         catch (const std::exception& e)
                         {
@@ -117,12 +142,27 @@ std::shared_ptr<IReader> EnablerParticipant::create_reader(
             // Only notify the discovery of topics that do not originate from a topic query callback
             if (dds_topic.topic_discoverer() != this->id())
             {
-                handler_->add_topic(dds_topic);
+                discovered_topic.emplace(dds_topic);
             }
         }
         readers_[dds_topic] = reader;
+        update_type_reference_nts_(dds_topic.m_topic_name, dds_topic.type_name);
     }
     cv_.notify_all();
+
+    if (discovered_topic)
+    {
+        handler_->add_topic(*discovered_topic);
+    }
+    else if (discovered_service)
+    {
+        handler_->add_service(*discovered_service);
+    }
+    else if (discovered_action)
+    {
+        handler_->add_action(*discovered_action);
+    }
+
     return reader;
 }
 
@@ -137,55 +177,294 @@ bool EnablerParticipant::publish(
         return false;
     }
 
-    std::unique_lock<std::mutex> lck(mtx_);
+    NotificationScope notifications(handler_->notification_queue());
+    Tracer* tracer = handler_->tracer();
+    TraceSpan publish_span(tracer, tracer ? tracer->start_trace() : 0, SpanKind::PUBLISH);
+    std::unique_lock<MeteredMutex<std::mutex>> lck(mtx_);
 
     std::string type_name;
-    auto i_reader = lookup_reader_nts_(topic_name, type_name);
+    auto reader = get_topic_reader_nts_(topic_name, type_name, lck);
+    if (nullptr == reader)
+    {
+        return false;
+    }
 
-    if (nullptr == i_reader)
+    auto data = std::make_unique<RtpsPayloadData>();
+
+    EntityMetrics& metrics = handler_->entity_metrics(topic_name);
+    publish_span.entity(metrics.name.c_str());
+    const auto start = std::chrono::steady_clock::now();
+    Payload payload;
+    TraceSpan serialize_span = publish_span.child(SpanKind::SERIALIZE);
+    if (!handler_->get_serialized_data(type_name, json, payload))
     {
-        DdsTopic topic;
-        if (!query_topic_nts_(topic_name, topic))
+        EPROSIMA_LOG_ERROR(DDSENABLER_ENABLER_PARTICIPANT,
+                "Failed to publish data in topic " << topic_name << " : data serialization failed.");
+        return false;
+    }
+    serialize_span.end();
+    metrics.record_conversion(start);
+
+    if (!payload_pool_->get_payload(payload, data->payload))
+    {
+        EPROSIMA_LOG_ERROR(DDSENABLER_ENABLER_PARTICIPANT,
+                "Failed to publish data in topic " << topic_name << " : get_payload failed.");
+        return false;
+    }
+
+    metrics.published.fetch_add(1, std::memory_order_relaxed);
+    metrics.bytes_out.fetch_add(data->payload.length, std::memory_order_relaxed);
+    TraceSpan write_span = publish_span.child(SpanKind::WRITE);
+    reader->simulate_data_reception(std::move(data));
+    return true;
+}
+
+bool EnablerParticipant::declare_topic(
+        const std::string& topic_name,
+        const TopicInfo& topic_info)
+{
+    if (topic_name.empty())
+    {
+        EPROSIMA_LOG_ERROR(DDSENABLER_ENABLER_PARTICIPANT,
+                "Failed to declare topic: topic name is empty.");
+        return false;
+    }
+
+    NotificationScope notifications(handler_->notification_queue());
+    std::unique_lock<MeteredMutex<std::mutex>> lck(mtx_);
+
+    std::string type_name;
+    if (nullptr != lookup_reader_nts_(topic_name, type_name))
+    {
+        if (type_name != topic_info.type_name)
         {
             EPROSIMA_LOG_ERROR(DDSENABLER_ENABLER_PARTICIPANT,
-                    "Failed to publish data in topic " << topic_name);
+                    "Failed to declare topic " << topic_name << " : topic already exists with type " << type_name <<
+                    ".");
             return false;
         }
+        return true;
+    }
 
-        if (!create_topic_writer_nts_(topic, i_reader, lck))
+    DdsTopic topic;
+    if (!fill_topic_struct_nts_(topic_name, topic_info, topic))
+    {
+        return false;
+    }
+
+    return declare_topic_nts_(topic, lck);
+}
+
+bool EnablerParticipant::declare_topic(
+        const std::string& topic_name)
+{
+    if (topic_name.empty())
+    {
+        EPROSIMA_LOG_ERROR(DDSENABLER_ENABLER_PARTICIPANT,
+                "Failed to declare topic: topic name is empty.");
+        return false;
+    }
+
+    NotificationScope notifications(handler_->notification_queue());
+    std::unique_lock<MeteredMutex<std::mutex>> lck(mtx_);
+
+    if (nullptr != lookup_reader_nts_(topic_name))
+    {
+        return true;
+    }
+
+    DdsTopic topic;
+    if (!query_topic_nts_(topic_name, topic))
+    {
+        EPROSIMA_LOG_ERROR(DDSENABLER_ENABLER_PARTICIPANT,
+                "Failed to declare topic " << topic_name);
+        return false;
+    }
+
+    return declare_topic_nts_(topic, lck);
+}
+
+bool EnablerParticipant::declare_topics(
+        const std::vector<std::pair<std::string, TopicInfo>>& topics_info)
+{
+    NotificationScope notifications(handler_->notification_queue());
+    std::unique_lock<MeteredMutex<std::mutex>> lck(mtx_);
+
+    bool ret = true;
+    std::vector<DdsTopic> topics;
+    for (const auto& topic_info : topics_info)
+    {
+        std::string type_name;
+        if (nullptr != lookup_reader_nts_(topic_info.first, type_name))
         {
-            EPROSIMA_LOG_ERROR(DDSENABLER_ENABLER_PARTICIPANT,
-                    "Failed to publish data in topic " << topic_name << " : writer creation failed.");
-            return false;
+            if (type_name != topic_info.second.type_name)
+            {
+                EPROSIMA_LOG_ERROR(DDSENABLER_ENABLER_PARTICIPANT,
+                        "Failed to declare topic " << topic_info.first << " : topic already exists with type " <<
+                        type_name << ".");
+                ret = false;
+            }
+            continue;
         }
 
-        type_name = topic.type_name;
+        DdsTopic topic;
+        if (!fill_topic_struct_nts_(topic_info.first, topic_info.second, topic))
+        {
+            ret = false;
+            continue;
+        }
+        topics.push_back(topic);
+    }
 
-        // (Optionally) wait for writer created in DDS participant to match with external readers, to avoid losing this
-        // message when not using transient durability
-        std::this_thread::sleep_for(std::chrono::milliseconds(std::static_pointer_cast<EnablerParticipantConfiguration>(
-                    configuration_)->initial_publish_wait));
+    if (topics.empty())
+    {
+        return ret;
+    }
+
+    std::vector<ddspipe::core::types::Endpoint> request_edps;
+    if (!create_topic_writers_nts_(topics, request_edps, lck))
+    {
+        EPROSIMA_LOG_ERROR(DDSENABLER_ENABLER_PARTICIPANT,
+                "Failed to declare topics : writers creation failed.");
+        return false;
+    }
+
+    // (Optionally) wait once for all the writers created to match with external readers
+    lck.unlock();
+    std::this_thread::sleep_for(std::chrono::milliseconds(std::static_pointer_cast<EnablerParticipantConfiguration>(
+                configuration_)->initial_publish_wait));
+
+    return ret;
+}
+
+bool EnablerParticipant::loan_payload(
+        const std::string& topic_name,
+        const uint32_t size,
+        Payload& loan)
+{
+    if (topic_name.empty())
+    {
+        EPROSIMA_LOG_ERROR(DDSENABLER_ENABLER_PARTICIPANT,
+                "Failed to loan payload: topic name is empty.");
+        return false;
     }
 
-    auto reader = std::dynamic_pointer_cast<InternalReader>(i_reader);
+    if (0 == size)
+    {
+        EPROSIMA_LOG_ERROR(DDSENABLER_ENABLER_PARTICIPANT,
+                "Failed to loan payload for topic " << topic_name << " : requested size is zero.");
+        return false;
+    }
+
+    NotificationScope notifications(handler_->notification_queue());
+    std::unique_lock<MeteredMutex<std::mutex>> lck(mtx_);
 
+    // Resolve the topic (creating its writer if needed) so the loan can be published right away
+    std::string type_name;
+    if (nullptr == get_topic_reader_nts_(topic_name, type_name, lck))
+    {
+        return false;
+    }
+
+    if (!payload_pool_->get_payload(size, loan))
+    {
+        EPROSIMA_LOG_ERROR(DDSENABLER_ENABLER_PARTICIPANT,
+                "Failed to loan payload for topic " << topic_name << " : get_payload failed.");
+        return false;
+    }
+    loan.length = size;
+
+    return true;
+}
+
+bool EnablerParticipant::publish_loaned(
+        const std::string& topic_name,
+        Payload& loan)
+{
+    if (loan.payload_owner != payload_pool_.get())
+    {
+        EPROSIMA_LOG_ERROR(DDSENABLER_ENABLER_PARTICIPANT,
+                "Failed to publish loaned payload in topic " << topic_name <<
+                " : payload was not loaned by this participant.");
+        return false;
+    }
+
+    if (0 == loan.length || loan.length > loan.max_size)
+    {
+        EPROSIMA_LOG_ERROR(DDSENABLER_ENABLER_PARTICIPANT,
+                "Failed to publish loaned payload in topic " << topic_name << " : invalid payload length " <<
+                loan.length << ".");
+        return false;
+    }
+
+    Tracer* tracer = handler_->tracer();
+    TraceSpan publish_span(tracer, tracer ? tracer->start_trace() : 0, SpanKind::PUBLISH);
+    std::unique_lock<MeteredMutex<std::mutex>> lck(mtx_);
+
+    auto reader = std::dynamic_pointer_cast<InternalReader>(lookup_reader_nts_(topic_name));
+    if (nullptr == reader)
+    {
+        EPROSIMA_LOG_ERROR(DDSENABLER_ENABLER_PARTICIPANT,
+                "Failed to publish loaned payload in topic " << topic_name << " : topic not found.");
+        return false;
+    }
+
+    // Hand the loaned buffer over to the data without copying it, ownership is released when the sample is consumed
     auto data = std::make_unique<RtpsPayloadData>();
+    data->payload = std::move(loan);
 
-    Payload payload;
-    if (!handler_->get_serialized_data(type_name, json, payload))
+    EntityMetrics& metrics = handler_->entity_metrics(topic_name);
+    publish_span.entity(metrics.name.c_str());
+    metrics.published.fetch_add(1, std::memory_order_relaxed);
+    metrics.bytes_out.fetch_add(data->payload.length, std::memory_order_relaxed);
+    TraceSpan write_span = publish_span.child(SpanKind::WRITE);
+    reader->simulate_data_reception(std::move(data));
+    return true;
+}
+
+bool EnablerParticipant::publish_cdr(
+        const std::string& topic_name,
+        const uint8_t* cdr,
+        const uint32_t size,
+        fastdds::dds::DataRepresentationId_t representation)
+{
+    if (topic_name.empty())
     {
         EPROSIMA_LOG_ERROR(DDSENABLER_ENABLER_PARTICIPANT,
-                "Failed to publish data in topic " << topic_name << " : data serialization failed.");
+                "Failed to publish data: topic name is empty.");
         return false;
     }
 
-    if (!payload_pool_->get_payload(payload, data->payload))
+    NotificationScope notifications(handler_->notification_queue());
+    Tracer* tracer = handler_->tracer();
+    TraceSpan publish_span(tracer, tracer ? tracer->start_trace() : 0, SpanKind::PUBLISH);
+    std::unique_lock<MeteredMutex<std::mutex>> lck(mtx_);
+
+    std::string type_name;
+    auto reader = get_topic_reader_nts_(topic_name, type_name, lck);
+    if (nullptr == reader)
+    {
+        return false;
+    }
+
+    auto data = std::make_unique<RtpsPayloadData>();
+
+    EntityMetrics& metrics = handler_->entity_metrics(topic_name);
+    publish_span.entity(metrics.name.c_str());
+
+    // Store the (validated) data straight into the sample payload, no intermediate payload is needed
+    TraceSpan serialize_span = publish_span.child(SpanKind::SERIALIZE);
+    if (!handler_->get_serialized_data(type_name, cdr, size, representation, data->payload))
     {
         EPROSIMA_LOG_ERROR(DDSENABLER_ENABLER_PARTICIPANT,
-                "Failed to publish data in topic " << topic_name << " : get_payload failed.");
+                "Failed to publish data in topic " << topic_name << " : invalid CDR data.");
         return false;
     }
+    serialize_span.end();
 
+    metrics.published.fetch_add(1, std::memory_order_relaxed);
+    metrics.bytes_out.fetch_add(data->payload.length, std::memory_order_relaxed);
+    TraceSpan write_span = publish_span.child(SpanKind::WRITE);
     reader->simulate_data_reception(std::move(data));
     return true;
 }
@@ -195,7 +474,7 @@ bool EnablerParticipant::publish_rpc(
         const std::string& json,
         const uint64_t request_id)
 {
-    std::unique_lock<std::mutex> lck(mtx_);
+    std::unique_lock<MeteredMutex<std::mutex>> lck(mtx_);
 
     std::shared_ptr<RpcInfo> rpc_info = std::make_shared<RpcInfo>(topic_name);
 
@@ -250,6 +529,8 @@ bool EnablerParticipant::publish_rpc(
 
     auto data = std::make_unique<RpcPayloadData>();
 
+    EntityMetrics& metrics = handler_->entity_metrics(topic_name);
+    const auto start = std::chrono::steady_clock::now();
     Payload payload;
     if (!handler_->get_serialized_data(type_name, json, payload))
     {
@@ -257,6 +538,7 @@ bool EnablerParticipant::publish_rpc(
                 "Failed to publish data in topic " << topic.m_topic_name << " : data serialization failed.");
         return false;
     }
+    metrics.record_conversion(start);
 
     if (!payload_pool_->get_payload(payload, data->payload))
     {
@@ -275,6 +557,8 @@ bool EnablerParticipant::publish_rpc(
     data->write_params.get_reference().sample_identity(sample_identity);
     data->write_params.get_reference().related_sample_identity(sample_identity);
 
+    metrics.published.fetch_add(1, std::memory_order_relaxed);
+    metrics.bytes_out.fetch_add(data->payload.length, std::memory_order_relaxed);
     reader->simulate_data_reception(std::move(data));
     return true;
 }
@@ -283,8 +567,29 @@ bool EnablerParticipant::announce_service(
         const std::string& service_name,
         Protocol Protocol)
 {
-    std::unique_lock<std::mutex> lck(mtx_);
+    NotificationScope notifications(handler_->notification_queue());
+    std::unique_lock<MeteredMutex<std::mutex>> lck(mtx_);
+
+    return announce_service_nts_(service_name, nullptr, Protocol, lck);
+}
 
+bool EnablerParticipant::announce_service(
+        const std::string& service_name,
+        const ServiceInfo& service_info,
+        Protocol Protocol)
+{
+    NotificationScope notifications(handler_->notification_queue());
+    std::unique_lock<MeteredMutex<std::mutex>> lck(mtx_);
+
+    return announce_service_nts_(service_name, &service_info, Protocol, lck);
+}
+
+bool EnablerParticipant::announce_service_nts_(
+        const std::string& service_name,
+        const ServiceInfo* service_info,
+        Protocol Protocol,
+        std::unique_lock<MeteredMutex<std::mutex>>& lck)
+{
     auto it = services_.find(service_name);
     if (it != services_.end())
     {
@@ -299,7 +604,16 @@ bool EnablerParticipant::announce_service(
     }
 
     std::shared_ptr<ServiceDiscovered> service = std::make_shared<ServiceDiscovered>(service_name, Protocol);
-    if (!query_service_nts_(service, Protocol))
+    if (nullptr != service_info)
+    {
+        if (!fill_service_type_nts_(*service_info, service, Protocol))
+        {
+            EPROSIMA_LOG_ERROR(DDSENABLER_ENABLER_PARTICIPANT,
+                    "Failed to announce service " << service_name << " : service types not found.");
+            return false;
+        }
+    }
+    else if (!query_service_nts_(service, Protocol))
     {
         return false;
     }
@@ -319,7 +633,7 @@ bool EnablerParticipant::announce_service(
 bool EnablerParticipant::revoke_service(
         const std::string& service_name)
 {
-    std::unique_lock<std::mutex> lck(mtx_);
+    std::unique_lock<MeteredMutex<std::mutex>> lck(mtx_);
 
     return revoke_service_nts_(service_name);
 }
@@ -393,7 +707,7 @@ bool EnablerParticipant::send_service_reply(
 Protocol EnablerParticipant::get_service_protocol(
         const std::string& service_name)
 {
-    std::unique_lock<std::mutex> lck(mtx_);
+    std::unique_lock<MeteredMutex<std::mutex>> lck(mtx_);
     auto it = services_.find(service_name);
     if (it != services_.end())
     {
@@ -403,12 +717,42 @@ Protocol EnablerParticipant::get_service_protocol(
     return Protocol::PROTOCOL_UNKNOWN;
 }
 
+bool EnablerParticipant::is_service_announced(
+        const std::string& service_name,
+        Protocol Protocol)
+{
+    std::unique_lock<MeteredMutex<std::mutex>> lck(mtx_);
+
+    return is_service_announced_nts_(service_name, Protocol);
+}
+
 bool EnablerParticipant::announce_action(
         const std::string& action_name,
         Protocol Protocol)
 {
-    std::unique_lock<std::mutex> lck(mtx_);
+    NotificationScope notifications(handler_->notification_queue());
+    std::unique_lock<MeteredMutex<std::mutex>> lck(mtx_);
+
+    return announce_action_nts_(action_name, nullptr, Protocol, lck);
+}
 
+bool EnablerParticipant::announce_action(
+        const std::string& action_name,
+        const ActionInfo& action_info,
+        Protocol Protocol)
+{
+    NotificationScope notifications(handler_->notification_queue());
+    std::unique_lock<MeteredMutex<std::mutex>> lck(mtx_);
+
+    return announce_action_nts_(action_name, &action_info, Protocol, lck);
+}
+
+bool EnablerParticipant::announce_action_nts_(
+        const std::string& action_name,
+        const ActionInfo* action_info,
+        Protocol Protocol,
+        std::unique_lock<MeteredMutex<std::mutex>>& lck)
+{
     if (Protocol != Protocol::ROS2)
     {
         EPROSIMA_LOG_ERROR(DDSENABLER_ENABLER_PARTICIPANT,
@@ -443,10 +787,13 @@ bool EnablerParticipant::announce_action(
     }
 
     std::shared_ptr<ActionDiscovered> action = std::make_shared<ActionDiscovered>(action_name, Protocol);
-    if (!query_action_nts_(*action, Protocol, lck))
+    const bool created = (nullptr != action_info) ?
+            create_action_nts_(*action, *action_info, Protocol, lck) :
+            query_action_nts_(*action, Protocol, lck);
+    if (!created)
     {
         EPROSIMA_LOG_ERROR(DDSENABLER_ENABLER_PARTICIPANT,
-                "Failed to announce action " << action_name << " : action type request failed.");
+                "Failed to announce action " << action_name << " : action creation failed.");
         return false;
     }
 
@@ -454,10 +801,31 @@ bool EnablerParticipant::announce_action(
     return true;
 }
 
+bool EnablerParticipant::is_action_announced(
+        const std::string& action_name,
+        Protocol Protocol)
+{
+    std::unique_lock<MeteredMutex<std::mutex>> lck(mtx_);
+
+    auto it = actions_.find(action_name);
+    if (it == actions_.end() || !it->second->enabler_as_server || it->second->protocol != Protocol)
+    {
+        return false;
+    }
+
+    auto goal = it->second->goal.lock();
+    auto result = it->second->result.lock();
+    auto cancel = it->second->cancel.lock();
+    return goal && result && cancel &&
+           is_service_announced_nts_(goal->service_name, Protocol) &&
+           is_service_announced_nts_(result->service_name, Protocol) &&
+           is_service_announced_nts_(cancel->service_name, Protocol);
+}
+
 bool EnablerParticipant::revoke_action(
         const std::string& action_name)
 {
-    std::unique_lock<std::mutex> lck(mtx_);
+    std::unique_lock<MeteredMutex<std::mutex>> lck(mtx_);
 
     auto it = actions_.find(action_name);
     if (it == actions_.end())
@@ -782,6 +1150,125 @@ bool EnablerParticipant::update_action_status(
     return publish(status_topic, status_json);
 }
 
+void EnablerParticipant::get_discovery_snapshot(
+        DiscoverySnapshot& snapshot)
+{
+    // QoS are recorded in their compact encoding, accepted by deserialize_qos as the YAML one
+    auto topic_info = [](const DdsTopic& topic)
+            {
+                return TopicInfo(topic.type_name, serialization::serialize_qos(topic.topic_qos, true));
+            };
+    auto service_info = [&topic_info](const RpcTopic& service)
+            {
+                return ServiceInfo(topic_info(service.request_topic()), topic_info(service.reply_topic()));
+            };
+
+    std::lock_guard<MeteredMutex<std::mutex>> lck(mtx_);
+
+    // RPC topics are restored through their services and actions, or rediscovered
+    std::set<std::string> topic_names;
+    for (const auto& reader : readers_)
+    {
+        const DdsTopic& topic = reader.first;
+        if (RpcType::NONE == RpcInfo(topic.m_topic_name).rpc_type && topic_names.insert(topic.m_topic_name).second)
+        {
+            snapshot.topics.emplace_back(topic.m_topic_name, topic_info(topic));
+        }
+    }
+
+    for (const auto& service : services_)
+    {
+        // Services of actions are recorded along with their action
+        if (!service.second->enabler_as_server || !service.second->fully_discovered ||
+                RpcType::SERVICE != RpcInfo(service.second->topic_request.m_topic_name).rpc_type)
+        {
+            continue;
+        }
+        snapshot.services.push_back({service.first, service.second->get_protocol(),
+                                     service_info(service.second->get_service())});
+    }
+
+    for (const auto& action : actions_)
+    {
+        if (!action.second->enabler_as_server || !action.second->fully_discovered)
+        {
+            continue;
+        }
+        try
+        {
+            const RpcAction rpc_action = action.second->get_action();
+            const ActionInfo action_info(
+                service_info(rpc_action.goal),
+                service_info(rpc_action.result),
+                service_info(rpc_action.cancel),
+                topic_info(rpc_action.feedback),
+                topic_info(rpc_action.status));
+            snapshot.actions.push_back({action.first, action.second->protocol, action_info});
+        }
+        catch (const std::exception& e)
+        {
+            EPROSIMA_LOG_WARNING(DDSENABLER_ENABLER_PARTICIPANT,
+                    "Action " << action.first << " not recorded in discovery snapshot: " << e.what());
+        }
+    }
+}
+
+std::shared_ptr<InternalReader> EnablerParticipant::get_topic_reader_nts_(
+        const std::string& topic_name,
+        std::string& type_name,
+        std::unique_lock<MeteredMutex<std::mutex>>& lck)
+{
+    auto i_reader = lookup_reader_nts_(topic_name, type_name);
+
+    if (nullptr == i_reader)
+    {
+        DdsTopic topic;
+        if (!query_topic_nts_(topic_name, topic))
+        {
+            EPROSIMA_LOG_ERROR(DDSENABLER_ENABLER_PARTICIPANT,
+                    "Failed to publish data in topic " << topic_name);
+            return nullptr;
+        }
+
+        if (!create_topic_writer_nts_(topic, i_reader, lck))
+        {
+            EPROSIMA_LOG_ERROR(DDSENABLER_ENABLER_PARTICIPANT,
+                    "Failed to publish data in topic " << topic_name << " : writer creation failed.");
+            return nullptr;
+        }
+
+        type_name = topic.type_name;
+
+        // (Optionally) wait for writer created in DDS participant to match with external readers, to avoid losing this
+        // message when not using transient durability
+        std::this_thread::sleep_for(std::chrono::milliseconds(std::static_pointer_cast<EnablerParticipantConfiguration>(
+                    configuration_)->initial_publish_wait));
+    }
+
+    return std::dynamic_pointer_cast<InternalReader>(i_reader);
+}
+
+bool EnablerParticipant::declare_topic_nts_(
+        const DdsTopic& topic,
+        std::unique_lock<MeteredMutex<std::mutex>>& lck)
+{
+    std::shared_ptr<IReader> reader;
+    if (!create_topic_writer_nts_(topic, reader, lck))
+    {
+        EPROSIMA_LOG_ERROR(DDSENABLER_ENABLER_PARTICIPANT,
+                "Failed to declare topic " << topic.m_topic_name << " : writer creation failed.");
+        return false;
+    }
+
+    // (Optionally) wait for writer created in DDS participant to match with external readers.
+    // The lock is released first, so topics declared concurrently do not wait for each other.
+    lck.unlock();
+    std::this_thread::sleep_for(std::chrono::milliseconds(std::static_pointer_cast<EnablerParticipantConfiguration>(
+                configuration_)->initial_publish_wait));
+
+    return true;
+}
+
 bool EnablerParticipant::query_topic_nts_(
         const std::string& topic_name,
         DdsTopic& topic)
@@ -836,7 +1323,7 @@ bool EnablerParticipant::query_service_nts_(
 bool EnablerParticipant::query_action_nts_(
         ActionDiscovered& action,
         Protocol Protocol,
-        std::unique_lock<std::mutex>& lck)
+        std::unique_lock<MeteredMutex<std::mutex>>& lck)
 {
     if (!action_query_callback_)
     {
@@ -856,6 +1343,15 @@ bool EnablerParticipant::query_action_nts_(
         return false;
     }
 
+    return create_action_nts_(action, action_info, Protocol, lck);
+}
+
+bool EnablerParticipant::create_action_nts_(
+        ActionDiscovered& action,
+        const ActionInfo& action_info,
+        Protocol Protocol,
+        std::unique_lock<MeteredMutex<std::mutex>>& lck)
+{
     std::string goal_service_name = action.action_name + ACTION_GOAL_SUFFIX;
     std::string cancel_service_name = action.action_name + ACTION_CANCEL_SUFFIX;
     std::string result_service_name = action.action_name + ACTION_RESULT_SUFFIX;
@@ -875,6 +1371,8 @@ bool EnablerParticipant::query_action_nts_(
         }
     }
 
+    // Resolve every service and topic of the action before creating any endpoint, so all of them can be
+    // created in a single batch (i.e. one discovery round trip instead of one per endpoint)
     std::shared_ptr<ServiceDiscovered> goal_service = std::make_shared<ServiceDiscovered>(goal_service_name,
                     Protocol);
     if (!fill_service_type_nts_(
@@ -886,14 +1384,6 @@ bool EnablerParticipant::query_action_nts_(
                 "Failed to announce action " << action.action_name << " : goal service type not found.");
         return false;
     }
-    if (!create_service_request_writer_nts_(goal_service, lck))
-    {
-        EPROSIMA_LOG_ERROR(DDSENABLER_ENABLER_PARTICIPANT,
-                "Failed to announce action " << action.action_name << " : goal service writer creation failed.");
-        return false;
-    }
-    services_.insert_or_assign(goal_service_name, goal_service);
-    action.goal = goal_service;
 
     std::shared_ptr<ServiceDiscovered> cancel_service = std::make_shared<ServiceDiscovered>(cancel_service_name,
                     Protocol);
@@ -906,14 +1396,6 @@ bool EnablerParticipant::query_action_nts_(
                 "Failed to announce action " << action.action_name << " : cancel service type not found.");
         return false;
     }
-    if (!create_service_request_writer_nts_(cancel_service, lck))
-    {
-        EPROSIMA_LOG_ERROR(DDSENABLER_ENABLER_PARTICIPANT,
-                "Failed to announce action " << action.action_name << " : cancel service writer creation failed.");
-        return false;
-    }
-    services_.insert_or_assign(cancel_service_name, cancel_service);
-    action.cancel = cancel_service;
 
     std::shared_ptr<ServiceDiscovered> result_service = std::make_shared<ServiceDiscovered>(result_service_name,
                     Protocol);
@@ -926,14 +1408,6 @@ bool EnablerParticipant::query_action_nts_(
                 "Failed to announce action " << action.action_name << " : result service type not found.");
         return false;
     }
-    if (!create_service_request_writer_nts_(result_service, lck))
-    {
-        EPROSIMA_LOG_ERROR(DDSENABLER_ENABLER_PARTICIPANT,
-                "Failed to announce action " << action.action_name << " : result service writer creation failed.");
-        return false;
-    }
-    services_.insert_or_assign(result_service_name, result_service);
-    action.result = result_service;
 
     std::string prefix;
     switch (Protocol)
@@ -961,24 +1435,6 @@ bool EnablerParticipant::query_action_nts_(
                 "Failed to announce action " << action.action_name << " : feedback topic type not found.");
         return false;
     }
-    {
-        auto feedback_reader = lookup_reader_nts_(feedback_topic_name);
-        if (!feedback_reader)
-        {
-            if (!create_topic_writer_nts_(
-                        feedback_topic,
-                        feedback_reader,
-                        lck))
-            {
-                EPROSIMA_LOG_ERROR(DDSENABLER_ENABLER_PARTICIPANT,
-                        "Failed to announce action " << action.action_name <<
-                        " : feedback topic writer creation failed.");
-                return false;
-            }
-        }
-    }
-    action.feedback = feedback_topic;
-    action.feedback_discovered = true;
 
     std::string status_topic_name = prefix + action.action_name + ACTION_STATUS_SUFFIX;
     DdsTopic status_topic;
@@ -991,22 +1447,58 @@ bool EnablerParticipant::query_action_nts_(
                 "Failed to announce action " << action.action_name << " : status topic type not found.");
         return false;
     }
+
+    const std::vector<std::shared_ptr<ServiceDiscovered>> action_services =
     {
-        auto status_reader = lookup_reader_nts_(action.status.m_topic_name);
-        if (!status_reader)
+        goal_service,
+        cancel_service,
+        result_service
+    };
+
+    std::vector<DdsTopic> topics;
+    for (const auto& service : action_services)
+    {
+        if (nullptr != lookup_reader_nts_(service->topic_request.m_topic_name))
         {
-            if (!create_topic_writer_nts_(
-                        status_topic,
-                        status_reader,
-                        lck))
-            {
-                EPROSIMA_LOG_ERROR(DDSENABLER_ENABLER_PARTICIPANT,
-                        "Failed to announce action " << action.action_name <<
-                        " : status topic writer creation failed.");
-                return false;
-            }
+            EPROSIMA_LOG_ERROR(DDSENABLER_ENABLER_PARTICIPANT,
+                    "Failed to announce action " << action.action_name <<
+                    " : there is already a server running for service " << service->service_name << ".");
+            return false;
         }
+        topics.push_back(service->topic_request);
     }
+
+    // Feedback and status writers may already exist (e.g. if the action was previously announced)
+    if (nullptr == lookup_reader_nts_(feedback_topic_name))
+    {
+        topics.push_back(feedback_topic);
+    }
+    if (nullptr == lookup_reader_nts_(status_topic_name))
+    {
+        topics.push_back(status_topic);
+    }
+
+    std::vector<ddspipe::core::types::Endpoint> request_edps;
+    if (!create_topic_writers_nts_(topics, request_edps, lck))
+    {
+        EPROSIMA_LOG_ERROR(DDSENABLER_ENABLER_PARTICIPANT,
+                "Failed to announce action " << action.action_name << " : writers creation failed.");
+        return false;
+    }
+
+    // Service request endpoints were the first ones to be created
+    for (std::size_t i = 0; i < action_services.size(); ++i)
+    {
+        action_services[i]->endpoint_request = request_edps[i];
+        services_.insert_or_assign(action_services[i]->service_name, action_services[i]);
+    }
+    action.goal = goal_service;
+    action.cancel = cancel_service;
+    action.result = result_service;
+
+    action.feedback = feedback_topic;
+    action.feedback_discovered = true;
+
     action.status = status_topic;
     action.status_discovered = true;
 
@@ -1018,7 +1510,7 @@ bool EnablerParticipant::query_action_nts_(
 bool EnablerParticipant::create_topic_writer_nts_(
         const DdsTopic& topic,
         std::shared_ptr<IReader>& reader,
-        std::unique_lock<std::mutex>& lck)
+        std::unique_lock<MeteredMutex<std::mutex>>& lck)
 {
     ddspipe::core::types::Endpoint request_edp;
     return create_topic_writer_nts_(topic, reader, request_edp, lck);
@@ -1028,22 +1520,51 @@ bool EnablerParticipant::create_topic_writer_nts_(
         const DdsTopic& topic,
         std::shared_ptr<IReader>& reader,
         ddspipe::core::types::Endpoint& request_edp,
-        std::unique_lock<std::mutex>& lck)
+        std::unique_lock<MeteredMutex<std::mutex>>& lck)
 {
-    request_edp = rtps::CommonParticipant::simulate_endpoint(topic, this->id());
-    this->discovery_database_->add_endpoint(request_edp);
+    std::vector<ddspipe::core::types::Endpoint> request_edps;
+    bool ret = create_topic_writers_nts_({topic}, request_edps, lck);
 
-    // Wait for reader to be created from discovery thread
-    // NOTE: Set a timeout to avoid a deadlock in case the reader is never created for some reason (e.g. the topic
+    request_edp = request_edps.front();
+    reader = lookup_reader_nts_(topic.m_topic_name);
+
+    return ret;
+}
+
+bool EnablerParticipant::create_topic_writers_nts_(
+        const std::vector<DdsTopic>& topics,
+        std::vector<ddspipe::core::types::Endpoint>& request_edps,
+        std::unique_lock<MeteredMutex<std::mutex>>& lck)
+{
+    // Submit all endpoints at once, so the discovery thread creates their readers in a row
+    request_edps.clear();
+    request_edps.reserve(topics.size());
+    for (const auto& topic : topics)
+    {
+        request_edps.push_back(rtps::CommonParticipant::simulate_endpoint(topic, this->id()));
+        this->discovery_database_->add_endpoint(request_edps.back());
+    }
+
+    // Wait for all readers to be created from discovery thread
+    // NOTE: Set a timeout to avoid a deadlock in case a reader is never created for some reason (e.g. the topic
     // is blocked or the underlying DDS Pipe object is disabled/destroyed before the reader is created).
     if (!cv_.wait_for(lck, std::chrono::seconds(5), [&]
             {
-                return nullptr != (reader = lookup_reader_nts_(topic.m_topic_name));
+                return std::all_of(topics.begin(), topics.end(), [&](const DdsTopic& topic)
+                {
+                    return nullptr != lookup_reader_nts_(topic.m_topic_name);
+                });
             }))
     {
-        EPROSIMA_LOG_ERROR(DDSENABLER_ENABLER_PARTICIPANT,
-                "Failed to create internal reader for topic " << topic.m_topic_name <<
-                " , please verify that the topic is allowed.");
+        for (const auto& topic : topics)
+        {
+            if (nullptr == lookup_reader_nts_(topic.m_topic_name))
+            {
+                EPROSIMA_LOG_ERROR(DDSENABLER_ENABLER_PARTICIPANT,
+                        "Failed to create internal reader for topic " << topic.m_topic_name <<
+                        " , please verify that the topic is allowed.");
+            }
+        }
         return false;
     }
 
@@ -1052,7 +1573,7 @@ bool EnablerParticipant::create_topic_writer_nts_(
 
 bool EnablerParticipant::create_service_request_writer_nts_(
         std::shared_ptr<ServiceDiscovered> service,
-        std::unique_lock<std::mutex>& lck)
+        std::unique_lock<MeteredMutex<std::mutex>>& lck)
 {
     auto reader = lookup_reader_nts_(service->topic_request.m_topic_name);
 
@@ -1238,6 +1759,22 @@ bool EnablerParticipant::action_discovered_nts_(
     return false;
 }
 
+bool EnablerParticipant::is_service_announced_nts_(
+        const std::string& service_name,
+        Protocol Protocol) const
+{
+    auto it = services_.find(service_name);
+    if (it == services_.end())
+    {
+        return false;
+    }
+
+    const auto& service = it->second;
+    return service->enabler_as_server &&
+           service->get_protocol() == Protocol &&
+           (service->external_server || service->endpoint_request.has_value());
+}
+
 bool EnablerParticipant::revoke_service_nts_(
         const std::string& service_name)
 {
@@ -1270,12 +1807,63 @@ bool EnablerParticipant::revoke_service_nts_(
     auto reader = lookup_reader_nts_(request_name);
     if (nullptr != reader)
     {
+        const std::string type_name = reader->topic().type_name;
         readers_.erase(reader->topic());
+        update_type_reference_nts_(request_name, type_name);
     }
 
     return true;
 }
 
+void EnablerParticipant::on_endpoint_changed_(
+        const Endpoint& endpoint,
+        bool erased)
+{
+    std::lock_guard<MeteredMutex<std::mutex>> lck(mtx_);
+
+    const auto key = std::make_pair(endpoint.topic.m_topic_name, endpoint.topic.type_name);
+    auto& endpoints = topic_endpoints_[key];
+    if (erased || !endpoint.active)
+    {
+        endpoints.erase(endpoint.guid);
+    }
+    else
+    {
+        endpoints.insert(endpoint.guid);
+    }
+
+    update_type_reference_nts_(key.first, key.second);
+
+    if (endpoints.empty())
+    {
+        topic_endpoints_.erase(key);
+    }
+}
+
+void EnablerParticipant::update_type_reference_nts_(
+        const std::string& topic_name,
+        const std::string& type_name)
+{
+    const auto key = std::make_pair(topic_name, type_name);
+
+    auto it = topic_endpoints_.find(key);
+    bool live = it != topic_endpoints_.end() && !it->second.empty() &&
+            std::any_of(readers_.begin(), readers_.end(), [&](const auto& reader)
+                    {
+                        return reader.first.m_topic_name == topic_name && reader.first.type_name == type_name;
+                    });
+
+    // Types of live topics are never evicted from the schema cache
+    if (live && referenced_topics_.insert(key).second)
+    {
+        handler_->reference_type(type_name);
+    }
+    else if (!live && referenced_topics_.erase(key) > 0)
+    {
+        handler_->release_type(type_name);
+    }
+}
+
 } /* namespace participants */
 } /* namespace ddsenabler */
 } /* namespace eprosima */
@@ -16,14 +16,28 @@
  * @file Handler.cpp
  */
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <thread>
+#include <vector>
+
 #include <fastdds/dds/domain/DomainParticipantFactory.hpp>
 #include <fastdds/dds/xtypes/dynamic_types/DynamicData.hpp>
+#include <fastdds/dds/xtypes/dynamic_types/DynamicDataFactory.hpp>
 #include <fastdds/dds/xtypes/dynamic_types/DynamicPubSubType.hpp>
 #include <fastdds/dds/xtypes/dynamic_types/DynamicType.hpp>
 #include <fastdds/dds/xtypes/dynamic_types/DynamicTypeBuilderFactory.hpp>
+#include <fastdds/dds/xtypes/dynamic_types/TypeDescriptor.hpp>
 #include <fastdds/dds/xtypes/utils.hpp>
 
 #include <cpp_utils/exception/InconsistencyException.hpp>
+#include <cpp_utils/exception/InitializationException.hpp>
+#include <cpp_utils/utils.hpp>
 
 #include <ddsenabler_participants/Serialization.hpp>
 #include <ddsenabler_participants/types/dynamic_types_collection/DynamicTypesCollection.hpp>
@@ -36,6 +50,114 @@ namespace participants {
 
 using namespace eprosima::ddspipe::core::types;
 
+namespace {
+
+//! Size of the RTPS encapsulation header (identifier + options)
+constexpr uint32_t ENCAPSULATION_HEADER_SIZE = 4u;
+
+//! Approximate ratio between the memory used by a DynamicType (and its pubsub type) and its serialized TypeObject
+constexpr std::size_t DYNAMIC_TYPE_EXPANSION_FACTOR = 8u;
+
+/**
+ * Estimate the memory used by the DynamicType of a registered type from the size of its serialized TypeObject.
+ */
+std::size_t estimate_dynamic_type_size(
+        const fastdds::dds::xtypes::TypeIdentifier& type_id)
+{
+    fastdds::dds::xtypes::TypeObject type_object;
+    if (fastdds::dds::RETCODE_OK !=
+            fastdds::dds::DomainParticipantFactory::get_instance()->type_object_registry().get_type_object(
+                type_id, type_object))
+    {
+        return 0;
+    }
+
+    try
+    {
+        return DYNAMIC_TYPE_EXPANSION_FACTOR * serialization::serialize_type_object(type_object).size();
+    }
+    catch (const utils::InconsistencyException&)
+    {
+        return 0;
+    }
+}
+
+/**
+ * Deduce the data representation of a CDR encapsulation identifier, checking it is a valid encoding for a type
+ * of the given extensibility.
+ */
+bool representation_from_encapsulation(
+        const uint16_t encapsulation,
+        const fastdds::dds::ExtensibilityKind extensibility,
+        fastdds::dds::DataRepresentationId_t& representation)
+{
+    // Drop the endianness bit, both endiannesses are valid
+    switch (encapsulation & ~0x0001)
+    {
+        case 0x0000: // CDR_BE / CDR_LE
+            representation = fastdds::dds::DataRepresentationId::XCDR_DATA_REPRESENTATION;
+            return fastdds::dds::ExtensibilityKind::MUTABLE != extensibility;
+        case 0x0002: // PL_CDR_BE / PL_CDR_LE
+            representation = fastdds::dds::DataRepresentationId::XCDR_DATA_REPRESENTATION;
+            return fastdds::dds::ExtensibilityKind::MUTABLE == extensibility;
+        case 0x0006: // CDR2_BE / CDR2_LE
+            representation = fastdds::dds::DataRepresentationId::XCDR2_DATA_REPRESENTATION;
+            return fastdds::dds::ExtensibilityKind::FINAL == extensibility;
+        case 0x0008: // D_CDR2_BE / D_CDR2_LE
+            representation = fastdds::dds::DataRepresentationId::XCDR2_DATA_REPRESENTATION;
+            return fastdds::dds::ExtensibilityKind::APPENDABLE == extensibility;
+        case 0x000a: // PL_CDR2_BE / PL_CDR2_LE
+            representation = fastdds::dds::DataRepresentationId::XCDR2_DATA_REPRESENTATION;
+            return fastdds::dds::ExtensibilityKind::MUTABLE == extensibility;
+        default:
+            return false;
+    }
+}
+
+/**
+ * Maximum length of a discovery batch, in discovery batch windows, so a continuous discovery storm does not delay
+ * notifications indefinitely.
+ */
+constexpr unsigned int DISCOVERY_BATCH_MAX_WINDOWS = 10;
+
+/**
+ * Run \c n_tasks tasks in up to \c n_threads threads (the calling one included), each one pulling the index of the
+ * next task to run.
+ */
+void run_in_parallel(
+        const std::size_t n_tasks,
+        unsigned int n_threads,
+        const std::function<void(std::size_t)>& task)
+{
+    if (0 == n_threads)
+    {
+        n_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    n_threads = static_cast<unsigned int>(std::min<std::size_t>(n_threads, std::max<std::size_t>(n_tasks, 1)));
+
+    std::atomic<std::size_t> next_task{0};
+    auto worker = [&]()
+            {
+                for (std::size_t i = next_task++; i < n_tasks; i = next_task++)
+                {
+                    task(i);
+                }
+            };
+
+    std::vector<std::thread> threads;
+    for (unsigned int i = 1; i < n_threads; ++i)
+    {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+}
+
+} // namespace
+
 Handler::Handler(
         const HandlerConfiguration& config,
         const std::shared_ptr<ddspipe::core::PayloadPool>& payload_pool)
@@ -46,6 +168,44 @@ Handler::Handler(
             "Creating handler instance.");
 
     writer_ = std::make_unique<Writer>();
+    writer_->set_notification_queue(&notifications_);
+
+    if (configuration_.callback_budget_ms > 0)
+    {
+        callback_watchdog_ = std::make_unique<CallbackWatchdog>(
+            std::chrono::milliseconds(configuration_.callback_budget_ms),
+            configuration_.callback_offload_threshold);
+        writer_->set_callback_watchdog(callback_watchdog_.get());
+    }
+    writer_->set_incremental_type_collections(configuration_.incremental_type_collections);
+    writer_->set_compact_qos(configuration_.compact_qos);
+
+    if (configuration_.tracing.enabled())
+    {
+        try
+        {
+            tracer_ = std::make_unique<Tracer>(configuration_.tracing);
+            writer_->set_tracer(tracer_.get());
+        }
+        catch (const utils::InitializationException& e)
+        {
+            EPROSIMA_LOG_ERROR(DDSENABLER_HANDLER,
+                    "Tracing disabled: " << e.what());
+        }
+    }
+
+    if (!configuration_.type_store_path.empty())
+    {
+        try
+        {
+            type_store_ = std::make_unique<TypeStore>(configuration_.type_store_path);
+        }
+        catch (const utils::InitializationException& e)
+        {
+            EPROSIMA_LOG_ERROR(DDSENABLER_HANDLER,
+                    "Type store disabled: " << e.what());
+        }
+    }
 
     writer_->set_is_UUID_active_callback(
         [this](const std::string& action_name, const UUID& uuid)
@@ -60,19 +220,52 @@ Handler::Handler(
             return this->erase_action_UUID(uuid, reason);
         }
         );
+
+    if (configuration_.discovery_batch_window_ms > 0)
+    {
+        discovery_thread_ = std::thread(&Handler::discovery_batch_routine_, this);
+    }
+
+    if (!configuration_.priority_classes.empty())
+    {
+        // Topics not assigned to any class fall into an implicit class of the lowest priority
+        std::vector<PriorityClass> classes = configuration_.priority_classes;
+        PriorityClass default_class;
+        default_class.name = DEFAULT_PRIORITY_CLASS_NAME;
+        classes.push_back(default_class);
+
+        priority_dispatcher_ = std::make_unique<PriorityDispatcher>(classes, configuration_.priority_scheduling);
+    }
 }
 
 Handler::~Handler()
 {
     EPROSIMA_LOG_INFO(DDSENABLER_HANDLER,
             "Destroying handler.");
+
+    // Stop delivering queued samples before anything they use is destroyed
+    priority_dispatcher_.reset();
+
+    if (discovery_thread_.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(discovery_mtx_);
+            stop_discovery_batching_ = true;
+        }
+        discovery_cv_.notify_one();
+        discovery_thread_.join();
+
+        // Do not drop the entities discovered in the last window
+        flush_discovery_batch();
+    }
 }
 
 void Handler::add_schema(
         const fastdds::dds::DynamicType::_ref_type& dyn_type,
         const fastdds::dds::xtypes::TypeIdentifier& type_id)
 {
-    std::lock_guard<std::recursive_mutex> lock(mtx_);
+    NotificationScope notifications(notifications_);
+    std::lock_guard<MeteredMutex<std::recursive_mutex>> lock(mtx_);
 
     add_schema_nts_(dyn_type, type_id);
 }
@@ -80,7 +273,22 @@ void Handler::add_schema(
 void Handler::add_topic(
         const DdsTopic& topic)
 {
-    std::lock_guard<std::recursive_mutex> lock(mtx_);
+    if (configuration_.discovery_batch_window_ms > 0)
+    {
+        // Only the pending batch is locked, the entity is notified later from the discovery batching thread
+        std::lock_guard<std::mutex> lock(discovery_mtx_);
+
+        EPROSIMA_LOG_INFO(DDSENABLER_HANDLER,
+                "Queuing topic: " << topic << ".");
+
+        schedule_discovery_batch_nts_();
+        pending_discovery_.topics.push_back(topic);
+        discovery_pending_.store(true, std::memory_order_release);
+        return;
+    }
+
+    NotificationScope notifications(notifications_);
+    std::lock_guard<MeteredMutex<std::recursive_mutex>> lock(mtx_);
 
     EPROSIMA_LOG_INFO(DDSENABLER_HANDLER,
             "Adding topic: " << topic << ".");
@@ -91,7 +299,21 @@ void Handler::add_topic(
 void Handler::add_service(
         const RpcTopic& service)
 {
-    std::lock_guard<std::recursive_mutex> lock(mtx_);
+    if (configuration_.discovery_batch_window_ms > 0)
+    {
+        std::lock_guard<std::mutex> lock(discovery_mtx_);
+
+        EPROSIMA_LOG_INFO(DDSENABLER_HANDLER,
+                "Queuing service: " << service.service_name() << ".");
+
+        schedule_discovery_batch_nts_();
+        pending_discovery_.services.push_back(service);
+        discovery_pending_.store(true, std::memory_order_release);
+        return;
+    }
+
+    NotificationScope notifications(notifications_);
+    std::lock_guard<MeteredMutex<std::recursive_mutex>> lock(mtx_);
 
     EPROSIMA_LOG_INFO(DDSENABLER_HANDLER,
             "Adding service: " << service.service_name() << ".");
@@ -102,7 +324,21 @@ void Handler::add_service(
 void Handler::add_action(
         const RpcAction& action)
 {
-    std::lock_guard<std::recursive_mutex> lock(mtx_);
+    if (configuration_.discovery_batch_window_ms > 0)
+    {
+        std::lock_guard<std::mutex> lock(discovery_mtx_);
+
+        EPROSIMA_LOG_INFO(DDSENABLER_HANDLER,
+                "Queuing action: " << action.action_name << ".");
+
+        schedule_discovery_batch_nts_();
+        pending_discovery_.actions.push_back(action);
+        discovery_pending_.store(true, std::memory_order_release);
+        return;
+    }
+
+    NotificationScope notifications(notifications_);
+    std::lock_guard<MeteredMutex<std::recursive_mutex>> lock(mtx_);
 
     EPROSIMA_LOG_INFO(DDSENABLER_HANDLER,
             "Adding action: " << action.action_name << ".");
@@ -114,49 +350,97 @@ void Handler::add_data(
         const DdsTopic& topic,
         RtpsPayloadData& data)
 {
-    std::lock_guard<std::recursive_mutex> lock(mtx_);
+    std::shared_ptr<RpcInfo> rpc_info = std::make_shared<RpcInfo>(topic.m_topic_name);
 
-    EPROSIMA_LOG_INFO(DDSENABLER_HANDLER,
-            "Adding data in topic: " << topic << ".");
+    EntityMetrics& metrics = entity_metrics_(*rpc_info);
+    metrics.received.fetch_add(1, std::memory_order_relaxed);
+    metrics.bytes_in.fetch_add(data.payload.length, std::memory_order_relaxed);
 
-    fastdds::dds::DynamicType::_ref_type dyn_type;
-    auto it = schemas_.find(topic.type_name);
-    if (it == schemas_.end())
+    // The discovery of an entity is notified before its first sample, even if its batch window is not over yet
+    if (discovery_pending_.load(std::memory_order_acquire) && is_discovery_pending_(topic, *rpc_info))
     {
-        EPROSIMA_LOG_WARNING(DDSENABLER_HANDLER,
-                "Schema for type " << topic.type_name << " not available.");
-        return;
+        flush_discovery_batch();
     }
-    dyn_type = it->second.second;
 
-    Message msg;
-    msg.sequence_number = unique_sequence_number_++;
-    msg.publish_time = data.source_timestamp;
-    if (data.payload.length > 0)
+    TraceSpan add_data_span(tracer_.get(), tracer_ ? tracer_->start_trace() : 0, SpanKind::ADD_DATA,
+            metrics.name.c_str());
+    const uint64_t trace_id = add_data_span.trace_id();
+    if (trace_id != 0)
     {
-        msg.topic = topic;
-        msg.instanceHandle = data.instanceHandle;
-        msg.source_guid = data.source_guid;
-
-        if (data.payload_owner != nullptr)
+        // The reception span goes from the source timestamp, so it is only meaningful with synchronized clocks
+        const int64_t source_ns = data.source_timestamp.to_ns();
+        if (source_ns > 0 && source_ns < add_data_span.start_ns())
         {
-            payload_pool_->get_payload(
-                data.payload,
-                msg.payload);
-
-            msg.payload_owner = payload_pool_.get();
+            Span receive;
+            receive.trace_id = trace_id;
+            receive.entity = metrics.name.c_str();
+            receive.kind = SpanKind::RECEIVE;
+            receive.start_ns = source_ns;
+            receive.end_ns = add_data_span.start_ns();
+            tracer_->record(receive);
         }
-        else
+    }
+
+    // Samples of plain topics are delivered by priority class when configured, so the reception thread only queues
+    // them. RPC samples are still processed right away, as their reception relies on the request identifiers they get.
+    std::size_t priority_class;
+    if (priority_dispatcher_ && get_priority_class_(topic.m_topic_name, priority_class))
+    {
+        Message msg;
+        fill_message_(topic, data, msg);
+        msg.metrics = &metrics;
+        msg.trace_id = trace_id;
+        priority_dispatcher_->push(priority_class, [this, msg]() mutable
+                {
+                    deliver_queued_sample_(msg);
+                }, [&metrics]()
+                {
+                    metrics.dropped.fetch_add(1, std::memory_order_relaxed);
+                });
+        return;
+    }
+
+    // User callbacks are invoked once the handler lock is released
+    NotificationScope notifications(notifications_);
+    std::lock_guard<MeteredMutex<std::recursive_mutex>> lock(mtx_);
+
+    EPROSIMA_LOG_INFO(DDSENABLER_HANDLER,
+            "Adding data in topic: " << topic << ".");
+
+    // Samples of topics with a typed subscription skip the JSON (and DynamicData) conversion
+    auto typed_it = typed_subscriptions_.find(topic.m_topic_name);
+    if (typed_it != typed_subscriptions_.end())
+    {
+        if (typed_it->second.first != topic.type_name)
         {
-            throw utils::InconsistencyException(STR_ENTRY << "Payload owner not found in data received.");
+            EPROSIMA_LOG_WARNING(DDSENABLER_HANDLER,
+                    "Typed subscription to topic " << topic.m_topic_name << " expects type " <<
+                    typed_it->second.first << " but received " << topic.type_name << ".");
+            metrics.filtered.fetch_add(1, std::memory_order_relaxed);
+            return;
         }
+        Message msg;
+        fill_message_(topic, data, msg);
+        msg.metrics = &metrics;
+        msg.trace_id = trace_id;
+        push_typed_notification_nts_(msg, typed_it->second.second);
+        return;
     }
-    else
+
+    fastdds::dds::DynamicType::_ref_type dyn_type = get_dynamic_type_nts_(topic.type_name);
+    if (!dyn_type)
     {
-        throw utils::InconsistencyException(STR_ENTRY << "Received sample with no payload.");
+        EPROSIMA_LOG_WARNING(DDSENABLER_HANDLER,
+                "Schema for type " << topic.type_name << " not available.");
+        metrics.dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
     }
 
-    std::shared_ptr<RpcInfo> rpc_info = std::make_shared<RpcInfo>(topic.m_topic_name);
+    Message msg;
+    fill_message_(topic, data, msg);
+    msg.sequence_number = unique_sequence_number_++;
+    msg.metrics = &metrics;
+    msg.trace_id = trace_id;
 
     switch (rpc_info->rpc_type)
     {
@@ -307,11 +591,13 @@ void Handler::add_data(
                             {
                                 if (send_action_get_result_reply_callback_)
                                 {
-                                    send_action_get_result_reply_callback_(
-                                        rpc_info->action_name,
-                                        uuid,
-                                        result,
-                                        requests_id_);
+                                    // Reenters the enabler, so it is deferred like the notifications
+                                    notifications_.push([callback = send_action_get_result_reply_callback_,
+                                            action_name = rpc_info->action_name, uuid, result = std::move(result),
+                                            request_id = requests_id_]()
+                                            {
+                                                callback(action_name, uuid, result, request_id);
+                                            });
                                 }
                             }
                             break;
@@ -359,12 +645,13 @@ bool Handler::get_type_identifier(
         const std::string& type_name,
         fastdds::dds::xtypes::TypeIdentifier& type_identifier)
 {
-    std::lock_guard<std::recursive_mutex> lock(mtx_);
+    NotificationScope notifications(notifications_);
+    std::lock_guard<MeteredMutex<std::recursive_mutex>> lock(mtx_);
 
-    auto it = schemas_.find(type_name);
-    if (it != schemas_.end())
+    const TypeInterner::TypeId id = type_interner_.find(type_name);
+    if (TypeInterner::INVALID_TYPE_ID != id)
     {
-        type_identifier = it->second.first;
+        type_identifier = schemas_[id].type_id;
         return true;
     }
 
@@ -393,6 +680,20 @@ bool Handler::get_type_identifier(
         }
     }
 
+    // Try to retrieve it from the persistent type store
+    if (type_store_)
+    {
+        fastdds::dds::xtypes::TypeObject type_object;
+        if (type_store_->load(type_name, type_identifier, type_object))
+        {
+            // Already persisted, so there is no need to report it to the user either
+            if (add_schema_nts_(type_identifier, type_object, false))
+            {
+                return true;
+            }
+        }
+    }
+
     if (!type_query_callback_)
     {
         EPROSIMA_LOG_ERROR(DDSENABLER_HANDLER,
@@ -409,65 +710,642 @@ bool Handler::get_type_identifier(
         return false;
     }
 
-    // Register the type obtained through the type query callback
-    fastdds::dds::xtypes::TypeObject type_object;
-    if (!register_type_nts_(type_name, serialized_type.get(), serialized_type_size, type_identifier, type_object))
+    // Register the type obtained through the type query callback
+    fastdds::dds::xtypes::TypeObject type_object;
+    if (!register_type_nts_(type_name, serialized_type.get(), serialized_type_size, type_identifier, type_object))
+    {
+        EPROSIMA_LOG_ERROR(DDSENABLER_HANDLER,
+                "Failed to register type " << type_name << ".");
+        return false;
+    }
+
+    // Add to schemas map, but do not report it to the user as it is the exact same information we obtained through the
+    // type query callback.
+    add_schema_nts_(type_identifier, type_object, false);
+
+    return true;
+}
+
+std::size_t Handler::preload_types(
+        const std::string& directory,
+        unsigned int n_threads)
+{
+    std::error_code ec;
+    if (!std::filesystem::is_directory(directory, ec))
+    {
+        EPROSIMA_LOG_ERROR(DDSENABLER_HANDLER,
+                "Failed to preload types: " << directory << " is not a directory.");
+        return 0;
+    }
+
+    std::vector<std::filesystem::path> files;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, ec))
+    {
+        if (entry.is_regular_file() && entry.path().extension() == ".bin")
+        {
+            files.push_back(entry.path());
+        }
+    }
+
+    struct PreloadedType
+    {
+        std::vector<std::pair<fastdds::dds::xtypes::TypeIdentifier, fastdds::dds::xtypes::TypeObject>> types;
+        fastdds::dds::DynamicType::_ref_type dyn_type;
+        bool valid {false};
+    };
+    std::vector<PreloadedType> preloaded(files.size());
+
+    // Read and decode the collections (dependencies first, type last)
+    run_in_parallel(files.size(), n_threads,
+        [&](std::size_t i)
+        {
+            std::ifstream file(files[i], std::ios::binary);
+            std::vector<unsigned char> serialized_type(
+                (std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+            DynamicTypesCollection dynamic_types;
+            if (serialized_type.empty() ||
+                    !serialization::deserialize_dynamic_types(serialized_type.data(),
+                    static_cast<uint32_t>(serialized_type.size()), dynamic_types))
+            {
+                EPROSIMA_LOG_ERROR(DDSENABLER_HANDLER,
+                        "Failed to preload type from " << files[i] << ".");
+                return;
+            }
+
+            std::string type_name;
+            for (const DynamicType& dynamic_type : dynamic_types.dynamic_types())
+            {
+                fastdds::dds::xtypes::TypeIdentifier type_identifier;
+                fastdds::dds::xtypes::TypeObject type_object;
+                if (dynamic_type.type_object().empty() ||
+                        !serialization::deserialize_dynamic_type(dynamic_type, type_name, type_identifier,
+                        type_object))
+                {
+                    EPROSIMA_LOG_ERROR(DDSENABLER_HANDLER,
+                            "Failed to preload type from " << files[i] << ".");
+                    return;
+                }
+                preloaded[i].types.emplace_back(type_identifier, type_object);
+            }
+            preloaded[i].valid = !preloaded[i].types.empty();
+        });
+
+    // Register the type objects, so every dependency is available when building the DynamicTypes
+    auto& registry = fastdds::dds::DomainParticipantFactory::get_instance()->type_object_registry();
+    for (auto& type : preloaded)
+    {
+        for (const auto& type_entry : type.types)
+        {
+            if (!type.valid)
+            {
+                break;
+            }
+            fastdds::dds::xtypes::TypeIdentifierPair type_identifiers;
+            type_identifiers.type_identifier1(type_entry.first);
+            type.valid = (fastdds::dds::RETCODE_OK == registry.register_type_object(type_entry.second,
+                    type_identifiers));
+        }
+    }
+
+    // Build the DynamicTypes
+    run_in_parallel(preloaded.size(), n_threads,
+        [&](std::size_t i)
+        {
+            if (!preloaded[i].valid)
+            {
+                return;
+            }
+            auto builder = fastdds::dds::DynamicTypeBuilderFactory::get_instance()->create_type_w_type_object(
+                preloaded[i].types.back().second);
+            if (builder)
+            {
+                preloaded[i].dyn_type = builder->build();
+            }
+        });
+
+    // Types are persisted once mtx_ is released
+    NotificationScope notifications(notifications_);
+    std::lock_guard<MeteredMutex<std::recursive_mutex>> lock(mtx_);
+
+    std::size_t n_preloaded = 0;
+    for (const auto& type : preloaded)
+    {
+        if (!type.dyn_type)
+        {
+            continue;
+        }
+
+        // Known to the user already, so there is no need to report it
+        add_schema_nts_(type.dyn_type, type.types.back().first, false);
+        n_preloaded++;
+    }
+
+    EPROSIMA_LOG_INFO(DDSENABLER_HANDLER,
+            "Preloaded " << n_preloaded << " out of " << files.size() << " types from " << directory << ".");
+
+    return n_preloaded;
+}
+
+std::size_t Handler::load_type_bundle(
+        const std::string& path,
+        unsigned int n_threads)
+{
+    std::error_code ec;
+    if (!std::filesystem::is_regular_file(path, ec))
+    {
+        EPROSIMA_LOG_ERROR(DDSENABLER_HANDLER,
+                "Failed to load type bundle: " << path << " is not a file.");
+        return 0;
+    }
+
+    // Opened read-only, so a bundle with malformed records is rejected instead of modified
+    std::unique_ptr<TypeStore> bundle;
+    try
+    {
+        bundle = std::make_unique<TypeStore>(path, true);
+    }
+    catch (const utils::InitializationException& e)
+    {
+        EPROSIMA_LOG_ERROR(DDSENABLER_HANDLER,
+                "Failed to load type bundle: " << e.what());
+        return 0;
+    }
+    catch (const std::filesystem::filesystem_error& e)
+    {
+        EPROSIMA_LOG_ERROR(DDSENABLER_HANDLER,
+                "Failed to load type bundle: " << e.what());
+        return 0;
+    }
+
+    struct BundledType
+    {
+        std::string type_name;
+        fastdds::dds::xtypes::TypeIdentifier type_identifier;
+        fastdds::dds::xtypes::TypeObject type_object;
+        fastdds::dds::DynamicType::_ref_type dyn_type;
+        std::string idl;
+        std::string placeholder;
+    };
+    const auto type_names = bundle->type_names();
+    std::vector<BundledType> bundled(type_names.size());
+
+    // Register the type objects (dependencies included) sequentially, as records may share dependencies
+    for (std::size_t i = 0; i < type_names.size(); ++i)
+    {
+        bundled[i].type_name = type_names[i];
+        if (!bundle->load(type_names[i], bundled[i].type_identifier, bundled[i].type_object))
+        {
+            EPROSIMA_LOG_ERROR(DDSENABLER_HANDLER,
+                    "Failed to load type " << type_names[i] << " from type bundle " << path << ".");
+            bundled[i].type_name.clear();
+            continue;
+        }
+        bundle->get_description(type_names[i], bundled[i].idl, bundled[i].placeholder);
+    }
+
+    // Build the DynamicTypes
+    run_in_parallel(bundled.size(), n_threads,
+        [&](std::size_t i)
+        {
+            if (bundled[i].type_name.empty())
+            {
+                return;
+            }
+            auto builder = fastdds::dds::DynamicTypeBuilderFactory::get_instance()->create_type_w_type_object(
+                bundled[i].type_object);
+            if (builder)
+            {
+                bundled[i].dyn_type = builder->build();
+            }
+        });
+
+    // Types are persisted once mtx_ is released
+    NotificationScope notifications(notifications_);
+    std::lock_guard<MeteredMutex<std::recursive_mutex>> lock(mtx_);
+
+    std::size_t n_loaded = 0;
+    for (auto& type : bundled)
+    {
+        if (!type.dyn_type)
+        {
+            continue;
+        }
+
+        // Bundled types are known to the user beforehand, so there is no need to report them
+        add_schema_nts_(type.dyn_type, type.type_identifier, false);
+
+        // Precomputed descriptions spare their generation on first request
+        auto& description = schemas_[type_interner_.find(type.type_name)].description;
+        if (!type.idl.empty())
+        {
+            description.idl = std::move(type.idl);
+        }
+        if (!type.placeholder.empty())
+        {
+            description.placeholder = std::move(type.placeholder);
+        }
+        n_loaded++;
+    }
+
+    EPROSIMA_LOG_INFO(DDSENABLER_HANDLER,
+            "Loaded " << n_loaded << " out of " << type_names.size() << " types from type bundle " << path << ".");
+
+    return n_loaded;
+}
+
+std::size_t Handler::save_type_bundle(
+        const std::string& path)
+{
+    std::lock_guard<std::mutex> bundle_lock(bundle_store_mtx_);
+
+    if (!bundle_store_ || bundle_store_path_ != path)
+    {
+        bundle_store_.reset();
+        try
+        {
+            bundle_store_ = std::make_unique<TypeStore>(path);
+            bundle_store_path_ = path;
+        }
+        catch (const utils::InitializationException& e)
+        {
+            EPROSIMA_LOG_ERROR(DDSENABLER_HANDLER,
+                    "Failed to save type bundle: " << e.what());
+            return 0;
+        }
+    }
+
+    struct KnownType
+    {
+        std::string type_name;
+        fastdds::dds::xtypes::TypeIdentifier type_identifier;
+        std::optional<std::string> idl;
+        std::optional<std::string> placeholder;
+    };
+    std::vector<KnownType> known_types;
+    {
+        std::lock_guard<MeteredMutex<std::recursive_mutex>> lock(mtx_);
+
+        known_types.reserve(schemas_.size());
+        for (TypeInterner::TypeId id = 0; id < schemas_.size(); ++id)
+        {
+            const Schema& schema = schemas_[id];
+            if (fastdds::dds::xtypes::TK_NONE == schema.type_id._d())
+            {
+                continue;
+            }
+            known_types.push_back({type_interner_.type_name(id), schema.type_id, schema.description.idl,
+                                   schema.description.placeholder});
+        }
+    }
+
+    // Write outside the handler lock, types already in the bundle are skipped by the store
+    std::size_t n_saved = 0;
+    for (auto& type : known_types)
+    {
+        if (bundle_store_->contains(type.type_name))
+        {
+            n_saved++;
+            continue;
+        }
+
+        // The description of types evicted from the schema cache is dropped, but may still be in the type store
+        if (!type.idl && !type.placeholder && type_store_)
+        {
+            std::string idl;
+            std::string placeholder;
+            if (type_store_->get_description(type.type_name, idl, placeholder))
+            {
+                type.idl = std::move(idl);
+                type.placeholder = std::move(placeholder);
+            }
+        }
+
+        if (bundle_store_->store(type.type_name, type.type_identifier, type.idl.value_or(""),
+                type.placeholder.value_or("")))
+        {
+            n_saved++;
+        }
+    }
+
+    return n_saved;
+}
+
+bool Handler::get_type_idl(
+        const std::string& type_name,
+        std::string& idl)
+{
+    fastdds::dds::DynamicType::_ref_type dyn_type;
+    fastdds::dds::xtypes::TypeIdentifier type_id;
+    {
+        std::lock_guard<MeteredMutex<std::recursive_mutex>> lock(mtx_);
+
+        const TypeInterner::TypeId id = type_interner_.find(type_name);
+        if (TypeInterner::INVALID_TYPE_ID != id && schemas_[id].description.idl.has_value())
+        {
+            idl = schemas_[id].description.idl.value();
+            return true;
+        }
+
+        if (!get_schema_(type_name, dyn_type, type_id))
+        {
+            return false;
+        }
+    }
+
+    // Generate outside the lock so discovery and data reception are not blocked
+    std::string generated_idl;
+    if (!writer_->generate_type_idl(dyn_type, generated_idl))
+    {
+        return false;
+    }
+
+    std::lock_guard<MeteredMutex<std::recursive_mutex>> lock(mtx_);
+    idl = generated_idl;
+    schemas_[type_interner_.find(type_name)].description.idl = std::move(generated_idl);
+    return true;
+}
+
+bool Handler::get_type_collection(
+        const std::string& type_name,
+        std::vector<unsigned char>& collection)
+{
+    fastdds::dds::DynamicType::_ref_type dyn_type;
+    fastdds::dds::xtypes::TypeIdentifier type_id;
+    {
+        std::lock_guard<MeteredMutex<std::recursive_mutex>> lock(mtx_);
+
+        const TypeInterner::TypeId id = type_interner_.find(type_name);
+        if (TypeInterner::INVALID_TYPE_ID != id && schemas_[id].description.collection.has_value())
+        {
+            collection = schemas_[id].description.collection.value();
+            return true;
+        }
+
+        if (!get_schema_(type_name, dyn_type, type_id))
+        {
+            return false;
+        }
+    }
+
+    // Generate outside the lock so discovery and data reception are not blocked
+    std::vector<unsigned char> generated_collection;
+    if (!writer_->generate_type_collection(dyn_type, type_id, generated_collection))
+    {
+        return false;
+    }
+
+    std::lock_guard<MeteredMutex<std::recursive_mutex>> lock(mtx_);
+    collection = generated_collection;
+    schemas_[type_interner_.find(type_name)].description.collection = std::move(generated_collection);
+    return true;
+}
+
+bool Handler::get_type_placeholder(
+        const std::string& type_name,
+        std::string& placeholder)
+{
+    fastdds::dds::DynamicType::_ref_type dyn_type;
+    fastdds::dds::xtypes::TypeIdentifier type_id;
+    {
+        std::lock_guard<MeteredMutex<std::recursive_mutex>> lock(mtx_);
+
+        const TypeInterner::TypeId id = type_interner_.find(type_name);
+        if (TypeInterner::INVALID_TYPE_ID != id && schemas_[id].description.placeholder.has_value())
+        {
+            placeholder = schemas_[id].description.placeholder.value();
+            return true;
+        }
+
+        if (!get_schema_(type_name, dyn_type, type_id))
+        {
+            return false;
+        }
+    }
+
+    // Generate outside the lock so discovery and data reception are not blocked
+    std::string generated_placeholder;
+    if (!writer_->generate_type_placeholder(dyn_type, generated_placeholder))
+    {
+        return false;
+    }
+
+    std::lock_guard<MeteredMutex<std::recursive_mutex>> lock(mtx_);
+    placeholder = generated_placeholder;
+    schemas_[type_interner_.find(type_name)].description.placeholder = std::move(generated_placeholder);
+    return true;
+}
+
+void Handler::reference_type(
+        const std::string& type_name)
+{
+    std::lock_guard<MeteredMutex<std::recursive_mutex>> lock(mtx_);
+
+    live_types_[type_name]++;
+}
+
+void Handler::release_type(
+        const std::string& type_name)
+{
+    std::lock_guard<MeteredMutex<std::recursive_mutex>> lock(mtx_);
+
+    auto it = live_types_.find(type_name);
+    if (it == live_types_.end())
+    {
+        return;
+    }
+    if (--it->second == 0)
+    {
+        live_types_.erase(it);
+        evict_schemas_nts_();
+    }
+}
+
+SchemaCacheStats Handler::get_schema_cache_stats()
+{
+    std::lock_guard<MeteredMutex<std::recursive_mutex>> lock(mtx_);
+
+    SchemaCacheStats stats;
+    stats.known_types = schemas_.size();
+    stats.cached_types = schemas_lru_.size();
+    stats.pinned_types = live_types_.size();
+    stats.pubsub_types = writer_->pubsub_types_size();
+    stats.estimated_bytes = schemas_bytes_;
+    for (const auto& schema : schemas_)
+    {
+        const SchemaDescription& description = schema.description;
+        stats.estimated_bytes += (description.idl ? description.idl->size() : 0) +
+                (description.placeholder ? description.placeholder->size() : 0) +
+                (description.collection ? description.collection->size() : 0);
+    }
+    stats.evictions = schema_evictions_;
+    return stats;
+}
+
+void Handler::flush_discovery_batch()
+{
+    NotificationScope notifications(notifications_);
+    std::lock_guard<std::mutex> delivery_lock(discovery_delivery_mtx_);
+
+    PendingDiscovery batch;
+    {
+        std::lock_guard<std::mutex> lock(discovery_mtx_);
+        std::swap(batch, pending_discovery_);
+        discovery_pending_.store(false, std::memory_order_release);
+    }
+
+    if (batch.empty())
+    {
+        return;
+    }
+
+    EPROSIMA_LOG_INFO(DDSENABLER_HANDLER,
+            "Notifying discovery batch: " << batch.topics.size() << " topics, " << batch.services.size() <<
+            " services, " << batch.actions.size() << " actions.");
+
+    // Delivered without holding either the handler or the participant locks
+    writer_->write_discovery_batch(batch.topics, batch.services, batch.actions);
+}
+
+bool Handler::get_serialized_data(
+        const std::string& type_name,
+        const std::string& json,
+        Payload& payload)
+{
+    std::lock_guard<MeteredMutex<std::recursive_mutex>> lock(mtx_);
+
+    fastdds::dds::DynamicType::_ref_type dyn_type = get_dynamic_type_nts_(type_name);
+    if (!dyn_type)
+    {
+        EPROSIMA_LOG_ERROR(DDSENABLER_HANDLER,
+                "Failed to deserialize data for type " << type_name << " : schema not available.");
+        return false;
+    }
+
+    fastdds::dds::DynamicData::_ref_type dyn_data;
+    if ((fastdds::dds::RETCODE_OK !=
+            fastdds::dds::json_deserialize(json, dyn_type, fastdds::dds::DynamicDataJsonFormat::EPROSIMA,
+            dyn_data)) || !dyn_data)
+    {
+        EPROSIMA_LOG_ERROR(DDSENABLER_HANDLER,
+                "Failed to deserialize data for type " << type_name << " : json deserialization failed.");
+        return false;
+    }
+
+    // Use XCDR1 for backwards compatibility (e.g. ROS 2 distributions prior to Kilted)
+    fastdds::dds::DynamicPubSubType pubsub_type (dyn_type);
+    uint32_t payload_size = pubsub_type.calculate_serialized_size(&dyn_data,
+                    fastdds::dds::DataRepresentationId::XCDR_DATA_REPRESENTATION);
+
+    if (!payload_pool_->get_payload(payload_size, payload))
+    {
+        EPROSIMA_LOG_ERROR(DDSENABLER_HANDLER,
+                "Failed to deserialize data for type " << type_name << " : get_payload failed.");
+        return false;
+    }
+
+    if (!pubsub_type.serialize(&dyn_data, payload, fastdds::dds::DataRepresentationId::XCDR_DATA_REPRESENTATION))
     {
         EPROSIMA_LOG_ERROR(DDSENABLER_HANDLER,
-                "Failed to register type " << type_name << ".");
+                "Failed to deserialize data for type " << type_name << " : payload serialization failed.");
         return false;
     }
 
-    // Add to schemas map, but do not report it to the user as it is the exact same information we obtained through the
-    // type query callback.
-    add_schema_nts_(type_identifier, type_object, false);
-
     return true;
 }
 
 bool Handler::get_serialized_data(
         const std::string& type_name,
-        const std::string& json,
+        const uint8_t* cdr,
+        const uint32_t size,
+        fastdds::dds::DataRepresentationId_t representation,
         Payload& payload)
 {
-    std::lock_guard<std::recursive_mutex> lock(mtx_);
+    if (nullptr == cdr || size < ENCAPSULATION_HEADER_SIZE)
+    {
+        EPROSIMA_LOG_ERROR(DDSENABLER_HANDLER,
+                "Failed to process CDR data for type " << type_name << " : missing encapsulation header.");
+        return false;
+    }
 
-    fastdds::dds::DynamicType::_ref_type dyn_type;
-    auto it = schemas_.find(type_name);
-    if (it == schemas_.end())
+    std::lock_guard<MeteredMutex<std::recursive_mutex>> lock(mtx_);
+
+    fastdds::dds::DynamicType::_ref_type dyn_type = get_dynamic_type_nts_(type_name);
+    if (!dyn_type)
     {
         EPROSIMA_LOG_ERROR(DDSENABLER_HANDLER,
-                "Failed to deserialize data for type " << type_name << " : schema not available.");
+                "Failed to process CDR data for type " << type_name << " : schema not available.");
         return false;
     }
-    dyn_type = it->second.second;
 
-    fastdds::dds::DynamicData::_ref_type dyn_data;
-    if ((fastdds::dds::RETCODE_OK !=
-            fastdds::dds::json_deserialize(json, dyn_type, fastdds::dds::DynamicDataJsonFormat::EPROSIMA,
-            dyn_data)) || !dyn_data)
+    fastdds::dds::TypeDescriptor::_ref_type type_descriptor {
+        fastdds::dds::traits<fastdds::dds::TypeDescriptor>::make_shared()};
+    if (fastdds::dds::RETCODE_OK != dyn_type->get_descriptor(type_descriptor))
     {
         EPROSIMA_LOG_ERROR(DDSENABLER_HANDLER,
-                "Failed to deserialize data for type " << type_name << " : json deserialization failed.");
+                "Failed to process CDR data for type " << type_name << " : type descriptor not available.");
         return false;
     }
 
-    // Use XCDR1 for backwards compatibility (e.g. ROS 2 distributions prior to Kilted)
+    // The encapsulation identifier is always sent in big endian
+    const uint16_t encapsulation = static_cast<uint16_t>((cdr[0] << 8) | cdr[1]);
+    fastdds::dds::DataRepresentationId_t source_representation;
+    if (!representation_from_encapsulation(encapsulation, type_descriptor->extensibility_kind(),
+            source_representation))
+    {
+        EPROSIMA_LOG_ERROR(DDSENABLER_HANDLER,
+                "Failed to process CDR data for type " << type_name << " : encapsulation " << encapsulation <<
+                " does not match the type.");
+        return false;
+    }
+
+    if (source_representation == representation)
+    {
+        // Same encoding, forward the bytes as they are
+        if (!payload_pool_->get_payload(size, payload))
+        {
+            EPROSIMA_LOG_ERROR(DDSENABLER_HANDLER,
+                    "Failed to process CDR data for type " << type_name << " : get_payload failed.");
+            return false;
+        }
+        std::memcpy(payload.data, cdr, size);
+        payload.length = size;
+        return true;
+    }
+
+    // Re-encode the data with the requested representation
+    Payload source_payload;
+    if (!payload_pool_->get_payload(size, source_payload))
+    {
+        EPROSIMA_LOG_ERROR(DDSENABLER_HANDLER,
+                "Failed to process CDR data for type " << type_name << " : get_payload failed.");
+        return false;
+    }
+    std::memcpy(source_payload.data, cdr, size);
+    source_payload.length = size;
+
     fastdds::dds::DynamicPubSubType pubsub_type (dyn_type);
-    uint32_t payload_size = pubsub_type.calculate_serialized_size(&dyn_data,
-                    fastdds::dds::DataRepresentationId::XCDR_DATA_REPRESENTATION);
+    fastdds::dds::DynamicData::_ref_type dyn_data(
+        fastdds::dds::DynamicDataFactory::get_instance()->create_data(dyn_type));
+    if (!pubsub_type.deserialize(source_payload, &dyn_data))
+    {
+        EPROSIMA_LOG_ERROR(DDSENABLER_HANDLER,
+                "Failed to process CDR data for type " << type_name << " : payload deserialization failed.");
+        return false;
+    }
 
+    uint32_t payload_size = pubsub_type.calculate_serialized_size(&dyn_data, representation);
     if (!payload_pool_->get_payload(payload_size, payload))
     {
         EPROSIMA_LOG_ERROR(DDSENABLER_HANDLER,
-                "Failed to deserialize data for type " << type_name << " : get_payload failed.");
+                "Failed to process CDR data for type " << type_name << " : get_payload failed.");
         return false;
     }
 
-    if (!pubsub_type.serialize(&dyn_data, payload, fastdds::dds::DataRepresentationId::XCDR_DATA_REPRESENTATION))
+    if (!pubsub_type.serialize(&dyn_data, payload, representation))
     {
         EPROSIMA_LOG_ERROR(DDSENABLER_HANDLER,
-                "Failed to deserialize data for type " << type_name << " : payload serialization failed.");
+                "Failed to process CDR data for type " << type_name << " : payload serialization failed.");
         return false;
     }
 
@@ -484,12 +1362,37 @@ void Handler::add_schema_nts_(
     const std::string& type_name = dyn_type->get_name().to_string();
 
     // Check if it exists already
-    auto it = schemas_.find(type_name);
-    if (it != schemas_.end())
+    TypeInterner::TypeId id = type_interner_.find(type_name);
+    if (TypeInterner::INVALID_TYPE_ID != id)
     {
+        // Known but evicted, so just keep the given DynamicType (the user already knows about it)
+        if (!schemas_[id].dyn_type)
+        {
+            schemas_[id].dyn_type = dyn_type;
+            touch_schema_nts_(id);
+        }
         return;
     }
-    schemas_[type_name] = {type_id, dyn_type};
+    id = type_interner_.intern(type_name, type_id);
+    // Schemas are indexed by the interned id, which is not assumed to follow the number of schemas
+    if (schemas_.size() <= id)
+    {
+        schemas_.resize(id + 1);
+    }
+    schemas_[id].type_id = type_id;
+    schemas_[id].dyn_type = dyn_type;
+    touch_schema_nts_(id);
+
+    // Persist new types so they are known from startup in later executions. The record is appended once mtx_ is
+    // released, so the file I/O does not block the threads receiving data
+    if (type_store_)
+    {
+        notifications_.push(
+            [type_store = type_store_.get(), type_name, type_id]()
+            {
+                type_store->store(type_name, type_id);
+            });
+    }
 
     // Add to schemas map
     EPROSIMA_LOG_INFO(DDSENABLER_HANDLER,
@@ -521,11 +1424,355 @@ bool Handler::add_schema_nts_(
     return true;
 }
 
+bool Handler::get_schema_(
+        const std::string& type_name,
+        fastdds::dds::DynamicType::_ref_type& dyn_type,
+        fastdds::dds::xtypes::TypeIdentifier& type_id)
+{
+    TypeInterner::TypeId id = type_interner_.find(type_name);
+    if (TypeInterner::INVALID_TYPE_ID == id)
+    {
+        // Not discovered yet, try to obtain it from the registry or the user
+        if (!get_type_identifier(type_name, type_id))
+        {
+            EPROSIMA_LOG_ERROR(DDSENABLER_HANDLER,
+                    "Unknown type " << type_name << ".");
+            return false;
+        }
+        id = type_interner_.find(type_name);
+        if (TypeInterner::INVALID_TYPE_ID == id)
+        {
+            EPROSIMA_LOG_ERROR(DDSENABLER_HANDLER,
+                    "Unknown type " << type_name << ".");
+            return false;
+        }
+    }
+
+    type_id = schemas_[id].type_id;
+    dyn_type = get_dynamic_type_nts_(id);
+    return nullptr != dyn_type;
+}
+
+fastdds::dds::DynamicType::_ref_type Handler::get_dynamic_type_nts_(
+        const std::string& type_name)
+{
+    const TypeInterner::TypeId id = type_interner_.find(type_name);
+    if (TypeInterner::INVALID_TYPE_ID == id)
+    {
+        return nullptr;
+    }
+    return get_dynamic_type_nts_(id);
+}
+
+fastdds::dds::DynamicType::_ref_type Handler::get_dynamic_type_nts_(
+        TypeInterner::TypeId id)
+{
+    Schema& schema = schemas_[id];
+    if (!schema.dyn_type)
+    {
+        // Evicted, rebuild it from the registry (it is neither queried nor notified again)
+        const std::string& type_name = type_interner_.type_name(id);
+        fastdds::dds::xtypes::TypeObject type_object;
+        if (fastdds::dds::RETCODE_OK !=
+                fastdds::dds::DomainParticipantFactory::get_instance()->type_object_registry().get_type_object(
+                    schema.type_id, type_object))
+        {
+            EPROSIMA_LOG_ERROR(DDSENABLER_HANDLER,
+                    "Failed to rebuild evicted type " << type_name << " : type object not available.");
+            return nullptr;
+        }
+
+        auto builder = fastdds::dds::DynamicTypeBuilderFactory::get_instance()->create_type_w_type_object(
+            type_object);
+        if (builder)
+        {
+            schema.dyn_type = builder->build();
+        }
+        if (!schema.dyn_type)
+        {
+            EPROSIMA_LOG_ERROR(DDSENABLER_HANDLER,
+                    "Failed to rebuild evicted type " << type_name << ".");
+            return nullptr;
+        }
+
+        EPROSIMA_LOG_INFO(DDSENABLER_HANDLER,
+                "Rebuilt evicted type " << type_name << ".");
+    }
+
+    // Copy the reference, as touching the schema may evict others (never the touched one)
+    fastdds::dds::DynamicType::_ref_type dyn_type = schema.dyn_type;
+    touch_schema_nts_(id);
+    return dyn_type;
+}
+
+void Handler::touch_schema_nts_(
+        TypeInterner::TypeId id)
+{
+    Schema& schema = schemas_[id];
+    if (schema.cached)
+    {
+        schemas_lru_.splice(schemas_lru_.begin(), schemas_lru_, schema.lru_it);
+        return;
+    }
+
+    schemas_lru_.push_front(id);
+    schema.cached = true;
+    schema.lru_it = schemas_lru_.begin();
+    schema.estimated_bytes = estimate_dynamic_type_size(schema.type_id);
+    schemas_bytes_ += schema.estimated_bytes;
+
+    evict_schemas_nts_();
+}
+
+void Handler::evict_schemas_nts_()
+{
+    auto over_bounds = [this]()
+            {
+                return (configuration_.schema_cache_max_types > 0 &&
+                       schemas_lru_.size() > configuration_.schema_cache_max_types) ||
+                       (configuration_.schema_cache_max_bytes > 0 &&
+                       schemas_bytes_ > configuration_.schema_cache_max_bytes);
+            };
+
+    // Walk from the least recently used type, never evicting the most recently used one
+    auto lru_it = schemas_lru_.end();
+    while (over_bounds() && lru_it != schemas_lru_.begin() && std::prev(lru_it) != schemas_lru_.begin())
+    {
+        --lru_it;
+        const std::string& type_name = type_interner_.type_name(*lru_it);
+        if (live_types_.count(type_name))
+        {
+            continue;
+        }
+
+        Schema& schema = schemas_[*lru_it];
+        if (schema.dyn_type)
+        {
+            writer_->erase_pubsub_type(schema.dyn_type);
+            schema.dyn_type = nullptr;
+        }
+        schema.description = SchemaDescription();
+        schema.cached = false;
+        schemas_bytes_ -= schema.estimated_bytes;
+
+        EPROSIMA_LOG_INFO(DDSENABLER_HANDLER,
+                "Evicting type " << type_name << " from the schema cache.");
+
+        lru_it = schemas_lru_.erase(lru_it);
+        schema_evictions_++;
+    }
+}
+
+void Handler::schedule_discovery_batch_nts_()
+{
+    discovery_batch_last_ = std::chrono::steady_clock::now();
+    if (pending_discovery_.empty())
+    {
+        discovery_batch_start_ = discovery_batch_last_;
+    }
+    discovery_cv_.notify_one();
+}
+
+bool Handler::is_discovery_pending_(
+        const DdsTopic& topic,
+        const RpcInfo& rpc_info)
+{
+    std::lock_guard<std::mutex> lock(discovery_mtx_);
+
+    // Services and actions span several topics, so samples of any RPC topic wait for all of them
+    if (RpcType::NONE != rpc_info.rpc_type)
+    {
+        return !pending_discovery_.services.empty() || !pending_discovery_.actions.empty();
+    }
+
+    return std::any_of(pending_discovery_.topics.begin(), pending_discovery_.topics.end(),
+                   [&topic](const DdsTopic& pending_topic)
+                   {
+                       return pending_topic.m_topic_name == topic.m_topic_name;
+                   });
+}
+
+void Handler::discovery_batch_routine_()
+{
+    const std::chrono::milliseconds window(configuration_.discovery_batch_window_ms);
+
+    std::unique_lock<std::mutex> lock(discovery_mtx_);
+    while (!stop_discovery_batching_)
+    {
+        if (pending_discovery_.empty())
+        {
+            discovery_cv_.wait(lock);
+            continue;
+        }
+
+        // Debounce: wait for a window without new entities, bounded by the maximum batch length
+        const auto deadline = std::min(
+            discovery_batch_last_ + window,
+            discovery_batch_start_ + window * DISCOVERY_BATCH_MAX_WINDOWS);
+        if (std::chrono::steady_clock::now() < deadline)
+        {
+            discovery_cv_.wait_until(lock, deadline);
+            continue;
+        }
+
+        lock.unlock();
+        flush_discovery_batch();
+        lock.lock();
+    }
+}
+
+bool Handler::get_priority_class_(
+        const std::string& topic_name,
+        std::size_t& priority_class)
+{
+    std::lock_guard<std::mutex> lock(priority_mtx_);
+
+    constexpr std::size_t NOT_QUEUED = std::numeric_limits<std::size_t>::max();
+
+    auto it = priority_classes_.find(topic_name);
+    if (it == priority_classes_.end())
+    {
+        // The first class matching the topic is the one used, or the implicit default class (the last one) if none
+        std::size_t index = NOT_QUEUED;
+        if (RpcType::NONE == RpcInfo(topic_name).rpc_type)
+        {
+            const auto& classes = configuration_.priority_classes;
+            for (index = 0; index < classes.size(); ++index)
+            {
+                const auto& patterns = classes[index].topics;
+                if (std::any_of(patterns.begin(), patterns.end(), [&topic_name](const std::string& pattern)
+                        {
+                            return utils::match_pattern(pattern, topic_name);
+                        }))
+                {
+                    break;
+                }
+            }
+        }
+        it = priority_classes_.emplace(topic_name, index).first;
+    }
+
+    if (it->second == NOT_QUEUED)
+    {
+        return false;
+    }
+    priority_class = it->second;
+    return true;
+}
+
+void Handler::fill_message_(
+        const DdsTopic& topic,
+        const RtpsPayloadData& data,
+        Message& msg)
+{
+    if (data.payload.length == 0)
+    {
+        throw utils::InconsistencyException(STR_ENTRY << "Received sample with no payload.");
+    }
+    if (data.payload_owner == nullptr)
+    {
+        throw utils::InconsistencyException(STR_ENTRY << "Payload owner not found in data received.");
+    }
+
+    msg.topic = topic;
+    msg.instanceHandle = data.instanceHandle;
+    msg.source_guid = data.source_guid;
+    msg.publish_time = data.source_timestamp;
+    payload_pool_->get_payload(data.payload, msg.payload);
+    msg.payload_owner = payload_pool_.get();
+}
+
+void Handler::deliver_queued_sample_(
+        Message& msg)
+{
+    NotificationScope notifications(notifications_);
+    std::lock_guard<MeteredMutex<std::recursive_mutex>> lock(mtx_);
+
+    auto typed_it = typed_subscriptions_.find(msg.topic.m_topic_name);
+    if (typed_it != typed_subscriptions_.end())
+    {
+        if (typed_it->second.first != msg.topic.type_name)
+        {
+            EPROSIMA_LOG_WARNING(DDSENABLER_HANDLER,
+                    "Typed subscription to topic " << msg.topic.m_topic_name << " expects type " <<
+                    typed_it->second.first << " but received " << msg.topic.type_name << ".");
+            msg.metrics->filtered.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        push_typed_notification_nts_(msg, typed_it->second.second);
+        return;
+    }
+
+    fastdds::dds::DynamicType::_ref_type dyn_type = get_dynamic_type_nts_(msg.topic.type_name);
+    if (!dyn_type)
+    {
+        EPROSIMA_LOG_WARNING(DDSENABLER_HANDLER,
+                "Schema for type " << msg.topic.type_name << " not available.");
+        msg.metrics->dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    msg.sequence_number = unique_sequence_number_++;
+    write_sample_nts_(msg, dyn_type);
+}
+
+void Handler::push_typed_notification_nts_(
+        const Message& msg,
+        const TypedDataCallback& callback)
+{
+    // Traced, measured and timed by the watchdog in the writer, as the rest of the data notifications
+    writer_->write_typed_data(msg, [callback, msg]()
+            {
+                callback(msg.payload, msg.publish_time.to_ns());
+            });
+}
+
+std::vector<PriorityClassStats> Handler::get_priority_class_stats() const
+{
+    if (!priority_dispatcher_)
+    {
+        return {};
+    }
+    return priority_dispatcher_->stats();
+}
+
+EntityMetrics& Handler::entity_metrics(
+        const std::string& topic_name)
+{
+    return entity_metrics_(RpcInfo(topic_name));
+}
+
+MetricsReport Handler::get_metrics() const
+{
+    // Nothing here locks the data path, so metrics may be taken at any rate
+    MetricsReport report = metrics_.snapshot();
+    report.priority_classes = get_priority_class_stats();
+    report.pending_notifications = notifications_.size();
+    report.locks = lock_metrics();
+    return report;
+}
+
+EntityMetrics& Handler::entity_metrics_(
+        const RpcInfo& rpc_info)
+{
+    switch (rpc_info.rpc_type)
+    {
+        case RpcType::SERVICE:
+            return metrics_.entity(rpc_info.service_name, MetricsEntityKind::SERVICE);
+
+        case RpcType::ACTION:
+            return metrics_.entity(rpc_info.action_name, MetricsEntityKind::ACTION);
+
+        default:
+            return metrics_.entity(rpc_info.topic_name, MetricsEntityKind::TOPIC);
+    }
+}
+
 void Handler::write_schema_nts_(
         const fastdds::dds::DynamicType::_ref_type& dyn_type,
         const fastdds::dds::xtypes::TypeIdentifier& type_id)
 {
-    writer_->write_schema(dyn_type, type_id);
+    writer_->write_schema(dyn_type, type_id, configuration_.lazy_type_notification);
 }
 
 void Handler::write_topic_nts_(
@@ -646,6 +1893,28 @@ bool Handler::register_type_nts_(
     // Deserialize and register all dependencies and main type (last one in collection)
     for (DynamicType& dynamic_type : dynamic_types.dynamic_types())
     {
+        if (!serialization::deserialize_dynamic_type_identifier(dynamic_type, _type_identifier))
+        {
+            return false;
+        }
+
+        // Skip types already registered, which includes the dependencies referenced by incremental collections
+        if (fastdds::dds::RETCODE_OK ==
+                fastdds::dds::DomainParticipantFactory::get_instance()->type_object_registry().get_type_object(
+                    _type_identifier, _type_object))
+        {
+            _type_name = dynamic_type.type_name();
+            continue;
+        }
+
+        if (dynamic_type.type_object().empty())
+        {
+            EPROSIMA_LOG_ERROR(DDSENABLER_HANDLER,
+                    "Failed to register " << dynamic_type.type_name() <<
+                    " DynamicType: referenced but not previously registered.");
+            return false;
+        }
+
         if (!serialization::deserialize_dynamic_type(dynamic_type, _type_name, _type_identifier, _type_object))
         {
             EPROSIMA_LOG_ERROR(DDSENABLER_HANDLER,
@@ -684,6 +1953,31 @@ bool Handler::register_type_nts_(
     return true;
 }
 
+bool Handler::add_typed_subscription(
+        const std::string& topic_name,
+        const std::string& type_name,
+        TypedDataCallback callback)
+{
+    std::lock_guard<MeteredMutex<std::recursive_mutex>> lock(mtx_);
+
+    if (!typed_subscriptions_.emplace(topic_name, std::make_pair(type_name, std::move(callback))).second)
+    {
+        EPROSIMA_LOG_ERROR(DDSENABLER_HANDLER,
+                "Failed to subscribe to topic " << topic_name << " : already subscribed.");
+        return false;
+    }
+
+    return true;
+}
+
+bool Handler::remove_typed_subscription(
+        const std::string& topic_name)
+{
+    std::lock_guard<MeteredMutex<std::recursive_mutex>> lock(mtx_);
+
+    return typed_subscriptions_.erase(topic_name) > 0;
+}
+
 bool Handler::store_action_request(
         const std::string& action_name,
         const UUID& action_id,
@@ -691,7 +1985,7 @@ bool Handler::store_action_request(
         const ActionType action_type,
         const Protocol Protocol)
 {
-    std::lock_guard<std::recursive_mutex> lock(mtx_);
+    std::lock_guard<MeteredMutex<std::recursive_mutex>> lock(mtx_);
 
     auto it = action_request_id_to_uuid_.find(action_id);
     if (it != action_request_id_to_uuid_.end())
@@ -732,7 +2026,7 @@ bool Handler::handle_action_result(
         const UUID& action_id,
         const std::string& result)
 {
-    std::lock_guard<std::recursive_mutex> lock(mtx_);
+    std::unique_lock<MeteredMutex<std::recursive_mutex>> lock(mtx_);
     auto it = action_request_id_to_uuid_.find(action_id);
     if (it != action_request_id_to_uuid_.end())
     {
@@ -745,11 +2039,14 @@ bool Handler::handle_action_result(
         }
         if (it->second.result_request_id != 0)
         {
+            // Sending the reply reenters the enabler, so the handler lock is released first
+            const uint64_t result_request_id = it->second.result_request_id;
+            lock.unlock();
             return send_action_get_result_reply_callback_(
                 action_name,
                 action_id,
                 result,
-                it->second.result_request_id);
+                result_request_id);
         }
         if (it->second.set_result(std::move(result)))
         {
@@ -771,7 +2068,7 @@ void Handler::erase_action_UUID(
         const UUID& action_id,
         ActionEraseReason erase_reason)
 {
-    std::lock_guard<std::recursive_mutex> lock(mtx_);
+    std::lock_guard<MeteredMutex<std::recursive_mutex>> lock(mtx_);
     auto it = action_request_id_to_uuid_.find(action_id);
     if (it != action_request_id_to_uuid_.end())
     {
@@ -787,7 +2084,7 @@ bool Handler::is_UUID_active(
         const UUID& action_id,
         std::chrono::system_clock::time_point* goal_accepted_stamp)
 {
-    std::lock_guard<std::recursive_mutex> lock(mtx_);
+    std::lock_guard<MeteredMutex<std::recursive_mutex>> lock(mtx_);
     auto it = action_request_id_to_uuid_.find(action_id);
     if (it != action_request_id_to_uuid_.end() && action_name == it->second.action_name)
     {
@@ -805,7 +2102,7 @@ Protocol Handler::get_action_protocol(
         const std::string& action_name,
         const UUID& action_id)
 {
-    std::lock_guard<std::recursive_mutex> lock(mtx_);
+    std::lock_guard<MeteredMutex<std::recursive_mutex>> lock(mtx_);
     auto it = action_request_id_to_uuid_.find(action_id);
     if (it != action_request_id_to_uuid_.end() && action_name == it->second.action_name)
     {
@@ -820,7 +2117,7 @@ bool Handler::get_action_request_UUID(
         const ActionType action_type,
         UUID& action_id)
 {
-    std::lock_guard<std::recursive_mutex> lock(mtx_);
+    std::lock_guard<MeteredMutex<std::recursive_mutex>> lock(mtx_);
     for (auto it = action_request_id_to_uuid_.begin(); it != action_request_id_to_uuid_.end(); ++it)
     {
         try
@@ -845,7 +2142,7 @@ bool Handler::get_action_result(
         const UUID& action_id,
         std::string& result)
 {
-    std::lock_guard<std::recursive_mutex> lock(mtx_);
+    std::lock_guard<MeteredMutex<std::recursive_mutex>> lock(mtx_);
     auto it = action_request_id_to_uuid_.find(action_id);
     if (it != action_request_id_to_uuid_.end())
     {
@@ -942,6 +2239,21 @@ void Handler::set_action_cancel_request_notification_callback(
     writer_->set_action_cancel_request_notification_callback(callback);
 }
 
+void Handler::set_discovery_batch_notification_callback(
+        participants::DiscoveryBatchNotification callback)
+{
+    writer_->set_discovery_batch_notification_callback(callback);
+}
+
+void Handler::set_slow_callback_notification_callback(
+        participants::SlowCallbackNotification callback)
+{
+    if (callback_watchdog_)
+    {
+        callback_watchdog_->set_slow_callback_notification_callback(callback);
+    }
+}
+
 void Handler::set_send_action_send_goal_reply_callback(
         std::function<void(const std::string&, const uint64_t, bool accepted)> callback)
 {
@@ -956,7 +2268,7 @@ void Handler::set_send_action_get_result_reply_callback(
 
 uint64_t Handler::get_new_request_id()
 {
-    std::lock_guard<std::recursive_mutex> lock(mtx_);
+    std::lock_guard<MeteredMutex<std::recursive_mutex>> lock(mtx_);
     return ++requests_id_;
 }
 
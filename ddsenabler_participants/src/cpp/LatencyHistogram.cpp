@@ -0,0 +1,110 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file LatencyHistogram.cpp
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include <ddsenabler_participants/LatencyHistogram.hpp>
+
+namespace eprosima {
+namespace ddsenabler {
+namespace participants {
+
+namespace {
+
+std::size_t bucket_index(
+        uint64_t latency_ns) noexcept
+{
+    uint64_t latency_us = latency_ns / 1000;
+    std::size_t index = 0;
+    while (latency_us > 0 && index < LATENCY_HISTOGRAM_BUCKETS - 1)
+    {
+        latency_us >>= 1;
+        ++index;
+    }
+    return index;
+}
+
+uint64_t bucket_upper_bound_ns(
+        std::size_t index) noexcept
+{
+    return (uint64_t{1} << index) * 1000;
+}
+
+} // namespace
+
+uint64_t LatencyStats::mean_ns() const noexcept
+{
+    return (count > 0) ? total_ns / count : 0;
+}
+
+uint64_t LatencyStats::percentile_ns(
+        double percentile) const noexcept
+{
+    uint64_t total = 0;
+    for (const auto bucket : buckets)
+    {
+        total += bucket;
+    }
+    if (total == 0)
+    {
+        return 0;
+    }
+
+    const uint64_t rank = static_cast<uint64_t>(std::ceil(total * std::min(std::max(percentile, 0.0), 100.0) / 100));
+    uint64_t accumulated = 0;
+    for (std::size_t i = 0; i < LATENCY_HISTOGRAM_BUCKETS; ++i)
+    {
+        accumulated += buckets[i];
+        if (accumulated >= std::max<uint64_t>(rank, 1))
+        {
+            return std::min(bucket_upper_bound_ns(i), max_ns);
+        }
+    }
+    return max_ns;
+}
+
+void LatencyHistogram::record(
+        uint64_t latency_ns) noexcept
+{
+    buckets_[bucket_index(latency_ns)].fetch_add(1, std::memory_order_relaxed);
+    total_ns_.fetch_add(latency_ns, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+
+    uint64_t max = max_ns_.load(std::memory_order_relaxed);
+    while (latency_ns > max && !max_ns_.compare_exchange_weak(max, latency_ns, std::memory_order_relaxed))
+    {
+    }
+}
+
+LatencyStats LatencyHistogram::stats() const noexcept
+{
+    LatencyStats stats;
+    stats.count = count_.load(std::memory_order_relaxed);
+    stats.total_ns = total_ns_.load(std::memory_order_relaxed);
+    stats.max_ns = max_ns_.load(std::memory_order_relaxed);
+    for (std::size_t i = 0; i < LATENCY_HISTOGRAM_BUCKETS; ++i)
+    {
+        stats.buckets[i] = buckets_[i].load(std::memory_order_relaxed);
+    }
+    return stats;
+}
+
+} /* namespace participants */
+} /* namespace ddsenabler */
+} /* namespace eprosima */
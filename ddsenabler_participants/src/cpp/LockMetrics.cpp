@@ -0,0 +1,97 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file LockMetrics.cpp
+ */
+
+#include <map>
+#include <memory>
+#include <utility>
+
+#include <ddsenabler_participants/LockMetrics.hpp>
+
+namespace eprosima {
+namespace ddsenabler {
+namespace participants {
+
+namespace {
+
+/**
+ * Locks registered in the process.
+ *
+ * Never destroyed, so locks of objects with static storage duration may still be metered while the process exits.
+ */
+struct LockRegistry
+{
+    std::mutex mtx;
+
+    std::map<std::string, std::unique_ptr<LockStats>> locks;
+};
+
+LockRegistry& registry()
+{
+    static LockRegistry* registry = new LockRegistry();
+    return *registry;
+}
+
+} // namespace
+
+LockStats::LockStats(
+        const std::string& name)
+    : name(name)
+{
+}
+
+LockStats& lock_stats(
+        const std::string& name)
+{
+    LockRegistry& locks = registry();
+    std::lock_guard<std::mutex> lock(locks.mtx);
+
+    auto& stats = locks.locks[name];
+    if (!stats)
+    {
+        stats = std::make_unique<LockStats>(name);
+    }
+    return *stats;
+}
+
+std::vector<LockMetricsSnapshot> lock_metrics()
+{
+    LockRegistry& locks = registry();
+    std::lock_guard<std::mutex> lock(locks.mtx);
+
+    std::vector<LockMetricsSnapshot> snapshots;
+    for (const auto& it : locks.locks)
+    {
+        const LockStats& stats = *it.second;
+
+        LockMetricsSnapshot snapshot;
+        snapshot.name = stats.name;
+        snapshot.contended = stats.contended.load(std::memory_order_relaxed);
+        snapshot.wait_time = stats.wait_time.stats();
+        snapshot.hold_time = stats.hold_time.stats();
+        snapshot.acquisitions = snapshot.wait_time.count;
+        if (snapshot.acquisitions > 0)
+        {
+            snapshots.push_back(std::move(snapshot));
+        }
+    }
+    return snapshots;
+}
+
+} /* namespace participants */
+} /* namespace ddsenabler */
+} /* namespace eprosima */
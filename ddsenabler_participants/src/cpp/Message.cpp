@@ -34,6 +34,8 @@ Message::Message(
     source_guid = msg.source_guid;
     sequence_number = msg.sequence_number;
     publish_time = msg.publish_time;
+    metrics = msg.metrics;
+    trace_id = msg.trace_id;
 }
 
 Message::~Message()
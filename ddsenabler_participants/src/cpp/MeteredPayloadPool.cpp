@@ -0,0 +1,111 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file MeteredPayloadPool.cpp
+ */
+
+#include <ddsenabler_participants/MeteredPayloadPool.hpp>
+
+namespace eprosima {
+namespace ddsenabler {
+namespace participants {
+
+namespace {
+
+//! Number of pool calls in progress in the current thread, so calls made by the pool itself are not counted twice
+thread_local unsigned int pool_call_depth = 0;
+
+struct PoolCall
+{
+    PoolCall()
+    {
+        ++pool_call_depth;
+    }
+
+    ~PoolCall()
+    {
+        --pool_call_depth;
+    }
+
+    bool outermost() const noexcept
+    {
+        return 1 == pool_call_depth;
+    }
+
+};
+
+} // namespace
+
+bool MeteredPayloadPool::get_payload(
+        uint32_t size,
+        ddspipe::core::types::Payload& payload)
+{
+    PoolCall call;
+    if (!FastPayloadPool::get_payload(size, payload))
+    {
+        return false;
+    }
+    if (call.outermost())
+    {
+        in_use_.fetch_add(1, std::memory_order_relaxed);
+    }
+    reserved_total_.fetch_add(1, std::memory_order_relaxed);
+    reserved_bytes_total_.fetch_add(size, std::memory_order_relaxed);
+    return true;
+}
+
+bool MeteredPayloadPool::get_payload(
+        const ddspipe::core::types::Payload& src_payload,
+        ddspipe::core::types::Payload& target_payload)
+{
+    PoolCall call;
+    if (!FastPayloadPool::get_payload(src_payload, target_payload))
+    {
+        return false;
+    }
+    if (call.outermost())
+    {
+        in_use_.fetch_add(1, std::memory_order_relaxed);
+    }
+    return true;
+}
+
+bool MeteredPayloadPool::release_payload(
+        ddspipe::core::types::Payload& payload)
+{
+    PoolCall call;
+    if (!FastPayloadPool::release_payload(payload))
+    {
+        return false;
+    }
+    if (call.outermost())
+    {
+        in_use_.fetch_sub(1, std::memory_order_relaxed);
+    }
+    return true;
+}
+
+PayloadPoolStats MeteredPayloadPool::stats() const noexcept
+{
+    PayloadPoolStats stats;
+    stats.in_use = in_use_.load(std::memory_order_relaxed);
+    stats.reserved_total = reserved_total_.load(std::memory_order_relaxed);
+    stats.reserved_bytes_total = reserved_bytes_total_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+} /* namespace participants */
+} /* namespace ddsenabler */
+} /* namespace eprosima */
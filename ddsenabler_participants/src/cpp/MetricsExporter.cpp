@@ -0,0 +1,855 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file MetricsExporter.cpp
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <tuple>
+#include <utility>
+
+#ifndef _WIN32
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif // ifndef _WIN32
+
+#include <nlohmann/json.hpp>
+
+#include <fastdds/dds/log/Log.hpp>
+
+#include <ddsenabler_participants/MetricsExporter.hpp>
+
+namespace eprosima {
+namespace ddsenabler {
+namespace participants {
+
+namespace {
+
+//! Maximum size of the requests read from the Prometheus endpoints
+constexpr const std::size_t MAX_REQUEST_SIZE = 4096;
+
+//! Time given to clients to send their request
+constexpr const int REQUEST_TIMEOUT_MS = 1000;
+
+//! Time given to clients to make room for each chunk of the response
+constexpr const int RESPONSE_TIMEOUT_MS = 1000;
+
+const char* kind_to_string(
+        MetricsEntityKind kind)
+{
+    switch (kind)
+    {
+        case MetricsEntityKind::SERVICE:
+            return "service";
+        case MetricsEntityKind::ACTION:
+            return "action";
+        default:
+            return "topic";
+    }
+}
+
+int64_t to_ms(
+        std::chrono::system_clock::time_point timestamp)
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(timestamp.time_since_epoch()).count();
+}
+
+std::string format_double(
+        double value)
+{
+    std::ostringstream out;
+    out << std::setprecision(12) << value;
+    return out.str();
+}
+
+//! Escape a Prometheus label value
+std::string escape_label(
+        const std::string& value)
+{
+    std::string escaped;
+    escaped.reserve(value.size());
+    for (const char c : value)
+    {
+        switch (c)
+        {
+            case '\\':
+                escaped += "\\\\";
+                break;
+            case '"':
+                escaped += "\\\"";
+                break;
+            case '\n':
+                escaped += "\\n";
+                break;
+            default:
+                escaped += c;
+        }
+    }
+    return escaped;
+}
+
+//! Quote a CSV field if needed
+std::string escape_csv(
+        const std::string& value)
+{
+    if (value.find_first_of(",\"\n") == std::string::npos)
+    {
+        return value;
+    }
+    std::string escaped = "\"";
+    for (const char c : value)
+    {
+        if (c == '"')
+        {
+            escaped += '"';
+        }
+        escaped += c;
+    }
+    return escaped + "\"";
+}
+
+std::string entity_labels(
+        const EntityMetricsSnapshot& entity)
+{
+    return std::string("kind=\"") + kind_to_string(entity.kind) + "\",entity=\"" + escape_label(entity.name) + "\"";
+}
+
+void write_family_header(
+        std::ostringstream& out,
+        const std::string& name,
+        const char* type,
+        const char* help)
+{
+    out << "# HELP " << name << " " << help << "\n";
+    out << "# TYPE " << name << " " << type << "\n";
+}
+
+void write_histogram(
+        std::ostringstream& out,
+        const std::string& name,
+        const std::string& labels,
+        const LatencyStats& stats)
+{
+    // The last bucket holds every latency above the previous one, so it is exported as +Inf
+    uint64_t accumulated = 0;
+    for (std::size_t i = 0; i + 1 < LATENCY_HISTOGRAM_BUCKETS; ++i)
+    {
+        accumulated += stats.buckets[i];
+        const double upper_bound_s = static_cast<double>(uint64_t{1} << i) * 1e-6;
+        out << name << "_bucket{" << labels << ",le=\"" << format_double(upper_bound_s) << "\"} " << accumulated
+            << "\n";
+    }
+    out << name << "_bucket{" << labels << ",le=\"+Inf\"} " << stats.count << "\n";
+    out << name << "_sum{" << labels << "} " << format_double(stats.total_ns * 1e-9) << "\n";
+    out << name << "_count{" << labels << "} " << stats.count << "\n";
+}
+
+nlohmann::json latency_to_json(
+        const LatencyStats& stats)
+{
+    nlohmann::json json;
+    json["count"] = stats.count;
+    json["mean_ns"] = stats.mean_ns();
+    json["p50_ns"] = stats.percentile_ns(50);
+    json["p99_ns"] = stats.percentile_ns(99);
+    json["p999_ns"] = stats.percentile_ns(99.9);
+    json["max_ns"] = stats.max_ns;
+    return json;
+}
+
+/**
+ * Rates per second of the counters of an entity since a previous report.
+ */
+struct EntityRates
+{
+    double received {0};
+    double delivered {0};
+    double published {0};
+    double dropped {0};
+};
+
+using EntityKey = std::pair<MetricsEntityKind, std::string>;
+
+//! Compute the rates of every entity of \c report present in \c previous
+std::map<EntityKey, EntityRates> compute_rates(
+        const MetricsReport& report,
+        const MetricsReport* previous)
+{
+    std::map<EntityKey, EntityRates> rates;
+    if (!previous)
+    {
+        return rates;
+    }
+    const double interval_s = std::chrono::duration<double>(report.timestamp - previous->timestamp).count();
+    if (interval_s <= 0)
+    {
+        return rates;
+    }
+
+    std::map<EntityKey, const EntityMetricsSnapshot*> previous_entities;
+    for (const auto& entity : previous->entities)
+    {
+        previous_entities[{entity.kind, entity.name}] = &entity;
+    }
+
+    auto rate = [interval_s](uint64_t current, uint64_t before)
+            {
+                return (current >= before) ? (current - before) / interval_s : 0.0;
+            };
+
+    for (const auto& entity : report.entities)
+    {
+        auto it = previous_entities.find({entity.kind, entity.name});
+        if (it == previous_entities.end())
+        {
+            continue;
+        }
+        EntityRates& entity_rates = rates[it->first];
+        entity_rates.received = rate(entity.received, it->second->received);
+        entity_rates.delivered = rate(entity.delivered, it->second->delivered);
+        entity_rates.published = rate(entity.published, it->second->published);
+        entity_rates.dropped = rate(entity.dropped, it->second->dropped);
+    }
+    return rates;
+}
+
+#ifndef _WIN32
+#ifdef MSG_NOSIGNAL
+constexpr const int SEND_FLAGS = MSG_NOSIGNAL;
+#else
+constexpr const int SEND_FLAGS = 0;
+#endif // ifdef MSG_NOSIGNAL
+
+bool send_all(
+        int fd,
+        const std::string& data)
+{
+    std::size_t sent = 0;
+    while (sent < data.size())
+    {
+        const ssize_t ret = ::send(fd, data.data() + sent, data.size() - sent, SEND_FLAGS);
+        if (ret <= 0)
+        {
+            return false;
+        }
+        sent += static_cast<std::size_t>(ret);
+    }
+    return true;
+}
+
+//! Remove the Unix socket at a path, leaving anything else that may be there untouched
+void unlink_socket(
+        const std::string& path)
+{
+    struct stat status {};
+    if (::lstat(path.c_str(), &status) == 0 && S_ISSOCK(status.st_mode))
+    {
+        ::unlink(path.c_str());
+    }
+}
+
+#endif // ifndef _WIN32
+
+} // namespace
+
+std::string metrics_to_prometheus(
+        const MetricsReport& report)
+{
+    std::ostringstream out;
+
+    // Counters of every entity
+    const std::vector<std::tuple<const char*, uint64_t EntityMetricsSnapshot::*, const char*>> counters = {
+        {"ddsenabler_received_total", &EntityMetricsSnapshot::received, "Samples received from DDS."},
+        {"ddsenabler_converted_total", &EntityMetricsSnapshot::converted, "Conversions between CDR and JSON."},
+        {"ddsenabler_delivered_total", &EntityMetricsSnapshot::delivered, "Notifications delivered to the app."},
+        {"ddsenabler_filtered_total", &EntityMetricsSnapshot::filtered, "Samples discarded on purpose."},
+        {"ddsenabler_dropped_total", &EntityMetricsSnapshot::dropped, "Samples lost."},
+        {"ddsenabler_published_total", &EntityMetricsSnapshot::published, "Samples published from the app."},
+        {"ddsenabler_received_bytes_total", &EntityMetricsSnapshot::bytes_in, "Serialized bytes received from DDS."},
+        {"ddsenabler_published_bytes_total", &EntityMetricsSnapshot::bytes_out, "Serialized bytes published."}
+    };
+    for (const auto& counter : counters)
+    {
+        write_family_header(out, std::get<0>(counter), "counter", std::get<2>(counter));
+        for (const auto& entity : report.entities)
+        {
+            out << std::get<0>(counter) << "{" << entity_labels(entity) << "} " << entity.*std::get<1>(counter)
+                << "\n";
+        }
+    }
+
+    // Latency histograms of every entity
+    const std::vector<std::tuple<const char*, LatencyStats EntityMetricsSnapshot::*, const char*>> histograms = {
+        {"ddsenabler_conversion_seconds", &EntityMetricsSnapshot::conversion_time,
+         "Time taken by the conversions between CDR and JSON."},
+        {"ddsenabler_callback_seconds", &EntityMetricsSnapshot::callback_time, "Time taken by the app callbacks."},
+        {"ddsenabler_latency_seconds", &EntityMetricsSnapshot::latency,
+         "Time from the sample source timestamp until its notification is delivered."}
+    };
+    for (const auto& histogram : histograms)
+    {
+        write_family_header(out, std::get<0>(histogram), "histogram", std::get<2>(histogram));
+        for (const auto& entity : report.entities)
+        {
+            write_histogram(out, std::get<0>(histogram), entity_labels(entity), entity.*std::get<1>(histogram));
+        }
+    }
+
+    // Priority classes
+    if (!report.priority_classes.empty())
+    {
+        write_family_header(out, "ddsenabler_priority_queued", "gauge", "Samples waiting in a priority class.");
+        for (const auto& priority_class : report.priority_classes)
+        {
+            out << "ddsenabler_priority_queued{class=\"" << escape_label(priority_class.name) << "\"} "
+                << priority_class.queued << "\n";
+        }
+        write_family_header(out, "ddsenabler_priority_delivered_total", "counter",
+                "Samples delivered from a priority class.");
+        for (const auto& priority_class : report.priority_classes)
+        {
+            out << "ddsenabler_priority_delivered_total{class=\"" << escape_label(priority_class.name) << "\"} "
+                << priority_class.delivered << "\n";
+        }
+        write_family_header(out, "ddsenabler_priority_dropped_total", "counter",
+                "Samples dropped because the queue of a priority class was full.");
+        for (const auto& priority_class : report.priority_classes)
+        {
+            out << "ddsenabler_priority_dropped_total{class=\"" << escape_label(priority_class.name) << "\"} "
+                << priority_class.dropped << "\n";
+        }
+        write_family_header(out, "ddsenabler_priority_latency_seconds", "histogram",
+                "Time from a sample being queued in a priority class until its delivery completes.");
+        for (const auto& priority_class : report.priority_classes)
+        {
+            write_histogram(out, "ddsenabler_priority_latency_seconds",
+                    "class=\"" + escape_label(priority_class.name) + "\"", priority_class.latency);
+        }
+    }
+
+    // Queues and payload pool
+    write_family_header(out, "ddsenabler_pending_notifications", "gauge",
+            "Notifications waiting to be delivered to the app.");
+    out << "ddsenabler_pending_notifications " << report.pending_notifications << "\n";
+    write_family_header(out, "ddsenabler_payload_pool_in_use", "gauge", "Payload references currently held.");
+    out << "ddsenabler_payload_pool_in_use " << report.payload_pool.in_use << "\n";
+    write_family_header(out, "ddsenabler_payload_pool_reserved_total", "counter", "Payloads reserved since startup.");
+    out << "ddsenabler_payload_pool_reserved_total " << report.payload_pool.reserved_total << "\n";
+    write_family_header(out, "ddsenabler_payload_pool_reserved_bytes_total", "counter",
+            "Payload bytes reserved since startup.");
+    out << "ddsenabler_payload_pool_reserved_bytes_total " << report.payload_pool.reserved_bytes_total << "\n";
+
+    // Lock contention
+    if (!report.locks.empty())
+    {
+        write_family_header(out, "ddsenabler_lock_acquisitions_total", "counter", "Acquisitions of a lock.");
+        for (const auto& lock : report.locks)
+        {
+            out << "ddsenabler_lock_acquisitions_total{lock=\"" << escape_label(lock.name) << "\"} "
+                << lock.acquisitions << "\n";
+        }
+        write_family_header(out, "ddsenabler_lock_contended_total", "counter",
+                "Acquisitions of a lock that waited for another thread to release it.");
+        for (const auto& lock : report.locks)
+        {
+            out << "ddsenabler_lock_contended_total{lock=\"" << escape_label(lock.name) << "\"} "
+                << lock.contended << "\n";
+        }
+        write_family_header(out, "ddsenabler_lock_wait_seconds", "histogram", "Time waited to acquire a lock.");
+        for (const auto& lock : report.locks)
+        {
+            write_histogram(out, "ddsenabler_lock_wait_seconds", "lock=\"" + escape_label(lock.name) + "\"",
+                    lock.wait_time);
+        }
+        write_family_header(out, "ddsenabler_lock_hold_seconds", "histogram", "Time a lock was held.");
+        for (const auto& lock : report.locks)
+        {
+            write_histogram(out, "ddsenabler_lock_hold_seconds", "lock=\"" + escape_label(lock.name) + "\"",
+                    lock.hold_time);
+        }
+    }
+
+    return out.str();
+}
+
+std::string metrics_to_json(
+        const MetricsReport& report,
+        const MetricsReport* previous)
+{
+    const auto rates = compute_rates(report, previous);
+
+    nlohmann::json json;
+    json["timestamp_ms"] = to_ms(report.timestamp);
+
+    json["entities"] = nlohmann::json::array();
+    for (const auto& entity : report.entities)
+    {
+        nlohmann::json entity_json;
+        entity_json["name"] = entity.name;
+        entity_json["kind"] = kind_to_string(entity.kind);
+        entity_json["received"] = entity.received;
+        entity_json["converted"] = entity.converted;
+        entity_json["delivered"] = entity.delivered;
+        entity_json["filtered"] = entity.filtered;
+        entity_json["dropped"] = entity.dropped;
+        entity_json["published"] = entity.published;
+        entity_json["bytes_in"] = entity.bytes_in;
+        entity_json["bytes_out"] = entity.bytes_out;
+        entity_json["conversion_time"] = latency_to_json(entity.conversion_time);
+        entity_json["callback_time"] = latency_to_json(entity.callback_time);
+        entity_json["latency"] = latency_to_json(entity.latency);
+
+        auto it = rates.find({entity.kind, entity.name});
+        if (it != rates.end())
+        {
+            entity_json["received_per_s"] = it->second.received;
+            entity_json["delivered_per_s"] = it->second.delivered;
+            entity_json["published_per_s"] = it->second.published;
+            entity_json["dropped_per_s"] = it->second.dropped;
+        }
+        json["entities"].push_back(std::move(entity_json));
+    }
+
+    json["priority_classes"] = nlohmann::json::array();
+    for (const auto& priority_class : report.priority_classes)
+    {
+        nlohmann::json class_json;
+        class_json["name"] = priority_class.name;
+        class_json["queued"] = priority_class.queued;
+        class_json["delivered"] = priority_class.delivered;
+        class_json["dropped"] = priority_class.dropped;
+        class_json["latency"] = latency_to_json(priority_class.latency);
+        json["priority_classes"].push_back(std::move(class_json));
+    }
+
+    json["pending_notifications"] = report.pending_notifications;
+    json["payload_pool"]["in_use"] = report.payload_pool.in_use;
+    json["payload_pool"]["reserved_total"] = report.payload_pool.reserved_total;
+    json["payload_pool"]["reserved_bytes_total"] = report.payload_pool.reserved_bytes_total;
+
+    json["locks"] = nlohmann::json::array();
+    for (const auto& lock : report.locks)
+    {
+        nlohmann::json lock_json;
+        lock_json["name"] = lock.name;
+        lock_json["acquisitions"] = lock.acquisitions;
+        lock_json["contended"] = lock.contended;
+        lock_json["wait_time"] = latency_to_json(lock.wait_time);
+        lock_json["hold_time"] = latency_to_json(lock.hold_time);
+        json["locks"].push_back(std::move(lock_json));
+    }
+
+    return json.dump();
+}
+
+std::string metrics_csv_header()
+{
+    return "timestamp_ms,kind,entity,received,converted,delivered,filtered,dropped,published,bytes_in,bytes_out,"
+           "received_per_s,delivered_per_s,published_per_s,dropped_per_s,"
+           "conversion_p50_ns,conversion_p99_ns,callback_p50_ns,callback_p99_ns,"
+           "latency_p50_ns,latency_p99_ns,latency_p999_ns,latency_max_ns";
+}
+
+std::string metrics_to_csv(
+        const MetricsReport& report,
+        const MetricsReport* previous)
+{
+    const auto rates = compute_rates(report, previous);
+
+    std::ostringstream out;
+    for (const auto& entity : report.entities)
+    {
+        EntityRates entity_rates;
+        auto it = rates.find({entity.kind, entity.name});
+        if (it != rates.end())
+        {
+            entity_rates = it->second;
+        }
+
+        out << to_ms(report.timestamp) << "," << kind_to_string(entity.kind) << "," << escape_csv(entity.name) << ","
+            << entity.received << "," << entity.converted << "," << entity.delivered << "," << entity.filtered << ","
+            << entity.dropped << "," << entity.published << "," << entity.bytes_in << "," << entity.bytes_out << ","
+            << format_double(entity_rates.received) << "," << format_double(entity_rates.delivered) << ","
+            << format_double(entity_rates.published) << "," << format_double(entity_rates.dropped) << ","
+            << entity.conversion_time.percentile_ns(50) << "," << entity.conversion_time.percentile_ns(99) << ","
+            << entity.callback_time.percentile_ns(50) << "," << entity.callback_time.percentile_ns(99) << ","
+            << entity.latency.percentile_ns(50) << "," << entity.latency.percentile_ns(99) << ","
+            << entity.latency.percentile_ns(99.9) << "," << entity.latency.max_ns << "\n";
+    }
+    return out.str();
+}
+
+MetricsExporter::MetricsExporter(
+        const MetricsExportConfiguration& configuration,
+        MetricsSource&& source)
+    : configuration_(configuration)
+    , source_(std::move(source))
+{
+    if (configuration_.prometheus_port != 0)
+    {
+        tcp_listener_ = open_tcp_listener_(configuration_.prometheus_port);
+    }
+    if (!configuration_.prometheus_unix_socket.empty())
+    {
+        unix_listener_ = open_unix_listener_(configuration_.prometheus_unix_socket);
+    }
+
+#ifndef _WIN32
+    if ((tcp_listener_ >= 0 || unix_listener_ >= 0) && ::pipe(wake_pipe_) != 0)
+    {
+        EPROSIMA_LOG_WARNING(DDSENABLER_METRICS_EXPORTER,
+                "Failed to create the wake-up pipe of the metrics exporter: " << std::strerror(errno));
+        wake_pipe_[0] = wake_pipe_[1] = -1;
+    }
+#endif // ifndef _WIN32
+
+    thread_ = std::thread(&MetricsExporter::run_, this);
+}
+
+MetricsExporter::~MetricsExporter()
+{
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        stop_.store(true);
+    }
+    cv_.notify_one();
+
+#ifndef _WIN32
+    if (wake_pipe_[1] >= 0)
+    {
+        const char wake = 0;
+        if (::write(wake_pipe_[1], &wake, 1) < 0)
+        {
+            // The exporter thread notices the stop on its next poll timeout
+        }
+    }
+#endif // ifndef _WIN32
+
+    thread_.join();
+
+#ifndef _WIN32
+    for (int fd : {tcp_listener_, unix_listener_, wake_pipe_[0], wake_pipe_[1]})
+    {
+        if (fd >= 0)
+        {
+            ::close(fd);
+        }
+    }
+    if (unix_listener_ >= 0)
+    {
+        unlink_socket(configuration_.prometheus_unix_socket);
+    }
+#endif // ifndef _WIN32
+}
+
+bool MetricsExporter::dump()
+{
+    if (configuration_.file_path.empty())
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(dump_mtx_);
+
+    auto report = std::make_unique<MetricsReport>(source_());
+
+    std::string data;
+    if (MetricsFileFormat::CSV == configuration_.file_format)
+    {
+        data = metrics_to_csv(*report, previous_.get());
+    }
+    else
+    {
+        data = metrics_to_json(*report, previous_.get()) + "\n";
+    }
+    previous_ = std::move(report);
+
+    rotate_nts_(data.size());
+
+    std::error_code ec;
+    const bool new_file = !std::filesystem::exists(configuration_.file_path, ec) ||
+            std::filesystem::file_size(configuration_.file_path, ec) == 0;
+
+    std::ofstream file(configuration_.file_path, std::ios::app);
+    if (!file.is_open())
+    {
+        EPROSIMA_LOG_WARNING(DDSENABLER_METRICS_EXPORTER,
+                "Failed to open metrics file " << configuration_.file_path << ".");
+        return false;
+    }
+    if (new_file && MetricsFileFormat::CSV == configuration_.file_format)
+    {
+        file << metrics_csv_header() << "\n";
+    }
+    file << data;
+    return file.good();
+}
+
+void MetricsExporter::run_()
+{
+    const bool dump_to_file = !configuration_.file_path.empty();
+    const auto period = std::chrono::milliseconds(std::max<uint32_t>(configuration_.file_period_ms, 1));
+    auto next_dump = std::chrono::steady_clock::now() + period;
+
+    while (!stop_.load())
+    {
+        // Without file dumps, just wait for requests (or the stop)
+        auto timeout = std::chrono::milliseconds(1000);
+        if (dump_to_file)
+        {
+            timeout = std::max(std::chrono::milliseconds(0), std::chrono::duration_cast<std::chrono::milliseconds>(
+                                next_dump - std::chrono::steady_clock::now()));
+        }
+        wait_(timeout);
+
+        if (dump_to_file && !stop_.load() && std::chrono::steady_clock::now() >= next_dump)
+        {
+            dump();
+            next_dump += period;
+            // Skip the dumps missed meanwhile (e.g. because of a slow disk) instead of writing them in a burst
+            const auto now = std::chrono::steady_clock::now();
+            if (next_dump < now)
+            {
+                next_dump = now + period;
+            }
+        }
+    }
+}
+
+void MetricsExporter::wait_(
+        std::chrono::milliseconds timeout)
+{
+#ifndef _WIN32
+    if (wake_pipe_[0] >= 0)
+    {
+        std::vector<pollfd> fds;
+        for (int fd : {tcp_listener_, unix_listener_, wake_pipe_[0]})
+        {
+            if (fd >= 0)
+            {
+                fds.push_back({fd, POLLIN, 0});
+            }
+        }
+
+        if (::poll(fds.data(), fds.size(), static_cast<int>(timeout.count())) <= 0)
+        {
+            return;
+        }
+        for (const auto& fd : fds)
+        {
+            if ((fd.revents & POLLIN) && fd.fd != wake_pipe_[0])
+            {
+                serve_(fd.fd);
+            }
+        }
+        return;
+    }
+#endif // ifndef _WIN32
+
+    std::unique_lock<std::mutex> lock(mtx_);
+    cv_.wait_for(lock, timeout, [this]()
+            {
+                return stop_.load();
+            });
+}
+
+int MetricsExporter::open_tcp_listener_(
+        uint16_t port)
+{
+#ifndef _WIN32
+    const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0)
+    {
+        EPROSIMA_LOG_WARNING(DDSENABLER_METRICS_EXPORTER,
+                "Failed to create the metrics socket: " << std::strerror(errno));
+        return -1;
+    }
+
+    const int reuse = 1;
+    ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    // Only reachable from localhost
+    sockaddr_in address {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || ::listen(fd, 8) != 0)
+    {
+        EPROSIMA_LOG_WARNING(DDSENABLER_METRICS_EXPORTER,
+                "Failed to serve metrics on localhost port " << port << ": " << std::strerror(errno));
+        ::close(fd);
+        return -1;
+    }
+    ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+
+    EPROSIMA_LOG_INFO(DDSENABLER_METRICS_EXPORTER, "Serving metrics on localhost port " << port << ".");
+    return fd;
+#else
+    EPROSIMA_LOG_WARNING(DDSENABLER_METRICS_EXPORTER,
+            "Metrics endpoints are not supported on this platform, port " << port << " not served.");
+    return -1;
+#endif // ifndef _WIN32
+}
+
+int MetricsExporter::open_unix_listener_(
+        const std::string& path)
+{
+#ifndef _WIN32
+    sockaddr_un address {};
+    if (path.size() >= sizeof(address.sun_path))
+    {
+        EPROSIMA_LOG_WARNING(DDSENABLER_METRICS_EXPORTER,
+                "Metrics socket path " << path << " is too long.");
+        return -1;
+    }
+
+    const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0)
+    {
+        EPROSIMA_LOG_WARNING(DDSENABLER_METRICS_EXPORTER,
+                "Failed to create the metrics socket: " << std::strerror(errno));
+        return -1;
+    }
+
+    // Remove the socket left by a previous run, but never a file that happens to be at the configured path
+    unlink_socket(path);
+
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || ::listen(fd, 8) != 0)
+    {
+        EPROSIMA_LOG_WARNING(DDSENABLER_METRICS_EXPORTER,
+                "Failed to serve metrics on Unix socket " << path << ": " << std::strerror(errno));
+        ::close(fd);
+        return -1;
+    }
+    ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+
+    EPROSIMA_LOG_INFO(DDSENABLER_METRICS_EXPORTER, "Serving metrics on Unix socket " << path << ".");
+    return fd;
+#else
+    EPROSIMA_LOG_WARNING(DDSENABLER_METRICS_EXPORTER,
+            "Metrics endpoints are not supported on this platform, socket " << path << " not served.");
+    return -1;
+#endif // ifndef _WIN32
+}
+
+void MetricsExporter::serve_(
+        int listener)
+{
+#ifndef _WIN32
+    const int fd = ::accept(listener, nullptr, nullptr);
+    if (fd < 0)
+    {
+        return;
+    }
+
+    // Neither wait indefinitely for clients not reading the response, as the exporter thread serves them all
+    timeval send_timeout {};
+    send_timeout.tv_sec = RESPONSE_TIMEOUT_MS / 1000;
+    send_timeout.tv_usec = (RESPONSE_TIMEOUT_MS % 1000) * 1000;
+    ::setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &send_timeout, sizeof(send_timeout));
+
+    // Read the request head, without waiting indefinitely for slow clients
+    std::string request;
+    char buffer[512];
+    pollfd client {fd, POLLIN, 0};
+    while (request.find("\r\n\r\n") == std::string::npos && request.find("\n\n") == std::string::npos &&
+            request.size() < MAX_REQUEST_SIZE && ::poll(&client, 1, REQUEST_TIMEOUT_MS) > 0)
+    {
+        const ssize_t ret = ::recv(fd, buffer, sizeof(buffer), 0);
+        if (ret <= 0)
+        {
+            break;
+        }
+        request.append(buffer, static_cast<std::size_t>(ret));
+    }
+
+    std::string response;
+    const std::string request_line = request.substr(0, request.find_first_of("\r\n"));
+    if (request_line.rfind("GET /metrics ", 0) == 0 || request_line.rfind("GET / ", 0) == 0)
+    {
+        const std::string body = metrics_to_prometheus(source_());
+        response = "HTTP/1.0 200 OK\r\nContent-Type: text/plain; version=0.0.4\r\nContent-Length: " +
+                std::to_string(body.size()) + "\r\nConnection: close\r\n\r\n" + body;
+    }
+    else
+    {
+        response = "HTTP/1.0 404 Not Found\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+    }
+
+    if (!send_all(fd, response))
+    {
+        EPROSIMA_LOG_INFO(DDSENABLER_METRICS_EXPORTER,
+                "Metrics client disconnected or stalled before the response was sent.");
+    }
+    ::close(fd);
+#else
+    static_cast<void>(listener);
+#endif // ifndef _WIN32
+}
+
+void MetricsExporter::rotate_nts_(
+        std::size_t size)
+{
+    const std::string& path = configuration_.file_path;
+    std::error_code ec;
+    const auto current_size = std::filesystem::file_size(path, ec);
+    if (ec || configuration_.file_max_size == 0 || current_size == 0 ||
+            current_size + size <= configuration_.file_max_size)
+    {
+        return;
+    }
+
+    // path -> path.1 -> ... -> path.<max files>, the oldest one being removed
+    const unsigned int max_files = configuration_.file_max_files;
+    if (max_files == 0)
+    {
+        std::filesystem::remove(path, ec);
+        return;
+    }
+    std::filesystem::remove(path + "." + std::to_string(max_files), ec);
+    for (unsigned int i = max_files - 1; i > 0; --i)
+    {
+        const std::string from = path + "." + std::to_string(i);
+        if (std::filesystem::exists(from, ec))
+        {
+            std::filesystem::rename(from, path + "." + std::to_string(i + 1), ec);
+        }
+    }
+    std::filesystem::rename(path, path + ".1", ec);
+    if (ec)
+    {
+        EPROSIMA_LOG_WARNING(DDSENABLER_METRICS_EXPORTER,
+                "Failed to rotate metrics file " << path << ": " << ec.message());
+    }
+}
+
+} /* namespace participants */
+} /* namespace ddsenabler */
+} /* namespace eprosima */
@@ -0,0 +1,175 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file MetricsRegistry.cpp
+ */
+
+#include <algorithm>
+#include <tuple>
+#include <utility>
+
+#include <ddsenabler_participants/MetricsRegistry.hpp>
+
+namespace eprosima {
+namespace ddsenabler {
+namespace participants {
+
+namespace {
+
+uint64_t elapsed_ns(
+        std::chrono::steady_clock::time_point start) noexcept
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now() - start).count());
+}
+
+EntityMetrics* find(
+        EntityMetrics* first,
+        const EntityMetrics* last,
+        const std::string& name,
+        MetricsEntityKind kind) noexcept
+{
+    for (EntityMetrics* entity = first; entity != last; entity = entity->next)
+    {
+        if (entity->kind == kind && entity->name == name)
+        {
+            return entity;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace
+
+EntityMetrics::EntityMetrics(
+        const std::string& name,
+        MetricsEntityKind kind)
+    : name(name)
+    , kind(kind)
+{
+}
+
+void EntityMetrics::record_conversion(
+        std::chrono::steady_clock::time_point start) noexcept
+{
+    conversion_time.record(elapsed_ns(start));
+    converted.fetch_add(1, std::memory_order_relaxed);
+}
+
+MetricsRegistry::~MetricsRegistry()
+{
+    for (auto& bucket : buckets_)
+    {
+        EntityMetrics* entity = bucket.load(std::memory_order_acquire);
+        while (entity)
+        {
+            EntityMetrics* next = entity->next;
+            delete entity;
+            entity = next;
+        }
+    }
+}
+
+EntityMetrics& MetricsRegistry::entity(
+        const std::string& name,
+        MetricsEntityKind kind)
+{
+    auto& bucket = buckets_[std::hash<std::string>()(name) % BUCKETS];
+
+    EntityMetrics* head = bucket.load(std::memory_order_acquire);
+    EntityMetrics* entity = find(head, nullptr, name, kind);
+    if (entity)
+    {
+        return *entity;
+    }
+
+    // Prepend the entity, unless another thread adds it first
+    EntityMetrics* added = new EntityMetrics(name, kind);
+    added->next = head;
+    while (!bucket.compare_exchange_weak(added->next, added, std::memory_order_acq_rel, std::memory_order_acquire))
+    {
+        // Only the entities prepended meanwhile need to be checked
+        entity = find(added->next, head, name, kind);
+        if (entity)
+        {
+            delete added;
+            return *entity;
+        }
+        head = added->next;
+    }
+    return *added;
+}
+
+MetricsReport MetricsRegistry::snapshot() const
+{
+    MetricsReport report;
+    report.timestamp = std::chrono::system_clock::now();
+
+    for (const auto& bucket : buckets_)
+    {
+        for (const EntityMetrics* entity = bucket.load(std::memory_order_acquire); entity; entity = entity->next)
+        {
+            EntityMetricsSnapshot snapshot;
+            snapshot.name = entity->name;
+            snapshot.kind = entity->kind;
+            snapshot.received = entity->received.load(std::memory_order_relaxed);
+            snapshot.converted = entity->converted.load(std::memory_order_relaxed);
+            snapshot.delivered = entity->delivered.load(std::memory_order_relaxed);
+            snapshot.filtered = entity->filtered.load(std::memory_order_relaxed);
+            snapshot.dropped = entity->dropped.load(std::memory_order_relaxed);
+            snapshot.published = entity->published.load(std::memory_order_relaxed);
+            snapshot.bytes_in = entity->bytes_in.load(std::memory_order_relaxed);
+            snapshot.bytes_out = entity->bytes_out.load(std::memory_order_relaxed);
+            snapshot.conversion_time = entity->conversion_time.stats();
+            snapshot.callback_time = entity->callback_time.stats();
+            snapshot.latency = entity->latency.stats();
+            report.entities.push_back(std::move(snapshot));
+        }
+    }
+
+    std::sort(report.entities.begin(), report.entities.end(), [](
+                const EntityMetricsSnapshot& lhs,
+                const EntityMetricsSnapshot& rhs)
+            {
+                return std::tie(lhs.kind, lhs.name) < std::tie(rhs.kind, rhs.name);
+            });
+    return report;
+}
+
+std::function<void()> measure_delivery(
+        EntityMetrics& metrics,
+        int64_t source_timestamp,
+        std::function<void()>&& notification)
+{
+    return [&metrics, source_timestamp, notification = std::move(notification)]()
+           {
+               const auto start = std::chrono::steady_clock::now();
+               notification();
+               metrics.callback_time.record(elapsed_ns(start));
+               metrics.delivered.fetch_add(1, std::memory_order_relaxed);
+
+               // Skip samples with no source timestamp, or from a clock ahead of ours
+               const int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::system_clock::now().time_since_epoch()).count();
+               if (source_timestamp > 0 && now >= source_timestamp)
+               {
+                   metrics.latency.record(static_cast<uint64_t>(now - source_timestamp));
+               }
+           };
+}
+
+} /* namespace participants */
+} /* namespace ddsenabler */
+} /* namespace eprosima */
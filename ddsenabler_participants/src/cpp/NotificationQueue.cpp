@@ -0,0 +1,133 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file NotificationQueue.cpp
+ */
+
+#include <exception>
+#include <unordered_map>
+#include <utility>
+
+#include <fastdds/dds/log/Log.hpp>
+
+#include <ddsenabler_participants/NotificationQueue.hpp>
+
+namespace eprosima {
+namespace ddsenabler {
+namespace participants {
+
+namespace {
+
+//! Notification scopes open in the current thread on a queue
+struct ScopeState
+{
+    //! Number of open scopes
+    unsigned int depth {0};
+
+    //! Whether notifications were queued within the open scopes
+    bool pushed {false};
+};
+
+//! Scopes open in the current thread, per queue (only queues with open scopes are present)
+thread_local std::unordered_map<const NotificationQueue*, ScopeState> open_scopes;
+
+} // namespace
+
+void NotificationQueue::push(
+        Notification&& notification)
+{
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        notifications_.push_back(std::move(notification));
+        size_.store(notifications_.size(), std::memory_order_relaxed);
+    }
+
+    auto it = open_scopes.find(this);
+    if (it == open_scopes.end())
+    {
+        deliver();
+    }
+    else
+    {
+        it->second.pushed = true;
+    }
+}
+
+void NotificationQueue::deliver()
+{
+    std::unique_lock<std::mutex> lock(mtx_);
+    if (delivering_)
+    {
+        // The delivering thread also takes care of these ones (and of those queued from the callbacks it runs)
+        return;
+    }
+    delivering_ = true;
+
+    while (!notifications_.empty())
+    {
+        Notification notification = std::move(notifications_.front());
+        notifications_.pop_front();
+        size_.store(notifications_.size(), std::memory_order_relaxed);
+
+        lock.unlock();
+        try
+        {
+            notification();
+        }
+        catch (const std::exception& e)
+        {
+            EPROSIMA_LOG_ERROR(DDSENABLER_NOTIFICATION_QUEUE,
+                    "Failed to deliver notification: " << e.what());
+        }
+        catch (...)
+        {
+            // Nothing may escape, or the queue would be left delivering forever
+            EPROSIMA_LOG_ERROR(DDSENABLER_NOTIFICATION_QUEUE,
+                    "Failed to deliver notification: unknown exception.");
+        }
+        // Release the arguments held by the notification before locking again
+        notification = nullptr;
+        lock.lock();
+    }
+
+    delivering_ = false;
+}
+
+NotificationScope::NotificationScope(
+        NotificationQueue& queue)
+    : queue_(queue)
+{
+    ++open_scopes[&queue_].depth;
+}
+
+NotificationScope::~NotificationScope()
+{
+    auto it = open_scopes.find(&queue_);
+    if (0 < --it->second.depth)
+    {
+        return;
+    }
+
+    const bool pushed = it->second.pushed;
+    open_scopes.erase(it);
+    if (pushed)
+    {
+        queue_.deliver();
+    }
+}
+
+} /* namespace participants */
+} /* namespace ddsenabler */
+} /* namespace eprosima */
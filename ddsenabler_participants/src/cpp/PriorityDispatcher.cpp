@@ -0,0 +1,171 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file PriorityDispatcher.cpp
+ */
+
+#include <algorithm>
+
+#include <fastdds/dds/log/Log.hpp>
+
+#include <ddsenabler_participants/PriorityDispatcher.hpp>
+
+namespace eprosima {
+namespace ddsenabler {
+namespace participants {
+
+PriorityDispatcher::PriorityDispatcher(
+        const std::vector<PriorityClass>& classes,
+        PriorityScheduling scheduling)
+    : queues_(classes.size())
+    , scheduling_(scheduling)
+{
+    for (std::size_t i = 0; i < classes.size(); ++i)
+    {
+        queues_[i].name = classes[i].name;
+        queues_[i].weight = std::max(classes[i].weight, 1u);
+        queues_[i].max_size = classes[i].queue_size;
+    }
+    if (!queues_.empty())
+    {
+        credits_ = queues_[0].weight;
+    }
+
+    thread_ = std::thread(&PriorityDispatcher::run_, this);
+}
+
+PriorityDispatcher::~PriorityDispatcher()
+{
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        stop_ = true;
+    }
+    cv_.notify_one();
+    thread_.join();
+}
+
+bool PriorityDispatcher::push(
+        std::size_t priority_class,
+        Task&& task,
+        Task&& on_drop)
+{
+    bool dropped = false;
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        Queue& queue = queues_.at(priority_class);
+        if (queue.max_size > 0 && queue.entries.size() >= queue.max_size)
+        {
+            if (queue.entries.front().on_drop)
+            {
+                queue.entries.front().on_drop();
+            }
+            queue.entries.pop_front();
+            queue.dropped.fetch_add(1, std::memory_order_relaxed);
+            --pending_;
+            dropped = true;
+        }
+        queue.entries.push_back({std::move(task), std::move(on_drop), std::chrono::steady_clock::now()});
+        queue.queued.store(queue.entries.size(), std::memory_order_relaxed);
+        ++pending_;
+    }
+    cv_.notify_one();
+    return !dropped;
+}
+
+std::vector<PriorityClassStats> PriorityDispatcher::stats() const
+{
+    std::vector<PriorityClassStats> stats(queues_.size());
+    for (std::size_t i = 0; i < queues_.size(); ++i)
+    {
+        stats[i].name = queues_[i].name;
+        stats[i].queued = queues_[i].queued.load(std::memory_order_relaxed);
+        stats[i].delivered = queues_[i].delivered.load(std::memory_order_relaxed);
+        stats[i].dropped = queues_[i].dropped.load(std::memory_order_relaxed);
+        stats[i].latency = queues_[i].latency.stats();
+    }
+    return stats;
+}
+
+std::size_t PriorityDispatcher::next_class_nts_()
+{
+    if (PriorityScheduling::STRICT == scheduling_)
+    {
+        std::size_t i = 0;
+        while (queues_[i].entries.empty())
+        {
+            ++i;
+        }
+        return i;
+    }
+
+    // Weighted round robin: serve the current class until it runs out of tasks or credits, then move to the next one
+    while (queues_[current_class_].entries.empty() || credits_ == 0)
+    {
+        current_class_ = (current_class_ + 1) % queues_.size();
+        credits_ = queues_[current_class_].weight;
+    }
+    --credits_;
+    return current_class_;
+}
+
+void PriorityDispatcher::run_()
+{
+    std::unique_lock<std::mutex> lock(mtx_);
+    while (true)
+    {
+        cv_.wait(lock, [this]()
+                {
+                    return stop_ || pending_ > 0;
+                });
+        if (stop_)
+        {
+            return;
+        }
+
+        Queue& queue = queues_[next_class_nts_()];
+        Entry entry = std::move(queue.entries.front());
+        queue.entries.pop_front();
+        queue.queued.store(queue.entries.size(), std::memory_order_relaxed);
+        --pending_;
+
+        lock.unlock();
+        try
+        {
+            entry.task();
+        }
+        catch (const std::exception& e)
+        {
+            EPROSIMA_LOG_ERROR(DDSENABLER_PRIORITY_DISPATCHER,
+                    "Failed to deliver sample of priority class " << queue.name << ": " << e.what());
+        }
+        catch (...)
+        {
+            // Nothing may escape, or the process would be terminated
+            EPROSIMA_LOG_ERROR(DDSENABLER_PRIORITY_DISPATCHER,
+                    "Failed to deliver sample of priority class " << queue.name << ": unknown exception.");
+        }
+        queue.latency.record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - entry.queued_time).count()));
+        // Release the task (and the sample it holds) before locking again
+        entry.task = nullptr;
+        lock.lock();
+
+        queue.delivered.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+} /* namespace participants */
+} /* namespace ddsenabler */
+} /* namespace eprosima */
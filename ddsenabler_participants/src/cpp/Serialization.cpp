@@ -16,7 +16,10 @@
  * @file serialization.cpp
  */
 
+#include <array>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 
 #include <yaml-cpp/yaml.h>
 
@@ -48,7 +51,33 @@ using namespace eprosima::fastdds::dds::xtypes;
 // QoS serialization //
 ///////////////////////
 
-std::string serialize_qos(
+namespace {
+
+//! Number of combinations of the serialized QoS policies (one bit each)
+constexpr std::size_t QOS_COMBINATIONS = 16u;
+
+std::size_t qos_index(
+        const TopicQoS& qos)
+{
+    return (qos.is_reliable() ? 1u : 0u) |
+           (qos.is_transient_local() ? 2u : 0u) |
+           (qos.has_ownership() ? 4u : 0u) |
+           (qos.keyed ? 8u : 0u);
+}
+
+TopicQoS qos_from_index(
+        std::size_t index)
+{
+    TopicQoS qos{};
+    qos.reliability_qos = (index & 1u) ? ReliabilityKind::RELIABLE : ReliabilityKind::BEST_EFFORT;
+    qos.durability_qos = (index & 2u) ? DurabilityKind::TRANSIENT_LOCAL : DurabilityKind::VOLATILE;
+    qos.ownership_qos = (index & 4u) ?
+            OwnershipQosPolicyKind::EXCLUSIVE_OWNERSHIP_QOS : OwnershipQosPolicyKind::SHARED_OWNERSHIP_QOS;
+    qos.keyed = (index & 8u) != 0;
+    return qos;
+}
+
+std::string serialize_qos_yaml(
         const TopicQoS& qos)
 {
     YAML::Node qos_yaml;
@@ -100,7 +129,18 @@ std::string serialize_qos(
     return YAML::Dump(qos_yaml);
 }
 
-TopicQoS deserialize_qos(
+std::string serialize_qos_compact(
+        const TopicQoS& qos)
+{
+    std::string qos_str(QOS_SERIALIZATION_COMPACT_PREFIX);
+    qos_str.push_back(qos.is_reliable() ? '1' : '0');
+    qos_str.push_back(qos.is_transient_local() ? '1' : '0');
+    qos_str.push_back(qos.has_ownership() ? '1' : '0');
+    qos_str.push_back(qos.keyed ? '1' : '0');
+    return qos_str;
+}
+
+TopicQoS deserialize_qos_yaml(
         const std::string& qos_str)
 {
     TopicQoS qos{};
@@ -147,6 +187,61 @@ TopicQoS deserialize_qos(
     return qos;
 }
 
+//! Precomputed encodings of every serializable QoS
+struct QosEncodings
+{
+    std::array<std::string, QOS_COMBINATIONS> yaml;
+    std::array<std::string, QOS_COMBINATIONS> compact;
+
+    //! QoS index of every precomputed encoding
+    std::unordered_map<std::string, std::size_t> indexes;
+};
+
+const QosEncodings& qos_encodings()
+{
+    // Built once (thread-safe static initialization)
+    static const QosEncodings encodings = []()
+            {
+                QosEncodings _encodings;
+                for (std::size_t i = 0; i < QOS_COMBINATIONS; ++i)
+                {
+                    const TopicQoS qos = qos_from_index(i);
+                    _encodings.yaml[i] = serialize_qos_yaml(qos);
+                    _encodings.compact[i] = serialize_qos_compact(qos);
+                    _encodings.indexes.emplace(_encodings.yaml[i], i);
+                    _encodings.indexes.emplace(_encodings.compact[i], i);
+                }
+                return _encodings;
+            }();
+    return encodings;
+}
+
+} // namespace
+
+const std::string& serialize_qos(
+        const TopicQoS& qos,
+        bool compact)
+{
+    const QosEncodings& encodings = qos_encodings();
+    const std::size_t index = qos_index(qos);
+    return compact ? encodings.compact[index] : encodings.yaml[index];
+}
+
+TopicQoS deserialize_qos(
+        const std::string& qos_str)
+{
+    // Encodings generated by the enabler itself are resolved without parsing
+    const QosEncodings& encodings = qos_encodings();
+    auto it = encodings.indexes.find(qos_str);
+    if (it != encodings.indexes.end())
+    {
+        return qos_from_index(it->second);
+    }
+
+    // Otherwise (e.g. hand-written or differently formatted YAML), parse it
+    return deserialize_qos_yaml(qos_str);
+}
+
 //////////////////////////
 // XTypes serialization //
 //////////////////////////
@@ -159,22 +254,46 @@ template<class DynamicTypeData>
 DynamicTypeData deserialize_type_data(
         const std::string& typedata_str);
 
-std::string serialize_type_identifier(
-        const TypeIdentifier& type_identifier);
-
-TypeIdentifier deserialize_type_identifier(
-        const std::string& typeid_str);
-
-std::string serialize_type_object(
-        const TypeObject& type_object);
+bool serialize_dynamic_type_(
+        const std::string& type_name,
+        const TypeIdentifier& type_identifier,
+        DynamicTypesCollection& dynamic_types,
+        DynamicTypesCache* cache,
+        bool incremental);
 
-TypeObject deserialize_type_object(
-        const std::string& typeobj_str);
+bool add_dynamic_type_(
+        const TypeIdentifier& type_identifier,
+        const std::string& type_name,
+        DynamicTypesCollection& dynamic_types,
+        DynamicTypesCache* cache,
+        bool as_reference);
 
 bool serialize_dynamic_type(
         const std::string& type_name,
         const TypeIdentifier& type_identifier,
         DynamicTypesCollection& dynamic_types)
+{
+    return serialize_dynamic_type_(type_name, type_identifier, dynamic_types, nullptr, false);
+}
+
+bool serialize_dynamic_type(
+        const std::string& type_name,
+        const TypeIdentifier& type_identifier,
+        DynamicTypesCollection& dynamic_types,
+        DynamicTypesCache& cache,
+        bool incremental)
+{
+    std::lock_guard<std::mutex> lock(cache.mtx);
+
+    return serialize_dynamic_type_(type_name, type_identifier, dynamic_types, &cache, incremental);
+}
+
+bool serialize_dynamic_type_(
+        const std::string& type_name,
+        const TypeIdentifier& type_identifier,
+        DynamicTypesCollection& dynamic_types,
+        DynamicTypesCache* cache,
+        bool incremental)
 {
     TypeIdentifierPair type_identifiers;
 
@@ -193,34 +312,80 @@ bool serialize_dynamic_type(
         return false;
     }
 
-    std::string dependency_name;
     unsigned int dependency_index = 0;
     const auto type_dependencies = type_info.complete().dependent_typeids();
     for (auto dependency : type_dependencies)
     {
-        TypeIdentifier dependency_type_identifier;
-        dependency_type_identifier = dependency.type_id();
-
-        TypeObject dependency_type_object;
-        if (fastdds::dds::RETCODE_OK !=
-                fastdds::dds::DomainParticipantFactory::get_instance()->type_object_registry().get_type_object(
-                    dependency_type_identifier,
-                    dependency_type_object))
+        // Store dependency in dynamic_types collection, or just reference it if already delivered
+        if (!add_dynamic_type_(dependency.type_id(), type_name + "_" + std::to_string(dependency_index), dynamic_types,
+                cache, incremental))
         {
             EPROSIMA_LOG_ERROR(DDSENABLER_SERIALIZATION,
-                    "Error getting TypeObject of dependency " << "for type " << type_name);
+                    "Error serializing dependency " << "for type " << type_name);
             return false;
         }
 
-        dependency_name = type_name + "_" + std::to_string(dependency_index);
-
-        // Store dependency in dynamic_types collection
-        serialize_dynamic_type(dependency_type_identifier, dependency_type_object, dependency_name, dynamic_types);
-
         // Increment suffix counter
         dependency_index++;
     }
 
+    // Store dynamic type in dynamic_types collection (never as a reference, as it is the type being delivered)
+    if (!add_dynamic_type_(type_identifier, type_name, dynamic_types, cache, false))
+    {
+        return false;
+    }
+
+    return true;
+}
+
+void mark_types_delivered(
+        const std::vector<std::string>& type_identifiers,
+        DynamicTypesCache& cache)
+{
+    std::lock_guard<std::mutex> lock(cache.mtx);
+
+    // Following collections can reference these types
+    cache.delivered.insert(type_identifiers.begin(), type_identifiers.end());
+}
+
+bool add_dynamic_type_(
+        const TypeIdentifier& type_identifier,
+        const std::string& type_name,
+        DynamicTypesCollection& dynamic_types,
+        DynamicTypesCache* cache,
+        bool as_reference)
+{
+    DynamicType dynamic_type;
+    dynamic_type.type_name(type_name);
+
+    try
+    {
+        dynamic_type.type_identifier(utils::base64_encode(serialize_type_identifier(type_identifier)));
+    }
+    catch (const utils::InconsistencyException& e)
+    {
+        EPROSIMA_LOG_ERROR(DDSENABLER_SERIALIZATION, "Error serializing DynamicType. Error message:\n " << e.what());
+        return false;
+    }
+
+    if (nullptr != cache)
+    {
+        if (as_reference && cache->delivered.count(dynamic_type.type_identifier()) != 0)
+        {
+            // Already delivered: reference it by its (hash) identifier, leaving the type object empty
+            dynamic_types.dynamic_types().push_back(dynamic_type);
+            return true;
+        }
+
+        auto it = cache->type_objects.find(dynamic_type.type_identifier());
+        if (it != cache->type_objects.end())
+        {
+            dynamic_type.type_object(it->second);
+            dynamic_types.dynamic_types().push_back(dynamic_type);
+            return true;
+        }
+    }
+
     TypeObject type_object;
     if (fastdds::dds::RETCODE_OK !=
             fastdds::dds::DomainParticipantFactory::get_instance()->type_object_registry().get_type_object(
@@ -231,8 +396,24 @@ bool serialize_dynamic_type(
         return false;
     }
 
-    // Store dynamic type in dynamic_types collection
-    return serialize_dynamic_type(type_identifier, type_object, type_name, dynamic_types);
+    try
+    {
+        dynamic_type.type_object(utils::base64_encode(serialize_type_object(type_object)));
+    }
+    catch (const utils::InconsistencyException& e)
+    {
+        EPROSIMA_LOG_ERROR(DDSENABLER_SERIALIZATION, "Error serializing DynamicType. Error message:\n " << e.what());
+        return false;
+    }
+
+    if (nullptr != cache)
+    {
+        cache->type_objects.emplace(dynamic_type.type_identifier(), dynamic_type.type_object());
+    }
+
+    dynamic_types.dynamic_types().push_back(dynamic_type);
+
+    return true;
 }
 
 bool serialize_dynamic_type(
@@ -287,6 +468,24 @@ bool deserialize_dynamic_type(
     return true;
 }
 
+bool deserialize_dynamic_type_identifier(
+        const DynamicType& dynamic_type,
+        TypeIdentifier& type_identifier)
+{
+    try
+    {
+        type_identifier = deserialize_type_identifier(utils::base64_decode(dynamic_type.type_identifier()));
+    }
+    catch (const utils::InconsistencyException& e)
+    {
+        EPROSIMA_LOG_ERROR(DDSENABLER_SERIALIZATION,
+                "Failed to deserialize " << dynamic_type.type_name() << " TypeIdentifier: " << e.what());
+        return false;
+    }
+
+    return true;
+}
+
 template<class DynamicTypeData>
 std::string serialize_type_data(
         const DynamicTypeData& type_data)
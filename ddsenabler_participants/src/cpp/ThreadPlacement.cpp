@@ -0,0 +1,244 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file ThreadPlacement.cpp
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <sstream>
+#include <utility>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif // if defined(__linux__)
+
+#include <fastdds/dds/log/Log.hpp>
+
+#include <ddsenabler_participants/ThreadPlacement.hpp>
+
+namespace eprosima {
+namespace ddsenabler {
+namespace participants {
+
+namespace {
+
+//! Maximum length of a thread name, without the terminating null character
+constexpr std::size_t MAX_THREAD_NAME_LENGTH = 15;
+
+bool parse_cpu(
+        const std::string& str,
+        unsigned int& cpu)
+{
+    if (str.empty() || str.find_first_not_of("0123456789") != std::string::npos)
+    {
+        return false;
+    }
+    try
+    {
+        cpu = static_cast<unsigned int>(std::stoul(str));
+    }
+    catch (const std::exception&)
+    {
+        return false;
+    }
+    return true;
+}
+
+bool get_current_thread_affinity(
+        std::vector<unsigned int>& cpus)
+{
+    cpus.clear();
+#if defined(__linux__)
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    if (0 != pthread_getaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set))
+    {
+        return false;
+    }
+    for (unsigned int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+    {
+        if (CPU_ISSET(cpu, &cpu_set))
+        {
+            cpus.push_back(cpu);
+        }
+    }
+    return true;
+#else
+    return false;
+#endif // if defined(__linux__)
+}
+
+bool get_current_thread_name(
+        std::string& name)
+{
+#if defined(__linux__)
+    char buffer[MAX_THREAD_NAME_LENGTH + 1] = {};
+    if (0 != pthread_getname_np(pthread_self(), buffer, sizeof(buffer)))
+    {
+        return false;
+    }
+    name = buffer;
+    return true;
+#else
+    static_cast<void>(name);
+    return false;
+#endif // if defined(__linux__)
+}
+
+} // namespace
+
+bool parse_cpu_list(
+        const std::string& cpu_list,
+        std::vector<unsigned int>& cpus)
+{
+    std::vector<unsigned int> parsed;
+    std::stringstream stream(cpu_list);
+    std::string range;
+    while (std::getline(stream, range, ','))
+    {
+        range.erase(std::remove_if(range.begin(), range.end(), ::isspace), range.end());
+
+        unsigned int first;
+        unsigned int last;
+        const auto dash = range.find('-');
+        if (dash == std::string::npos)
+        {
+            if (!parse_cpu(range, first))
+            {
+                return false;
+            }
+            last = first;
+        }
+        else if (!parse_cpu(range.substr(0, dash), first) || !parse_cpu(range.substr(dash + 1), last) || last < first)
+        {
+            return false;
+        }
+
+        for (unsigned int cpu = first; cpu <= last; ++cpu)
+        {
+            parsed.push_back(cpu);
+        }
+    }
+
+    if (parsed.empty())
+    {
+        return false;
+    }
+
+    std::sort(parsed.begin(), parsed.end());
+    parsed.erase(std::unique(parsed.begin(), parsed.end()), parsed.end());
+    cpus = std::move(parsed);
+    return true;
+}
+
+bool get_numa_node_cpus(
+        int numa_node,
+        std::vector<unsigned int>& cpus)
+{
+    if (numa_node < 0)
+    {
+        return false;
+    }
+
+    std::ifstream file("/sys/devices/system/node/node" + std::to_string(numa_node) + "/cpulist");
+    std::string cpu_list;
+    if (!file || !std::getline(file, cpu_list))
+    {
+        EPROSIMA_LOG_WARNING(DDSENABLER_THREAD_PLACEMENT,
+                "Failed to get the CPUs of NUMA node " << numa_node << ".");
+        return false;
+    }
+
+    return parse_cpu_list(cpu_list, cpus);
+}
+
+bool set_current_thread_affinity(
+        const std::vector<unsigned int>& cpus)
+{
+#if defined(__linux__)
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    for (const auto cpu : cpus)
+    {
+        if (cpu >= CPU_SETSIZE)
+        {
+            EPROSIMA_LOG_WARNING(DDSENABLER_THREAD_PLACEMENT,
+                    "Ignoring CPU " << cpu << ": out of the supported range.");
+            continue;
+        }
+        CPU_SET(cpu, &cpu_set);
+    }
+
+    if (0 == CPU_COUNT(&cpu_set) || 0 != pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set))
+    {
+        EPROSIMA_LOG_WARNING(DDSENABLER_THREAD_PLACEMENT,
+                "Failed to set thread affinity: none of the requested CPUs is available.");
+        return false;
+    }
+    return true;
+#else
+    EPROSIMA_LOG_WARNING(DDSENABLER_THREAD_PLACEMENT,
+            "Failed to set thread affinity: not supported on this platform.");
+    static_cast<void>(cpus);
+    return false;
+#endif // if defined(__linux__)
+}
+
+bool set_current_thread_name(
+        const std::string& name)
+{
+#if defined(__linux__)
+    return 0 == pthread_setname_np(pthread_self(), name.substr(0, MAX_THREAD_NAME_LENGTH).c_str());
+#else
+    static_cast<void>(name);
+    return false;
+#endif // if defined(__linux__)
+}
+
+ScopedThreadPlacement::ScopedThreadPlacement(
+        const ThreadPlacement& placement)
+{
+    if (!placement.cpus.empty() && get_current_thread_affinity(previous_cpus_) &&
+            !set_current_thread_affinity(placement.cpus))
+    {
+        previous_cpus_.clear();
+    }
+
+    if (!placement.name.empty() && get_current_thread_name(previous_name_) &&
+            !set_current_thread_name(placement.name))
+    {
+        previous_name_.clear();
+    }
+}
+
+ScopedThreadPlacement::~ScopedThreadPlacement()
+{
+    if (!previous_cpus_.empty())
+    {
+        set_current_thread_affinity(previous_cpus_);
+    }
+
+    if (!previous_name_.empty())
+    {
+        set_current_thread_name(previous_name_);
+    }
+}
+
+} /* namespace participants */
+} /* namespace ddsenabler */
+} /* namespace eprosima */
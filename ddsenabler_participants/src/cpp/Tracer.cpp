@@ -0,0 +1,287 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file Tracer.cpp
+ */
+
+#include <algorithm>
+#include <utility>
+
+#include <nlohmann/json.hpp>
+
+#include <fastdds/dds/log/Log.hpp>
+
+#include <cpp_utils/exception/InitializationException.hpp>
+#include <cpp_utils/Formatter.hpp>
+
+#include <ddsenabler_participants/Tracer.hpp>
+
+namespace eprosima {
+namespace ddsenabler {
+namespace participants {
+
+namespace {
+
+//! Process of the trace events
+constexpr const int TRACE_PID = 1;
+
+//! Source of the tracer identifiers
+std::atomic<uint64_t> next_tracer_id {1};
+
+} // namespace
+
+const char* span_name(
+        SpanKind kind) noexcept
+{
+    switch (kind)
+    {
+        case SpanKind::RECEIVE:
+            return "receive";
+        case SpanKind::ADD_DATA:
+            return "add_data";
+        case SpanKind::DECODE:
+            return "decode";
+        case SpanKind::ENCODE:
+            return "encode";
+        case SpanKind::QUEUE:
+            return "queue";
+        case SpanKind::CALLBACK:
+            return "callback";
+        case SpanKind::PUBLISH:
+            return "publish";
+        case SpanKind::SERIALIZE:
+            return "serialize";
+        case SpanKind::WRITE:
+            return "write";
+    }
+    return "unknown";
+}
+
+Tracer::ThreadBuffer::ThreadBuffer(
+        std::size_t capacity,
+        uint32_t thread_id)
+    : spans(std::max<std::size_t>(capacity, 1))
+    , thread_id(thread_id)
+{
+}
+
+Tracer::Tracer(
+        const TracingConfiguration& configuration)
+    : configuration_(configuration)
+    , id_(next_tracer_id.fetch_add(1, std::memory_order_relaxed))
+{
+    file_.open(configuration_.file_path, std::ios::trunc);
+    if (!file_)
+    {
+        throw utils::InitializationException(
+                  utils::Formatter() << "Failed to open trace file " << configuration_.file_path << ".");
+    }
+
+    nlohmann::json process_name = {
+        {"name", "process_name"},
+        {"ph", "M"},
+        {"pid", TRACE_PID},
+        {"args", {{"name", "DDS Enabler"}}}
+    };
+    file_ << "[\n" << process_name.dump();
+    file_.flush();
+
+    thread_ = std::thread(&Tracer::run_, this);
+}
+
+Tracer::~Tracer()
+{
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        stop_ = true;
+    }
+    cv_.notify_one();
+    thread_.join();
+
+    flush();
+
+    std::lock_guard<std::mutex> lock(file_mtx_);
+    file_ << "\n]\n";
+    file_.close();
+
+    const uint64_t lost = lost_spans();
+    if (lost > 0)
+    {
+        EPROSIMA_LOG_WARNING(DDSENABLER_TRACER,
+                lost << " spans were lost as their thread buffer was full, consider increasing its size.");
+    }
+}
+
+uint64_t Tracer::start_trace() noexcept
+{
+    const uint64_t sample = samples_.fetch_add(1, std::memory_order_relaxed);
+    const uint64_t period = std::max<uint64_t>(configuration_.sampling_period, 1);
+    if (sample % period != 0)
+    {
+        return 0;
+    }
+    return sample / period + 1;
+}
+
+void Tracer::record(
+        const Span& span) noexcept
+{
+    ThreadBuffer* buffer = thread_buffer_();
+    if (nullptr == buffer)
+    {
+        return;
+    }
+
+    const uint64_t head = buffer->head.load(std::memory_order_relaxed);
+    if (head - buffer->tail.load(std::memory_order_acquire) >= buffer->spans.size())
+    {
+        buffer->lost.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    buffer->spans[head % buffer->spans.size()] = span;
+    buffer->head.store(head + 1, std::memory_order_release);
+}
+
+void Tracer::flush()
+{
+    std::lock_guard<std::mutex> file_lock(file_mtx_);
+
+    std::vector<ThreadBuffer*> buffers;
+    {
+        std::lock_guard<std::mutex> lock(buffers_mtx_);
+        for (const auto& buffer : buffers_)
+        {
+            buffers.push_back(buffer.get());
+        }
+    }
+
+    for (ThreadBuffer* buffer : buffers)
+    {
+        const uint64_t tail = buffer->tail.load(std::memory_order_relaxed);
+        const uint64_t head = buffer->head.load(std::memory_order_acquire);
+        for (uint64_t i = tail; i < head; ++i)
+        {
+            const Span& span = buffer->spans[i % buffer->spans.size()];
+
+            // Spans of the same sample are linked through flow events, so they can be followed across threads
+            nlohmann::json event = {
+                {"name", span_name(span.kind)},
+                {"cat", "ddsenabler"},
+                {"ph", "X"},
+                {"ts", span.start_ns / 1000.0},
+                {"dur", std::max<int64_t>(span.end_ns - span.start_ns, 0) / 1000.0},
+                {"pid", TRACE_PID},
+                {"tid", buffer->thread_id},
+                {"bind_id", span.trace_id},
+                {"flow_in", true},
+                {"flow_out", true},
+                {"args", {
+                     {"trace", span.trace_id},
+                     {"entity", span.entity ? span.entity : ""}
+                 }}
+            };
+            file_ << ",\n" << event.dump();
+        }
+        buffer->tail.store(head, std::memory_order_release);
+    }
+
+    file_.flush();
+}
+
+uint64_t Tracer::lost_spans() const noexcept
+{
+    std::lock_guard<std::mutex> lock(buffers_mtx_);
+    uint64_t lost = 0;
+    for (const auto& buffer : buffers_)
+    {
+        lost += buffer->lost.load(std::memory_order_relaxed);
+    }
+    return lost;
+}
+
+int64_t Tracer::now_ns() noexcept
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+Tracer::ThreadBuffer* Tracer::thread_buffer_() noexcept
+{
+    // Buffers of the calling thread, by tracer (identifiers are never reused, so entries of destroyed tracers are
+    // never matched)
+    thread_local std::vector<std::pair<uint64_t, ThreadBuffer*>> thread_buffers;
+
+    for (const auto& entry : thread_buffers)
+    {
+        if (entry.first == id_)
+        {
+            return entry.second;
+        }
+    }
+
+    try
+    {
+        std::lock_guard<std::mutex> lock(buffers_mtx_);
+        buffers_.push_back(std::make_unique<ThreadBuffer>(configuration_.buffer_size,
+                static_cast<uint32_t>(buffers_.size() + 1)));
+        thread_buffers.emplace_back(id_, buffers_.back().get());
+        return buffers_.back().get();
+    }
+    catch (const std::exception&)
+    {
+        return nullptr;
+    }
+}
+
+void Tracer::run_()
+{
+    std::unique_lock<std::mutex> lock(mtx_);
+    while (!stop_)
+    {
+        cv_.wait_for(lock, std::chrono::milliseconds(configuration_.flush_period_ms), [this]()
+                {
+                    return stop_;
+                });
+
+        lock.unlock();
+        flush();
+        lock.lock();
+    }
+}
+
+std::function<void()> trace_delivery(
+        Tracer& tracer,
+        uint64_t trace_id,
+        const char* entity,
+        std::function<void()>&& notification)
+{
+    return [&tracer, trace_id, entity, queued_ns = Tracer::now_ns(), notification = std::move(notification)]()
+           {
+               Span queue;
+               queue.trace_id = trace_id;
+               queue.entity = entity;
+               queue.kind = SpanKind::QUEUE;
+               queue.start_ns = queued_ns;
+               queue.end_ns = Tracer::now_ns();
+               tracer.record(queue);
+
+               TraceSpan callback(&tracer, trace_id, SpanKind::CALLBACK, entity);
+               notification();
+           };
+}
+
+} /* namespace participants */
+} /* namespace ddsenabler */
+} /* namespace eprosima */
@@ -0,0 +1,133 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file TypeInterner.cpp
+ */
+
+#include <cpp_utils/exception/InconsistencyException.hpp>
+
+#include <ddsenabler_participants/Serialization.hpp>
+
+#include <ddsenabler_participants/TypeInterner.hpp>
+
+namespace {
+
+//! FNV-1a 64 bits offset basis
+constexpr uint64_t FNV_OFFSET_BASIS = 14695981039346656037ull;
+
+//! FNV-1a 64 bits prime
+constexpr uint64_t FNV_PRIME = 1099511628211ull;
+
+uint64_t fnv1a(
+        const uint8_t* data,
+        std::size_t size,
+        uint64_t hash = FNV_OFFSET_BASIS) noexcept
+{
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        hash ^= data[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+} // namespace
+
+namespace std {
+
+std::size_t hash<eprosima::fastdds::dds::xtypes::TypeIdentifier>::operator ()(
+        const eprosima::fastdds::dds::xtypes::TypeIdentifier& k) const noexcept
+{
+    using namespace eprosima::fastdds::dds::xtypes;
+
+    const uint8_t discriminator = k._d();
+    uint64_t hash = fnv1a(&discriminator, sizeof(discriminator));
+
+    if (EK_COMPLETE == discriminator || EK_MINIMAL == discriminator)
+    {
+        const auto& equivalence_hash = k.equivalence_hash();
+        hash = fnv1a(equivalence_hash.data(), equivalence_hash.size(), hash);
+    }
+    else
+    {
+        try
+        {
+            const std::string serialized = eprosima::ddsenabler::participants::serialization::serialize_type_identifier(
+                k);
+            hash = fnv1a(reinterpret_cast<const uint8_t*>(serialized.data()), serialized.size(), hash);
+        }
+        catch (const eprosima::utils::InconsistencyException&)
+        {
+            // Only the discriminator is hashed, which is still consistent with equality
+        }
+    }
+
+    return static_cast<std::size_t>(hash);
+}
+
+} // std
+
+namespace eprosima {
+namespace ddsenabler {
+namespace participants {
+
+using namespace eprosima::fastdds::dds::xtypes;
+
+TypeInterner::TypeId TypeInterner::intern(
+        const std::string& type_name,
+        const TypeIdentifier& type_identifier)
+{
+    auto it = name_index_.find(type_name);
+    if (it != name_index_.end())
+    {
+        return it->second;
+    }
+
+    const TypeId id = static_cast<TypeId>(types_.size());
+    types_.emplace_back(type_name, type_identifier);
+    name_index_.emplace(type_name, id);
+    identifier_index_.emplace(type_identifier, id);
+    return id;
+}
+
+TypeInterner::TypeId TypeInterner::find(
+        const std::string& type_name) const noexcept
+{
+    auto it = name_index_.find(type_name);
+    return (it != name_index_.end()) ? it->second : INVALID_TYPE_ID;
+}
+
+TypeInterner::TypeId TypeInterner::find(
+        const TypeIdentifier& type_identifier) const noexcept
+{
+    auto it = identifier_index_.find(type_identifier);
+    return (it != identifier_index_.end()) ? it->second : INVALID_TYPE_ID;
+}
+
+const std::string& TypeInterner::type_name(
+        TypeId id) const
+{
+    return types_.at(id).first;
+}
+
+const TypeIdentifier& TypeInterner::type_identifier(
+        TypeId id) const
+{
+    return types_.at(id).second;
+}
+
+} /* namespace participants */
+} /* namespace ddsenabler */
+} /* namespace eprosima */
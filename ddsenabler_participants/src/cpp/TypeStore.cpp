@@ -0,0 +1,581 @@
+// Copyright 2024 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file TypeStore.cpp
+ */
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif // _WIN32
+
+#include <fastdds/dds/domain/DomainParticipantFactory.hpp>
+#include <fastdds/dds/log/Log.hpp>
+
+#include <cpp_utils/exception/InconsistencyException.hpp>
+#include <cpp_utils/exception/InitializationException.hpp>
+#include <cpp_utils/Formatter.hpp>
+
+#include <ddsenabler_participants/Serialization.hpp>
+
+#include <ddsenabler_participants/TypeStore.hpp>
+
+namespace eprosima {
+namespace ddsenabler {
+namespace participants {
+
+using namespace eprosima::fastdds::dds::xtypes;
+
+namespace {
+
+//! Magic string identifying type store files
+constexpr const char TYPE_STORE_MAGIC[8] = {'D', 'D', 'S', 'E', 'T', 'Y', 'P', 'E'};
+
+//! Version of the type store format (2: records hold the IDL and data placeholder of the type)
+constexpr uint32_t TYPE_STORE_VERSION = 2u;
+
+//! Size of the file header: magic, version and reserved word
+constexpr std::size_t TYPE_STORE_HEADER_SIZE = sizeof(TYPE_STORE_MAGIC) + 2 * sizeof(uint32_t);
+
+//! First byte of the hash index keys holding the hash of a TypeIdentifier
+constexpr char HASH_KEY_PREFIX = 'h';
+
+//! First byte of the hash index keys holding a serialized TypeIdentifier (one without hash)
+constexpr char SERIALIZED_KEY_PREFIX = 's';
+
+void append_uint32(
+        std::string& buffer,
+        uint32_t value)
+{
+    buffer.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void append_string(
+        std::string& buffer,
+        const std::string& value)
+{
+    append_uint32(buffer, static_cast<uint32_t>(value.size()));
+    buffer.append(value);
+}
+
+bool read_uint32(
+        const char* data,
+        std::size_t size,
+        std::size_t& offset,
+        uint32_t& value)
+{
+    if (size < sizeof(value) || offset > size - sizeof(value))
+    {
+        return false;
+    }
+    std::memcpy(&value, data + offset, sizeof(value));
+    offset += sizeof(value);
+    return true;
+}
+
+bool read_string(
+        const char* data,
+        std::size_t size,
+        std::size_t& offset,
+        std::string& value)
+{
+    uint32_t length;
+    if (!read_uint32(data, size, offset, length) || length > size - offset)
+    {
+        return false;
+    }
+    value.assign(data + offset, length);
+    offset += length;
+    return true;
+}
+
+} // namespace
+
+TypeStore::TypeStore(
+        const std::string& file_path,
+        bool read_only)
+    : file_path_(file_path)
+    , read_only_(read_only)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+
+    std::error_code ec;
+    if (!read_only_ && !std::filesystem::exists(file_path_, ec))
+    {
+        std::ofstream file(file_path_, std::ios::binary);
+        std::string header(TYPE_STORE_MAGIC, sizeof(TYPE_STORE_MAGIC));
+        append_uint32(header, TYPE_STORE_VERSION);
+        append_uint32(header, 0u);
+        if (!file.write(header.data(), header.size()))
+        {
+            throw utils::InitializationException(
+                      utils::Formatter() << "Failed to create type store " << file_path_ << ".");
+        }
+    }
+
+    map_nts_();
+
+    uint32_t version = 0;
+    std::size_t offset = sizeof(TYPE_STORE_MAGIC);
+    if (mapped_size_ < TYPE_STORE_HEADER_SIZE ||
+            0 != std::memcmp(data_, TYPE_STORE_MAGIC, sizeof(TYPE_STORE_MAGIC)) ||
+            !read_uint32(data_, mapped_size_, offset, version))
+    {
+        unmap_nts_();
+        throw utils::InitializationException(
+                  utils::Formatter() << "File " << file_path_ << " is not a valid type store.");
+    }
+    if (TYPE_STORE_VERSION != version)
+    {
+        // Never reinterpret (nor truncate) the records of another version
+        unmap_nts_();
+        throw utils::InitializationException(
+                  utils::Formatter() << "Type store " << file_path_ << " has version " << version << ", expected "
+                                     << TYPE_STORE_VERSION << ".");
+    }
+    indexed_size_ = TYPE_STORE_HEADER_SIZE;
+
+    if (!index_nts_())
+    {
+        if (read_only_)
+        {
+            const std::size_t bad_offset = indexed_size_;
+            unmap_nts_();
+            throw utils::InitializationException(
+                      utils::Formatter() << "Malformed record at offset " << bad_offset << " of type store "
+                                         << file_path_ << ".");
+        }
+
+        // Discard the truncated record so new records are appended right after the valid ones
+        EPROSIMA_LOG_WARNING(DDSENABLER_TYPE_STORE,
+                "Discarding truncated record at the end of type store " << file_path_ << ".");
+        unmap_nts_();
+        std::filesystem::resize_file(file_path_, indexed_size_, ec);
+        if (ec)
+        {
+            throw utils::InitializationException(
+                      utils::Formatter() << "Failed to discard truncated record of type store " << file_path_ << ": "
+                                         << ec.message() << ".");
+        }
+        map_nts_();
+    }
+
+    EPROSIMA_LOG_INFO(DDSENABLER_TYPE_STORE,
+            "Opened type store " << file_path_ << " with " << name_index_.size() << " types.");
+}
+
+TypeStore::~TypeStore()
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+
+    unmap_nts_();
+}
+
+bool TypeStore::contains(
+        const std::string& type_name) const
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+
+    return name_index_.find(type_name) != name_index_.end();
+}
+
+bool TypeStore::contains(
+        const TypeIdentifier& type_identifier) const
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+
+    try
+    {
+        return hash_index_.find(hash_key_(type_identifier)) != hash_index_.end();
+    }
+    catch (const utils::InconsistencyException& e)
+    {
+        return false;
+    }
+}
+
+bool TypeStore::load(
+        const std::string& type_name,
+        TypeIdentifier& type_identifier,
+        TypeObject& type_object)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+
+    auto it = name_index_.find(type_name);
+    if (it == name_index_.end())
+    {
+        return false;
+    }
+
+    Record record;
+    std::size_t record_size;
+    if (!read_record_nts_(it->second, record, record_size))
+    {
+        EPROSIMA_LOG_ERROR(DDSENABLER_TYPE_STORE,
+                "Failed to read type " << type_name << " from type store.");
+        return false;
+    }
+
+    auto& registry = fastdds::dds::DomainParticipantFactory::get_instance()->type_object_registry();
+
+    // Register all dependencies and main type (last one in record)
+    TypeIdentifier _type_identifier;
+    TypeObject _type_object;
+    try
+    {
+        for (const auto& entry : record.entries)
+        {
+            _type_identifier = serialization::deserialize_type_identifier(entry.first);
+
+            // Skip the type object deserialization of types already registered
+            if (fastdds::dds::RETCODE_OK == registry.get_type_object(_type_identifier, _type_object))
+            {
+                continue;
+            }
+
+            _type_object = serialization::deserialize_type_object(entry.second);
+
+            TypeIdentifierPair type_identifiers;
+            type_identifiers.type_identifier1(_type_identifier);
+            if (fastdds::dds::RETCODE_OK != registry.register_type_object(_type_object, type_identifiers))
+            {
+                EPROSIMA_LOG_ERROR(DDSENABLER_TYPE_STORE,
+                        "Failed to register a dependency of type " << type_name << ".");
+                return false;
+            }
+        }
+    }
+    catch (const utils::InconsistencyException& e)
+    {
+        EPROSIMA_LOG_ERROR(DDSENABLER_TYPE_STORE,
+                "Failed to deserialize type " << type_name << " from type store: " << e.what());
+        return false;
+    }
+
+    type_identifier = _type_identifier;
+    type_object = _type_object;
+
+    return true;
+}
+
+bool TypeStore::store(
+        const std::string& type_name,
+        const TypeIdentifier& type_identifier,
+        const std::string& idl,
+        const std::string& placeholder)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+
+    if (name_index_.find(type_name) != name_index_.end())
+    {
+        return true;
+    }
+
+    if (read_only_)
+    {
+        EPROSIMA_LOG_ERROR(DDSENABLER_TYPE_STORE,
+                "Failed to store type " << type_name << ": type store " << file_path_ << " is read-only.");
+        return false;
+    }
+
+    auto& registry = fastdds::dds::DomainParticipantFactory::get_instance()->type_object_registry();
+
+    TypeIdentifierPair type_identifiers;
+    type_identifiers.type_identifier1(type_identifier);
+    TypeInformation type_info;
+    if (fastdds::dds::RETCODE_OK != registry.get_type_information(type_identifiers, type_info, true))
+    {
+        EPROSIMA_LOG_ERROR(DDSENABLER_TYPE_STORE,
+                "Error getting TypeInformation for type " << type_name << ".");
+        return false;
+    }
+
+    std::vector<TypeIdentifier> identifiers;
+    for (const auto& dependency : type_info.complete().dependent_typeids())
+    {
+        identifiers.push_back(dependency.type_id());
+    }
+    identifiers.push_back(type_identifier);
+
+    std::string body;
+    append_string(body, type_name);
+    append_uint32(body, static_cast<uint32_t>(identifiers.size()));
+    try
+    {
+        for (const auto& identifier : identifiers)
+        {
+            TypeObject type_object;
+            if (fastdds::dds::RETCODE_OK != registry.get_type_object(identifier, type_object))
+            {
+                EPROSIMA_LOG_ERROR(DDSENABLER_TYPE_STORE,
+                        "Error getting TypeObject for type " << type_name << " or its dependencies.");
+                return false;
+            }
+            append_string(body, serialization::serialize_type_identifier(identifier));
+            append_string(body, serialization::serialize_type_object(type_object));
+        }
+    }
+    catch (const utils::InconsistencyException& e)
+    {
+        EPROSIMA_LOG_ERROR(DDSENABLER_TYPE_STORE,
+                "Failed to serialize type " << type_name << ": " << e.what());
+        return false;
+    }
+
+    append_string(body, idl);
+    append_string(body, placeholder);
+
+    std::string record;
+    append_uint32(record, static_cast<uint32_t>(body.size()));
+    record.append(body);
+
+    {
+        std::ofstream file(file_path_, std::ios::binary | std::ios::app);
+        if (!file.write(record.data(), record.size()) || !file.flush())
+        {
+            EPROSIMA_LOG_ERROR(DDSENABLER_TYPE_STORE,
+                    "Failed to append type " << type_name << " to type store " << file_path_ << ".");
+            return false;
+        }
+    }
+
+    try
+    {
+        map_nts_();
+    }
+    catch (const utils::InitializationException& e)
+    {
+        EPROSIMA_LOG_ERROR(DDSENABLER_TYPE_STORE, e.what());
+        return false;
+    }
+
+    return index_nts_();
+}
+
+std::size_t TypeStore::size() const
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+
+    return name_index_.size();
+}
+
+std::vector<std::string> TypeStore::type_names() const
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+
+    std::vector<std::string> type_names;
+    type_names.reserve(name_index_.size());
+    for (const auto& it : name_index_)
+    {
+        type_names.push_back(it.first);
+    }
+    return type_names;
+}
+
+bool TypeStore::get_description(
+        const std::string& type_name,
+        std::string& idl,
+        std::string& placeholder) const
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+
+    auto it = name_index_.find(type_name);
+    if (it == name_index_.end())
+    {
+        return false;
+    }
+
+    Record record;
+    std::size_t record_size;
+    if (!read_record_nts_(it->second, record, record_size))
+    {
+        return false;
+    }
+
+    idl = std::move(record.idl);
+    placeholder = std::move(record.placeholder);
+    return true;
+}
+
+void TypeStore::map_nts_()
+{
+    unmap_nts_();
+
+#ifndef _WIN32
+    int fd = ::open(file_path_.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        throw utils::InitializationException(
+                  utils::Formatter() << "Failed to open type store " << file_path_ << ".");
+    }
+
+    struct stat file_stat;
+    if (0 != ::fstat(fd, &file_stat))
+    {
+        ::close(fd);
+        throw utils::InitializationException(
+                  utils::Formatter() << "Failed to stat type store " << file_path_ << ".");
+    }
+
+    void* address = ::mmap(nullptr, static_cast<std::size_t>(file_stat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (MAP_FAILED == address)
+    {
+        throw utils::InitializationException(
+                  utils::Formatter() << "Failed to map type store " << file_path_ << ".");
+    }
+
+    data_ = static_cast<const char*>(address);
+    mapped_size_ = static_cast<std::size_t>(file_stat.st_size);
+#else
+    std::ifstream file(file_path_, std::ios::binary);
+    if (!file)
+    {
+        throw utils::InitializationException(
+                  utils::Formatter() << "Failed to open type store " << file_path_ << ".");
+    }
+    buffer_.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+    data_ = buffer_.data();
+    mapped_size_ = buffer_.size();
+#endif // _WIN32
+}
+
+void TypeStore::unmap_nts_()
+{
+    if (nullptr == data_)
+    {
+        return;
+    }
+
+#ifndef _WIN32
+    ::munmap(const_cast<char*>(data_), mapped_size_);
+#else
+    buffer_.clear();
+#endif // _WIN32
+
+    data_ = nullptr;
+    mapped_size_ = 0;
+}
+
+bool TypeStore::index_nts_()
+{
+    while (indexed_size_ < mapped_size_)
+    {
+        Record record;
+        std::size_t record_size;
+        if (!read_record_nts_(indexed_size_, record, record_size))
+        {
+            if (0 == record_size || read_only_)
+            {
+                // The record exceeds the end of the file, or cannot be skipped
+                return false;
+            }
+
+            // Skip the malformed record, keeping the valid ones after it
+            EPROSIMA_LOG_WARNING(DDSENABLER_TYPE_STORE,
+                    "Skipping malformed record at offset " << indexed_size_ << " of type store " << file_path_ << ".");
+            indexed_size_ += record_size;
+            continue;
+        }
+
+        try
+        {
+            hash_index_.emplace(
+                hash_key_(serialization::deserialize_type_identifier(record.entries.back().first)), indexed_size_);
+            name_index_.emplace(record.type_name, indexed_size_);
+        }
+        catch (const utils::InconsistencyException& e)
+        {
+            if (read_only_)
+            {
+                return false;
+            }
+            EPROSIMA_LOG_WARNING(DDSENABLER_TYPE_STORE,
+                    "Skipping type " << record.type_name << " of type store " << file_path_ << ": " << e.what());
+        }
+
+        indexed_size_ += record_size;
+    }
+
+    return true;
+}
+
+bool TypeStore::read_record_nts_(
+        std::size_t offset,
+        Record& record,
+        std::size_t& record_size) const
+{
+    record_size = 0;
+
+    uint32_t body_size;
+    std::size_t position = offset;
+    if (!read_uint32(data_, mapped_size_, position, body_size) || body_size > mapped_size_ - position)
+    {
+        return false;
+    }
+
+    const std::size_t end = position + body_size;
+    record_size = end - offset;
+
+    uint32_t n_entries;
+    if (!read_string(data_, end, position, record.type_name) || !read_uint32(data_, end, position, n_entries))
+    {
+        return false;
+    }
+
+    record.entries.clear();
+    for (uint32_t i = 0; i < n_entries; ++i)
+    {
+        Entry entry;
+        if (!read_string(data_, end, position, entry.first) || !read_string(data_, end, position, entry.second))
+        {
+            return false;
+        }
+        record.entries.push_back(std::move(entry));
+    }
+
+    if (!read_string(data_, end, position, record.idl) || !read_string(data_, end, position, record.placeholder))
+    {
+        return false;
+    }
+
+    return !record.entries.empty();
+}
+
+std::string TypeStore::hash_key_(
+        const TypeIdentifier& type_identifier)
+{
+    // Both kinds of keys are prefixed with their kind, as a serialized identifier may be as short as a hash
+    if (EK_COMPLETE != type_identifier._d() && EK_MINIMAL != type_identifier._d())
+    {
+        // Identifiers without hash (fully descriptive or plain ones) are keyed on their serialized form
+        return SERIALIZED_KEY_PREFIX + serialization::serialize_type_identifier(type_identifier);
+    }
+
+    const auto& hash = type_identifier.equivalence_hash();
+    return HASH_KEY_PREFIX + std::string(reinterpret_cast<const char*>(hash.data()), hash.size());
+}
+
+} /* namespace participants */
+} /* namespace ddsenabler */
+} /* namespace eprosima */
@@ -58,7 +58,8 @@ UUID json_to_uuid(
 
 void Writer::write_schema(
         const fastdds::dds::DynamicType::_ref_type& dyn_type,
-        const fastdds::dds::xtypes::TypeIdentifier& type_id)
+        const fastdds::dds::xtypes::TypeIdentifier& type_id,
+        const bool lazy)
 {
     assert(nullptr != dyn_type);
 
@@ -68,21 +69,109 @@ void Writer::write_schema(
     EPROSIMA_LOG_INFO(DDSENABLER_WRITER,
             "Writing schema: " << type_name << ".");
 
+    if (lazy)
+    {
+        // Only the type name is notified, the rest of the information is generated on demand
+        if (type_notification_callback_)
+        {
+            notify_("type_notification", type_name,
+                    [callback = type_notification_callback_, type_name]()
+                    {
+                        callback(type_name.c_str(), "", nullptr, 0, "");
+                    });
+        }
+        return;
+    }
+
+    std::string idl;
+    if (!generate_type_idl(dyn_type, idl))
+    {
+        return;
+    }
+
+    std::vector<unsigned char> types_collection;
+    std::vector<std::string> type_identifiers;
+    if (!generate_type_collection(dyn_type, type_id, types_collection, &type_identifiers))
+    {
+        return;
+    }
+
+    std::string data_placeholder;
+    if (!generate_type_placeholder(dyn_type, data_placeholder))
+    {
+        return;
+    }
+
+    // Notify type reception
+    if (type_notification_callback_)
+    {
+        notify_("type_notification", type_name,
+                [this, callback = type_notification_callback_, type_name, idl = std::move(idl),
+                        types_collection = std::move(types_collection),
+                        data_placeholder = std::move(data_placeholder),
+                        type_identifiers = std::move(type_identifiers)]()
+                {
+                    callback(
+                        type_name.c_str(),
+                        idl.c_str(),
+                        types_collection.data(),
+                        static_cast<uint32_t>(types_collection.size()),
+                        data_placeholder.c_str()
+                        );
+
+                    // Only types the user's app has actually received can be referenced by later collections
+                    if (incremental_type_collections_)
+                    {
+                        mark_types_delivered(type_identifiers, types_cache_);
+                    }
+                });
+    }
+}
+
+bool Writer::generate_type_idl(
+        const fastdds::dds::DynamicType::_ref_type& dyn_type,
+        std::string& idl)
+{
+    assert(nullptr != dyn_type);
+
     std::stringstream ss_idl;
     auto ret = fastdds::dds::idl_serialize(dyn_type, ss_idl);
     if (ret != fastdds::dds::RETCODE_OK)
     {
         EPROSIMA_LOG_ERROR(DDSENABLER_WRITER,
-                "Failed to serialize DynamicType to idl for type with name: " << type_name);
-        return;
+                "Failed to serialize DynamicType to idl for type with name: " << dyn_type->get_name().to_string());
+        return false;
     }
 
+    idl = ss_idl.str();
+    return true;
+}
+
+bool Writer::generate_type_collection(
+        const fastdds::dds::DynamicType::_ref_type& dyn_type,
+        const fastdds::dds::xtypes::TypeIdentifier& type_id,
+        std::vector<unsigned char>& collection,
+        std::vector<std::string>* type_identifiers)
+{
+    assert(nullptr != dyn_type);
+
+    const std::string& type_name = dyn_type->get_name().to_string();
+
     DynamicTypesCollection types_collection;
-    if (!serialize_dynamic_type(type_name, type_id, types_collection))
+    if (!serialize_dynamic_type(type_name, type_id, types_collection, types_cache_, incremental_type_collections_))
     {
         EPROSIMA_LOG_ERROR(DDSENABLER_WRITER,
                 "Failed to serialize dynamic types collection: " << type_name);
-        return;
+        return false;
+    }
+
+    if (nullptr != type_identifiers)
+    {
+        type_identifiers->clear();
+        for (const auto& dynamic_type : types_collection.dynamic_types())
+        {
+            type_identifiers->push_back(dynamic_type.type_identifier());
+        }
     }
 
     std::unique_ptr<fastdds::rtps::SerializedPayload_t> types_collection_payload = serialize_dynamic_types(
@@ -91,9 +180,23 @@ void Writer::write_schema(
     {
         EPROSIMA_LOG_ERROR(DDSENABLER_WRITER,
                 "Failed to serialize dynamic types collection: " << type_name);
-        return;
+        return false;
     }
 
+    collection.assign(
+        types_collection_payload->data,
+        types_collection_payload->data + types_collection_payload->length);
+    return true;
+}
+
+bool Writer::generate_type_placeholder(
+        const fastdds::dds::DynamicType::_ref_type& dyn_type,
+        std::string& placeholder)
+{
+    assert(nullptr != dyn_type);
+
+    const std::string& type_name = dyn_type->get_name().to_string();
+
     std::stringstream ss_data_holder;
     ss_data_holder << std::setw(4);
     if (fastdds::dds::RETCODE_OK !=
@@ -102,7 +205,7 @@ void Writer::write_schema(
     {
         EPROSIMA_LOG_ERROR(DDSENABLER_WRITER,
                 "Not able to generate data placeholder for type " << type_name << ".");
-        return;
+        return false;
     }
 
     // Filter placeholder based on action/service type suffix
@@ -143,17 +246,8 @@ void Writer::write_schema(
                 "JSON filter failed for " << type_name << ": " << e.what());
     }
 
-    // Notify type reception
-    if (type_notification_callback_)
-    {
-        type_notification_callback_(
-            type_name.c_str(),
-            ss_idl.str().c_str(),
-            types_collection_payload->data,
-            types_collection_payload->length,
-            data_placeholder.c_str()
-            );
-    }
+    placeholder = std::move(data_placeholder);
+    return true;
 }
 
 void Writer::write_topic(
@@ -165,11 +259,11 @@ void Writer::write_topic(
     // Notify topic reception
     if (topic_notification_callback_)
     {
-        std::string serialized_qos = serialize_qos(topic.topic_qos);
-        topic_notification_callback_(
-            topic.topic_name().c_str(),
-            TopicInfo(topic.type_name, serialized_qos)
-            );
+        notify_("topic_notification", topic.topic_name(),
+                [callback = topic_notification_callback_, topic_name = topic.topic_name(), info = topic_info_(topic)]()
+                {
+                    callback(topic_name.c_str(), info);
+                });
     }
 }
 
@@ -177,17 +271,34 @@ void Writer::write_data(
         const Message& msg,
         const fastdds::dds::DynamicType::_ref_type& dyn_type)
 {
+    if (!data_notification_callback_)
+    {
+        if (msg.metrics)
+        {
+            msg.metrics->filtered.fetch_add(1, std::memory_order_relaxed);
+        }
+        return;
+    }
+
     nlohmann::json json_data;
-    if (data_notification_callback_ && prepare_json_data_(msg, dyn_type, json_data))
+    if (prepare_json_data_(msg, dyn_type, json_data))
     {
-        data_notification_callback_(
-            msg.topic.topic_name().c_str(),
-            json_data.dump(4).c_str(),
-            msg.publish_time.to_ns()
-            );
+        notify_("data_notification", msg.topic.topic_name(), msg,
+                [callback = data_notification_callback_, topic_name = msg.topic.topic_name(),
+                        json = json_data.dump(4), publish_time = msg.publish_time.to_ns()]()
+                {
+                    callback(topic_name.c_str(), json.c_str(), publish_time);
+                }, true);
     }
 }
 
+void Writer::write_typed_data(
+        const Message& msg,
+        NotificationQueue::Notification&& notification)
+{
+    notify_("typed_data_notification", msg.topic.topic_name(), msg, std::move(notification), true);
+}
+
 void Writer::write_service_notification(
         const ddspipe::core::types::RpcTopic& service)
 {
@@ -196,15 +307,12 @@ void Writer::write_service_notification(
 
     if (service_notification_callback_)
     {
-        std::string request_serialized_qos = serialize_qos(service.request_topic().topic_qos);
-        std::string reply_serialized_qos = serialize_qos(service.reply_topic().topic_qos);
-        service_notification_callback_(
-            service.service_name().c_str(),
-            ServiceInfo(
-                TopicInfo(service.request_topic().type_name, request_serialized_qos),
-                TopicInfo(service.reply_topic().type_name, reply_serialized_qos)
-                )
-            );
+        notify_("service_notification", service.service_name(),
+                [callback = service_notification_callback_, service_name = service.service_name(),
+                        info = service_info_(service)]()
+                {
+                    callback(service_name.c_str(), info);
+                });
     }
 }
 
@@ -217,12 +325,12 @@ void Writer::write_service_reply_notification(
     nlohmann::json json_data;
     if (service_reply_notification_callback_ && prepare_json_data_(msg, dyn_type, json_data))
     {
-        service_reply_notification_callback_(
-            service_name.c_str(),
-            json_data.dump(4).c_str(),
-            request_id,
-            msg.publish_time.to_ns()
-            );
+        notify_("service_reply_notification", service_name, msg,
+                [callback = service_reply_notification_callback_, service_name, json = json_data.dump(4), request_id,
+                        publish_time = msg.publish_time.to_ns()]()
+                {
+                    callback(service_name.c_str(), json.c_str(), request_id, publish_time);
+                });
     }
 }
 
@@ -235,12 +343,12 @@ void Writer::write_service_request_notification(
     nlohmann::json json_data;
     if (service_request_notification_callback_ && prepare_json_data_(msg, dyn_type, json_data))
     {
-        service_request_notification_callback_(
-            service_name.c_str(),
-            json_data.dump(4).c_str(),
-            request_id,
-            msg.publish_time.to_ns()
-            );
+        notify_("service_request_notification", service_name, msg,
+                [callback = service_request_notification_callback_, service_name, json = json_data.dump(4), request_id,
+                        publish_time = msg.publish_time.to_ns()]()
+                {
+                    callback(service_name.c_str(), json.c_str(), request_id, publish_time);
+                });
     }
 }
 
@@ -252,33 +360,66 @@ void Writer::write_action_notification(
 
     if (action_notification_callback_)
     {
-        std::string goal_request_serialized_qos = serialize_qos(action.goal.request_topic().topic_qos);
-        std::string goal_reply_serialized_qos = serialize_qos(action.goal.reply_topic().topic_qos);
-        std::string cancel_request_serialized_qos = serialize_qos(action.cancel.request_topic().topic_qos);
-        std::string cancel_reply_serialized_qos = serialize_qos(action.cancel.reply_topic().topic_qos);
-        std::string result_request_serialized_qos = serialize_qos(action.result.request_topic().topic_qos);
-        std::string result_reply_serialized_qos = serialize_qos(action.result.reply_topic().topic_qos);
-        std::string feedback_serialized_qos = serialize_qos(action.feedback.topic_qos);
-        std::string status_serialized_qos = serialize_qos(action.status.topic_qos);
-
-        action_notification_callback_(
-            action.action_name.c_str(),
-            ActionInfo(
-                ServiceInfo(
-                    TopicInfo(action.goal.request_topic().type_name, goal_request_serialized_qos),
-                    TopicInfo(action.goal.reply_topic().type_name, goal_reply_serialized_qos)
-                    ),
-                ServiceInfo(
-                    TopicInfo(action.result.request_topic().type_name, result_request_serialized_qos),
-                    TopicInfo(action.result.reply_topic().type_name, result_reply_serialized_qos)
-                    ),
-                ServiceInfo(
-                    TopicInfo(action.cancel.request_topic().type_name, cancel_request_serialized_qos),
-                    TopicInfo(action.cancel.reply_topic().type_name, cancel_reply_serialized_qos)
-                    ),
-                TopicInfo(action.feedback.type_name, feedback_serialized_qos),
-                TopicInfo(action.status.type_name, status_serialized_qos)
-                ));
+        notify_("action_notification", action.action_name,
+                [callback = action_notification_callback_, action_name = action.action_name,
+                        info = action_info_(action)]()
+                {
+                    callback(action_name.c_str(), info);
+                });
+    }
+}
+
+void Writer::write_discovery_batch(
+        const std::vector<DdsTopic>& topics,
+        const std::vector<ddspipe::core::types::RpcTopic>& services,
+        const std::vector<RpcAction>& actions)
+{
+    EPROSIMA_LOG_INFO(DDSENABLER_WRITER,
+            "Writting discovery batch: " << topics.size() << " topics, " << services.size() << " services, " <<
+            actions.size() << " actions.");
+
+    if (!discovery_batch_notification_callback_)
+    {
+        // Fall back to individual notifications, still delivered together
+        for (const auto& topic : topics)
+        {
+            write_topic(topic);
+        }
+        for (const auto& service : services)
+        {
+            write_service_notification(service);
+        }
+        for (const auto& action : actions)
+        {
+            write_action_notification(action);
+        }
+        return;
+    }
+
+    DiscoveryBatch batch;
+    batch.topics.reserve(topics.size());
+    for (const auto& topic : topics)
+    {
+        batch.topics.emplace_back(topic.topic_name(), topic_info_(topic));
+    }
+    batch.services.reserve(services.size());
+    for (const auto& service : services)
+    {
+        batch.services.emplace_back(service.service_name(), service_info_(service));
+    }
+    batch.actions.reserve(actions.size());
+    for (const auto& action : actions)
+    {
+        batch.actions.emplace_back(action.action_name, action_info_(action));
+    }
+
+    if (!batch.empty())
+    {
+        notify_("discovery_batch_notification", "",
+                [callback = discovery_batch_notification_callback_, batch = std::move(batch)]()
+                {
+                    callback(batch);
+                });
     }
 }
 
@@ -291,12 +432,12 @@ void Writer::write_action_result_notification(
     nlohmann::json json_data;
     if (action_result_notification_callback_ && prepare_json_data_(msg, dyn_type, json_data))
     {
-        action_result_notification_callback_(
-            action_name.c_str(),
-            json_data.dump(4).c_str(),
-            action_id,
-            msg.publish_time.to_ns()
-            );
+        notify_("action_result_notification", action_name, msg,
+                [callback = action_result_notification_callback_, action_name, json = json_data.dump(4), action_id,
+                        publish_time = msg.publish_time.to_ns()]()
+                {
+                    callback(action_name.c_str(), json.c_str(), action_id, publish_time);
+                });
     }
 }
 
@@ -322,12 +463,13 @@ void Writer::write_action_feedback_notification(
             return;
         }
 
-        action_feedback_notification_callback_(
-            action_name.c_str(),
-            json_data[msg.topic.topic_name()]["data"][instanceHandle.str()]["feedback"].dump(4).c_str(),
-            uuid,
-            msg.publish_time.to_ns()
-            );
+        std::string feedback = json_data[msg.topic.topic_name()]["data"][instanceHandle.str()]["feedback"].dump(4);
+        notify_("action_feedback_notification", action_name, msg,
+                [callback = action_feedback_notification_callback_, action_name, json = std::move(feedback), uuid,
+                        publish_time = msg.publish_time.to_ns()]()
+                {
+                    callback(action_name.c_str(), json.c_str(), uuid, publish_time);
+                });
     }
 }
 
@@ -362,37 +504,25 @@ void Writer::write_action_goal_reply_notification(
         status_message = "Action goal reply notification malformed";
         status_code = ddsenabler::participants::StatusCode::UNKNOWN;
     }
-    if (action_status_notification_callback_)
-    {
-        action_status_notification_callback_(
-            action_name.c_str(),
-            action_id,
-            status_code,
-            status_message.c_str(),
-            msg.publish_time.to_ns()
-            );
-    }
-
-    if (ddsenabler::participants::StatusCode::ACCEPTED == status_code &&
-            send_action_get_result_request_callback_ &&
-            !send_action_get_result_request_callback_(
-                action_name.c_str(),
-                action_id))
-    {
-        status_message = "Action goal aborted";
-        status_code = ddsenabler::participants::StatusCode::ABORTED;
-
-        if (action_status_notification_callback_)
-        {
-            action_status_notification_callback_(
-                action_name.c_str(),
-                action_id,
-                status_code,
-                status_message.c_str(),
-                msg.publish_time.to_ns()
-                );
-        }
-    }
+    // The result is requested within the same notification, as it reenters the enabler and its outcome may still
+    // need to be notified
+    notify_("action_status_notification", action_name, msg,
+            [status_callback = action_status_notification_callback_,
+                    get_result_callback = send_action_get_result_request_callback_, action_name, action_id, status_code,
+                    status_message, publish_time = msg.publish_time.to_ns()]()
+            {
+                if (status_callback)
+                {
+                    status_callback(action_name.c_str(), action_id, status_code, status_message.c_str(), publish_time);
+                }
+
+                if (ddsenabler::participants::StatusCode::ACCEPTED == status_code && get_result_callback &&
+                        !get_result_callback(action_name.c_str(), action_id) && status_callback)
+                {
+                    status_callback(action_name.c_str(), action_id, ddsenabler::participants::StatusCode::ABORTED,
+                            "Action goal aborted", publish_time);
+                }
+            });
 }
 
 void Writer::write_action_cancel_reply_notification(
@@ -473,13 +603,12 @@ void Writer::write_action_cancel_reply_notification(
 
             if (action_status_notification_callback_)
             {
-                action_status_notification_callback_(
-                    action_name.c_str(),
-                    uuid,
-                    status_code,
-                    status_message.c_str(),
-                    msg.publish_time.to_ns()
-                    );
+                notify_("action_status_notification", action_name, msg,
+                        [callback = action_status_notification_callback_, action_name, uuid, status_code,
+                                status_message, publish_time = msg.publish_time.to_ns()]()
+                        {
+                            callback(action_name.c_str(), uuid, status_code, status_message.c_str(), publish_time);
+                        });
             }
         }
     }
@@ -584,13 +713,12 @@ void Writer::write_action_status_notification(
 
             if (action_status_notification_callback_)
             {
-                action_status_notification_callback_(
-                    action_name.c_str(),
-                    uuid,
-                    status_code,
-                    status_message.c_str(),
-                    msg.publish_time.to_ns()
-                    );
+                notify_("action_status_notification", action_name, msg,
+                        [callback = action_status_notification_callback_, action_name, uuid, status_code,
+                                status_message, publish_time = msg.publish_time.to_ns()]()
+                        {
+                            callback(action_name.c_str(), uuid, status_code, status_message.c_str(), publish_time);
+                        });
             }
         }
     }
@@ -621,21 +749,30 @@ void Writer::write_action_request_notification(
     {
         if (ActionType::GOAL == action_type)
         {
-            bool accepted;
-            if (action_goal_request_notification_callback_)
-            {
-                accepted = action_goal_request_notification_callback_(
-                    action_name.c_str(),
-                    json_data.dump(4).c_str(),
-                    json_to_uuid(json_data[msg.topic.topic_name()]["data"][instanceHandle.str()]["goal_id"]),
-                    msg.publish_time.to_ns()
-                    );
-            }
-
-            send_action_send_goal_reply_callback_(
-                action_name.c_str(),
-                request_id,
-                accepted);
+            UUID goal_id = json_to_uuid(json_data[msg.topic.topic_name()]["data"][instanceHandle.str()]["goal_id"]);
+            // The reply depends on the user accepting the goal, so it is sent within the same notification
+            notify_("action_goal_request_notification", action_name, msg,
+                    [goal_request_callback = action_goal_request_notification_callback_,
+                            send_goal_reply_callback = send_action_send_goal_reply_callback_, action_name,
+                            json = json_data.dump(4), goal_id, request_id, publish_time = msg.publish_time.to_ns()]()
+                    {
+                        bool accepted = false;
+                        if (goal_request_callback)
+                        {
+                            accepted = goal_request_callback(action_name.c_str(), json.c_str(), goal_id, publish_time);
+                        }
+
+                        if (send_goal_reply_callback)
+                        {
+                            send_goal_reply_callback(action_name.c_str(), request_id, accepted);
+                        }
+                        else
+                        {
+                            EPROSIMA_LOG_ERROR(DDSENABLER_WRITER,
+                                    "Failed to reply goal request of action " << action_name <<
+                                    " : send goal reply callback not set.");
+                        }
+                    });
 
             return;
         }
@@ -647,13 +784,13 @@ void Writer::write_action_request_notification(
                 auto nanosec = json_data[msg.topic.topic_name()]["data"][instanceHandle.str()]["goal_info"]["nanosec"];
                 int64_t timestamp = static_cast<int64_t>(sec.get<int64_t>()) * 1000000000 +
                         static_cast<int64_t>(nanosec.get<uint32_t>());
-                action_cancel_request_notification_callback_(
-                    action_name.c_str(),
-                    json_to_uuid(json_data[msg.topic.topic_name()]["data"][instanceHandle.str()]["goal_id"]),
-                    timestamp,
-                    request_id,
-                    msg.publish_time.to_ns()
-                    );
+                UUID goal_id = json_to_uuid(json_data[msg.topic.topic_name()]["data"][instanceHandle.str()]["goal_id"]);
+                notify_("action_cancel_request_notification", action_name, msg,
+                        [callback = action_cancel_request_notification_callback_, action_name, goal_id, timestamp,
+                                request_id, publish_time = msg.publish_time.to_ns()]()
+                        {
+                            callback(action_name.c_str(), goal_id, timestamp, request_id, publish_time);
+                        });
             }
             return;
         }
@@ -666,6 +803,69 @@ void Writer::write_action_request_notification(
     }
 }
 
+void Writer::notify_(
+        const char* callback_name,
+        const std::string& entity_name,
+        NotificationQueue::Notification&& notification,
+        bool offloadable,
+        EntityMetrics* metrics)
+{
+    if (callback_watchdog_)
+    {
+        // Time the callback when the notification is delivered
+        notification = [watchdog = callback_watchdog_, callback_name, entity_name, offloadable,
+                        untimed = std::move(notification)]()
+                {
+                    watchdog->invoke(callback_name, entity_name, untimed, offloadable);
+                };
+
+        if (offloadable)
+        {
+            NotificationQueue::Notification on_drop;
+            if (metrics)
+            {
+                on_drop = [metrics]()
+                        {
+                            metrics->dropped.fetch_add(1, std::memory_order_relaxed);
+                        };
+            }
+            // Otherwise the watchdog keeps track of the notification until delivered from the queue
+            if (callback_watchdog_->offload(entity_name, notification, std::move(on_drop)))
+            {
+                return;
+            }
+        }
+    }
+
+    if (notification_queue_)
+    {
+        notification_queue_->push(std::move(notification));
+    }
+    else
+    {
+        notification();
+    }
+}
+
+void Writer::notify_(
+        const char* callback_name,
+        const std::string& entity_name,
+        const Message& msg,
+        NotificationQueue::Notification&& notification,
+        bool offloadable)
+{
+    if (tracer_ && msg.trace_id)
+    {
+        notification = trace_delivery(*tracer_, msg.trace_id, msg.metrics ? msg.metrics->name.c_str() : nullptr,
+                        std::move(notification));
+    }
+    if (msg.metrics)
+    {
+        notification = measure_delivery(*msg.metrics, msg.publish_time.to_ns(), std::move(notification));
+    }
+    notify_(callback_name, entity_name, std::move(notification), offloadable, msg.metrics);
+}
+
 bool Writer::uuid_from_request_json(
         const Message& msg,
         const fastdds::dds::DynamicType::_ref_type& dyn_type,
@@ -702,16 +902,26 @@ bool Writer::prepare_json_data_(
     EPROSIMA_LOG_INFO(DDSENABLER_WRITER,
             "Writing message from topic: " << msg.topic.topic_name() << ".");
 
+    const auto start = std::chrono::steady_clock::now();
+    const char* entity = msg.metrics ? msg.metrics->name.c_str() : nullptr;
+
     // Get the dynamic data to be serialized into JSON
+    TraceSpan decode_span(tracer_, msg.trace_id, SpanKind::DECODE, entity);
     fastdds::dds::DynamicData::_ref_type dyn_data = get_dynamic_data_(msg, dyn_type);
+    decode_span.end();
 
     if (nullptr == dyn_data)
     {
         EPROSIMA_LOG_ERROR(DDSENABLER_WRITER,
                 "Not able to get DynamicData from topic " << msg.topic.topic_name() << ".");
+        if (msg.metrics)
+        {
+            msg.metrics->dropped.fetch_add(1, std::memory_order_relaxed);
+        }
         return false;
     }
 
+    TraceSpan encode_span(tracer_, msg.trace_id, SpanKind::ENCODE, entity);
     std::stringstream ss_dyn_data;
     ss_dyn_data << std::setw(4);
     if (fastdds::dds::RETCODE_OK !=
@@ -719,6 +929,10 @@ bool Writer::prepare_json_data_(
     {
         EPROSIMA_LOG_ERROR(DDSENABLER_WRITER,
                 "Not able to serialize data of topic " << msg.topic.topic_name() << " into JSON format.");
+        if (msg.metrics)
+        {
+            msg.metrics->dropped.fetch_add(1, std::memory_order_relaxed);
+        }
         return false;
     }
 
@@ -744,9 +958,38 @@ bool Writer::prepare_json_data_(
         json_output[msg.topic.topic_name()]["data"][ss_instanceHandle.str()] = nlohmann::json::parse(ss_dyn_data.str());
     }
 
+    if (msg.metrics)
+    {
+        msg.metrics->record_conversion(start);
+    }
     return true;
 }
 
+TopicInfo Writer::topic_info_(
+        const DdsTopic& topic) const
+{
+    return TopicInfo(topic.type_name, serialize_qos(topic.topic_qos, compact_qos_));
+}
+
+ServiceInfo Writer::service_info_(
+        const ddspipe::core::types::RpcTopic& service) const
+{
+    return ServiceInfo(
+        topic_info_(service.request_topic()),
+        topic_info_(service.reply_topic()));
+}
+
+ActionInfo Writer::action_info_(
+        const RpcAction& action) const
+{
+    return ActionInfo(
+        service_info_(action.goal),
+        service_info_(action.result),
+        service_info_(action.cancel),
+        topic_info_(action.feedback),
+        topic_info_(action.status));
+}
+
 fastdds::dds::DynamicData::_ref_type Writer::get_dynamic_data_(
         const Message& msg,
         const fastdds::dds::DynamicType::_ref_type& dyn_type) noexcept
@@ -769,8 +1012,8 @@ fastdds::dds::DynamicData::_ref_type Writer::get_dynamic_data_(
     return dyn_data;
 }
 
-fastdds::dds::DynamicPubSubType Writer::get_pubsub_type_(
-        const fastdds::dds::DynamicType::_ref_type& dyn_type) noexcept
+fastdds::dds::DynamicPubSubType& Writer::get_pubsub_type_(
+        const fastdds::dds::DynamicType::_ref_type& dyn_type)
 {
     // Check if we already have this pubsub type
     auto it = dynamic_pubsub_types_.find(dyn_type);
@@ -780,10 +1023,7 @@ fastdds::dds::DynamicPubSubType Writer::get_pubsub_type_(
     }
 
     // Create a new pubsub type
-    fastdds::dds::DynamicPubSubType pubsub_type(dyn_type);
-    dynamic_pubsub_types_[dyn_type] = pubsub_type;
-
-    return pubsub_type;
+    return dynamic_pubsub_types_.emplace(dyn_type, fastdds::dds::DynamicPubSubType(dyn_type)).first->second;
 }
 
 } /* namespace participants */
@@ -12,9 +12,27 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <atomic>
+#include <condition_variable>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include <cpp_utils/exception/InitializationException.hpp>
 #include <cpp_utils/testing/gtest_aux.hpp>
 #include <gtest/gtest.h>
 
+#include <nlohmann/json.hpp>
+
 #include <fastdds/dds/domain/DomainParticipantFactory.hpp>
 #include <fastdds/dds/domain/DomainParticipant.hpp>
 #include <fastdds/dds/publisher/DataWriter.hpp>
@@ -31,9 +49,23 @@
 
 #include <ddspipe_core/efficiency/payload/FastPayloadPool.hpp>
 
+#include <Constants.hpp>
+#include <DiscoverySnapshot.hpp>
 #include <Handler.hpp>
 #include <HandlerConfiguration.hpp>
+#include <LatencyHistogram.hpp>
+#include <LockMetrics.hpp>
 #include <Message.hpp>
+#include <MeteredPayloadPool.hpp>
+#include <MetricsExporter.hpp>
+#include <MetricsRegistry.hpp>
+#include <NotificationQueue.hpp>
+#include <PriorityDispatcher.hpp>
+#include <Serialization.hpp>
+#include <ThreadPlacement.hpp>
+#include <Tracer.hpp>
+#include <TypeInterner.hpp>
+#include <TypeStore.hpp>
 #include <Writer.hpp>
 
 #include "types/DDSEnablerTestTypesPubSubTypes.hpp"
@@ -66,6 +98,10 @@ public:
         current_test_instance_ = this;
 
         writer_ = std::make_unique<WriterTest>();
+        writer_->set_incremental_type_collections(config.incremental_type_collections);
+        writer_->set_notification_queue(&notifications_);
+        writer_->set_callback_watchdog(callback_watchdog_.get());
+        writer_->set_tracer(tracer());
 
         // Set the callbacks
         set_data_notification_callback(test_data_notification_callback);
@@ -78,6 +114,7 @@ public:
     using participants::Handler::schemas_;
     using participants::Handler::writer_;
     using participants::Handler::unique_sequence_number_;
+    using participants::Handler::mtx_;
 
     // eprosima::ddsenabler::participants::DdsTypeQuery type_query;
     static bool test_type_query_callback(
@@ -106,6 +143,7 @@ public:
         }
 
         current_test_instance_->data_called_++;
+        current_test_instance_->data_topics_.push_back(topic_name);
     }
 
     // eprosima::ddsenabler::participants::DdsTypeNotification type_notification;
@@ -122,6 +160,8 @@ public:
         }
 
         current_test_instance_->type_called_++;
+        current_test_instance_->last_type_idl_ = serialized_type;
+        current_test_instance_->last_type_collection_size_ = serialized_type_internal_size;
     }
 
     // eprosima::ddsenabler::participants::DdsTopicNotification topic_notification;
@@ -137,10 +177,30 @@ public:
         current_test_instance_->topic_called_++;
     }
 
+    // eprosima::ddsenabler::participants::DiscoveryBatchNotification discovery_batch_notification;
+    static void test_discovery_batch_notification_callback(
+            const eprosima::ddsenabler::participants::DiscoveryBatch& batch)
+    {
+        if (current_test_instance_ == nullptr)
+        {
+            return;
+        }
+
+        current_test_instance_->discovery_batch_called_++;
+        current_test_instance_->discovery_batch_topics_ += static_cast<uint32_t>(batch.topics.size());
+        current_test_instance_->data_called_before_discovery_batch_ = current_test_instance_->data_called_;
+    }
+
     uint32_t type_query_called = 0;
     uint32_t data_called_ = 0;
+    std::vector<std::string> data_topics_;
     uint32_t type_called_ = 0;
+    std::string last_type_idl_;
+    uint32_t last_type_collection_size_ = 0;
     uint32_t topic_called_ = 0;
+    std::atomic<uint32_t> discovery_batch_called_{0};
+    std::atomic<uint32_t> discovery_batch_topics_{0};
+    uint32_t data_called_before_discovery_batch_ = 0;
 
 
     // Pointer to the current test instance (for use in the static callback)
@@ -158,6 +218,11 @@ void get_dynamic_type(
     std::shared_ptr<TopicDataType> type_support;
     switch (num_type)
     {
+        case 4:
+        {
+            type_support.reset(new DDSEnablerTestType4PubSubType());
+            break;
+        }
         case 3:
         {
             type_support.reset(new DDSEnablerTestType3PubSubType());
@@ -233,6 +298,36 @@ void get_data_payload(
     type_support->delete_data(data);
 }
 
+//! Mutex reporting when a thread starts blocking on it, so contention is produced without relying on timing
+class BlockingReportMutex
+{
+public:
+
+    void lock()
+    {
+        blocking.store(true);
+        mutex_.lock();
+    }
+
+    bool try_lock()
+    {
+        return mutex_.try_lock();
+    }
+
+    void unlock()
+    {
+        mutex_.unlock();
+    }
+
+    static std::atomic<bool> blocking;
+
+protected:
+
+    std::mutex mutex_;
+};
+
+std::atomic<bool> BlockingReportMutex::blocking {false};
+
 TEST(DdsEnablerParticipantsTest, ddsenabler_participants_handler_creation)
 {
     // Create Payload Pool
@@ -452,6 +547,1782 @@ TEST(DdsEnablerParticipantsTest, ddsenabler_participants_write_schema_first_time
     ASSERT_EQ(handler_->data_called_, 2);
 }
 
+TEST(DdsEnablerParticipantsTest, ddsenabler_participants_serialized_data_from_cdr)
+{
+    // Create Payload Pool
+    auto payload_pool_ = std::make_shared<ddspipe::core::FastPayloadPool>();
+    ASSERT_NE(payload_pool_, nullptr);
+
+    // Create Handler configuration
+    participants::HandlerConfiguration handler_config;
+
+    // Create Handler
+    auto handler_ = std::make_shared<HandlerTest>(handler_config, payload_pool_);
+    ASSERT_NE(handler_, nullptr);
+
+    xtypes::TypeIdentifier type_id;
+    DynamicType::_ref_type dynamic_type;
+    ddspipe::core::types::DdsTopic pipe_topic;
+    get_dynamic_type(1, dynamic_type, type_id, pipe_topic);
+    handler_->add_schema(dynamic_type, type_id);
+
+    // XCDR2 serialized data of an appendable type (D_CDR2 encapsulation)
+    ddspipe::core::types::Payload cdr;
+    payload_pool_->get_payload(1000, cdr);
+    get_data_payload(1, cdr);
+    std::vector<uint8_t> bytes(cdr.data, cdr.data + cdr.length);
+
+    // Same representation: data is forwarded as is
+    ddspipe::core::types::Payload same;
+    ASSERT_TRUE(handler_->get_serialized_data(pipe_topic.type_name, bytes.data(), bytes.size(),
+            DataRepresentationId::XCDR2_DATA_REPRESENTATION, same));
+    ASSERT_EQ(same.length, bytes.size());
+    ASSERT_EQ(0, std::memcmp(same.data, bytes.data(), bytes.size()));
+
+    // Different representation: data is re-encoded with XCDR1 (CDR encapsulation)
+    ddspipe::core::types::Payload reencoded;
+    ASSERT_TRUE(handler_->get_serialized_data(pipe_topic.type_name, bytes.data(), bytes.size(),
+            DataRepresentationId::XCDR_DATA_REPRESENTATION, reencoded));
+    ASSERT_EQ(reencoded.data[0], 0x00);
+    ASSERT_EQ(reencoded.data[1] & ~0x01, 0x00);
+
+    // Encapsulation not matching the type extensibility (PL_CDR2 for an appendable type)
+    std::vector<uint8_t> mutable_bytes = bytes;
+    mutable_bytes[1] = 0x0b;
+    ddspipe::core::types::Payload invalid;
+    ASSERT_FALSE(handler_->get_serialized_data(pipe_topic.type_name, mutable_bytes.data(), mutable_bytes.size(),
+            DataRepresentationId::XCDR2_DATA_REPRESENTATION, invalid));
+
+    // Missing encapsulation header
+    ASSERT_FALSE(handler_->get_serialized_data(pipe_topic.type_name, bytes.data(), 2,
+            DataRepresentationId::XCDR2_DATA_REPRESENTATION, invalid));
+
+    // Unknown type
+    ASSERT_FALSE(handler_->get_serialized_data("UnknownType", bytes.data(), bytes.size(),
+            DataRepresentationId::XCDR2_DATA_REPRESENTATION, invalid));
+}
+
+TEST(DdsEnablerParticipantsTest, ddsenabler_participants_lazy_type_notification)
+{
+    // Create Payload Pool
+    auto payload_pool_ = std::make_shared<ddspipe::core::FastPayloadPool>();
+    ASSERT_NE(payload_pool_, nullptr);
+
+    // Create Handler configuration
+    participants::HandlerConfiguration handler_config;
+    handler_config.lazy_type_notification = true;
+
+    // Create Handler
+    auto handler_ = std::make_shared<HandlerTest>(handler_config, payload_pool_);
+    ASSERT_NE(handler_, nullptr);
+
+    xtypes::TypeIdentifier type_id;
+    DynamicType::_ref_type dynamic_type;
+    ddspipe::core::types::DdsTopic pipe_topic;
+    get_dynamic_type(1, dynamic_type, type_id, pipe_topic);
+
+    // Only the type name is notified
+    handler_->add_schema(dynamic_type, type_id);
+    ASSERT_EQ(handler_->type_called_, 1);
+    ASSERT_TRUE(handler_->last_type_idl_.empty());
+    ASSERT_EQ(handler_->last_type_collection_size_, 0);
+
+    // The rest of the information is generated on demand, and cached afterwards
+    std::string idl;
+    ASSERT_TRUE(handler_->get_type_idl(pipe_topic.type_name, idl));
+    ASSERT_FALSE(idl.empty());
+    std::string cached_idl;
+    ASSERT_TRUE(handler_->get_type_idl(pipe_topic.type_name, cached_idl));
+    ASSERT_EQ(idl, cached_idl);
+
+    std::vector<unsigned char> collection;
+    ASSERT_TRUE(handler_->get_type_collection(pipe_topic.type_name, collection));
+    ASSERT_FALSE(collection.empty());
+
+    std::string placeholder;
+    ASSERT_TRUE(handler_->get_type_placeholder(pipe_topic.type_name, placeholder));
+    ASSERT_FALSE(placeholder.empty());
+
+    // A non lazy handler notifies the same information
+    handler_config.lazy_type_notification = false;
+    auto eager_handler_ = std::make_shared<HandlerTest>(handler_config, payload_pool_);
+    ASSERT_NE(eager_handler_, nullptr);
+
+    eager_handler_->add_schema(dynamic_type, type_id);
+    ASSERT_EQ(eager_handler_->type_called_, 1);
+    ASSERT_EQ(eager_handler_->last_type_idl_, idl);
+    ASSERT_EQ(eager_handler_->last_type_collection_size_, collection.size());
+}
+
+TEST(DdsEnablerParticipantsTest, ddsenabler_participants_incremental_type_collections)
+{
+    // Create Payload Pool
+    auto payload_pool_ = std::make_shared<ddspipe::core::FastPayloadPool>();
+    ASSERT_NE(payload_pool_, nullptr);
+
+    // Create Handler configuration
+    participants::HandlerConfiguration handler_config;
+    handler_config.incremental_type_collections = true;
+
+    // Create Handler
+    auto handler_ = std::make_shared<HandlerTest>(handler_config, payload_pool_);
+    ASSERT_NE(handler_, nullptr);
+
+    // DDSEnablerTestType4 depends on DDSEnablerTestType1
+    xtypes::TypeIdentifier type_id;
+    DynamicType::_ref_type dynamic_type;
+    ddspipe::core::types::DdsTopic pipe_topic;
+    get_dynamic_type(1, dynamic_type, type_id, pipe_topic);
+
+    xtypes::TypeIdentifier type_id4;
+    DynamicType::_ref_type dynamic_type4;
+    ddspipe::core::types::DdsTopic pipe_topic4;
+    get_dynamic_type(4, dynamic_type4, type_id4, pipe_topic4);
+
+    handler_->add_schema(dynamic_type, type_id);
+    handler_->add_schema(dynamic_type4, type_id4);
+    ASSERT_EQ(handler_->type_called_, 2);
+
+    // The dependency was already delivered, so it is only referenced
+    std::vector<unsigned char> collection;
+    ASSERT_TRUE(handler_->get_type_collection(pipe_topic4.type_name, collection));
+
+    participants::DynamicTypesCollection dynamic_types;
+    ASSERT_TRUE(participants::serialization::deserialize_dynamic_types(collection.data(),
+            static_cast<uint32_t>(collection.size()), dynamic_types));
+    ASSERT_EQ(dynamic_types.dynamic_types().size(), 2u);
+    ASSERT_TRUE(dynamic_types.dynamic_types()[0].type_object().empty());
+    ASSERT_FALSE(dynamic_types.dynamic_types()[1].type_object().empty());
+
+    // A full collection includes the dependency
+    participants::DynamicTypesCollection full_dynamic_types;
+    ASSERT_TRUE(participants::serialization::serialize_dynamic_type(pipe_topic4.type_name, type_id4,
+            full_dynamic_types));
+    ASSERT_EQ(full_dynamic_types.dynamic_types().size(), 2u);
+    ASSERT_FALSE(full_dynamic_types.dynamic_types()[0].type_object().empty());
+    ASSERT_EQ(full_dynamic_types.dynamic_types()[0].type_identifier(),
+            dynamic_types.dynamic_types()[0].type_identifier());
+
+    // Types are only delivered once the type callback runs: a dependency discovered while no callback is installed is
+    // included in the first collection notified afterwards
+    auto late_handler_ = std::make_shared<HandlerTest>(handler_config, payload_pool_);
+    ASSERT_NE(late_handler_, nullptr);
+
+    late_handler_->set_type_notification_callback(nullptr);
+    late_handler_->add_schema(dynamic_type, type_id);
+    ASSERT_EQ(late_handler_->type_called_, 0);
+
+    late_handler_->set_type_notification_callback(HandlerTest::test_type_notification_callback);
+    late_handler_->add_schema(dynamic_type4, type_id4);
+    ASSERT_EQ(late_handler_->type_called_, 1);
+
+    auto full_collection = participants::serialization::serialize_dynamic_types(full_dynamic_types);
+    ASSERT_NE(full_collection, nullptr);
+    ASSERT_EQ(late_handler_->last_type_collection_size_, full_collection->length);
+}
+
+TEST(DdsEnablerParticipantsTest, ddsenabler_participants_type_store)
+{
+    const std::string file_path =
+            (std::filesystem::temp_directory_path() / "ddsenabler_participants_type_store.bin").string();
+    std::filesystem::remove(file_path);
+
+    // DDSEnablerTestType4 depends on DDSEnablerTestType1
+    xtypes::TypeIdentifier type_id;
+    DynamicType::_ref_type dynamic_type;
+    ddspipe::core::types::DdsTopic pipe_topic;
+    get_dynamic_type(4, dynamic_type, type_id, pipe_topic);
+
+    {
+        participants::TypeStore type_store(file_path);
+        ASSERT_EQ(type_store.size(), 0u);
+
+        ASSERT_TRUE(type_store.store(pipe_topic.type_name, type_id));
+        ASSERT_EQ(type_store.size(), 1u);
+
+        // Storing the same type again has no effect
+        ASSERT_TRUE(type_store.store(pipe_topic.type_name, type_id));
+        ASSERT_EQ(type_store.size(), 1u);
+    }
+
+    // Reopen the store, indexing the persisted records
+    participants::TypeStore type_store(file_path);
+    ASSERT_EQ(type_store.size(), 1u);
+    ASSERT_TRUE(type_store.contains(pipe_topic.type_name));
+    ASSERT_TRUE(type_store.contains(type_id));
+    ASSERT_FALSE(type_store.contains(std::string("unknown")));
+
+    xtypes::TypeIdentifier loaded_type_id;
+    xtypes::TypeObject loaded_type_obj;
+    ASSERT_TRUE(type_store.load(pipe_topic.type_name, loaded_type_id, loaded_type_obj));
+    ASSERT_EQ(loaded_type_id, type_id);
+
+    xtypes::TypeObject type_obj;
+    ASSERT_EQ(RETCODE_OK,
+            DomainParticipantFactory::get_instance()->type_object_registry().get_type_object(type_id, type_obj));
+    ASSERT_EQ(loaded_type_obj, type_obj);
+
+    ASSERT_FALSE(type_store.load("unknown", loaded_type_id, loaded_type_obj));
+
+    std::filesystem::remove(file_path);
+}
+
+TEST(DdsEnablerParticipantsTest, ddsenabler_participants_type_store_recovery)
+{
+    const std::string file_path =
+            (std::filesystem::temp_directory_path() / "ddsenabler_participants_type_store_recovery.bin").string();
+    std::filesystem::remove(file_path);
+
+    xtypes::TypeIdentifier type_id1;
+    DynamicType::_ref_type dynamic_type1;
+    ddspipe::core::types::DdsTopic pipe_topic1;
+    get_dynamic_type(1, dynamic_type1, type_id1, pipe_topic1);
+
+    xtypes::TypeIdentifier type_id2;
+    DynamicType::_ref_type dynamic_type2;
+    ddspipe::core::types::DdsTopic pipe_topic2;
+    get_dynamic_type(2, dynamic_type2, type_id2, pipe_topic2);
+
+    {
+        participants::TypeStore type_store(file_path);
+        ASSERT_TRUE(type_store.store(pipe_topic1.type_name, type_id1));
+        ASSERT_TRUE(type_store.store(pipe_topic2.type_name, type_id2));
+        ASSERT_EQ(type_store.size(), 2u);
+    }
+
+    // Truncate the last record, as an interrupted append would
+    const auto full_size = std::filesystem::file_size(file_path);
+    std::filesystem::resize_file(file_path, full_size - 8);
+
+    {
+        // The truncated record is discarded, keeping the previous one
+        participants::TypeStore type_store(file_path);
+        ASSERT_EQ(type_store.size(), 1u);
+        ASSERT_TRUE(type_store.contains(pipe_topic1.type_name));
+        ASSERT_FALSE(type_store.contains(pipe_topic2.type_name));
+
+        // New records are appended right after the valid ones
+        ASSERT_TRUE(type_store.store(pipe_topic2.type_name, type_id2));
+        ASSERT_EQ(type_store.size(), 2u);
+    }
+    ASSERT_EQ(std::filesystem::file_size(file_path), full_size);
+
+    // Corrupt the type name length of the first record (right after the header and the record size)
+    {
+        std::fstream file(file_path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(16 + sizeof(uint32_t));
+        const uint32_t length = 0xFFFFFFFF;
+        file.write(reinterpret_cast<const char*>(&length), sizeof(length));
+    }
+
+    {
+        // The malformed record is skipped, but the valid one after it is kept
+        participants::TypeStore type_store(file_path);
+        ASSERT_EQ(type_store.size(), 1u);
+        ASSERT_FALSE(type_store.contains(pipe_topic1.type_name));
+        ASSERT_TRUE(type_store.contains(pipe_topic2.type_name));
+        ASSERT_TRUE(type_store.contains(type_id2));
+    }
+    ASSERT_EQ(std::filesystem::file_size(file_path), full_size);
+
+    std::filesystem::remove(file_path);
+}
+
+TEST(DdsEnablerParticipantsTest, ddsenabler_participants_type_bundle)
+{
+    const std::string file_path =
+            (std::filesystem::temp_directory_path() / "ddsenabler_participants_type_bundle.bin").string();
+    std::filesystem::remove(file_path);
+
+    // DDSEnablerTestType4 depends on DDSEnablerTestType1
+    xtypes::TypeIdentifier type_id;
+    DynamicType::_ref_type dynamic_type;
+    ddspipe::core::types::DdsTopic pipe_topic;
+    get_dynamic_type(4, dynamic_type, type_id, pipe_topic);
+
+    // Bundle the type with recognizable descriptions, so they can be told apart from generated ones
+    {
+        participants::TypeStore bundle(file_path);
+        ASSERT_TRUE(bundle.store(pipe_topic.type_name, type_id, "bundled idl", "bundled placeholder"));
+        ASSERT_EQ(bundle.type_names(), std::vector<std::string>{pipe_topic.type_name});
+
+        std::string idl;
+        std::string placeholder;
+        ASSERT_TRUE(bundle.get_description(pipe_topic.type_name, idl, placeholder));
+        ASSERT_EQ(idl, "bundled idl");
+        ASSERT_EQ(placeholder, "bundled placeholder");
+        ASSERT_FALSE(bundle.get_description("unknown", idl, placeholder));
+    }
+
+    auto payload_pool_ = std::make_shared<ddspipe::core::FastPayloadPool>();
+    participants::HandlerConfiguration handler_config;
+    auto handler_ = std::make_shared<HandlerTest>(handler_config, payload_pool_);
+
+    ASSERT_EQ(handler_->load_type_bundle(file_path + ".missing"), 0u);
+    ASSERT_EQ(handler_->load_type_bundle(file_path), 1u);
+
+    // Served from cache, without querying the type nor generating its descriptions
+    xtypes::TypeIdentifier loaded_type_id;
+    ASSERT_TRUE(handler_->get_type_identifier(pipe_topic.type_name, loaded_type_id));
+    ASSERT_EQ(loaded_type_id, type_id);
+
+    std::string idl;
+    ASSERT_TRUE(handler_->get_type_idl(pipe_topic.type_name, idl));
+    ASSERT_EQ(idl, "bundled idl");
+
+    std::string placeholder;
+    ASSERT_TRUE(handler_->get_type_placeholder(pipe_topic.type_name, placeholder));
+    ASSERT_EQ(placeholder, "bundled placeholder");
+
+    // A bundle with a truncated record is rejected, and left untouched
+    const auto bundle_size = std::filesystem::file_size(file_path);
+    std::filesystem::resize_file(file_path, bundle_size - 1);
+    ASSERT_THROW({participants::TypeStore bundle(file_path, true);}, utils::InitializationException);
+    auto other_handler_ = std::make_shared<HandlerTest>(handler_config, payload_pool_);
+    ASSERT_EQ(other_handler_->load_type_bundle(file_path), 0u);
+    ASSERT_EQ(std::filesystem::file_size(file_path), bundle_size - 1);
+
+    // So is a bundle of another version (right after the magic string)
+    std::filesystem::resize_file(file_path, bundle_size);
+    {
+        std::fstream file(file_path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(8);
+        const uint32_t version = 1;
+        file.write(reinterpret_cast<const char*>(&version), sizeof(version));
+    }
+    ASSERT_THROW({participants::TypeStore bundle(file_path);}, utils::InitializationException);
+    ASSERT_EQ(other_handler_->load_type_bundle(file_path), 0u);
+    ASSERT_EQ(std::filesystem::file_size(file_path), bundle_size);
+
+    // Read-only stores are never created nor written
+    std::filesystem::remove(file_path);
+    ASSERT_THROW({participants::TypeStore bundle(file_path, true);}, utils::InitializationException);
+    ASSERT_FALSE(std::filesystem::exists(file_path));
+}
+
+TEST(DdsEnablerParticipantsTest, ddsenabler_participants_schema_cache)
+{
+    auto payload_pool_ = std::make_shared<ddspipe::core::FastPayloadPool>();
+    participants::HandlerConfiguration handler_config;
+    handler_config.schema_cache_max_types = 1;
+    auto handler_ = std::make_shared<HandlerTest>(handler_config, payload_pool_);
+
+    xtypes::TypeIdentifier type_id1;
+    DynamicType::_ref_type dynamic_type1;
+    ddspipe::core::types::DdsTopic pipe_topic1;
+    get_dynamic_type(1, dynamic_type1, type_id1, pipe_topic1);
+
+    xtypes::TypeIdentifier type_id2;
+    DynamicType::_ref_type dynamic_type2;
+    ddspipe::core::types::DdsTopic pipe_topic2;
+    get_dynamic_type(2, dynamic_type2, type_id2, pipe_topic2);
+
+    // The least recently used type is evicted, but still known
+    handler_->add_schema(dynamic_type1, type_id1);
+    handler_->add_schema(dynamic_type2, type_id2);
+    auto stats = handler_->get_schema_cache_stats();
+    ASSERT_EQ(stats.known_types, 2u);
+    ASSERT_EQ(stats.cached_types, 1u);
+    ASSERT_EQ(stats.evictions, 1u);
+    ASSERT_GT(stats.estimated_bytes, 0u);
+    ASSERT_EQ(handler_->type_called_, 2);
+
+    // An evicted type is rebuilt on demand, without querying nor notifying it again
+    std::string idl;
+    ASSERT_TRUE(handler_->get_type_idl(pipe_topic1.type_name, idl));
+    ASSERT_FALSE(idl.empty());
+    stats = handler_->get_schema_cache_stats();
+    ASSERT_EQ(stats.cached_types, 1u);
+    ASSERT_EQ(stats.evictions, 2u);
+    ASSERT_EQ(handler_->type_called_, 2);
+    ASSERT_EQ(handler_->type_query_called, 0);
+
+    // Types referenced by live topics are never evicted, even if the bound is exceeded
+    handler_->reference_type(pipe_topic1.type_name);
+    ASSERT_TRUE(handler_->get_type_idl(pipe_topic2.type_name, idl));
+    stats = handler_->get_schema_cache_stats();
+    ASSERT_EQ(stats.cached_types, 2u);
+    ASSERT_EQ(stats.pinned_types, 1u);
+    ASSERT_EQ(stats.evictions, 2u);
+
+    // Released types become evictable again
+    handler_->release_type(pipe_topic1.type_name);
+    stats = handler_->get_schema_cache_stats();
+    ASSERT_EQ(stats.cached_types, 1u);
+    ASSERT_EQ(stats.pinned_types, 0u);
+    ASSERT_EQ(stats.evictions, 3u);
+}
+
+TEST(DdsEnablerParticipantsTest, ddsenabler_participants_preload_types)
+{
+    // Synthetic corpus of types sharing a dependency, in the format saved from the type notification callback
+    constexpr std::size_t N_TYPES = 500;
+    const auto directory = std::filesystem::temp_directory_path() / "ddsenabler_participants_preload_types";
+    std::filesystem::remove_all(directory);
+    ASSERT_TRUE(std::filesystem::create_directories(directory));
+
+    auto factory = DynamicTypeBuilderFactory::get_instance();
+    auto& registry = DomainParticipantFactory::get_instance()->type_object_registry();
+
+    TypeDescriptor::_ref_type base_descriptor {traits<TypeDescriptor>::make_shared()};
+    base_descriptor->kind(TK_STRUCTURE);
+    base_descriptor->name("PreloadTypesBase");
+    DynamicTypeBuilder::_ref_type base_builder {factory->create_type(base_descriptor)};
+    MemberDescriptor::_ref_type base_member {traits<MemberDescriptor>::make_shared()};
+    base_member->name("stamp");
+    base_member->type(factory->get_primitive_type(TK_INT64));
+    ASSERT_EQ(RETCODE_OK, base_builder->add_member(base_member));
+    DynamicType::_ref_type base_type = base_builder->build();
+
+    for (std::size_t i = 0; i < N_TYPES; ++i)
+    {
+        const std::string type_name = "PreloadTypes_" + std::to_string(i);
+
+        TypeDescriptor::_ref_type descriptor {traits<TypeDescriptor>::make_shared()};
+        descriptor->kind(TK_STRUCTURE);
+        descriptor->name(type_name);
+        DynamicTypeBuilder::_ref_type builder {factory->create_type(descriptor)};
+        MemberDescriptor::_ref_type member {traits<MemberDescriptor>::make_shared()};
+        member->name("base");
+        member->type(base_type);
+        ASSERT_EQ(RETCODE_OK, builder->add_member(member));
+        member = traits<MemberDescriptor>::make_shared();
+        member->name("value");
+        member->type(factory->get_primitive_type(TK_INT32));
+        ASSERT_EQ(RETCODE_OK, builder->add_member(member));
+
+        xtypes::TypeIdentifierPair type_ids;
+        ASSERT_EQ(RETCODE_OK, registry.register_typeobject_w_dynamic_type(builder->build(), type_ids));
+        const xtypes::TypeIdentifier& type_id =
+                (xtypes::EK_COMPLETE == type_ids.type_identifier1()._d()) ?
+                type_ids.type_identifier1() : type_ids.type_identifier2();
+
+        participants::DynamicTypesCollection dynamic_types;
+        ASSERT_TRUE(participants::serialization::serialize_dynamic_type(type_name, type_id, dynamic_types));
+        auto payload = participants::serialization::serialize_dynamic_types(dynamic_types);
+        ASSERT_NE(payload, nullptr);
+
+        std::ofstream file(directory / (type_name + ".bin"), std::ios::binary);
+        file.write(reinterpret_cast<const char*>(payload->data), payload->length);
+    }
+
+    // Preload sequentially and in parallel (timed by the preload_types benchmark)
+    auto payload_pool_ = std::make_shared<ddspipe::core::FastPayloadPool>();
+    participants::HandlerConfiguration handler_config;
+    for (unsigned int n_threads : {1u, 0u})
+    {
+        auto handler_ = std::make_shared<HandlerTest>(handler_config, payload_pool_);
+
+        ASSERT_EQ(handler_->preload_types(directory.string(), n_threads), N_TYPES);
+        ASSERT_EQ(handler_->schemas_.size(), N_TYPES);
+        ASSERT_EQ(handler_->type_called_, 0);
+    }
+
+    std::filesystem::remove_all(directory);
+}
+
+TEST(DdsEnablerParticipantsTest, ddsenabler_participants_type_interner)
+{
+    // Synthetic identifiers sharing the leading bytes of their equivalence hash, which collided in the former
+    // (three bytes wide) hash, and differing only in their trailing bytes
+    constexpr std::size_t N_TYPES = 5000;
+    std::vector<xtypes::TypeIdentifier> type_ids(N_TYPES);
+    for (std::size_t i = 0; i < N_TYPES; ++i)
+    {
+        xtypes::EquivalenceHash equivalence_hash{};
+        equivalence_hash[0] = 0xAA;
+        equivalence_hash[1] = 0xBB;
+        equivalence_hash[2] = 0xCC;
+        equivalence_hash[12] = static_cast<uint8_t>(i >> 8);
+        equivalence_hash[13] = static_cast<uint8_t>(i & 0xFF);
+        type_ids[i].equivalence_hash(equivalence_hash);
+    }
+
+    std::hash<xtypes::TypeIdentifier> hasher;
+    std::unordered_set<std::size_t> hashes;
+    for (const auto& type_id : type_ids)
+    {
+        hashes.insert(hasher(type_id));
+    }
+    ASSERT_EQ(hashes.size(), N_TYPES);
+
+    // Minimal identifiers with the same equivalence hash are different types
+    xtypes::TypeIdentifier minimal_type_id = type_ids[0];
+    minimal_type_id._d(xtypes::EK_MINIMAL);
+    ASSERT_NE(hasher(minimal_type_id), hasher(type_ids[0]));
+
+    // Identifiers without equivalence hash are hashed as well
+    xtypes::TypeIdentifier primitive_type_id;
+    primitive_type_id._d(xtypes::TK_INT32);
+    ASSERT_EQ(hasher(primitive_type_id), hasher(primitive_type_id));
+
+    // Dense identifiers are assigned in interning order
+    participants::TypeInterner interner;
+    for (std::size_t i = 0; i < N_TYPES; ++i)
+    {
+        ASSERT_EQ(interner.intern("SyntheticType_" + std::to_string(i), type_ids[i]), i);
+    }
+    ASSERT_EQ(interner.size(), N_TYPES);
+
+    for (std::size_t i = 0; i < N_TYPES; ++i)
+    {
+        const std::string type_name = "SyntheticType_" + std::to_string(i);
+        ASSERT_EQ(interner.find(type_name), i);
+        ASSERT_EQ(interner.find(type_ids[i]), i);
+        ASSERT_EQ(interner.type_name(i), type_name);
+        ASSERT_EQ(interner.type_identifier(i), type_ids[i]);
+
+        // Interning again returns the same identifier
+        ASSERT_EQ(interner.intern(type_name, type_ids[i]), i);
+    }
+    ASSERT_EQ(interner.size(), N_TYPES);
+
+    ASSERT_EQ(interner.find("unknown"), participants::TypeInterner::INVALID_TYPE_ID);
+    ASSERT_EQ(interner.find(minimal_type_id), participants::TypeInterner::INVALID_TYPE_ID);
+
+    // The first type interned for a TypeIdentifier shared by several names is the one found by TypeIdentifier
+    ASSERT_EQ(interner.intern("SyntheticTypeAlias", type_ids[0]), N_TYPES);
+    ASSERT_EQ(interner.find(type_ids[0]), 0u);
+}
+
+TEST(DdsEnablerParticipantsTest, ddsenabler_participants_qos_serialization)
+{
+    using namespace ddspipe::core::types;
+
+    auto make_qos = [](std::size_t i)
+            {
+                TopicQoS qos{};
+                qos.reliability_qos = (i & 1u) ? ReliabilityKind::RELIABLE : ReliabilityKind::BEST_EFFORT;
+                qos.durability_qos = (i & 2u) ? DurabilityKind::TRANSIENT_LOCAL : DurabilityKind::VOLATILE;
+                qos.ownership_qos = (i & 4u) ?
+                        OwnershipQosPolicyKind::EXCLUSIVE_OWNERSHIP_QOS : OwnershipQosPolicyKind::SHARED_OWNERSHIP_QOS;
+                qos.keyed = (i & 8u) != 0;
+                return qos;
+            };
+    auto expect_qos_eq = [](const TopicQoS& qos, const TopicQoS& expected)
+            {
+                ASSERT_EQ(qos.is_reliable(), expected.is_reliable());
+                ASSERT_EQ(qos.is_transient_local(), expected.is_transient_local());
+                ASSERT_EQ(qos.has_ownership(), expected.has_ownership());
+                ASSERT_EQ(qos.keyed, expected.keyed);
+            };
+
+    // Every combination round-trips through both encodings
+    for (std::size_t i = 0; i < 16; ++i)
+    {
+        const TopicQoS qos = make_qos(i);
+        const std::string& yaml_qos = participants::serialization::serialize_qos(qos);
+        const std::string& compact_qos = participants::serialization::serialize_qos(qos, true);
+        ASSERT_NE(yaml_qos, compact_qos);
+        ASSERT_EQ(compact_qos.rfind(participants::QOS_SERIALIZATION_COMPACT_PREFIX, 0), 0u);
+        expect_qos_eq(participants::serialization::deserialize_qos(yaml_qos), qos);
+        expect_qos_eq(participants::serialization::deserialize_qos(compact_qos), qos);
+    }
+
+    // The YAML encoding is unchanged, and any YAML formatting is still accepted
+    const std::string legacy_qos = "reliability: true\ndurability: false\nownership: false\nkeyed: false";
+    ASSERT_EQ(participants::serialization::serialize_qos(make_qos(1)), legacy_qos);
+    const std::string flow_qos = "{reliability: true, durability: true, ownership: false, keyed: true}";
+    expect_qos_eq(participants::serialization::deserialize_qos(flow_qos), make_qos(11));
+}
+
+/**
+ * Test that topics discovered within the discovery batch window are notified together in a single batch, from the
+ * discovery batching thread, and that pending entities can be flushed right away.
+ */
+TEST(DdsEnablerParticipantsTest, ddsenabler_participants_discovery_batch)
+{
+    auto payload_pool_ = std::make_shared<ddspipe::core::FastPayloadPool>();
+    ASSERT_NE(payload_pool_, nullptr);
+
+    // The window never ends during the test, so batches are driven by flushing them
+    participants::HandlerConfiguration handler_config;
+    handler_config.discovery_batch_window_ms = 600000;
+    auto handler_ = std::make_shared<HandlerTest>(handler_config, payload_pool_);
+    ASSERT_NE(handler_, nullptr);
+    handler_->set_discovery_batch_notification_callback(HandlerTest::test_discovery_batch_notification_callback);
+
+    for (int num_type = 1; num_type <= 4; ++num_type)
+    {
+        DynamicType::_ref_type dyn_type;
+        xtypes::TypeIdentifier type_id;
+        ddspipe::core::types::DdsTopic pipe_topic;
+        get_dynamic_type(num_type, dyn_type, type_id, pipe_topic);
+        handler_->add_topic(pipe_topic);
+    }
+
+    // Nothing is notified before the window is over
+    ASSERT_EQ(handler_->discovery_batch_called_.load(), 0u);
+    ASSERT_EQ(handler_->topic_called_, 0u);
+
+    // Pending entities are notified in a single batch, and not one by one
+    handler_->flush_discovery_batch();
+    ASSERT_EQ(handler_->discovery_batch_called_.load(), 1u);
+    ASSERT_EQ(handler_->discovery_batch_topics_.load(), 4u);
+    ASSERT_EQ(handler_->topic_called_, 0u);
+
+    // Flushing with no pending entities notifies nothing
+    handler_->flush_discovery_batch();
+    ASSERT_EQ(handler_->discovery_batch_called_.load(), 1u);
+}
+
+/**
+ * Test that the batch of a window is notified once the window is over, without flushing it.
+ */
+TEST(DdsEnablerParticipantsTest, ddsenabler_participants_discovery_batch_window)
+{
+    auto payload_pool_ = std::make_shared<ddspipe::core::FastPayloadPool>();
+    ASSERT_NE(payload_pool_, nullptr);
+
+    participants::HandlerConfiguration handler_config;
+    handler_config.discovery_batch_window_ms = 50;
+    auto handler_ = std::make_shared<HandlerTest>(handler_config, payload_pool_);
+    ASSERT_NE(handler_, nullptr);
+    handler_->set_discovery_batch_notification_callback(HandlerTest::test_discovery_batch_notification_callback);
+
+    for (int num_type = 1; num_type <= 4; ++num_type)
+    {
+        DynamicType::_ref_type dyn_type;
+        xtypes::TypeIdentifier type_id;
+        ddspipe::core::types::DdsTopic pipe_topic;
+        get_dynamic_type(num_type, dyn_type, type_id, pipe_topic);
+        handler_->add_topic(pipe_topic);
+    }
+
+    // A slow machine may split the topics in several windows, but all of them end up notified in batches
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (handler_->discovery_batch_topics_ < 4 && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ASSERT_GE(handler_->discovery_batch_called_.load(), 1u);
+    ASSERT_EQ(handler_->discovery_batch_topics_.load(), 4u);
+    ASSERT_EQ(handler_->topic_called_, 0u);
+}
+
+/**
+ * Test that the discovery of a topic is notified before its first sample, even if its batch window is not over.
+ */
+TEST(DdsEnablerParticipantsTest, ddsenabler_participants_discovery_batch_before_data)
+{
+    auto payload_pool_ = std::make_shared<ddspipe::core::FastPayloadPool>();
+    ASSERT_NE(payload_pool_, nullptr);
+
+    participants::HandlerConfiguration handler_config;
+    handler_config.discovery_batch_window_ms = 600000;
+    auto handler_ = std::make_shared<HandlerTest>(handler_config, payload_pool_);
+    ASSERT_NE(handler_, nullptr);
+    handler_->set_discovery_batch_notification_callback(HandlerTest::test_discovery_batch_notification_callback);
+
+    xtypes::TypeIdentifier type_id1;
+    DynamicType::_ref_type dyn_type1;
+    ddspipe::core::types::DdsTopic pipe_topic1;
+    get_dynamic_type(1, dyn_type1, type_id1, pipe_topic1);
+    handler_->add_schema(dyn_type1, type_id1);
+
+    xtypes::TypeIdentifier type_id2;
+    DynamicType::_ref_type dyn_type2;
+    ddspipe::core::types::DdsTopic pipe_topic2;
+    get_dynamic_type(2, dyn_type2, type_id2, pipe_topic2);
+    handler_->add_schema(dyn_type2, type_id2);
+
+    auto add_data = [&](
+        const ddspipe::core::types::DdsTopic& topic,
+        int num_type)
+            {
+                auto data = std::make_unique<eprosima::ddspipe::core::types::RtpsPayloadData>();
+                payload_pool_->get_payload(1000, data->payload);
+                data->payload_owner = payload_pool_.get();
+                get_data_payload(num_type, data->payload);
+                handler_->add_data(topic, *data);
+            };
+
+    // Samples of topics already notified do not flush the batch
+    handler_->add_topic(pipe_topic1);
+    handler_->flush_discovery_batch();
+    handler_->add_topic(pipe_topic2);
+    add_data(pipe_topic1, 1);
+    ASSERT_EQ(handler_->data_called_, 1u);
+    ASSERT_EQ(handler_->discovery_batch_called_.load(), 1u);
+
+    // The first sample of a pending topic flushes the batch before being notified
+    add_data(pipe_topic2, 2);
+    ASSERT_EQ(handler_->data_called_, 2u);
+    ASSERT_EQ(handler_->discovery_batch_called_.load(), 2u);
+    ASSERT_EQ(handler_->discovery_batch_topics_.load(), 2u);
+    ASSERT_EQ(handler_->data_called_before_discovery_batch_, 1u);
+}
+
+/**
+ * Test that a discovery snapshot is restored as written, and that the known types can be saved to a type bundle and
+ * loaded back by another handler.
+ */
+TEST(DdsEnablerParticipantsTest, ddsenabler_participants_discovery_snapshot)
+{
+    const std::string file_path =
+            (std::filesystem::temp_directory_path() / "ddsenabler_participants_discovery_snapshot.json").string();
+    const std::string types_path = file_path + participants::DISCOVERY_SNAPSHOT_TYPES_SUFFIX;
+    std::filesystem::remove(file_path);
+    std::filesystem::remove(types_path);
+
+    const participants::TopicInfo topic_info("type", participants::serialization::serialize_qos(
+            ddspipe::core::types::TopicQoS(), true));
+    const participants::ServiceInfo service_info(topic_info, participants::TopicInfo("reply_type", ""));
+
+    participants::DiscoverySnapshot snapshot;
+    snapshot.topics.emplace_back("rt/chatter", topic_info);
+    snapshot.services.push_back({"add_two_ints", participants::Protocol::DDS, service_info});
+    snapshot.actions.push_back({"fibonacci/_action/", participants::Protocol::ROS2,
+                                participants::ActionInfo(service_info, service_info, service_info, topic_info,
+                                topic_info)});
+    ASSERT_TRUE(snapshot.save(file_path));
+
+    participants::DiscoverySnapshot restored;
+    ASSERT_FALSE(restored.load(file_path + ".missing"));
+    ASSERT_TRUE(restored.load(file_path));
+    ASSERT_EQ(restored.topics.size(), 1u);
+    ASSERT_EQ(restored.topics[0].first, "rt/chatter");
+    ASSERT_EQ(restored.topics[0].second.type_name, "type");
+    ASSERT_EQ(restored.topics[0].second.serialized_qos, topic_info.serialized_qos);
+    ASSERT_EQ(restored.services.size(), 1u);
+    ASSERT_EQ(restored.services[0].name, "add_two_ints");
+    ASSERT_EQ(restored.services[0].protocol, participants::Protocol::DDS);
+    ASSERT_EQ(restored.services[0].info.reply.type_name, "reply_type");
+    ASSERT_TRUE(restored.services[0].info.reply.serialized_qos.empty());
+    ASSERT_EQ(restored.actions.size(), 1u);
+    ASSERT_EQ(restored.actions[0].name, "fibonacci/_action/");
+    ASSERT_EQ(restored.actions[0].protocol, participants::Protocol::ROS2);
+    ASSERT_EQ(restored.actions[0].info.cancel.request.type_name, "type");
+    ASSERT_EQ(restored.actions[0].info.status.type_name, "type");
+
+    // A corrupted snapshot is rejected, leaving the current contents untouched
+    {
+        std::ofstream file(file_path, std::ios::trunc);
+        file << "{\"version\": 1, \"topics\": [";
+    }
+    ASSERT_FALSE(restored.load(file_path));
+    ASSERT_EQ(restored.topics.size(), 1u);
+
+    // Known types are saved to a type bundle, and loaded back by another handler
+    auto payload_pool_ = std::make_shared<ddspipe::core::FastPayloadPool>();
+    participants::HandlerConfiguration handler_config;
+    auto handler_ = std::make_shared<HandlerTest>(handler_config, payload_pool_);
+
+    DynamicType::_ref_type dynamic_type;
+    xtypes::TypeIdentifier type_id;
+    ddspipe::core::types::DdsTopic pipe_topic;
+    get_dynamic_type(4, dynamic_type, type_id, pipe_topic);
+    handler_->add_schema(dynamic_type, type_id);
+    ASSERT_EQ(handler_->save_type_bundle(types_path), 1u);
+
+    // Saving again keeps the bundle as is
+    ASSERT_EQ(handler_->save_type_bundle(types_path), 1u);
+
+    auto restored_handler_ = std::make_shared<HandlerTest>(handler_config, payload_pool_);
+    ASSERT_EQ(restored_handler_->load_type_bundle(types_path), 1u);
+    xtypes::TypeIdentifier restored_type_id;
+    ASSERT_TRUE(restored_handler_->get_type_identifier(pipe_topic.type_name, restored_type_id));
+    ASSERT_EQ(restored_type_id, type_id);
+
+    // Types evicted from the schema cache are saved too, and the bundle kept open grows with the types known later
+    const std::string bounded_types_path = types_path + ".bounded";
+    std::filesystem::remove(bounded_types_path);
+    participants::HandlerConfiguration bounded_config;
+    bounded_config.schema_cache_max_types = 1;
+    auto bounded_handler_ = std::make_shared<HandlerTest>(bounded_config, payload_pool_);
+    for (int num_type = 1; num_type <= 2; ++num_type)
+    {
+        get_dynamic_type(num_type, dynamic_type, type_id, pipe_topic);
+        bounded_handler_->add_schema(dynamic_type, type_id);
+    }
+    ASSERT_EQ(bounded_handler_->get_schema_cache_stats().evictions, 1u);
+    ASSERT_EQ(bounded_handler_->save_type_bundle(bounded_types_path), 2u);
+
+    get_dynamic_type(3, dynamic_type, type_id, pipe_topic);
+    bounded_handler_->add_schema(dynamic_type, type_id);
+    ASSERT_EQ(bounded_handler_->save_type_bundle(bounded_types_path), 3u);
+    ASSERT_EQ(participants::TypeStore(bounded_types_path, true).size(), 3u);
+
+    std::filesystem::remove(file_path);
+    std::filesystem::remove(types_path);
+    std::filesystem::remove(bounded_types_path);
+}
+
+TEST(DdsEnablerParticipantsTest, ddsenabler_participants_thread_placement)
+{
+    std::vector<unsigned int> cpus;
+    ASSERT_TRUE(participants::parse_cpu_list("0-3, 8,2", cpus));
+    ASSERT_EQ(cpus, (std::vector<unsigned int>{0, 1, 2, 3, 8}));
+
+    // Malformed lists are rejected, leaving the output untouched
+    ASSERT_FALSE(participants::parse_cpu_list("", cpus));
+    ASSERT_FALSE(participants::parse_cpu_list("3-1", cpus));
+    ASSERT_FALSE(participants::parse_cpu_list("0,a", cpus));
+    ASSERT_FALSE(participants::parse_cpu_list("-1", cpus));
+    ASSERT_EQ(cpus.size(), 5u);
+
+#if defined(__linux__)
+    // Threads created under a placement inherit it, and the creating thread gets its own back afterwards
+    char original_name[16] = {};
+    pthread_getname_np(pthread_self(), original_name, sizeof(original_name));
+
+    std::string thread_name;
+    {
+        participants::ScopedThreadPlacement placement({{0}, participants::WORKER_THREAD_NAME});
+        std::thread thread([&thread_name]()
+                {
+                    char name[16] = {};
+                    pthread_getname_np(pthread_self(), name, sizeof(name));
+                    thread_name = name;
+                });
+        thread.join();
+    }
+    ASSERT_EQ(thread_name, participants::WORKER_THREAD_NAME);
+
+    char restored_name[16] = {};
+    pthread_getname_np(pthread_self(), restored_name, sizeof(restored_name));
+    ASSERT_STREQ(restored_name, original_name);
+#endif // if defined(__linux__)
+}
+
+TEST(DdsEnablerParticipantsTest, ddsenabler_participants_priority_classes)
+{
+    auto payload_pool_ = std::make_shared<ddspipe::core::FastPayloadPool>();
+
+    // Samples of the topic of type 2 are alarms, the rest fall into the default class
+    participants::PriorityClass alarms;
+    alarms.name = "alarms";
+    alarms.topics = {"*_topic_name_2"};
+
+    participants::HandlerConfiguration handler_config;
+    handler_config.priority_classes = {alarms};
+    auto handler_ = std::make_shared<HandlerTest>(handler_config, payload_pool_);
+
+    DynamicType::_ref_type dynamic_type;
+    xtypes::TypeIdentifier type_id;
+    ddspipe::core::types::DdsTopic telemetry_topic;
+    get_dynamic_type(1, dynamic_type, type_id, telemetry_topic);
+    handler_->add_schema(dynamic_type, type_id);
+    ddspipe::core::types::DdsTopic alarms_topic;
+    get_dynamic_type(2, dynamic_type, type_id, alarms_topic);
+    handler_->add_schema(dynamic_type, type_id);
+
+    auto add_sample = [&](
+        int num_type,
+        const ddspipe::core::types::DdsTopic& topic)
+            {
+                auto data = std::make_unique<eprosima::ddspipe::core::types::RtpsPayloadData>();
+                payload_pool_->get_payload(1000, data->payload);
+                data->payload_owner = payload_pool_.get();
+                get_data_payload(num_type, data->payload);
+                ASSERT_NO_THROW(handler_->add_data(topic, *data));
+            };
+
+    constexpr uint32_t N_SAMPLES = 10;
+    {
+        // Block deliveries while telemetry and then alarms are queued
+        std::lock_guard<participants::MeteredMutex<std::recursive_mutex>> lock(handler_->mtx_);
+        for (uint32_t i = 0; i < N_SAMPLES; ++i)
+        {
+            add_sample(1, telemetry_topic);
+        }
+
+        // Wait for the first telemetry sample to be taken (and blocked) for delivery before queuing the alarms
+        for (int i = 0; i < 500 && handler_->get_priority_class_stats()[1].queued != N_SAMPLES - 1; ++i)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        ASSERT_EQ(handler_->get_priority_class_stats()[1].queued, N_SAMPLES - 1);
+
+        for (uint32_t i = 0; i < N_SAMPLES; ++i)
+        {
+            add_sample(2, alarms_topic);
+        }
+    }
+
+    std::vector<participants::PriorityClassStats> stats;
+    for (int i = 0; i < 100; ++i)
+    {
+        stats = handler_->get_priority_class_stats();
+        if (stats[0].delivered + stats[1].delivered == 2 * N_SAMPLES)
+        {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    ASSERT_EQ(stats.size(), 2u);
+    ASSERT_EQ(stats[0].name, "alarms");
+    ASSERT_EQ(stats[1].name, participants::DEFAULT_PRIORITY_CLASS_NAME);
+    for (const auto& class_stats : stats)
+    {
+        ASSERT_EQ(class_stats.queued, 0u);
+        ASSERT_EQ(class_stats.delivered, N_SAMPLES);
+        ASSERT_EQ(class_stats.dropped, 0u);
+        ASSERT_EQ(class_stats.latency.count, N_SAMPLES);
+    }
+
+    // Only the telemetry sample already being delivered when the alarms arrived goes before them
+    ASSERT_EQ(handler_->data_called_, 2 * N_SAMPLES);
+    ASSERT_EQ(handler_->data_topics_[0], telemetry_topic.m_topic_name);
+    for (uint32_t i = 1; i <= N_SAMPLES; ++i)
+    {
+        ASSERT_EQ(handler_->data_topics_[i], alarms_topic.m_topic_name);
+    }
+    for (uint32_t i = N_SAMPLES + 1; i < 2 * N_SAMPLES; ++i)
+    {
+        ASSERT_EQ(handler_->data_topics_[i], telemetry_topic.m_topic_name);
+    }
+}
+
+/**
+ * Test that the latency of a high priority class stays flat while a lower priority class saturates its queue.
+ */
+TEST(DdsEnablerParticipantsTest, ddsenabler_participants_priority_classes_latency)
+{
+    auto payload_pool_ = std::make_shared<ddspipe::core::FastPayloadPool>();
+
+    participants::PriorityClass alarms;
+    alarms.name = "alarms";
+    alarms.topics = {"*_topic_name_2"};
+    participants::PriorityClass telemetry;
+    telemetry.name = "telemetry";
+    telemetry.topics = {"*_topic_name_1"};
+    telemetry.queue_size = 16;
+
+    participants::HandlerConfiguration handler_config;
+    handler_config.priority_classes = {alarms, telemetry};
+    auto handler_ = std::make_shared<HandlerTest>(handler_config, payload_pool_);
+
+    DynamicType::_ref_type dynamic_type;
+    xtypes::TypeIdentifier type_id;
+    ddspipe::core::types::DdsTopic telemetry_topic;
+    get_dynamic_type(1, dynamic_type, type_id, telemetry_topic);
+    handler_->add_schema(dynamic_type, type_id);
+    ddspipe::core::types::DdsTopic alarms_topic;
+    get_dynamic_type(2, dynamic_type, type_id, alarms_topic);
+    handler_->add_schema(dynamic_type, type_id);
+
+    // Every sample takes a while to be processed, so telemetry arrives much faster than it is delivered
+    handler_->set_data_notification_callback([](const char*, const char*, int64_t)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            });
+
+    auto add_sample = [&](
+        int num_type,
+        const ddspipe::core::types::DdsTopic& topic)
+            {
+                auto data = std::make_unique<eprosima::ddspipe::core::types::RtpsPayloadData>();
+                payload_pool_->get_payload(1000, data->payload);
+                data->payload_owner = payload_pool_.get();
+                get_data_payload(num_type, data->payload);
+                handler_->add_data(topic, *data);
+            };
+
+    std::atomic<bool> alarms_done{false};
+    std::thread telemetry_publisher([&]()
+            {
+                while (!alarms_done.load())
+                {
+                    add_sample(1, telemetry_topic);
+                }
+            });
+
+    constexpr uint32_t N_ALARMS = 20;
+    for (uint32_t i = 0; i < N_ALARMS; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        add_sample(2, alarms_topic);
+    }
+    alarms_done = true;
+    telemetry_publisher.join();
+
+    std::vector<participants::PriorityClassStats> stats;
+    for (int i = 0; i < 500; ++i)
+    {
+        stats = handler_->get_priority_class_stats();
+        if (stats[0].queued == 0 && stats[1].queued == 0)
+        {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ASSERT_EQ(stats.size(), 3u);
+    const participants::PriorityClassStats& alarms_stats = stats[0];
+    const participants::PriorityClassStats& telemetry_stats = stats[1];
+
+    // Telemetry saturates its queue, dropping samples, while no alarm is lost
+    ASSERT_GT(telemetry_stats.dropped, 0u);
+    ASSERT_EQ(alarms_stats.dropped, 0u);
+    ASSERT_EQ(alarms_stats.delivered, N_ALARMS);
+
+    // Alarms only wait for the sample being delivered, telemetry for its whole queue
+    ASSERT_LT(alarms_stats.latency.percentile_ns(50), telemetry_stats.latency.percentile_ns(50));
+    ASSERT_LT(alarms_stats.latency.mean_ns(), telemetry_stats.latency.mean_ns());
+}
+
+TEST(DdsEnablerParticipantsTest, ddsenabler_participants_priority_dispatcher_exceptions)
+{
+    std::mutex mtx;
+    std::condition_variable cv;
+    bool delivered = false;
+
+    // Declared last, so its thread is stopped before destroying what the tasks use
+    participants::PriorityClass priority_class;
+    priority_class.name = "default";
+    participants::PriorityDispatcher dispatcher({priority_class}, participants::PriorityScheduling::STRICT);
+
+    // Tasks throwing anything do not prevent running the next ones
+    dispatcher.push(0, []()
+            {
+                throw std::runtime_error("failed");
+            });
+    dispatcher.push(0, []()
+            {
+                throw 1;
+            });
+    dispatcher.push(0, [&]()
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                delivered = true;
+                cv.notify_all();
+            });
+
+    std::unique_lock<std::mutex> lock(mtx);
+    ASSERT_TRUE(cv.wait_for(lock, std::chrono::seconds(5), [&delivered]()
+            {
+                return delivered;
+            }));
+}
+
+TEST(DdsEnablerParticipantsTest, ddsenabler_participants_slow_callbacks)
+{
+    auto payload_pool_ = std::make_shared<ddspipe::core::FastPayloadPool>();
+
+    participants::HandlerConfiguration handler_config;
+    auto handler_ = std::make_shared<HandlerTest>(handler_config, payload_pool_);
+
+    DynamicType::_ref_type dynamic_type;
+    xtypes::TypeIdentifier type_id;
+    ddspipe::core::types::DdsTopic pipe_topic;
+    get_dynamic_type(1, dynamic_type, type_id, pipe_topic);
+    handler_->add_schema(dynamic_type, type_id);
+
+    // The user's app takes long to process every sample
+    static constexpr int SLOW_CALLBACK_MS = 200;
+    static std::atomic<uint32_t> slow_callbacks{0};
+    static std::atomic<bool> slow_callback_running{false};
+    handler_->set_data_notification_callback([](const char*, const char*, int64_t)
+            {
+                slow_callback_running = true;
+                std::this_thread::sleep_for(std::chrono::milliseconds(SLOW_CALLBACK_MS));
+                slow_callback_running = false;
+                slow_callbacks++;
+            });
+
+    ddspipe::core::types::Payload cdr;
+    payload_pool_->get_payload(1000, cdr);
+    get_data_payload(1, cdr);
+    std::vector<uint8_t> bytes(cdr.data, cdr.data + cdr.length);
+
+    // Samples are received from several threads, as from the DDS Pipe workers
+    constexpr uint32_t N_RECEIVERS = 2;
+    constexpr uint32_t N_SAMPLES = 3;
+    std::atomic<uint32_t> receivers_done{0};
+    std::vector<std::thread> receivers;
+    for (uint32_t i = 0; i < N_RECEIVERS; ++i)
+    {
+        receivers.emplace_back([&]()
+                {
+                    for (uint32_t j = 0; j < N_SAMPLES; ++j)
+                    {
+                        auto data = std::make_unique<eprosima::ddspipe::core::types::RtpsPayloadData>();
+                        payload_pool_->get_payload(1000, data->payload);
+                        data->payload_owner = payload_pool_.get();
+                        get_data_payload(1, data->payload);
+                        handler_->add_data(pipe_topic, *data);
+                    }
+                    receivers_done++;
+                });
+    }
+
+    // Publications are not blocked by the callbacks being invoked meanwhile: some start and complete within a
+    // single callback (callbacks are never invoked concurrently, as no topic is offloaded), and their latency stays
+    // far below that of a callback
+    participants::LatencyHistogram publish_latency;
+    uint32_t publications_within_callbacks = 0;
+    while (receivers_done.load() < N_RECEIVERS)
+    {
+        const uint32_t callbacks_before = slow_callbacks.load();
+        const bool running_before = slow_callback_running.load();
+        ddspipe::core::types::Payload payload;
+        const auto start = std::chrono::steady_clock::now();
+        ASSERT_TRUE(handler_->get_serialized_data(pipe_topic.type_name, bytes.data(), bytes.size(),
+                DataRepresentationId::XCDR2_DATA_REPRESENTATION, payload));
+        publish_latency.record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - start).count()));
+        if (running_before && slow_callback_running.load() && slow_callbacks.load() == callbacks_before)
+        {
+            publications_within_callbacks++;
+        }
+    }
+
+    for (auto& receiver : receivers)
+    {
+        receiver.join();
+    }
+
+    // All notifications have been delivered once every thread queuing them has returned
+    ASSERT_EQ(slow_callbacks.load(), N_RECEIVERS * N_SAMPLES);
+    ASSERT_EQ(handler_->unique_sequence_number_, N_RECEIVERS * N_SAMPLES);
+
+    ASSERT_GT(publications_within_callbacks, 0u);
+
+    constexpr uint64_t MIN_PUBLICATIONS = 100;
+    const participants::LatencyStats latency = publish_latency.stats();
+    ASSERT_GE(latency.count, MIN_PUBLICATIONS);
+    ASSERT_LT(latency.percentile_ns(99), static_cast<uint64_t>(SLOW_CALLBACK_MS) * 1000000 / 10);
+}
+
+TEST(DdsEnablerParticipantsTest, ddsenabler_participants_notification_scopes)
+{
+    participants::NotificationQueue queue;
+    participants::NotificationQueue other_queue;
+    std::vector<std::string> delivered;
+
+    {
+        participants::NotificationScope scope(queue);
+        {
+            // Nested scopes only defer the delivery until the outermost one is left
+            participants::NotificationScope nested_scope(queue);
+            queue.push([&delivered]()
+                    {
+                        delivered.push_back("deferred");
+                    });
+        }
+        ASSERT_TRUE(delivered.empty());
+
+        // Scopes on a queue do not defer the notifications of other queues
+        other_queue.push([&delivered]()
+                {
+                    delivered.push_back("other");
+                });
+        ASSERT_EQ(delivered, (std::vector<std::string>{"other"}));
+        ASSERT_EQ(queue.size(), 1u);
+    }
+    ASSERT_EQ(delivered, (std::vector<std::string>{"other", "deferred"}));
+
+    // Notifications throwing anything do not prevent delivering the next ones
+    queue.push([]()
+            {
+                throw 1;
+            });
+    queue.push([&delivered]()
+            {
+                delivered.push_back("after_throw");
+            });
+    ASSERT_EQ(delivered.back(), "after_throw");
+    ASSERT_EQ(queue.size(), 0u);
+}
+
+TEST(DdsEnablerParticipantsTest, ddsenabler_participants_callback_watchdog)
+{
+    auto payload_pool_ = std::make_shared<ddspipe::core::FastPayloadPool>();
+
+    // Samples are delivered from a dedicated thread after two consecutive overruns
+    participants::HandlerConfiguration handler_config;
+    handler_config.callback_budget_ms = 20;
+    handler_config.callback_offload_threshold = 2;
+    auto handler_ = std::make_shared<HandlerTest>(handler_config, payload_pool_);
+
+    DynamicType::_ref_type dynamic_type;
+    xtypes::TypeIdentifier type_id;
+    ddspipe::core::types::DdsTopic pipe_topic;
+    get_dynamic_type(1, dynamic_type, type_id, pipe_topic);
+    handler_->add_schema(dynamic_type, type_id);
+
+    static constexpr int SLOW_CALLBACK_MS = 50;
+    static std::mutex mtx;
+    static std::vector<std::thread::id> callback_threads;
+    handler_->set_data_notification_callback([](const char*, const char*, int64_t)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(SLOW_CALLBACK_MS));
+                std::lock_guard<std::mutex> lock(mtx);
+                callback_threads.push_back(std::this_thread::get_id());
+            });
+
+    static std::vector<std::pair<std::string, bool>> reports;
+    handler_->set_slow_callback_notification_callback([](const char* callback_name, const char*, int64_t duration,
+            bool offloaded)
+            {
+                ASSERT_GE(duration, static_cast<int64_t>(SLOW_CALLBACK_MS) * 1000000);
+                std::lock_guard<std::mutex> lock(mtx);
+                reports.emplace_back(callback_name, offloaded);
+            });
+
+    constexpr uint32_t N_SAMPLES = 4;
+    for (uint32_t i = 0; i < N_SAMPLES; ++i)
+    {
+        auto data = std::make_unique<eprosima::ddspipe::core::types::RtpsPayloadData>();
+        payload_pool_->get_payload(1000, data->payload);
+        data->payload_owner = payload_pool_.get();
+        get_data_payload(1, data->payload);
+
+        const auto start = std::chrono::steady_clock::now();
+        ASSERT_NO_THROW(handler_->add_data(pipe_topic, *data));
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+
+        // Once offloaded, receiving a sample does not wait for its callback
+        if (i >= handler_config.callback_offload_threshold)
+        {
+            ASSERT_LT(elapsed, std::chrono::milliseconds(SLOW_CALLBACK_MS));
+        }
+    }
+
+    for (int i = 0; i < 100; ++i)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            if (reports.size() == N_SAMPLES)
+            {
+                break;
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    std::lock_guard<std::mutex> lock(mtx);
+    ASSERT_EQ(callback_threads.size(), N_SAMPLES);
+    ASSERT_EQ(reports.size(), N_SAMPLES);
+    for (uint32_t i = 0; i < N_SAMPLES; ++i)
+    {
+        ASSERT_EQ(reports[i].first, "data_notification");
+        ASSERT_EQ(reports[i].second, i + 1 >= handler_config.callback_offload_threshold);
+        ASSERT_EQ(callback_threads[i] == std::this_thread::get_id(), i < handler_config.callback_offload_threshold);
+    }
+}
+
+TEST(DdsEnablerParticipantsTest, ddsenabler_participants_callback_watchdog_recovery)
+{
+    auto payload_pool_ = std::make_shared<ddspipe::core::FastPayloadPool>();
+
+    // Samples are delivered from a dedicated thread after two consecutive overruns, and from the receiving thread
+    // again after two consecutive callbacks within budget
+    participants::HandlerConfiguration handler_config;
+    handler_config.callback_budget_ms = 20;
+    handler_config.callback_offload_threshold = 2;
+    auto handler_ = std::make_shared<HandlerTest>(handler_config, payload_pool_);
+
+    DynamicType::_ref_type dynamic_type;
+    xtypes::TypeIdentifier type_id;
+    ddspipe::core::types::DdsTopic pipe_topic;
+    get_dynamic_type(1, dynamic_type, type_id, pipe_topic);
+    handler_->add_schema(dynamic_type, type_id);
+
+    static constexpr int SLOW_CALLBACK_MS = 50;
+    static std::atomic<bool> slow{true};
+    static std::mutex mtx;
+    static std::condition_variable cv;
+    static std::vector<std::thread::id> callback_threads;
+    handler_->set_data_notification_callback([](const char*, const char*, int64_t)
+            {
+                if (slow.load())
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(SLOW_CALLBACK_MS));
+                }
+                std::lock_guard<std::mutex> lock(mtx);
+                callback_threads.push_back(std::this_thread::get_id());
+                cv.notify_all();
+            });
+
+    // Each sample is received once the callback of the previous one has been invoked
+    auto add_sample = [&]()
+            {
+                auto data = std::make_unique<eprosima::ddspipe::core::types::RtpsPayloadData>();
+                payload_pool_->get_payload(1000, data->payload);
+                data->payload_owner = payload_pool_.get();
+                get_data_payload(1, data->payload);
+
+                std::unique_lock<std::mutex> lock(mtx);
+                const std::size_t callbacks = callback_threads.size();
+                lock.unlock();
+                ASSERT_NO_THROW(handler_->add_data(pipe_topic, *data));
+                lock.lock();
+                ASSERT_TRUE(cv.wait_for(lock, std::chrono::seconds(5), [&]()
+                        {
+                            return callback_threads.size() > callbacks;
+                        }));
+            };
+
+    for (uint32_t i = 0; i < handler_config.callback_offload_threshold; ++i)
+    {
+        add_sample();
+    }
+
+    // The callback is fast again: the topic is restored once enough callbacks have been delivered from the
+    // dedicated thread within budget and none of its samples is pending there
+    slow.store(false);
+    constexpr uint32_t MAX_SAMPLES = 100;
+    std::size_t restored_at = 0;
+    for (uint32_t i = 0; i < MAX_SAMPLES && restored_at == 0; ++i)
+    {
+        add_sample();
+        std::lock_guard<std::mutex> lock(mtx);
+        if (callback_threads.back() == std::this_thread::get_id())
+        {
+            restored_at = callback_threads.size() - 1;
+        }
+    }
+    ASSERT_GE(restored_at, 2u * handler_config.callback_offload_threshold);
+
+    // Samples keep being delivered from the receiving thread once restored
+    constexpr uint32_t N_RESTORED_SAMPLES = 3;
+    for (uint32_t i = 0; i < N_RESTORED_SAMPLES; ++i)
+    {
+        add_sample();
+    }
+
+    std::lock_guard<std::mutex> lock(mtx);
+    for (std::size_t i = 0; i < callback_threads.size(); ++i)
+    {
+        ASSERT_EQ(callback_threads[i] == std::this_thread::get_id(),
+                i < handler_config.callback_offload_threshold || i >= restored_at);
+    }
+}
+
+TEST(DdsEnablerParticipantsTest, ddsenabler_participants_callback_watchdog_order)
+{
+    auto payload_pool_ = std::make_shared<ddspipe::core::FastPayloadPool>();
+
+    // Samples are delivered from a dedicated thread after two consecutive overruns
+    participants::HandlerConfiguration handler_config;
+    handler_config.callback_budget_ms = 20;
+    handler_config.callback_offload_threshold = 2;
+    auto handler_ = std::make_shared<HandlerTest>(handler_config, payload_pool_);
+
+    DynamicType::_ref_type dynamic_type;
+    xtypes::TypeIdentifier type_id;
+    ddspipe::core::types::DdsTopic pipe_topic;
+    get_dynamic_type(1, dynamic_type, type_id, pipe_topic);
+    handler_->add_schema(dynamic_type, type_id);
+
+    static constexpr int SLOW_CALLBACK_MS = 50;
+    static std::mutex mtx;
+    static std::condition_variable cv;
+    static std::vector<std::pair<int64_t, std::thread::id>> callbacks;
+    static std::atomic<int> running{0};
+    static std::atomic<bool> concurrent{false};
+    handler_->set_data_notification_callback([](const char*, const char*, int64_t publish_time)
+            {
+                if (++running > 1)
+                {
+                    concurrent = true;
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(SLOW_CALLBACK_MS));
+                {
+                    std::lock_guard<std::mutex> lock(mtx);
+                    callbacks.emplace_back(publish_time, std::this_thread::get_id());
+                    cv.notify_all();
+                }
+                --running;
+            });
+
+    static bool offloaded = false;
+    handler_->set_slow_callback_notification_callback([](const char*, const char*, int64_t, bool is_offloaded)
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                offloaded = offloaded || is_offloaded;
+                cv.notify_all();
+            });
+
+    // The publish time of each sample is its (1-based) index
+    auto add_sample = [&](uint32_t index)
+            {
+                auto data = std::make_unique<eprosima::ddspipe::core::types::RtpsPayloadData>();
+                payload_pool_->get_payload(1000, data->payload);
+                data->payload_owner = payload_pool_.get();
+                get_data_payload(1, data->payload);
+                data->source_timestamp = ddspipe::core::types::DataTime(static_cast<int32_t>(index), 0);
+                ASSERT_NO_THROW(handler_->add_data(pipe_topic, *data));
+            };
+
+    // The first sample is delivered by the delivering thread, which keeps delivering the ones queued meanwhile
+    std::thread::id delivering_thread;
+    std::thread delivering([&]()
+            {
+                delivering_thread = std::this_thread::get_id();
+                add_sample(1);
+            });
+
+    constexpr uint32_t N_QUEUED_SAMPLES = 5;
+    constexpr uint32_t N_SAMPLES = 10;
+    while (running.load() == 0)
+    {
+        std::this_thread::yield();
+    }
+    for (uint32_t i = 2; i <= N_QUEUED_SAMPLES; ++i)
+    {
+        add_sample(i);
+    }
+
+    // Samples received once the topic is offloaded, while the previous ones are still queued, are delivered after
+    // them
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        ASSERT_TRUE(cv.wait_for(lock, std::chrono::seconds(5), []()
+                {
+                    return offloaded;
+                }));
+        ASSERT_LT(callbacks.size(), N_QUEUED_SAMPLES);
+    }
+    for (uint32_t i = N_QUEUED_SAMPLES + 1; i <= N_SAMPLES; ++i)
+    {
+        add_sample(i);
+    }
+
+    delivering.join();
+    std::unique_lock<std::mutex> lock(mtx);
+    ASSERT_TRUE(cv.wait_for(lock, std::chrono::seconds(5), []()
+            {
+                return callbacks.size() == N_SAMPLES;
+            }));
+
+    ASSERT_FALSE(concurrent.load());
+    for (uint32_t i = 0; i < N_SAMPLES; ++i)
+    {
+        ASSERT_EQ(callbacks[i].first, static_cast<int64_t>(i + 1) * 1000000000);
+        ASSERT_EQ(callbacks[i].second == delivering_thread, i < N_QUEUED_SAMPLES);
+    }
+}
+
+TEST(DdsEnablerParticipantsTest, ddsenabler_participants_metrics)
+{
+    auto payload_pool_ = std::make_shared<ddspipe::core::FastPayloadPool>();
+
+    participants::HandlerConfiguration handler_config;
+    auto handler_ = std::make_shared<HandlerTest>(handler_config, payload_pool_);
+
+    DynamicType::_ref_type dynamic_type;
+    xtypes::TypeIdentifier type_id;
+    ddspipe::core::types::DdsTopic known_topic;
+    get_dynamic_type(1, dynamic_type, type_id, known_topic);
+    handler_->add_schema(dynamic_type, type_id);
+
+    // The schema of the second topic is never received, so its samples are dropped
+    ddspipe::core::types::DdsTopic unknown_topic;
+    get_dynamic_type(2, dynamic_type, type_id, unknown_topic);
+
+    auto add_sample = [&](
+        int num_type,
+        const ddspipe::core::types::DdsTopic& topic)
+            {
+                auto data = std::make_unique<eprosima::ddspipe::core::types::RtpsPayloadData>();
+                payload_pool_->get_payload(1000, data->payload);
+                data->payload_owner = payload_pool_.get();
+                get_data_payload(num_type, data->payload);
+                ddspipe::core::types::DataTime::now(data->source_timestamp);
+                EXPECT_NO_THROW(handler_->add_data(topic, *data));
+                return data->payload.length;
+            };
+
+    constexpr uint32_t N_SAMPLES = 3;
+    uint64_t bytes_in = 0;
+    for (uint32_t i = 0; i < N_SAMPLES; ++i)
+    {
+        bytes_in += add_sample(1, known_topic);
+    }
+    add_sample(2, unknown_topic);
+
+    // Samples published from the user's app are counted too
+    participants::EntityMetrics& published = handler_->entity_metrics("published_topic");
+    published.published++;
+    published.bytes_out += 100;
+
+    const auto report = handler_->get_metrics();
+    ASSERT_EQ(report.entities.size(), 3u);
+
+    auto find = [&report](const std::string& name) -> const participants::EntityMetricsSnapshot*
+            {
+                for (const auto& entity : report.entities)
+                {
+                    if (entity.name == name)
+                    {
+                        return &entity;
+                    }
+                }
+                return nullptr;
+            };
+
+    const auto* known = find(known_topic.m_topic_name);
+    ASSERT_NE(known, nullptr);
+    ASSERT_EQ(known->kind, participants::MetricsEntityKind::TOPIC);
+    ASSERT_EQ(known->received, N_SAMPLES);
+    ASSERT_EQ(known->converted, N_SAMPLES);
+    ASSERT_EQ(known->delivered, N_SAMPLES);
+    ASSERT_EQ(known->filtered, 0u);
+    ASSERT_EQ(known->dropped, 0u);
+    ASSERT_EQ(known->bytes_in, bytes_in);
+    ASSERT_EQ(known->conversion_time.count, N_SAMPLES);
+    ASSERT_EQ(known->callback_time.count, N_SAMPLES);
+    ASSERT_EQ(known->latency.count, N_SAMPLES);
+    ASSERT_GT(known->latency.max_ns, 0u);
+
+    const auto* unknown = find(unknown_topic.m_topic_name);
+    ASSERT_NE(unknown, nullptr);
+    ASSERT_EQ(unknown->received, 1u);
+    ASSERT_EQ(unknown->converted, 0u);
+    ASSERT_EQ(unknown->delivered, 0u);
+    ASSERT_EQ(unknown->dropped, 1u);
+
+    const auto* publisher = find("published_topic");
+    ASSERT_NE(publisher, nullptr);
+    ASSERT_EQ(publisher->received, 0u);
+    ASSERT_EQ(publisher->published, 1u);
+    ASSERT_EQ(publisher->bytes_out, 100u);
+}
+
+TEST(DdsEnablerParticipantsTest, ddsenabler_participants_metrics_export)
+{
+    auto payload_pool_ = std::make_shared<participants::MeteredPayloadPool>();
+
+    participants::HandlerConfiguration handler_config;
+    auto handler_ = std::make_shared<HandlerTest>(handler_config, payload_pool_);
+
+    DynamicType::_ref_type dynamic_type;
+    xtypes::TypeIdentifier type_id;
+    ddspipe::core::types::DdsTopic topic;
+    get_dynamic_type(1, dynamic_type, type_id, topic);
+    handler_->add_schema(dynamic_type, type_id);
+
+    // The payload pool reports the payloads held
+    auto data = std::make_unique<eprosima::ddspipe::core::types::RtpsPayloadData>();
+    payload_pool_->get_payload(1000, data->payload);
+    data->payload_owner = payload_pool_.get();
+    get_data_payload(1, data->payload);
+    handler_->add_data(topic, *data);
+    ASSERT_EQ(payload_pool_->stats().in_use, 1u);
+    ASSERT_EQ(payload_pool_->stats().reserved_total, 1u);
+    ASSERT_EQ(payload_pool_->stats().reserved_bytes_total, 1000u);
+    data.reset();
+    ASSERT_EQ(payload_pool_->stats().in_use, 0u);
+    ASSERT_EQ(payload_pool_->stats().reserved_total, 1u);
+
+    auto source = [&]()
+            {
+                participants::MetricsReport report = handler_->get_metrics();
+                report.payload_pool = payload_pool_->stats();
+                return report;
+            };
+
+    // Prometheus text format
+    const std::string prometheus = participants::metrics_to_prometheus(source());
+    const std::string labels = "kind=\"topic\",entity=\"" + topic.m_topic_name + "\"";
+    ASSERT_NE(prometheus.find("# TYPE ddsenabler_received_total counter"), std::string::npos);
+    ASSERT_NE(prometheus.find("ddsenabler_received_total{" + labels + "} 1\n"), std::string::npos);
+    ASSERT_NE(prometheus.find("# TYPE ddsenabler_callback_seconds histogram"), std::string::npos);
+    ASSERT_NE(prometheus.find("ddsenabler_callback_seconds_bucket{" + labels + ",le=\"+Inf\"} 1\n"),
+            std::string::npos);
+    ASSERT_NE(prometheus.find("ddsenabler_callback_seconds_count{" + labels + "} 1\n"), std::string::npos);
+    ASSERT_NE(prometheus.find("ddsenabler_payload_pool_reserved_bytes_total 1000\n"), std::string::npos);
+
+    // Periodic CSV dumps, rotated once the file exceeds its maximum size
+    const std::string file_path =
+            (std::filesystem::temp_directory_path() / "ddsenabler_participants_metrics.csv").string();
+    for (const auto& path : {file_path, file_path + ".1", file_path + ".2"})
+    {
+        std::filesystem::remove(path);
+    }
+
+    participants::MetricsExportConfiguration export_config;
+    export_config.file_path = file_path;
+    export_config.file_format = participants::MetricsFileFormat::CSV;
+    export_config.file_period_ms = 50;
+    export_config.file_max_size = 1;
+    export_config.file_max_files = 1;
+    {
+        participants::MetricsExporter exporter(export_config, source);
+        std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    }
+
+    ASSERT_TRUE(std::filesystem::exists(file_path));
+    ASSERT_TRUE(std::filesystem::exists(file_path + ".1"));
+    ASSERT_FALSE(std::filesystem::exists(file_path + ".2"));
+
+    std::ifstream file(file_path);
+    std::string header;
+    std::string row;
+    std::getline(file, header);
+    std::getline(file, row);
+    ASSERT_EQ(header, participants::metrics_csv_header());
+    ASSERT_NE(row.find(",topic," + topic.m_topic_name + ",1,1,1,"), std::string::npos);
+
+    for (const auto& path : {file_path, file_path + ".1"})
+    {
+        std::filesystem::remove(path);
+    }
+
+#ifndef _WIN32
+    // A file other than a socket at the socket path is never removed
+    const std::string socket_path =
+            (std::filesystem::temp_directory_path() / "ddsenabler_participants_metrics.sock").string();
+    {
+        std::ofstream not_a_socket(socket_path);
+        not_a_socket << "not a socket";
+    }
+    participants::MetricsExportConfiguration socket_config;
+    socket_config.prometheus_unix_socket = socket_path;
+    {
+        participants::MetricsExporter exporter(socket_config, source);
+    }
+    ASSERT_TRUE(std::filesystem::is_regular_file(socket_path));
+    std::filesystem::remove(socket_path);
+#endif // ifndef _WIN32
+}
+
+TEST(DdsEnablerParticipantsTest, ddsenabler_participants_tracing)
+{
+    const std::string file_path =
+            (std::filesystem::temp_directory_path() / "ddsenabler_participants_trace.json").string();
+    std::filesystem::remove(file_path);
+
+    auto payload_pool_ = std::make_shared<ddspipe::core::FastPayloadPool>();
+
+    participants::HandlerConfiguration handler_config;
+    handler_config.tracing.file_path = file_path;
+    handler_config.tracing.sampling_period = 2;
+    {
+        auto handler_ = std::make_shared<HandlerTest>(handler_config, payload_pool_);
+        ASSERT_NE(handler_->tracer(), nullptr);
+
+        DynamicType::_ref_type dynamic_type;
+        xtypes::TypeIdentifier type_id;
+        ddspipe::core::types::DdsTopic topic;
+        get_dynamic_type(1, dynamic_type, type_id, topic);
+        handler_->add_schema(dynamic_type, type_id);
+
+        // One of every two samples is traced
+        constexpr uint32_t N_SAMPLES = 4;
+        for (uint32_t i = 0; i < N_SAMPLES; ++i)
+        {
+            auto data = std::make_unique<eprosima::ddspipe::core::types::RtpsPayloadData>();
+            payload_pool_->get_payload(1000, data->payload);
+            data->payload_owner = payload_pool_.get();
+            get_data_payload(1, data->payload);
+            ddspipe::core::types::DataTime::now(data->source_timestamp);
+            ASSERT_NO_THROW(handler_->add_data(topic, *data));
+        }
+
+        // Spans of samples not traced are not recorded
+        participants::TraceSpan untraced(handler_->tracer(), 0, participants::SpanKind::PUBLISH);
+        ASSERT_EQ(untraced.trace_id(), 0u);
+    }
+
+    // The trace file is closed by the handler, as a JSON array of Chrome trace events
+    std::ifstream file(file_path);
+    nlohmann::json trace;
+    ASSERT_NO_THROW(trace = nlohmann::json::parse(file));
+    ASSERT_TRUE(trace.is_array());
+
+    std::map<std::string, std::set<uint64_t>> traces_by_span;
+    for (const auto& event : trace)
+    {
+        if (event["ph"] != "X")
+        {
+            continue;
+        }
+        ASSERT_GE(event["dur"].get<double>(), 0.0);
+        traces_by_span[event["name"].get<std::string>()].insert(event["args"]["trace"].get<uint64_t>());
+    }
+
+    const std::set<uint64_t> traced_samples = {1, 2};
+    for (const auto& span : {"receive", "add_data", "decode", "encode", "queue", "callback"})
+    {
+        ASSERT_EQ(traces_by_span[span], traced_samples) << span;
+    }
+    ASSERT_EQ(traces_by_span.count("publish"), 0u);
+
+    std::filesystem::remove(file_path);
+}
+
+TEST(DdsEnablerParticipantsTest, ddsenabler_participants_lock_metrics)
+{
+    participants::MeteredMutex<BlockingReportMutex> mutex("test_lock");
+    participants::MeteredMutex<std::recursive_mutex> recursive_mutex("test_recursive_lock");
+
+    // The second acquisition waits for the lock, which is only released once the waiter is blocked on it
+    std::unique_lock<participants::MeteredMutex<BlockingReportMutex>> lock(mutex);
+    std::thread waiter([&mutex]()
+            {
+                std::lock_guard<participants::MeteredMutex<BlockingReportMutex>> waiter_lock(mutex);
+            });
+    while (!BlockingReportMutex::blocking.load())
+    {
+        std::this_thread::yield();
+    }
+    lock.unlock();
+    waiter.join();
+
+    // Nested acquisitions of recursive locks are not counted
+    {
+        std::lock_guard<participants::MeteredMutex<std::recursive_mutex>> outer(recursive_mutex);
+        std::lock_guard<participants::MeteredMutex<std::recursive_mutex>> inner(recursive_mutex);
+    }
+
+    auto payload_pool_ = std::make_shared<ddspipe::core::FastPayloadPool>();
+    participants::HandlerConfiguration handler_config;
+    auto handler_ = std::make_shared<HandlerTest>(handler_config, payload_pool_);
+
+    DynamicType::_ref_type dynamic_type;
+    xtypes::TypeIdentifier type_id;
+    ddspipe::core::types::DdsTopic topic;
+    get_dynamic_type(1, dynamic_type, type_id, topic);
+    handler_->add_schema(dynamic_type, type_id);
+
+    const auto locks = handler_->get_metrics().locks;
+
+#if defined(DDSENABLER_LOCK_METRICS)
+    auto find = [&locks](const std::string& name) -> const participants::LockMetricsSnapshot*
+            {
+                for (const auto& lock : locks)
+                {
+                    if (lock.name == name)
+                    {
+                        return &lock;
+                    }
+                }
+                return nullptr;
+            };
+
+    const auto* test_lock = find("test_lock");
+    ASSERT_NE(test_lock, nullptr);
+    ASSERT_EQ(test_lock->acquisitions, 2u);
+    ASSERT_EQ(test_lock->contended, 1u);
+    ASSERT_GT(test_lock->wait_time.max_ns, 0u);
+    ASSERT_EQ(test_lock->hold_time.count, 2u);
+    ASSERT_GT(test_lock->hold_time.max_ns, 0u);
+
+    const auto* test_recursive_lock = find("test_recursive_lock");
+    ASSERT_NE(test_recursive_lock, nullptr);
+    ASSERT_EQ(test_recursive_lock->acquisitions, 1u);
+    ASSERT_EQ(test_recursive_lock->contended, 0u);
+
+    const auto* handler_lock = find("handler");
+    ASSERT_NE(handler_lock, nullptr);
+    ASSERT_GT(handler_lock->acquisitions, 0u);
+
+    // Locks are exported along with the rest of metrics
+    participants::MetricsReport report;
+    report.locks = locks;
+    ASSERT_NE(participants::metrics_to_prometheus(report).find(
+                "ddsenabler_lock_contended_total{lock=\"test_lock\"} 1\n"), std::string::npos);
+    ASSERT_EQ(nlohmann::json::parse(participants::metrics_to_json(report))["locks"].size(), locks.size());
+#else
+    // Without lock metrics nothing is recorded
+    ASSERT_TRUE(locks.empty());
+#endif // if defined(DDSENABLER_LOCK_METRICS)
+}
+
 int main(
         int argc,
         char** argv)
@@ -30,6 +30,9 @@
 #include <ddspipe_participants/configuration/SimpleParticipantConfiguration.hpp>
 
 #include <ddsenabler_participants/EnablerParticipantConfiguration.hpp>
+#include <ddsenabler_participants/HandlerConfiguration.hpp>
+#include <ddsenabler_participants/MetricsExporter.hpp>
+#include <ddsenabler_participants/ThreadPlacement.hpp>
 
 #include <ddspipe_yaml/Yaml.hpp>
 #include <ddspipe_yaml/YamlReader.hpp>
@@ -70,8 +73,17 @@ public:
     std::shared_ptr<ddspipe::participants::SimpleParticipantConfiguration> simple_configuration;
     std::shared_ptr<ddsenabler::participants::EnablerParticipantConfiguration> enabler_configuration;
 
+    // Handler configuration
+    ddsenabler::participants::HandlerConfiguration handler_configuration;
+
     unsigned int n_threads = DEFAULT_N_THREADS;
 
+    // Placement of the threads created by the enabler
+    ddsenabler::participants::ThreadPlacementConfiguration thread_placement;
+
+    // Export of the enabler metrics
+    ddsenabler::participants::MetricsExportConfiguration metrics_export;
+
     ddspipe::core::types::TopicQoS topic_qos{};
 
 protected:
@@ -83,10 +95,30 @@ protected:
             const Yaml& yml,
             const ddspipe::yaml::YamlReaderVersion& version);
 
+    void load_priority_classes_configuration_(
+            const Yaml& yml,
+            const ddspipe::yaml::YamlReaderVersion& version);
+
+    void load_warm_up_configuration_(
+            const Yaml& yml,
+            const ddspipe::yaml::YamlReaderVersion& version);
+
     void load_specs_configuration_(
             const Yaml& yml,
             const ddspipe::yaml::YamlReaderVersion& version);
 
+    void load_thread_placement_configuration_(
+            const Yaml& yml,
+            const ddspipe::yaml::YamlReaderVersion& version);
+
+    void load_metrics_export_configuration_(
+            const Yaml& yml,
+            const ddspipe::yaml::YamlReaderVersion& version);
+
+    void load_tracing_configuration_(
+            const Yaml& yml,
+            const ddspipe::yaml::YamlReaderVersion& version);
+
     void load_dds_configuration_(
             const Yaml& yml,
             const ddspipe::yaml::YamlReaderVersion& version);
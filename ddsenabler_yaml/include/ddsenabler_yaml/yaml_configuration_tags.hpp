@@ -28,6 +28,71 @@ namespace yaml {
 constexpr const char* ENABLER_DDS_TAG("dds");
 constexpr const char* ENABLER_ENABLER_TAG("ddsenabler");
 constexpr const char* ENABLER_INITIAL_PUBLISH_WAIT_TAG("initial-publish-wait");
+constexpr const char* ENABLER_LAZY_TYPE_NOTIFICATION_TAG("lazy-type-notification");
+constexpr const char* ENABLER_INCREMENTAL_TYPE_COLLECTIONS_TAG("incremental-type-collections");
+constexpr const char* ENABLER_COMPACT_QOS_TAG("compact-qos");
+constexpr const char* ENABLER_TYPE_STORE_TAG("type-store");
+constexpr const char* ENABLER_PRELOAD_TYPES_TAG("preload-types");
+constexpr const char* ENABLER_TYPE_BUNDLE_TAG("type-bundle");
+constexpr const char* ENABLER_DISCOVERY_BATCH_WINDOW_TAG("discovery-batch-window");
+
+constexpr const char* ENABLER_SCHEMA_CACHE_TAG("schema-cache");
+constexpr const char* ENABLER_SCHEMA_CACHE_MAX_TYPES_TAG("max-types");
+constexpr const char* ENABLER_SCHEMA_CACHE_MAX_BYTES_TAG("max-bytes");
+
+constexpr const char* ENABLER_DISCOVERY_SNAPSHOT_TAG("discovery-snapshot");
+constexpr const char* ENABLER_DISCOVERY_SNAPSHOT_PATH_TAG("path");
+constexpr const char* ENABLER_DISCOVERY_SNAPSHOT_PERIOD_TAG("period");
+
+constexpr const char* ENABLER_PRIORITY_CLASSES_TAG("priority-classes");
+constexpr const char* ENABLER_PRIORITY_SCHEDULING_TAG("scheduling");
+constexpr const char* ENABLER_PRIORITY_SCHEDULING_STRICT("strict");
+constexpr const char* ENABLER_PRIORITY_SCHEDULING_WEIGHTED("weighted");
+constexpr const char* ENABLER_PRIORITY_CLASSES_LIST_TAG("classes");
+constexpr const char* ENABLER_PRIORITY_CLASS_NAME_TAG("name");
+constexpr const char* ENABLER_PRIORITY_CLASS_TOPICS_TAG("topics");
+constexpr const char* ENABLER_PRIORITY_CLASS_WEIGHT_TAG("weight");
+constexpr const char* ENABLER_PRIORITY_CLASS_QUEUE_SIZE_TAG("queue-size");
+
+constexpr const char* ENABLER_CALLBACK_BUDGET_TAG("callback-budget");
+constexpr const char* ENABLER_CALLBACK_BUDGET_DURATION_TAG("duration");
+constexpr const char* ENABLER_CALLBACK_BUDGET_OFFLOAD_AFTER_TAG("offload-after");
+
+constexpr const char* ENABLER_WARM_UP_TAG("warm-up");
+constexpr const char* ENABLER_WARM_UP_MAX_CONCURRENCY_TAG("max-concurrency");
+constexpr const char* ENABLER_WARM_UP_TOPICS_TAG("topics");
+constexpr const char* ENABLER_WARM_UP_SERVICES_TAG("services");
+constexpr const char* ENABLER_WARM_UP_ACTIONS_TAG("actions");
+constexpr const char* ENABLER_WARM_UP_NAME_TAG("name");
+constexpr const char* ENABLER_WARM_UP_TYPE_TAG("type");
+constexpr const char* ENABLER_WARM_UP_PROTOCOL_TAG("protocol");
+constexpr const char* ENABLER_WARM_UP_PROTOCOL_ROS2("ros2");
+constexpr const char* ENABLER_WARM_UP_PROTOCOL_DDS("dds");
+
+constexpr const char* ENABLER_THREAD_PLACEMENT_TAG("thread-placement");
+constexpr const char* ENABLER_THREAD_PLACEMENT_NUMA_NODE_TAG("numa-node");
+constexpr const char* ENABLER_THREAD_PLACEMENT_WORKERS_TAG("workers");
+constexpr const char* ENABLER_THREAD_PLACEMENT_DISPATCHERS_TAG("dispatchers");
+constexpr const char* ENABLER_THREAD_PLACEMENT_FILE_WATCHER_TAG("file-watcher");
+
+constexpr const char* ENABLER_METRICS_EXPORT_TAG("metrics-export");
+constexpr const char* ENABLER_METRICS_EXPORT_PROMETHEUS_TAG("prometheus");
+constexpr const char* ENABLER_METRICS_EXPORT_PORT_TAG("port");
+constexpr const char* ENABLER_METRICS_EXPORT_UNIX_SOCKET_TAG("unix-socket");
+constexpr const char* ENABLER_METRICS_EXPORT_FILE_TAG("file");
+constexpr const char* ENABLER_METRICS_EXPORT_FILE_PATH_TAG("path");
+constexpr const char* ENABLER_METRICS_EXPORT_FILE_FORMAT_TAG("format");
+constexpr const char* ENABLER_METRICS_EXPORT_FILE_FORMAT_JSON("json");
+constexpr const char* ENABLER_METRICS_EXPORT_FILE_FORMAT_CSV("csv");
+constexpr const char* ENABLER_METRICS_EXPORT_FILE_PERIOD_TAG("period");
+constexpr const char* ENABLER_METRICS_EXPORT_FILE_MAX_SIZE_TAG("max-size");
+constexpr const char* ENABLER_METRICS_EXPORT_FILE_MAX_FILES_TAG("max-files");
+
+constexpr const char* ENABLER_TRACING_TAG("tracing");
+constexpr const char* ENABLER_TRACING_PATH_TAG("path");
+constexpr const char* ENABLER_TRACING_SAMPLING_PERIOD_TAG("sampling-period");
+constexpr const char* ENABLER_TRACING_BUFFER_SIZE_TAG("buffer-size");
+constexpr const char* ENABLER_TRACING_FLUSH_PERIOD_TAG("flush-period");
 
 } /* namespace yaml */
 } /* namespace ddsenabler */
@@ -230,6 +230,237 @@ void EnablerConfiguration::load_enabler_configuration_(
         enabler_configuration->initial_publish_wait = YamlReader::get_nonnegative_int(yml,
                         ENABLER_INITIAL_PUBLISH_WAIT_TAG);
     }
+
+    // Get lazy type notification
+    if (YamlReader::is_tag_present(yml, ENABLER_LAZY_TYPE_NOTIFICATION_TAG))
+    {
+        handler_configuration.lazy_type_notification = YamlReader::get<bool>(yml,
+                        ENABLER_LAZY_TYPE_NOTIFICATION_TAG, version);
+    }
+
+    // Get incremental type collections
+    if (YamlReader::is_tag_present(yml, ENABLER_INCREMENTAL_TYPE_COLLECTIONS_TAG))
+    {
+        handler_configuration.incremental_type_collections = YamlReader::get<bool>(yml,
+                        ENABLER_INCREMENTAL_TYPE_COLLECTIONS_TAG, version);
+    }
+
+    // Get whether QoS are notified with the compact encoding
+    if (YamlReader::is_tag_present(yml, ENABLER_COMPACT_QOS_TAG))
+    {
+        handler_configuration.compact_qos = YamlReader::get<bool>(yml, ENABLER_COMPACT_QOS_TAG, version);
+    }
+
+    // Get type store path
+    if (YamlReader::is_tag_present(yml, ENABLER_TYPE_STORE_TAG))
+    {
+        handler_configuration.type_store_path = YamlReader::get<std::string>(yml, ENABLER_TYPE_STORE_TAG, version);
+    }
+
+    // Get directory of types to preload
+    if (YamlReader::is_tag_present(yml, ENABLER_PRELOAD_TYPES_TAG))
+    {
+        handler_configuration.preload_types_path = YamlReader::get<std::string>(yml, ENABLER_PRELOAD_TYPES_TAG,
+                        version);
+    }
+
+    // Get type bundle path
+    if (YamlReader::is_tag_present(yml, ENABLER_TYPE_BUNDLE_TAG))
+    {
+        handler_configuration.type_bundle_path = YamlReader::get<std::string>(yml, ENABLER_TYPE_BUNDLE_TAG, version);
+    }
+
+    // Get discovery batch window
+    if (YamlReader::is_tag_present(yml, ENABLER_DISCOVERY_BATCH_WINDOW_TAG))
+    {
+        handler_configuration.discovery_batch_window_ms = YamlReader::get_nonnegative_int(yml,
+                        ENABLER_DISCOVERY_BATCH_WINDOW_TAG);
+    }
+
+    // Get optional schema cache bounds
+    if (YamlReader::is_tag_present(yml, ENABLER_SCHEMA_CACHE_TAG))
+    {
+        auto schema_cache_yml = YamlReader::get_value_in_tag(yml, ENABLER_SCHEMA_CACHE_TAG);
+        if (YamlReader::is_tag_present(schema_cache_yml, ENABLER_SCHEMA_CACHE_MAX_TYPES_TAG))
+        {
+            handler_configuration.schema_cache_max_types = YamlReader::get_positive_int(schema_cache_yml,
+                            ENABLER_SCHEMA_CACHE_MAX_TYPES_TAG);
+        }
+        if (YamlReader::is_tag_present(schema_cache_yml, ENABLER_SCHEMA_CACHE_MAX_BYTES_TAG))
+        {
+            handler_configuration.schema_cache_max_bytes = YamlReader::get_positive_int(schema_cache_yml,
+                            ENABLER_SCHEMA_CACHE_MAX_BYTES_TAG);
+        }
+    }
+
+    // Get optional discovery snapshot configuration
+    if (YamlReader::is_tag_present(yml, ENABLER_DISCOVERY_SNAPSHOT_TAG))
+    {
+        auto snapshot_yml = YamlReader::get_value_in_tag(yml, ENABLER_DISCOVERY_SNAPSHOT_TAG);
+        enabler_configuration->discovery_snapshot_path = YamlReader::get<std::string>(snapshot_yml,
+                        ENABLER_DISCOVERY_SNAPSHOT_PATH_TAG, version);
+        if (YamlReader::is_tag_present(snapshot_yml, ENABLER_DISCOVERY_SNAPSHOT_PERIOD_TAG))
+        {
+            enabler_configuration->discovery_snapshot_period = YamlReader::get_nonnegative_int(snapshot_yml,
+                            ENABLER_DISCOVERY_SNAPSHOT_PERIOD_TAG);
+        }
+    }
+
+    // Get optional priority classes
+    if (YamlReader::is_tag_present(yml, ENABLER_PRIORITY_CLASSES_TAG))
+    {
+        auto priority_yml = YamlReader::get_value_in_tag(yml, ENABLER_PRIORITY_CLASSES_TAG);
+        load_priority_classes_configuration_(priority_yml, version);
+    }
+
+    // Get optional callback budget
+    if (YamlReader::is_tag_present(yml, ENABLER_CALLBACK_BUDGET_TAG))
+    {
+        auto budget_yml = YamlReader::get_value_in_tag(yml, ENABLER_CALLBACK_BUDGET_TAG);
+        handler_configuration.callback_budget_ms = YamlReader::get_positive_int(budget_yml,
+                        ENABLER_CALLBACK_BUDGET_DURATION_TAG);
+        if (YamlReader::is_tag_present(budget_yml, ENABLER_CALLBACK_BUDGET_OFFLOAD_AFTER_TAG))
+        {
+            handler_configuration.callback_offload_threshold = YamlReader::get_nonnegative_int(budget_yml,
+                            ENABLER_CALLBACK_BUDGET_OFFLOAD_AFTER_TAG);
+        }
+    }
+
+    // Get optional warm-up configuration
+    if (YamlReader::is_tag_present(yml, ENABLER_WARM_UP_TAG))
+    {
+        auto warm_up_yml = YamlReader::get_value_in_tag(yml, ENABLER_WARM_UP_TAG);
+        load_warm_up_configuration_(warm_up_yml, version);
+    }
+}
+
+void EnablerConfiguration::load_priority_classes_configuration_(
+        const Yaml& yml,
+        const YamlReaderVersion& version)
+{
+    // Get scheduling policy
+    if (YamlReader::is_tag_present(yml, ENABLER_PRIORITY_SCHEDULING_TAG))
+    {
+        auto scheduling = YamlReader::get<std::string>(yml, ENABLER_PRIORITY_SCHEDULING_TAG, version);
+        if (scheduling == ENABLER_PRIORITY_SCHEDULING_STRICT)
+        {
+            handler_configuration.priority_scheduling = participants::PriorityScheduling::STRICT;
+        }
+        else if (scheduling == ENABLER_PRIORITY_SCHEDULING_WEIGHTED)
+        {
+            handler_configuration.priority_scheduling = participants::PriorityScheduling::WEIGHTED;
+        }
+        else
+        {
+            throw eprosima::utils::ConfigurationException(
+                      utils::Formatter() << "Unknown priority scheduling " << scheduling << ", expected "
+                                         << ENABLER_PRIORITY_SCHEDULING_STRICT << " or "
+                                         << ENABLER_PRIORITY_SCHEDULING_WEIGHTED << ".");
+        }
+    }
+
+    // Get classes, from highest to lowest priority
+    auto classes_yml = YamlReader::get_value_in_tag(yml, ENABLER_PRIORITY_CLASSES_LIST_TAG);
+    if (!classes_yml.IsSequence())
+    {
+        throw eprosima::utils::ConfigurationException(
+                  utils::Formatter() << "Priority " << ENABLER_PRIORITY_CLASSES_LIST_TAG << " must be a list.");
+    }
+    for (const auto& class_yml : classes_yml)
+    {
+        participants::PriorityClass priority_class;
+        priority_class.name = YamlReader::get<std::string>(class_yml, ENABLER_PRIORITY_CLASS_NAME_TAG, version);
+        priority_class.topics = YamlReader::get_list<std::string>(class_yml, ENABLER_PRIORITY_CLASS_TOPICS_TAG,
+                        version);
+        if (YamlReader::is_tag_present(class_yml, ENABLER_PRIORITY_CLASS_WEIGHT_TAG))
+        {
+            priority_class.weight = YamlReader::get_positive_int(class_yml, ENABLER_PRIORITY_CLASS_WEIGHT_TAG);
+        }
+        if (YamlReader::is_tag_present(class_yml, ENABLER_PRIORITY_CLASS_QUEUE_SIZE_TAG))
+        {
+            priority_class.queue_size = YamlReader::get_nonnegative_int(class_yml,
+                            ENABLER_PRIORITY_CLASS_QUEUE_SIZE_TAG);
+        }
+        handler_configuration.priority_classes.push_back(priority_class);
+    }
+}
+
+void EnablerConfiguration::load_warm_up_configuration_(
+        const Yaml& yml,
+        const YamlReaderVersion& version)
+{
+    // Get maximum number of entities created concurrently
+    if (YamlReader::is_tag_present(yml, ENABLER_WARM_UP_MAX_CONCURRENCY_TAG))
+    {
+        enabler_configuration->warm_up_max_concurrency = YamlReader::get_positive_int(yml,
+                        ENABLER_WARM_UP_MAX_CONCURRENCY_TAG);
+    }
+
+    // Get topics
+    if (YamlReader::is_tag_present(yml, ENABLER_WARM_UP_TOPICS_TAG))
+    {
+        auto topics_yml = YamlReader::get_value_in_tag(yml, ENABLER_WARM_UP_TOPICS_TAG);
+        if (!topics_yml.IsSequence())
+        {
+            throw eprosima::utils::ConfigurationException(
+                      utils::Formatter() << "Warm-up " << ENABLER_WARM_UP_TOPICS_TAG << " must be a list.");
+        }
+        for (const auto& topic_yml : topics_yml)
+        {
+            participants::WarmUpTopic topic;
+            topic.name = YamlReader::get<std::string>(topic_yml, ENABLER_WARM_UP_NAME_TAG, version);
+            if (YamlReader::is_tag_present(topic_yml, ENABLER_WARM_UP_TYPE_TAG))
+            {
+                topic.type_name = YamlReader::get<std::string>(topic_yml, ENABLER_WARM_UP_TYPE_TAG, version);
+            }
+            enabler_configuration->warm_up_topics.push_back(topic);
+        }
+    }
+
+    // Get services and actions
+    auto load_rpcs = [&](
+        const char* tag,
+        std::vector<participants::WarmUpRpc>& rpcs)
+            {
+                if (!YamlReader::is_tag_present(yml, tag))
+                {
+                    return;
+                }
+                auto rpcs_yml = YamlReader::get_value_in_tag(yml, tag);
+                if (!rpcs_yml.IsSequence())
+                {
+                    throw eprosima::utils::ConfigurationException(
+                              utils::Formatter() << "Warm-up " << tag << " must be a list.");
+                }
+                for (const auto& rpc_yml : rpcs_yml)
+                {
+                    participants::WarmUpRpc rpc;
+                    rpc.name = YamlReader::get<std::string>(rpc_yml, ENABLER_WARM_UP_NAME_TAG, version);
+                    if (YamlReader::is_tag_present(rpc_yml, ENABLER_WARM_UP_PROTOCOL_TAG))
+                    {
+                        auto protocol = YamlReader::get<std::string>(rpc_yml, ENABLER_WARM_UP_PROTOCOL_TAG, version);
+                        if (protocol == ENABLER_WARM_UP_PROTOCOL_ROS2)
+                        {
+                            rpc.protocol = participants::Protocol::ROS2;
+                        }
+                        else if (protocol == ENABLER_WARM_UP_PROTOCOL_DDS)
+                        {
+                            rpc.protocol = participants::Protocol::DDS;
+                        }
+                        else
+                        {
+                            throw eprosima::utils::ConfigurationException(
+                                      utils::Formatter() << "Unknown RPC protocol " << protocol << " for " << rpc.name
+                                                         << ", expected " << ENABLER_WARM_UP_PROTOCOL_ROS2 << " or "
+                                                         << ENABLER_WARM_UP_PROTOCOL_DDS << ".");
+                        }
+                    }
+                    rpcs.push_back(rpc);
+                }
+            };
+
+    load_rpcs(ENABLER_WARM_UP_SERVICES_TAG, enabler_configuration->warm_up_services);
+    load_rpcs(ENABLER_WARM_UP_ACTIONS_TAG, enabler_configuration->warm_up_actions);
 }
 
 void EnablerConfiguration::load_specs_configuration_(
@@ -242,6 +473,27 @@ void EnablerConfiguration::load_specs_configuration_(
         n_threads = YamlReader::get_positive_int(yml, NUMBER_THREADS_TAG);
     }
 
+    // Get optional thread placement
+    if (YamlReader::is_tag_present(yml, ENABLER_THREAD_PLACEMENT_TAG))
+    {
+        auto placement_yml = YamlReader::get_value_in_tag(yml, ENABLER_THREAD_PLACEMENT_TAG);
+        load_thread_placement_configuration_(placement_yml, version);
+    }
+
+    // Get optional metrics export
+    if (YamlReader::is_tag_present(yml, ENABLER_METRICS_EXPORT_TAG))
+    {
+        auto metrics_yml = YamlReader::get_value_in_tag(yml, ENABLER_METRICS_EXPORT_TAG);
+        load_metrics_export_configuration_(metrics_yml, version);
+    }
+
+    // Get optional tracing
+    if (YamlReader::is_tag_present(yml, ENABLER_TRACING_TAG))
+    {
+        auto tracing_yml = YamlReader::get_value_in_tag(yml, ENABLER_TRACING_TAG);
+        load_tracing_configuration_(tracing_yml, version);
+    }
+
     /////
     // Get optional Log Configuration
     if (YamlReader::is_tag_present(yml, LOG_CONFIGURATION_TAG))
@@ -251,6 +503,135 @@ void EnablerConfiguration::load_specs_configuration_(
     }
 }
 
+void EnablerConfiguration::load_thread_placement_configuration_(
+        const Yaml& yml,
+        const YamlReaderVersion& version)
+{
+    // Threads are only named when a placement is configured
+    thread_placement.workers.name = participants::WORKER_THREAD_NAME;
+    thread_placement.dispatchers.name = participants::DISPATCHER_THREAD_NAME;
+    thread_placement.file_watcher.name = participants::FILE_WATCHER_THREAD_NAME;
+
+    // Get NUMA node
+    if (YamlReader::is_tag_present(yml, ENABLER_THREAD_PLACEMENT_NUMA_NODE_TAG))
+    {
+        thread_placement.numa_node = YamlReader::get_nonnegative_int(yml, ENABLER_THREAD_PLACEMENT_NUMA_NODE_TAG);
+    }
+
+    // Get the CPU set of each group of threads
+    auto load_cpus = [&](
+        const char* tag,
+        participants::ThreadPlacement& placement)
+            {
+                if (!YamlReader::is_tag_present(yml, tag))
+                {
+                    return;
+                }
+                auto cpu_list = YamlReader::get<std::string>(yml, tag, version);
+                if (!participants::parse_cpu_list(cpu_list, placement.cpus))
+                {
+                    throw eprosima::utils::ConfigurationException(
+                              utils::Formatter() << "Invalid CPU list " << cpu_list << " for " << tag
+                                                 << " threads, expected e.g. \"0-3,8\".");
+                }
+            };
+
+    load_cpus(ENABLER_THREAD_PLACEMENT_WORKERS_TAG, thread_placement.workers);
+    load_cpus(ENABLER_THREAD_PLACEMENT_DISPATCHERS_TAG, thread_placement.dispatchers);
+    load_cpus(ENABLER_THREAD_PLACEMENT_FILE_WATCHER_TAG, thread_placement.file_watcher);
+}
+
+void EnablerConfiguration::load_metrics_export_configuration_(
+        const Yaml& yml,
+        const YamlReaderVersion& version)
+{
+    // Get Prometheus endpoints
+    if (YamlReader::is_tag_present(yml, ENABLER_METRICS_EXPORT_PROMETHEUS_TAG))
+    {
+        auto prometheus_yml = YamlReader::get_value_in_tag(yml, ENABLER_METRICS_EXPORT_PROMETHEUS_TAG);
+        if (YamlReader::is_tag_present(prometheus_yml, ENABLER_METRICS_EXPORT_PORT_TAG))
+        {
+            const int port = YamlReader::get_positive_int(prometheus_yml, ENABLER_METRICS_EXPORT_PORT_TAG);
+            if (port > 65535)
+            {
+                throw eprosima::utils::ConfigurationException(
+                          utils::Formatter() << "Invalid metrics " << ENABLER_METRICS_EXPORT_PORT_TAG << " " << port
+                                             << ", expected a value up to 65535.");
+            }
+            metrics_export.prometheus_port = static_cast<uint16_t>(port);
+        }
+        if (YamlReader::is_tag_present(prometheus_yml, ENABLER_METRICS_EXPORT_UNIX_SOCKET_TAG))
+        {
+            metrics_export.prometheus_unix_socket = YamlReader::get<std::string>(prometheus_yml,
+                            ENABLER_METRICS_EXPORT_UNIX_SOCKET_TAG, version);
+        }
+    }
+
+    // Get file dumps
+    if (YamlReader::is_tag_present(yml, ENABLER_METRICS_EXPORT_FILE_TAG))
+    {
+        auto file_yml = YamlReader::get_value_in_tag(yml, ENABLER_METRICS_EXPORT_FILE_TAG);
+        metrics_export.file_path = YamlReader::get<std::string>(file_yml, ENABLER_METRICS_EXPORT_FILE_PATH_TAG,
+                        version);
+        if (YamlReader::is_tag_present(file_yml, ENABLER_METRICS_EXPORT_FILE_FORMAT_TAG))
+        {
+            auto format = YamlReader::get<std::string>(file_yml, ENABLER_METRICS_EXPORT_FILE_FORMAT_TAG, version);
+            if (format == ENABLER_METRICS_EXPORT_FILE_FORMAT_JSON)
+            {
+                metrics_export.file_format = participants::MetricsFileFormat::JSON;
+            }
+            else if (format == ENABLER_METRICS_EXPORT_FILE_FORMAT_CSV)
+            {
+                metrics_export.file_format = participants::MetricsFileFormat::CSV;
+            }
+            else
+            {
+                throw eprosima::utils::ConfigurationException(
+                          utils::Formatter() << "Invalid metrics file format " << format << ", expected "
+                                             << ENABLER_METRICS_EXPORT_FILE_FORMAT_JSON << " or "
+                                             << ENABLER_METRICS_EXPORT_FILE_FORMAT_CSV << ".");
+            }
+        }
+        if (YamlReader::is_tag_present(file_yml, ENABLER_METRICS_EXPORT_FILE_PERIOD_TAG))
+        {
+            metrics_export.file_period_ms = YamlReader::get_positive_int(file_yml,
+                            ENABLER_METRICS_EXPORT_FILE_PERIOD_TAG);
+        }
+        if (YamlReader::is_tag_present(file_yml, ENABLER_METRICS_EXPORT_FILE_MAX_SIZE_TAG))
+        {
+            metrics_export.file_max_size = YamlReader::get_nonnegative_int(file_yml,
+                            ENABLER_METRICS_EXPORT_FILE_MAX_SIZE_TAG);
+        }
+        if (YamlReader::is_tag_present(file_yml, ENABLER_METRICS_EXPORT_FILE_MAX_FILES_TAG))
+        {
+            metrics_export.file_max_files = YamlReader::get_nonnegative_int(file_yml,
+                            ENABLER_METRICS_EXPORT_FILE_MAX_FILES_TAG);
+        }
+    }
+}
+
+void EnablerConfiguration::load_tracing_configuration_(
+        const Yaml& yml,
+        const YamlReaderVersion& version)
+{
+    auto& tracing = handler_configuration.tracing;
+
+    tracing.file_path = YamlReader::get<std::string>(yml, ENABLER_TRACING_PATH_TAG, version);
+
+    if (YamlReader::is_tag_present(yml, ENABLER_TRACING_SAMPLING_PERIOD_TAG))
+    {
+        tracing.sampling_period = YamlReader::get_positive_int(yml, ENABLER_TRACING_SAMPLING_PERIOD_TAG);
+    }
+    if (YamlReader::is_tag_present(yml, ENABLER_TRACING_BUFFER_SIZE_TAG))
+    {
+        tracing.buffer_size = YamlReader::get_positive_int(yml, ENABLER_TRACING_BUFFER_SIZE_TAG);
+    }
+    if (YamlReader::is_tag_present(yml, ENABLER_TRACING_FLUSH_PERIOD_TAG))
+    {
+        tracing.flush_period_ms = YamlReader::get_positive_int(yml, ENABLER_TRACING_FLUSH_PERIOD_TAG);
+    }
+}
+
 void EnablerConfiguration::load_dds_configuration_(
         const Yaml& yml,
         const YamlReaderVersion& version)
@@ -122,6 +122,508 @@ TEST(DdsEnablerYamlTest, get_ddsenabler_default_values_configuration_yaml)
     ASSERT_EQ(configuration.n_threads, DEFAULT_N_THREADS);
 }
 
+TEST(DdsEnablerYamlTest, get_ddsenabler_warm_up_configuration_yaml)
+{
+    const char* yml_str =
+            R"(
+            ddsenabler:
+              warm-up:
+                max-concurrency: 8
+                topics:
+                  - name: "rt/chatter"
+                    type: "std_msgs::msg::dds_::String_"
+                  - name: "rt/queried"
+                services:
+                  - name: "add_two_ints"
+                  - name: "dds_service"
+                    protocol: dds
+                actions:
+                  - name: "fibonacci/_action/"
+                    protocol: ros2
+        )";
+
+    Yaml yml = YAML::Load(yml_str);
+
+    // Load configuration from YAML
+    EnablerConfiguration configuration(yml);
+
+    const auto& enabler_configuration = *configuration.enabler_configuration;
+    ASSERT_EQ(enabler_configuration.warm_up_max_concurrency, 8);
+
+    ASSERT_EQ(enabler_configuration.warm_up_topics.size(), 2);
+    ASSERT_EQ(enabler_configuration.warm_up_topics[0].name, "rt/chatter");
+    ASSERT_EQ(enabler_configuration.warm_up_topics[0].type_name, "std_msgs::msg::dds_::String_");
+    ASSERT_EQ(enabler_configuration.warm_up_topics[1].name, "rt/queried");
+    ASSERT_TRUE(enabler_configuration.warm_up_topics[1].type_name.empty());
+
+    ASSERT_EQ(enabler_configuration.warm_up_services.size(), 2);
+    ASSERT_EQ(enabler_configuration.warm_up_services[0].protocol, ddsenabler::participants::Protocol::ROS2);
+    ASSERT_EQ(enabler_configuration.warm_up_services[1].protocol, ddsenabler::participants::Protocol::DDS);
+
+    ASSERT_EQ(enabler_configuration.warm_up_actions.size(), 1);
+    ASSERT_EQ(enabler_configuration.warm_up_actions[0].name, "fibonacci/_action/");
+
+    // Unknown protocol
+    yml_str =
+            R"(
+            ddsenabler:
+              warm-up:
+                services:
+                  - name: "add_two_ints"
+                    protocol: error
+        )";
+
+    yml = YAML::Load(yml_str);
+    EXPECT_THROW({EnablerConfiguration configuration(yml);}, std::exception);
+
+    // Missing name
+    yml_str =
+            R"(
+            ddsenabler:
+              warm-up:
+                topics:
+                  - type: "std_msgs::msg::dds_::String_"
+        )";
+
+    yml = YAML::Load(yml_str);
+    EXPECT_THROW({EnablerConfiguration configuration(yml);}, std::exception);
+}
+
+TEST(DdsEnablerYamlTest, get_ddsenabler_lazy_type_notification_configuration_yaml)
+{
+    const char* yml_str =
+            R"(
+            ddsenabler:
+              lazy-type-notification: true
+        )";
+
+    Yaml yml = YAML::Load(yml_str);
+
+    // Load configuration from YAML
+    EnablerConfiguration configuration(yml);
+
+    ASSERT_TRUE(configuration.handler_configuration.lazy_type_notification);
+
+    // Default values
+    yml = YAML::Load("");
+    EnablerConfiguration default_configuration(yml);
+
+    ASSERT_FALSE(default_configuration.handler_configuration.lazy_type_notification);
+}
+
+TEST(DdsEnablerYamlTest, get_ddsenabler_incremental_type_collections_configuration_yaml)
+{
+    const char* yml_str =
+            R"(
+            ddsenabler:
+              incremental-type-collections: true
+        )";
+
+    Yaml yml = YAML::Load(yml_str);
+
+    // Load configuration from YAML
+    EnablerConfiguration configuration(yml);
+
+    ASSERT_TRUE(configuration.handler_configuration.incremental_type_collections);
+
+    // Default values
+    yml = YAML::Load("");
+    EnablerConfiguration default_configuration(yml);
+
+    ASSERT_FALSE(default_configuration.handler_configuration.incremental_type_collections);
+}
+
+TEST(DdsEnablerYamlTest, get_ddsenabler_type_store_configuration_yaml)
+{
+    const char* yml_str =
+            R"(
+            ddsenabler:
+              type-store: "types.bin"
+        )";
+
+    Yaml yml = YAML::Load(yml_str);
+
+    // Load configuration from YAML
+    EnablerConfiguration configuration(yml);
+
+    ASSERT_EQ(configuration.handler_configuration.type_store_path, "types.bin");
+
+    // Default values
+    yml = YAML::Load("");
+    EnablerConfiguration default_configuration(yml);
+
+    ASSERT_TRUE(default_configuration.handler_configuration.type_store_path.empty());
+}
+
+TEST(DdsEnablerYamlTest, get_ddsenabler_preload_types_configuration_yaml)
+{
+    const char* yml_str =
+            R"(
+            ddsenabler:
+              preload-types: "types"
+        )";
+
+    Yaml yml = YAML::Load(yml_str);
+
+    // Load configuration from YAML
+    EnablerConfiguration configuration(yml);
+
+    ASSERT_EQ(configuration.handler_configuration.preload_types_path, "types");
+
+    // Default values
+    yml = YAML::Load("");
+    EnablerConfiguration default_configuration(yml);
+
+    ASSERT_TRUE(default_configuration.handler_configuration.preload_types_path.empty());
+}
+
+TEST(DdsEnablerYamlTest, get_ddsenabler_type_bundle_configuration_yaml)
+{
+    const char* yml_str =
+            R"(
+            ddsenabler:
+              type-bundle: "types.bundle"
+        )";
+
+    Yaml yml = YAML::Load(yml_str);
+
+    // Load configuration from YAML
+    EnablerConfiguration configuration(yml);
+
+    ASSERT_EQ(configuration.handler_configuration.type_bundle_path, "types.bundle");
+
+    // Default values
+    yml = YAML::Load("");
+    EnablerConfiguration default_configuration(yml);
+
+    ASSERT_TRUE(default_configuration.handler_configuration.type_bundle_path.empty());
+}
+
+TEST(DdsEnablerYamlTest, get_ddsenabler_schema_cache_configuration_yaml)
+{
+    const char* yml_str =
+            R"(
+            ddsenabler:
+              schema-cache:
+                max-types: 256
+                max-bytes: 1048576
+        )";
+
+    Yaml yml = YAML::Load(yml_str);
+
+    // Load configuration from YAML
+    EnablerConfiguration configuration(yml);
+
+    ASSERT_EQ(configuration.handler_configuration.schema_cache_max_types, 256u);
+    ASSERT_EQ(configuration.handler_configuration.schema_cache_max_bytes, 1048576u);
+
+    // Default values
+    yml = YAML::Load("");
+    EnablerConfiguration default_configuration(yml);
+
+    // Unbounded
+    ASSERT_EQ(default_configuration.handler_configuration.schema_cache_max_types, 0u);
+    ASSERT_EQ(default_configuration.handler_configuration.schema_cache_max_bytes, 0u);
+}
+
+TEST(DdsEnablerYamlTest, get_ddsenabler_compact_qos_configuration_yaml)
+{
+    const char* yml_str =
+            R"(
+            ddsenabler:
+              compact-qos: true
+        )";
+
+    Yaml yml = YAML::Load(yml_str);
+
+    // Load configuration from YAML
+    EnablerConfiguration configuration(yml);
+
+    ASSERT_TRUE(configuration.handler_configuration.compact_qos);
+
+    // Default values
+    yml = YAML::Load("");
+    EnablerConfiguration default_configuration(yml);
+
+    ASSERT_FALSE(default_configuration.handler_configuration.compact_qos);
+}
+
+TEST(DdsEnablerYamlTest, get_ddsenabler_discovery_batch_window_configuration_yaml)
+{
+    const char* yml_str =
+            R"(
+            ddsenabler:
+              discovery-batch-window: 100
+        )";
+
+    Yaml yml = YAML::Load(yml_str);
+
+    // Load configuration from YAML
+    EnablerConfiguration configuration(yml);
+
+    ASSERT_EQ(configuration.handler_configuration.discovery_batch_window_ms, 100u);
+
+    // Default values
+    yml = YAML::Load("");
+    EnablerConfiguration default_configuration(yml);
+
+    // Disabled
+    ASSERT_EQ(default_configuration.handler_configuration.discovery_batch_window_ms, 0u);
+}
+
+TEST(DdsEnablerYamlTest, get_ddsenabler_discovery_snapshot_configuration_yaml)
+{
+    const char* yml_str =
+            R"(
+            ddsenabler:
+              discovery-snapshot:
+                path: "discovery.json"
+                period: 10000
+        )";
+
+    Yaml yml = YAML::Load(yml_str);
+
+    // Load configuration from YAML
+    EnablerConfiguration configuration(yml);
+
+    ASSERT_EQ(configuration.enabler_configuration->discovery_snapshot_path, "discovery.json");
+    ASSERT_EQ(configuration.enabler_configuration->discovery_snapshot_period, 10000u);
+
+    // Default values
+    yml = YAML::Load("");
+    EnablerConfiguration default_configuration(yml);
+
+    ASSERT_TRUE(default_configuration.enabler_configuration->discovery_snapshot_path.empty());
+    ASSERT_EQ(default_configuration.enabler_configuration->discovery_snapshot_period, 0u);
+}
+
+TEST(DdsEnablerYamlTest, get_ddsenabler_thread_placement_configuration_yaml)
+{
+    const char* yml_str =
+            R"(
+            specs:
+              thread-placement:
+                numa-node: 1
+                workers: "0-3,8"
+                dispatchers: "4"
+                file-watcher: 5
+        )";
+
+    Yaml yml = YAML::Load(yml_str);
+
+    // Load configuration from YAML
+    EnablerConfiguration configuration(yml);
+
+    ASSERT_EQ(configuration.thread_placement.numa_node, 1);
+    ASSERT_EQ(configuration.thread_placement.workers.cpus, (std::vector<unsigned int>{0, 1, 2, 3, 8}));
+    ASSERT_EQ(configuration.thread_placement.dispatchers.cpus, (std::vector<unsigned int>{4}));
+    ASSERT_EQ(configuration.thread_placement.file_watcher.cpus, (std::vector<unsigned int>{5}));
+    ASSERT_EQ(configuration.thread_placement.workers.name, ddsenabler::participants::WORKER_THREAD_NAME);
+    ASSERT_EQ(configuration.thread_placement.dispatchers.name, ddsenabler::participants::DISPATCHER_THREAD_NAME);
+    ASSERT_EQ(configuration.thread_placement.file_watcher.name, ddsenabler::participants::FILE_WATCHER_THREAD_NAME);
+
+    // Default values
+    yml = YAML::Load("");
+    EnablerConfiguration default_configuration(yml);
+
+    ASSERT_EQ(default_configuration.thread_placement.numa_node, -1);
+    ASSERT_TRUE(default_configuration.thread_placement.workers.cpus.empty());
+    ASSERT_TRUE(default_configuration.thread_placement.dispatchers.cpus.empty());
+    ASSERT_TRUE(default_configuration.thread_placement.file_watcher.cpus.empty());
+
+    // Threads are left as they are unless a placement is configured
+    ASSERT_TRUE(default_configuration.thread_placement.workers.name.empty());
+    ASSERT_TRUE(default_configuration.thread_placement.dispatchers.name.empty());
+    ASSERT_TRUE(default_configuration.thread_placement.file_watcher.name.empty());
+
+    // Decreasing CPU range
+    yml_str =
+            R"(
+            specs:
+              thread-placement:
+                workers: "3-1"
+        )";
+
+    yml = YAML::Load(yml_str);
+    EXPECT_THROW({EnablerConfiguration configuration(yml);}, std::exception);
+}
+
+TEST(DdsEnablerYamlTest, get_ddsenabler_priority_classes_configuration_yaml)
+{
+    const char* yml_str =
+            R"(
+            ddsenabler:
+              priority-classes:
+                scheduling: weighted
+                classes:
+                  - name: alarms
+                    topics: ["rt/estop", "rt/alarms/*"]
+                    weight: 8
+                    queue-size: 0
+                  - name: telemetry
+                    topics: ["rt/telemetry/*"]
+        )";
+
+    Yaml yml = YAML::Load(yml_str);
+
+    // Load configuration from YAML
+    EnablerConfiguration configuration(yml);
+
+    ASSERT_EQ(configuration.handler_configuration.priority_scheduling,
+            ddsenabler::participants::PriorityScheduling::WEIGHTED);
+    ASSERT_EQ(configuration.handler_configuration.priority_classes.size(), 2u);
+    ASSERT_EQ(configuration.handler_configuration.priority_classes[0].name, "alarms");
+    ASSERT_EQ(configuration.handler_configuration.priority_classes[0].topics,
+            (std::vector<std::string>{"rt/estop", "rt/alarms/*"}));
+    ASSERT_EQ(configuration.handler_configuration.priority_classes[0].weight, 8u);
+    ASSERT_EQ(configuration.handler_configuration.priority_classes[0].queue_size, 0u);
+    ASSERT_EQ(configuration.handler_configuration.priority_classes[1].name, "telemetry");
+    ASSERT_EQ(configuration.handler_configuration.priority_classes[1].weight, 1u);
+    ASSERT_EQ(configuration.handler_configuration.priority_classes[1].queue_size,
+            ddsenabler::participants::DEFAULT_PRIORITY_QUEUE_SIZE);
+
+    // Default values
+    yml = YAML::Load("");
+    EnablerConfiguration default_configuration(yml);
+
+    ASSERT_TRUE(default_configuration.handler_configuration.priority_classes.empty());
+    ASSERT_EQ(default_configuration.handler_configuration.priority_scheduling,
+            ddsenabler::participants::PriorityScheduling::STRICT);
+
+    // Unknown scheduling policy
+    yml_str =
+            R"(
+            ddsenabler:
+              priority-classes:
+                scheduling: error
+                classes: []
+        )";
+
+    yml = YAML::Load(yml_str);
+    EXPECT_THROW({EnablerConfiguration configuration(yml);}, std::exception);
+}
+
+TEST(DdsEnablerYamlTest, get_ddsenabler_callback_budget_configuration_yaml)
+{
+    const char* yml_str =
+            R"(
+            ddsenabler:
+              callback-budget:
+                duration: 50
+                offload-after: 3
+        )";
+
+    Yaml yml = YAML::Load(yml_str);
+
+    // Load configuration from YAML
+    EnablerConfiguration configuration(yml);
+
+    ASSERT_EQ(configuration.handler_configuration.callback_budget_ms, 50u);
+    ASSERT_EQ(configuration.handler_configuration.callback_offload_threshold, 3u);
+
+    // Default values
+    yml = YAML::Load("");
+    EnablerConfiguration default_configuration(yml);
+
+    // No budget
+    ASSERT_EQ(default_configuration.handler_configuration.callback_budget_ms, 0u);
+    ASSERT_EQ(default_configuration.handler_configuration.callback_offload_threshold, 0u);
+}
+
+TEST(DdsEnablerYamlTest, get_ddsenabler_metrics_export_configuration_yaml)
+{
+    const char* yml_str =
+            R"(
+            specs:
+              metrics-export:
+                prometheus:
+                  port: 9464
+                  unix-socket: "/tmp/ddsenabler_metrics.sock"
+                file:
+                  path: "metrics.csv"
+                  format: csv
+                  period: 5000
+                  max-size: 1048576
+                  max-files: 3
+        )";
+
+    Yaml yml = YAML::Load(yml_str);
+
+    // Load configuration from YAML
+    EnablerConfiguration configuration(yml);
+
+    ASSERT_TRUE(configuration.metrics_export.enabled());
+    ASSERT_EQ(configuration.metrics_export.prometheus_port, 9464);
+    ASSERT_EQ(configuration.metrics_export.prometheus_unix_socket, "/tmp/ddsenabler_metrics.sock");
+    ASSERT_EQ(configuration.metrics_export.file_path, "metrics.csv");
+    ASSERT_EQ(configuration.metrics_export.file_format, ddsenabler::participants::MetricsFileFormat::CSV);
+    ASSERT_EQ(configuration.metrics_export.file_period_ms, 5000u);
+    ASSERT_EQ(configuration.metrics_export.file_max_size, 1048576u);
+    ASSERT_EQ(configuration.metrics_export.file_max_files, 3u);
+
+    // Default values
+    yml = YAML::Load("");
+    EnablerConfiguration default_configuration(yml);
+
+    ASSERT_FALSE(default_configuration.metrics_export.enabled());
+    ASSERT_EQ(default_configuration.metrics_export.file_format, ddsenabler::participants::MetricsFileFormat::JSON);
+    ASSERT_EQ(default_configuration.metrics_export.file_period_ms,
+            ddsenabler::participants::DEFAULT_METRICS_FILE_PERIOD_MS);
+    ASSERT_EQ(default_configuration.metrics_export.file_max_size,
+            ddsenabler::participants::DEFAULT_METRICS_FILE_MAX_SIZE);
+    ASSERT_EQ(default_configuration.metrics_export.file_max_files,
+            ddsenabler::participants::DEFAULT_METRICS_FILE_MAX_FILES);
+
+    // Unknown file format
+    yml_str =
+            R"(
+            specs:
+              metrics-export:
+                file:
+                  path: "metrics.txt"
+                  format: error
+        )";
+
+    yml = YAML::Load(yml_str);
+    EXPECT_THROW({EnablerConfiguration configuration(yml);}, std::exception);
+}
+
+TEST(DdsEnablerYamlTest, get_ddsenabler_tracing_configuration_yaml)
+{
+    const char* yml_str =
+            R"(
+            specs:
+              tracing:
+                path: "trace.json"
+                sampling-period: 10
+                buffer-size: 1024
+                flush-period: 500
+        )";
+
+    Yaml yml = YAML::Load(yml_str);
+
+    // Load configuration from YAML
+    EnablerConfiguration configuration(yml);
+
+    ASSERT_TRUE(configuration.handler_configuration.tracing.enabled());
+    ASSERT_EQ(configuration.handler_configuration.tracing.file_path, "trace.json");
+    ASSERT_EQ(configuration.handler_configuration.tracing.sampling_period, 10u);
+    ASSERT_EQ(configuration.handler_configuration.tracing.buffer_size, 1024u);
+    ASSERT_EQ(configuration.handler_configuration.tracing.flush_period_ms, 500u);
+
+    // Default values
+    yml = YAML::Load("");
+    EnablerConfiguration default_configuration(yml);
+
+    ASSERT_FALSE(default_configuration.handler_configuration.tracing.enabled());
+    ASSERT_EQ(default_configuration.handler_configuration.tracing.sampling_period,
+            ddsenabler::participants::DEFAULT_TRACING_SAMPLING_PERIOD);
+    ASSERT_EQ(default_configuration.handler_configuration.tracing.buffer_size,
+            ddsenabler::participants::DEFAULT_TRACING_BUFFER_SIZE);
+    ASSERT_EQ(default_configuration.handler_configuration.tracing.flush_period_ms,
+            ddsenabler::participants::DEFAULT_TRACING_FLUSH_PERIOD_MS);
+}
+
 TEST(DdsEnablerYamlTest, get_ddsenabler_incorrect_path_configuration_json)
 {
     const char* path_str = "incorrect/path/file.json";